@@ -0,0 +1,62 @@
+#!/bin/sh
+
+# Compares the hot path benchmark results printed on the debug console
+# (build proj_cm33_ns and proj_cm55 with DEFINES+=HOT_PATH_BENCHMARK) with a
+# baseline. "make -C test bench" runs it on the host benchmark with
+# bench_host_baseline.csv.
+#
+# Usage: ./bench_compare.sh <console log> [baseline file] [threshold %]
+#
+# The "bench," lines of the console log are compared with the baseline by
+# their median cycle count. A kernel that is slower than the baseline by more
+# than the threshold is reported as a regression and the script exits with
+# status 1. Without a baseline file, the results are stored as the baseline.
+
+LOG_FILE="$1"
+BASELINE_FILE="${2:-bench_baseline.csv}"
+THRESHOLD="${3:-10}"
+
+if [ -z "${LOG_FILE}" ] || [ ! -f "${LOG_FILE}" ]; then
+    echo "Usage: $0 <console log> [baseline file] [threshold %]"
+    exit 2
+fi
+
+RESULTS=$(tr -d '\r' < "${LOG_FILE}" | grep '^bench,' | grep -v '^bench,core,')
+
+if [ -z "${RESULTS}" ]; then
+    echo "ERROR: no benchmark results in ${LOG_FILE}"
+    exit 2
+fi
+
+if [ ! -f "${BASELINE_FILE}" ]; then
+    echo "${RESULTS}" > "${BASELINE_FILE}"
+    echo "Baseline stored in ${BASELINE_FILE}"
+    exit 0
+fi
+
+printf "%-27s %10s %10s %8s\n" "kernel" "baseline" "current" "delta"
+echo "${RESULTS}" | awk -F, -v threshold="${THRESHOLD}" '
+    # bench,core,kernel,iterations,min_cycles,median_cycles,max_cycles
+    FNR == NR { base[$2 "/" $3] = $6; next }
+    {
+        name = $2 "/" $3
+        if (!(name in base)) {
+            printf "%-27s %10s %10d  NEW\n", name, "-", $6
+            next
+        }
+        delta = (base[name] > 0) ? (($6 - base[name]) * 100.0 / base[name]) : 0
+        status = "ok"
+        if (delta > threshold) { status = "REGRESSION"; failed = 1 }
+        else if (delta < -threshold) { status = "improved" }
+        printf "%-27s %10d %10d %+7.1f%%  %s\n", name, base[name], $6, delta, status
+        seen[name] = 1
+    }
+    END {
+        for (name in base) {
+            if (!(name in seen)) {
+                printf "%-27s %10d %10s  MISSING\n", name, base[name], "-"
+            }
+        }
+        exit failed
+    }
+' "${BASELINE_FILE}" -
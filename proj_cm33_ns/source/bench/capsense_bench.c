@@ -0,0 +1,154 @@
+/*******************************************************************************
+* File Name: capsense_bench.c
+*
+* Description: This file contains the CapSense benchmark kernels: the timing
+*              overhead, frame decoding and edge detection. They do not use any
+*              peripheral, so proj_cm55 builds this file as well.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include "cybsp.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "capsense_frame.h"
+#include "capsense_model.h"
+#include "capsense_bench.h"
+
+#if defined(HOT_PATH_BENCHMARK)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_SLIDER_STEP                   (7U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Inputs of the kernels: a binary frame with button 0 touched and the
+ * slider at 500, and a legacy frame with button 0 touched and the slider at
+ * 50 */
+static const uint8_t bench_frame_v1[CAPSENSE_FRAME_V1_SIZE] =
+{
+    CAPSENSE_FRAME_MAGIC, CAPSENSE_FRAME_VERSION_1, 0x10U,
+    (uint8_t) (CAPSENSE_FRAME_SENSOR_BUTTON0 | CAPSENSE_FRAME_SENSOR_SLIDER),
+    0x00U, 0xF4U, 0x01U, 0xF5U,
+};
+static const uint8_t bench_frame_legacy[CAPSENSE_FRAME_LEGACY_SIZE] =
+{
+    CAPSENSE_FRAME_LEGACY_ASCII_BASE + 1U,
+    CAPSENSE_FRAME_LEGACY_ASCII_BASE + 1U,
+    50U,
+};
+
+static capsense_frame_t bench_frame;
+static capsense_state_t bench_state[2];
+static volatile uint32_t bench_sink;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: bench_empty
+********************************************************************************
+* Summary:
+*  Measures the cost of the timing itself.
+*******************************************************************************/
+static void bench_empty(void)
+{
+}
+
+/*******************************************************************************
+* Function Name: bench_frame_decode_v1
+********************************************************************************
+* Summary:
+*  Decodes a binary CapSense frame.
+*******************************************************************************/
+static void bench_frame_decode_v1(void)
+{
+    bench_sink += (uint32_t) capsense_frame_decode(bench_frame_v1,
+            sizeof(bench_frame_v1), &bench_frame);
+}
+
+/*******************************************************************************
+* Function Name: bench_frame_decode_legacy
+********************************************************************************
+* Summary:
+*  Decodes a legacy ASCII CapSense frame.
+*******************************************************************************/
+static void bench_frame_decode_legacy(void)
+{
+    bench_sink += (uint32_t) capsense_frame_decode(bench_frame_legacy,
+            sizeof(bench_frame_legacy), &bench_frame);
+}
+
+/*******************************************************************************
+* Function Name: bench_edge_detect
+********************************************************************************
+* Summary:
+*  Converts a frame to the sensor state and detects the changed sensors.
+*  The slider moves on every iteration so the move detection runs. Runs
+*  after bench_frame_decode_v1, which leaves a binary frame in bench_frame.
+*******************************************************************************/
+static void bench_edge_detect(void)
+{
+    static uint32_t index;
+    capsense_state_t *p_prev = &bench_state[index & 1U];
+    capsense_state_t *p_cur = &bench_state[(index + 1U) & 1U];
+
+    bench_frame.position[CAPSENSE_FRAME_SLIDER_SLOT] =
+            (uint16_t) ((index * BENCH_SLIDER_STEP) % bench_frame.position_max);
+    capsense_model_decode(&bench_frame, p_cur);
+    bench_sink += capsense_model_events(p_prev, p_cur);
+    index++;
+}
+
+/* CapSense kernels, run in this order */
+const bench_kernel_t capsense_bench_kernels[] =
+{
+    { "overhead",            bench_empty,               0U },
+    { "frame_decode_legacy", bench_frame_decode_legacy, 0U },
+    { "frame_decode_v1",     bench_frame_decode_v1,     0U },
+    { "edge_detect",         bench_edge_detect,         0U },
+};
+
+const uint32_t capsense_bench_kernel_count =
+        sizeof(capsense_bench_kernels) / sizeof(capsense_bench_kernels[0]);
+
+#endif /* defined(HOT_PATH_BENCHMARK) */
+
+/* [] END OF FILE */
@@ -0,0 +1,283 @@
+/*******************************************************************************
+* File Name: hot_path_bench.c
+*
+* Description: This file contains the benchmark suite of the firmware hot paths.
+*              Each kernel is timed with the DWT cycle counter and the results
+*              of both CPUs are printed as comma separated lines that
+*              benchmark/bench_compare.sh compares against a stored baseline.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include "cybsp.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "cycfg_gatt_db.h"
+#include "bt_app.h"
+#include "bt_stream.h"
+#include "board.h"
+#include "capsense_model.h"
+#include "i2c_capsense.h"
+#include "bench_timer.h"
+#include "capsense_bench.h"
+#include "hot_path_bench.h"
+
+#if defined(HOT_PATH_BENCHMARK)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* ATT MTU and read by type request size of the GATT kernels */
+#define BENCH_MTU                           (247U)
+#define BENCH_READ_BY_TYPE_LEN              (BENCH_MTU - 2U)
+
+#define BENCH_GATT_HANDLE_FIRST             (0x0001U)
+#define BENCH_GATT_HANDLE_LAST              (0xFFFFU)
+
+/* The PWM kernel cycles the compare value through the LED PWM period */
+#define BENCH_PWM_PERIOD                    (100U)
+
+/* Time CM33 waits for the CM55 results after its own kernels */
+#define BENCH_CM55_TIMEOUT_MS               (1000U)
+#define BENCH_CM55_POLL_MS                  (10U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static volatile uint32_t bench_sink;
+static uint8_t bench_buf[BENCH_MTU];
+static bench_result_t bench_cm55_results[BENCH_TIMER_RESULTS_MAX];
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: bench_i2c_read
+********************************************************************************
+* Summary:
+*  Reads the touch frame from the PSoC 4000T, including the bus time.
+*******************************************************************************/
+static void bench_i2c_read(void)
+{
+    bench_sink += (uint32_t) i2c_capsense_bench_read();
+}
+
+/*******************************************************************************
+* Function Name: bench_find_by_handle
+********************************************************************************
+* Summary:
+*  Looks up the attribute at the end of the lookup table.
+*******************************************************************************/
+static void bench_find_by_handle(void)
+{
+    bench_sink += (uint32_t) (NULL != bt_app_find_by_handle(
+            app_gatt_db_ext_attr_tbl[app_gatt_db_ext_attr_tbl_size - 1U]
+            .handle));
+}
+
+/*******************************************************************************
+* Function Name: bench_write_value
+********************************************************************************
+* Summary:
+*  Writes the Diagnostics CCCD, which has no side effect beyond the value.
+*******************************************************************************/
+static void bench_write_value(void)
+{
+    uint8_t cccd[] = {0U, 0U};
+
+    bench_sink += (uint32_t) bt_app_gatt_req_write_value(
+            HDLD_CAPSENSE_DIAGNOSTICS_CLIENT_CHAR_CONFIG, cccd, sizeof(cccd));
+}
+
+/*******************************************************************************
+* Function Name: bench_read_by_type
+********************************************************************************
+* Summary:
+*  Builds the Read By Type Response for the device name over the whole
+*  database. Without a connection, the stack refuses to send it.
+*******************************************************************************/
+static void bench_read_by_type(void)
+{
+    wiced_bt_gatt_read_by_type_t req =
+    {
+        .s_handle = BENCH_GATT_HANDLE_FIRST,
+        .e_handle = BENCH_GATT_HANDLE_LAST,
+        .uuid =
+        {
+            .len = LEN_UUID_16,
+            .uu.uuid16 = GATT_UUID_GAP_DEVICE_NAME,
+        },
+    };
+
+    bench_sink += (uint32_t) bt_app_gatt_req_read_by_type_handler(0U,
+            GATT_REQ_READ_BY_TYPE, &req, BENCH_READ_BY_TYPE_LEN);
+}
+
+/*******************************************************************************
+* Function Name: bench_stream_pack
+********************************************************************************
+* Summary:
+*  Assembles a full stream notification.
+*******************************************************************************/
+static void bench_stream_pack(void)
+{
+    bench_sink += bt_stream_bench_pack(bench_buf);
+}
+
+/*******************************************************************************
+* Function Name: bench_pwm_update
+********************************************************************************
+* Summary:
+*  Writes the LED1 PWM compare value, as the board task does for a
+*  brightness command.
+*******************************************************************************/
+static void bench_pwm_update(void)
+{
+    static uint32_t compare;
+
+    Cy_TCPWM_PWM_SetCompare0(PWM1_HW, PWM1_NUM, compare++ % BENCH_PWM_PERIOD);
+}
+
+/*******************************************************************************
+* Function Name: bench_led_command
+********************************************************************************
+* Summary:
+*  Sends an LED brightness command. The board task has the higher priority,
+*  so the time includes the command handling and the PWM update.
+*******************************************************************************/
+static void bench_led_command(void)
+{
+    static uint8_t brightness;
+    led_command_data_t cmd =
+    {
+        .command = LED_SET_BRIGHTNESS,
+        .brightness = brightness++ % CAPSENSE_POSITION_PERCENT_MAX,
+    };
+
+    bench_sink += (uint32_t) xQueueSendToBack(led_command_data_q, &cmd, 0U);
+}
+
+/* CM33 kernels, run in this order after the CapSense kernels */
+static const bench_kernel_t bench_kernels[] =
+{
+    { "i2c_read",            bench_i2c_read,            0U },
+    { "find_by_handle",      bench_find_by_handle,      0U },
+    { "write_value",         bench_write_value,         0U },
+    { "read_by_type",        bench_read_by_type,        0U },
+    { "stream_pack",         bench_stream_pack,         0U },
+    { "pwm_update",          bench_pwm_update,          0U },
+    { "led_command",         bench_led_command,         0U },
+};
+
+/*******************************************************************************
+* Function Name: bench_run_kernels
+********************************************************************************
+* Summary:
+*  Times the given kernels and prints one result line per kernel.
+*******************************************************************************/
+static void bench_run_kernels(const bench_kernel_t *p_kernels, uint32_t count)
+{
+    bench_result_t result;
+
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        bench_timer_run(&p_kernels[i], &result);
+        bench_timer_print("cm33", &result);
+    }
+}
+
+/*******************************************************************************
+* Function Name: hot_path_benchmark
+********************************************************************************
+* Summary:
+*  Runs the CM33 kernels, prints the results of both CPUs and halts:
+*  bench,<core>,<kernel>,<iterations>,<min>,<median>,<max> in CPU cycles
+*  per call, including the overhead kernel. Called by the BT task once the
+*  GATT database is initialized. bench_timer_init() must have been called
+*  before CM55 was enabled.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void hot_path_benchmark(void)
+{
+    uint32_t count = 0U;
+
+    bench_timer_print_header();
+    bench_run_kernels(capsense_bench_kernels, capsense_bench_kernel_count);
+
+    /* Take the bus and the stream buffer over from the CapSense task */
+    i2c_capsense_bench_begin();
+    bt_stream_set_mtu(BENCH_MTU);
+    bench_run_kernels(bench_kernels,
+                      sizeof(bench_kernels) / sizeof(bench_kernels[0]));
+
+    /* CM55 runs its kernels at start-up, normally long before this point */
+    for (uint32_t waited = 0U; waited < BENCH_CM55_TIMEOUT_MS;
+            waited += BENCH_CM55_POLL_MS)
+    {
+        count = bench_timer_collect(bench_cm55_results,
+                                    BENCH_TIMER_RESULTS_MAX);
+        if (0U != count)
+        {
+            break;
+        }
+        vTaskDelay(pdMS_TO_TICKS(BENCH_CM55_POLL_MS));
+    }
+
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        bench_timer_print("cm55", &bench_cm55_results[i]);
+    }
+    if (0U == count)
+    {
+        printf("No CM55 benchmark results, is proj_cm55 built with "
+               "HOT_PATH_BENCHMARK?\r\n");
+    }
+
+    printf("Benchmark complete, halting\r\n");
+    bench_timer_halt();
+}
+
+#endif /* defined(HOT_PATH_BENCHMARK) */
+
+/* [] END OF FILE */
@@ -45,6 +45,10 @@
 * Header file includes
 *******************************************************************************/
 #include "stdint.h"
+#include "cybsp.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
 
 /*******************************************************************************
 * Global Constants
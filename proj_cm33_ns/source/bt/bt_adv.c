@@ -0,0 +1,350 @@
+/*******************************************************************************
+* File Name: bt_adv.c
+*
+* Description: This file contains the broadcast of the CapSense touch state in
+*              the manufacturer specific advertising data.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdio.h>
+#include "cycfg_gap.h"
+#include "bt_app.h"
+#include "bt_adv.h"
+#include "i2c_capsense.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Legacy advertising and scan response payload size */
+#define ADV_DATA_MAX                        (31U)
+
+/* Length and type byte of every AD structure */
+#define ADV_ELEM_HEADER_SIZE                (2U)
+
+/* Generated elements plus the touch record and the shortened name */
+#define ADV_ELEM_MAX                        (CY_BT_ADV_PACKET_DATA_SIZE + 2U)
+
+/* Minimum time between two advertising data updates */
+#define ADV_UPDATE_INTERVAL_MS              (50U)
+
+/* Position of the fields in the touch record */
+#define ADV_RECORD_TYPE_INDEX               (2U)
+#define ADV_RECORD_SEQUENCE_INDEX           (3U)
+#define ADV_RECORD_BUTTONS_INDEX            (4U)
+#define ADV_RECORD_SLIDER_INDEX             (5U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* AD structures of the advertising and scan response packets */
+typedef struct
+{
+    wiced_bt_ble_advert_elem_t elem[ADV_ELEM_MAX];
+    uint8_t count;
+    uint8_t len;
+} adv_packet_t;
+
+static adv_packet_t adv_packet;
+static adv_packet_t scan_rsp_packet;
+
+/* Touch record carried in the manufacturer specific data */
+static uint8_t adv_record[BT_ADV_RECORD_SIZE] =
+{
+    (uint8_t) BT_ADV_COMPANY_ID,
+    (uint8_t) (BT_ADV_COMPANY_ID >> 8U),
+    BT_ADV_RECORD_TYPE_TOUCH,
+};
+
+/* Tick of the last advertising data update */
+static TickType_t adv_update_tick;
+
+/* Set by the stack callbacks, handled by the BT task */
+static volatile bool adv_restart_pending;
+static volatile bool adv_stop_requested;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: adv_packet_add
+********************************************************************************
+* Summary:
+*  Appends an AD structure to a packet if it fits.
+*
+* Parameters:
+*  adv_packet_t *p_packet                  : Packet to append to
+*  const wiced_bt_ble_advert_elem_t *p_elem: AD structure
+*
+* Return:
+*  bool: true if the structure was added
+*
+*******************************************************************************/
+static bool adv_packet_add(adv_packet_t *p_packet,
+                           const wiced_bt_ble_advert_elem_t *p_elem)
+{
+    uint32_t len = ADV_ELEM_HEADER_SIZE + p_elem->len;
+
+    if ((p_packet->len + len > ADV_DATA_MAX) ||
+            (p_packet->count >= ADV_ELEM_MAX))
+    {
+        return false;
+    }
+
+    p_packet->elem[p_packet->count++] = *p_elem;
+    p_packet->len += (uint8_t) len;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: bt_adv_init
+********************************************************************************
+* Summary:
+*  Builds the advertising data from the generated GAP configuration and sets
+*  it together with the scan response. The advertising packet carries the
+*  flags, the touch record and the device name, shortened to the space left.
+*  The other generated elements, including the complete name, move to the
+*  scan response, which active scanners such as phones request.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_adv_init(void)
+{
+    const wiced_bt_ble_advert_elem_t *p_name = NULL;
+    wiced_bt_ble_advert_elem_t record =
+    {
+        .advert_type = BTM_BLE_ADVERT_TYPE_MANUFACTURER,
+        .len = BT_ADV_RECORD_SIZE,
+        .p_data = adv_record,
+    };
+
+    adv_packet.count = 0U;
+    adv_packet.len = ADV_ELEM_HEADER_SIZE + BT_ADV_RECORD_SIZE;
+    scan_rsp_packet.count = 0U;
+    scan_rsp_packet.len = 0U;
+
+    for (uint32_t i = 0U; i < CY_BT_ADV_PACKET_DATA_SIZE; i++)
+    {
+        const wiced_bt_ble_advert_elem_t *p_elem = &cy_bt_adv_packet_data[i];
+
+        if (BTM_BLE_ADVERT_TYPE_FLAG == p_elem->advert_type)
+        {
+            (void) adv_packet_add(&adv_packet, p_elem);
+            continue;
+        }
+
+        if (BTM_BLE_ADVERT_TYPE_NAME_COMPLETE == p_elem->advert_type)
+        {
+            p_name = p_elem;
+        }
+
+        if (!adv_packet_add(&scan_rsp_packet, p_elem) &&
+                !adv_packet_add(&adv_packet, p_elem))
+        {
+            printf("Advertising element 0x%x does not fit\r\n",
+                   p_elem->advert_type);
+        }
+    }
+
+    /* The length reserved for the record is added back with it */
+    adv_packet.len -= ADV_ELEM_HEADER_SIZE + BT_ADV_RECORD_SIZE;
+    (void) adv_packet_add(&adv_packet, &record);
+
+    if ((NULL != p_name) &&
+            (adv_packet.len + ADV_ELEM_HEADER_SIZE < ADV_DATA_MAX))
+    {
+        wiced_bt_ble_advert_elem_t name =
+        {
+            .advert_type = BTM_BLE_ADVERT_TYPE_NAME_SHORT,
+            .len = MIN(p_name->len, (uint16_t) (ADV_DATA_MAX -
+                    adv_packet.len - ADV_ELEM_HEADER_SIZE)),
+            .p_data = p_name->p_data,
+        };
+
+        if (name.len == p_name->len)
+        {
+            name.advert_type = BTM_BLE_ADVERT_TYPE_NAME_COMPLETE;
+        }
+        (void) adv_packet_add(&adv_packet, &name);
+    }
+
+    wiced_bt_ble_set_raw_scan_response_data(scan_rsp_packet.count,
+                                            scan_rsp_packet.elem);
+    wiced_bt_ble_set_raw_advertisement_data(adv_packet.count,
+                                            adv_packet.elem);
+    adv_update_tick = xTaskGetTickCount();
+}
+
+/*******************************************************************************
+* Function Name: bt_adv_stop
+********************************************************************************
+* Summary:
+*  Stops the advertisements before the application starts them in another
+*  mode. The resulting state change does not restart the broadcast.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_adv_stop(void)
+{
+    if (BTM_BLE_ADVERT_OFF != wiced_bt_ble_get_current_advert_mode())
+    {
+        adv_stop_requested = true;
+        (void) wiced_bt_start_advertisements(BTM_BLE_ADVERT_OFF,
+                                             BLE_ADDR_PUBLIC, NULL);
+    }
+}
+
+/*******************************************************************************
+* Function Name: bt_adv_on_state_changed
+********************************************************************************
+* Summary:
+*  Restarts the broadcast when the advertisements stop because of a timeout
+*  or a connection. The restart is done by the BT task.
+*
+* Parameters:
+*  wiced_bt_ble_advert_mode_t mode: New advertising mode
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_adv_on_state_changed(wiced_bt_ble_advert_mode_t mode)
+{
+    if (BTM_BLE_ADVERT_OFF != mode)
+    {
+        return;
+    }
+
+    if (adv_stop_requested)
+    {
+        adv_stop_requested = false;
+    }
+    else if (0U != BT_ADV_BROADCAST_ENABLE)
+    {
+        adv_restart_pending = true;
+        xTaskNotify(bt_task_handle, NOTIFIY_OFF, eNoAction);
+    }
+}
+
+/*******************************************************************************
+* Function Name: bt_adv_restart
+********************************************************************************
+* Summary:
+*  Starts the low duty cycle advertisements: connectable while no client is
+*  connected, non-connectable while one is.
+*******************************************************************************/
+static void bt_adv_restart(void)
+{
+    wiced_bt_ble_advert_mode_t mode = (0U == bt_connection_id) ?
+            BTM_BLE_ADVERT_UNDIRECTED_LOW : BTM_BLE_ADVERT_NONCONN_LOW;
+
+    adv_restart_pending = false;
+
+    if (BTM_BLE_ADVERT_OFF != wiced_bt_ble_get_current_advert_mode())
+    {
+        return;
+    }
+
+    if (WICED_BT_SUCCESS != wiced_bt_start_advertisements(mode,
+            BLE_ADDR_PUBLIC, NULL))
+    {
+        printf("Failed to restart the broadcast\r\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: bt_adv_process
+********************************************************************************
+* Summary:
+*  Puts the current touch state into the advertising data when it changed,
+*  at most every ADV_UPDATE_INTERVAL_MS, and restarts the broadcast when
+*  the advertisements stopped. Called from the BT task.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  TickType_t: Ticks until a pending update is due
+*
+*******************************************************************************/
+TickType_t bt_adv_process(void)
+{
+    uint8_t buttons = (uint8_t) capsense_data.buttons;
+    uint8_t slider = capsense_data.sliderdata;
+    TickType_t elapsed;
+
+    if (adv_restart_pending)
+    {
+        bt_adv_restart();
+    }
+
+    if ((buttons == adv_record[ADV_RECORD_BUTTONS_INDEX]) &&
+            (slider == adv_record[ADV_RECORD_SLIDER_INDEX]))
+    {
+        return portMAX_DELAY;
+    }
+
+    elapsed = xTaskGetTickCount() - adv_update_tick;
+    if (elapsed < pdMS_TO_TICKS(ADV_UPDATE_INTERVAL_MS))
+    {
+        return pdMS_TO_TICKS(ADV_UPDATE_INTERVAL_MS) - elapsed;
+    }
+
+    /* The sequence number lets observers tell a new touch from a repeated
+     * advertising event */
+    adv_record[ADV_RECORD_SEQUENCE_INDEX]++;
+    adv_record[ADV_RECORD_BUTTONS_INDEX] = buttons;
+    adv_record[ADV_RECORD_SLIDER_INDEX] = slider;
+
+    wiced_bt_ble_set_raw_advertisement_data(adv_packet.count,
+                                            adv_packet.elem);
+    adv_update_tick = xTaskGetTickCount();
+
+    return portMAX_DELAY;
+}
+
+/* [] END OF FILE */
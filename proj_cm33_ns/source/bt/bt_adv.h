@@ -0,0 +1,74 @@
+/*******************************************************************************
+* File Name: bt_adv.h
+*
+* Description: This file contains the declarations of the broadcast of the
+*              CapSense touch state in the advertising data.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef BT_ADV_H
+#define BT_ADV_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "wiced_bt_ble.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Keep advertising the touch state while a client is connected and after
+ * the advertising timeouts. Set to 0 to advertise only for connections. */
+#define BT_ADV_BROADCAST_ENABLE             (1U)
+
+/* Company identifier of Infineon Technologies AG */
+#define BT_ADV_COMPANY_ID                   (0x0009U)
+
+/* Manufacturer data: company ID (u16), record type, sequence number (u8),
+ * touched buttons (u8) and slider position in percent (u8) */
+#define BT_ADV_RECORD_TYPE_TOUCH            (0x01U)
+#define BT_ADV_RECORD_SIZE                  (6U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void bt_adv_init(void);
+void bt_adv_stop(void);
+void bt_adv_on_state_changed(wiced_bt_ble_advert_mode_t mode);
+TickType_t bt_adv_process(void);
+
+#endif /* BT_ADV_H */
+
+/* [] END OF FILE */
@@ -39,6 +39,7 @@
 /*******************************************************************************
 * Header file includes
 *******************************************************************************/
+#include <string.h>
 #include "cycfg_gap.h"
 #include "cybsp_bt_config.h"
 #include "cycfg_gatt_db.h"
@@ -49,7 +50,20 @@
 #include "bt_app.h"
 #include "board.h"
 #include "i2c_capsense.h"
+#include "capsense_model.h"
 #include "retarget_io_init.h"
+#include "power_stats.h"
+#include "bt_conn_param.h"
+#include "bt_link.h"
+#include "bt_stream.h"
+#include "bt_adv.h"
+#include "bt_periodic.h"
+#include "bt_gatt_rec.h"
+#include "bt_control.h"
+#include "bt_notify.h"
+#include "bt_indicate.h"
+#include "bt_bond.h"
+#include "hot_path_bench.h"
 
 /*******************************************************************************
 * Macros
@@ -58,18 +72,28 @@
 #define VTASK_DELAY_TICKS                           (10U)
 #define INIT_VALUE_ZERO                             (0U)
 #define BITS_TO_CLEAR_ON_ENTRY                      (0U)
-#define BITS_TO_CLEAR_ON_EXIT                       (0U)
+#define BITS_TO_CLEAR_ON_EXIT                       (0xFFFFFFFFUL)
 #define SET_DUTY_CYCLE_100                          (1000U)
 #define SET_DUTY_CYCLE_50                           (500U)
 #define BUTTON_COUNT                                (0U)
 #define BUTTON_STATUS                               (1U)
 #define SLIDER_DATA                                 (0U)
-#define APP_CAPSENSE_BUTTON                         (2U)
-#define APP_CAPSENSE_SLIDER                         (4U)
 #define NOTIFICATION_ENABLED                        (0U)
 #define CAPSENSE_BUTTON_CLIENT_CHAR_CONFIG_LEN      (2U)
+#define BUTTON_CLIENT_CONFIG_ENABLED                                          \
+    (GATT_CLIENT_CONFIG_NOTIFICATION | GATT_CLIENT_CONFIG_INDICATION)
 #define CAPSENSE_SLIDER_CLIENT_CHAR_CONFIG_LEN      (2U)
-#define NO_OF_CAPSENSE_BUTTONS                      (2U)
+#define CAPSENSE_STREAM_CLIENT_CHAR_CONFIG_LEN      (2U)
+#define NO_OF_CAPSENSE_BUTTONS                      (CAPSENSE_BUTTON_COUNT)
+#define DIAG_READ_OFFSET_START                      (0U)
+#define CAPSENSE_DIAG_CLIENT_CHAR_CONFIG_LEN        (2U)
+#define GATT_CLIENT_FEATURES_LEN                    (1U)
+#define ATT_DEFAULT_MTU                             (23U)
+#define ATT_NOTIFICATION_HEADER_SIZE                (3U)
+#define PAYLOAD_STAMP_LEN                           (6U)
+#define PAYLOAD_VALUE_MAX                           (3U)
+#define PAYLOAD_EXTENDED_MAX                                                  \
+    (PAYLOAD_VALUE_MAX + PAYLOAD_STAMP_LEN)
 
 /*******************************************************************************
 * Global Variables
@@ -80,6 +104,24 @@ volatile uint16_t bt_connection_id = INIT_VALUE_ZERO;
 /* Typdef for function used to free allocated buffer to stack */
 typedef void (*pfn_free_buffer_t)(uint8_t *);
 
+/* ATT MTU of the current connection */
+static uint16_t bt_att_mtu = ATT_DEFAULT_MTU;
+
+/* Minimum time between two button and slider notifications */
+static volatile uint16_t bt_app_notify_interval_ms = VTASK_DELAY_TICKS;
+
+/* Button and slider payload format, BT_APP_PAYLOAD_xx */
+static volatile uint8_t bt_app_payload_format = BT_APP_PAYLOAD_LEGACY;
+
+/* Sequence numbers of the last extended button and slider payloads */
+static uint16_t bt_app_button_seq;
+static uint16_t bt_app_slider_seq;
+
+#if defined(HOT_PATH_BENCHMARK)
+/* Set by bt_app_init() once the GATT database is initialized */
+static volatile bool bt_app_ready = false;
+#endif
+
 /*******************************************************************************
 * Function Definitions
 *******************************************************************************/
@@ -104,20 +146,67 @@ void bt_task(void* param)
     /* Suppress warning for unused parameter */
      CY_UNUSED_PARAMETER(param);
 
+    /* Restore the parameters of the last control write */
+    bt_control_load();
+
+#if defined(BT_STREAM_BENCHMARK)
+    /* Measure the stream throughput over simulated links */
+    bt_stream_benchmark();
+#endif
+
+#if defined(HOT_PATH_BENCHMARK)
+    /* Time the hot paths once bt_app_init() has initialized the GATT
+     * database, outside the stack callbacks. Halts once the results are
+     * printed. */
+    while (!bt_app_ready)
+    {
+        (void) xTaskNotifyWait(BITS_TO_CLEAR_ON_ENTRY, BITS_TO_CLEAR_ON_EXIT,
+                               &nofify_value, portMAX_DELAY);
+    }
+    hot_path_benchmark();
+#endif
+
     /* Repeatedly running part of the task */
     for(;;)
     {
-        /* Block till a notification is received. */
-        xTaskNotifyWait(BITS_TO_CLEAR_ON_ENTRY, BITS_TO_CLEAR_ON_EXIT,
-                &nofify_value, portMAX_DELAY);
-
-       /* Command has been received from queue */
-        if(NOTIFIY_ON == nofify_value)
+        /* Apply the connection parameter policy and the link negotiation
+         * timeouts and find out when they need to run again */
+        TickType_t wait_ticks = MIN(bt_conn_param_process(),
+                                    bt_link_process());
+
+        /* Send the queued notifications and stream samples and
+         * broadcast the touch state */
+        wait_ticks = MIN(wait_ticks, bt_notify_process());
+        wait_ticks = MIN(wait_ticks, bt_indicate_process());
+        wait_ticks = MIN(wait_ticks, bt_stream_process());
+        wait_ticks = MIN(wait_ticks, bt_adv_process());
+
+        /* Save the parameters of a control write and remove the bonds
+         * on request of the console */
+        wait_ticks = MIN(wait_ticks, bt_control_process());
+        wait_ticks = MIN(wait_ticks, bt_bond_process());
+
+#if defined(BT_PERIODIC_ADV)
+        wait_ticks = MIN(wait_ticks, bt_periodic_process());
+#endif
+#if defined(BT_GATT_RECORD)
+        /* Complete the notifications sent on the simulated link */
+        wait_ticks = MIN(wait_ticks, bt_gatt_rec_process());
+#endif
+
+        /* Block till a notification is received or the policy is due. */
+        if (pdTRUE == xTaskNotifyWait(BITS_TO_CLEAR_ON_ENTRY,
+                BITS_TO_CLEAR_ON_EXIT, &nofify_value, wait_ticks))
         {
-            bt_app_send_notification();
+            /* Command has been received from queue */
+            if(NOTIFIY_ON == nofify_value)
+            {
+                bt_app_send_notification();
+                (void) bt_notify_process();
+                (void) bt_indicate_process();
+                vTaskDelay(pdMS_TO_TICKS(bt_app_notify_interval_ms));
+            }
         }
-
-        vTaskDelay(pdMS_TO_TICKS(VTASK_DELAY_TICKS));
     }
 }
 
@@ -140,22 +229,35 @@ void bt_app_init(void)
     status = wiced_bt_gatt_register(bt_app_gatt_event_cb);
     printf("GATT event handler registration status: %d \r\n",status);
 
-    /* Initialize GATT Database */
-    status = wiced_bt_gatt_db_init(gatt_database, gatt_database_len, NULL);
+    /* Initialize GATT Database. The stack computes the Database Hash,
+     * which caching clients compare to skip the discovery. */
+    status = wiced_bt_gatt_db_init(gatt_database, gatt_database_len,
+                                   app_gatt_database_hash);
     printf("GATT database initialization status: %d \r\n",status);
+    printf("GATT database hash: ");
+    for (uint32_t i = 0U; i < app_gatt_database_hash_len; i++)
+    {
+        printf("%02X", app_gatt_database_hash[i]);
+    }
+    printf("\r\n");
 
-    /* Allow peer to pair */
-    wiced_bt_set_pairable_mode(FALSE, FALSE);
+    /* Allow peer to pair, and load the saved bonds */
+    wiced_bt_set_pairable_mode(TRUE, FALSE);
+    bt_bond_init();
 
-    /* Set Advertisement Data */
-    wiced_bt_ble_set_raw_advertisement_data(CY_BT_ADV_PACKET_DATA_SIZE, 
-                                            cy_bt_adv_packet_data);
+    /* Set Advertisement Data with the touch state record */
+    bt_adv_init();
 
-    /* Start Undirected LE Advertisements on device startup.
+#if defined(BT_PERIODIC_ADV)
+    /* Publish the touch events over periodic advertising */
+    bt_periodic_init();
+#endif
+
+    /* Start LE Advertisements on device startup, directed to the last
+     * bonded peer if there is one.
      * The corresponding parameters are contained in 'app_bt_cfg.c' 
      */
-    result = wiced_bt_start_advertisements(BTM_BLE_ADVERT_UNDIRECTED_HIGH,
-            BLE_ADDR_PUBLIC, NULL);
+    result = bt_bond_start_advertisements();
 
     /* Failed to start advertisement. Stop program execution */
     if (WICED_BT_SUCCESS != result)
@@ -163,6 +265,17 @@ void bt_app_init(void)
         printf("Failed to start advertisement! \r\n");
         handle_app_error();
     }
+
+#if defined(HOT_PATH_BENCHMARK)
+    /* Let the BT task time the hot paths */
+    bt_app_ready = true;
+    xTaskNotify(bt_task_handle, NOTIFIY_OFF, eNoAction);
+#endif
+
+#if defined(BT_GATT_RECORD)
+    /* Connect the simulated client */
+    bt_gatt_rec_start();
+#endif
 }
 
 /*******************************************************************************
@@ -225,12 +338,26 @@ wiced_result_t bt_app_management_cb(wiced_bt_management_evt_t event,
                 board_led2_set_state(SET_DUTY_CYCLE_100);
             }
 
+            /* Fall back to undirected advertising, and keep broadcasting
+             * the touch state */
+            bt_bond_on_advert_state_changed(
+                    p_event_data->ble_advert_state_changed);
+            bt_adv_on_state_changed(p_event_data->ble_advert_state_changed);
+
             if(BTM_BLE_ADVERT_UNDIRECTED_HIGH == p_event_data
                     ->ble_advert_state_changed)
             {
                 board_led2_set_state(SET_DUTY_CYCLE_50);
             }
 
+            if((BTM_BLE_ADVERT_DIRECTED_HIGH == p_event_data
+                    ->ble_advert_state_changed) ||
+               (BTM_BLE_ADVERT_DIRECTED_LOW == p_event_data
+                    ->ble_advert_state_changed))
+            {
+                board_led2_set_state(SET_DUTY_CYCLE_50);
+            }
+
             if(BTM_BLE_ADVERT_UNDIRECTED_LOW == p_event_data
                     ->ble_advert_state_changed)
             {
@@ -240,23 +367,20 @@ wiced_result_t bt_app_management_cb(wiced_bt_management_evt_t event,
             break;
 
         case BTM_BLE_CONNECTION_PARAM_UPDATE:
-            printf("Bluetooth connection parameter update status:%d\r\n"
-                   "parameter interval: %d ms\r\n"
-                   "parameter latency: %d ms\r\n"
-                   "parameter timeout: %d ms\r\n",
-                   p_event_data->ble_connection_param_update.status,
-                   p_event_data->ble_connection_param_update.conn_interval,
-                   p_event_data->ble_connection_param_update.conn_latency,
-                   p_event_data->ble_connection_param_update.supervision_timeout);
+            /* Log the negotiated parameters and complete the request */
+            bt_conn_param_on_update(&p_event_data->ble_connection_param_update);
             result = WICED_SUCCESS;
             break;
 
         case BTM_BLE_PHY_UPDATE_EVT:
-            /* Print the updated BLE physical link*/
-            printf("Bluetooth phy update selected TX - %dM\r\n"
-                   "Bluetooth phy update selected RX - %dM\r\n",
-                   p_event_data->ble_phy_update_event.tx_phy,
-                   p_event_data->ble_phy_update_event.rx_phy);
+            /* Record the PHY and continue with the data length */
+            bt_link_on_phy_update(&p_event_data->ble_phy_update_event);
+            break;
+
+        case BTM_BLE_DATA_LENGTH_UPDATE_EVENT:
+            /* Record the LL data length in effect */
+            bt_link_on_data_length_update(
+                    &p_event_data->ble_data_length_update_event);
             break;
 
         case BTM_PIN_REQUEST_EVT:
@@ -264,6 +388,46 @@ wiced_result_t bt_app_management_cb(wiced_bt_management_evt_t event,
             result = WICED_BT_ERROR;
             break;
 
+        case BTM_PAIRING_IO_CAPABILITIES_BLE_REQUEST_EVT:
+            /* Just Works pairing with LE Secure Connections and bonding */
+            bt_bond_on_io_capabilities(
+                    &p_event_data->pairing_io_capabilities_ble_request);
+            break;
+
+        case BTM_PAIRING_COMPLETE_EVT:
+            bt_bond_on_pairing_complete(&p_event_data->pairing_complete);
+            break;
+
+        case BTM_SECURITY_REQUEST_EVT:
+            wiced_bt_ble_security_grant(p_event_data->security_request.bd_addr,
+                                        WICED_BT_SUCCESS);
+            break;
+
+        case BTM_ENCRYPTION_STATUS_EVT:
+            /* Restore the client configurations of a bonded peer */
+            bt_bond_on_encryption_status(&p_event_data->encryption_status);
+            break;
+
+        case BTM_PAIRED_DEVICE_LINK_KEYS_UPDATE_EVT:
+            bt_bond_on_link_keys_update(
+                    &p_event_data->paired_device_link_keys_update);
+            break;
+
+        case BTM_PAIRED_DEVICE_LINK_KEYS_REQUEST_EVT:
+            result = bt_bond_on_link_keys_request(
+                    &p_event_data->paired_device_link_keys_request);
+            break;
+
+        case BTM_LOCAL_IDENTITY_KEYS_UPDATE_EVT:
+            bt_bond_on_local_keys_update(
+                    &p_event_data->local_identity_keys_update);
+            break;
+
+        case BTM_LOCAL_IDENTITY_KEYS_REQUEST_EVT:
+            result = bt_bond_on_local_keys_request(
+                    &p_event_data->local_identity_keys_request);
+            break;
+
         default:
             break;
     }
@@ -333,7 +497,9 @@ wiced_bt_gatt_status_t bt_app_gatt_event_cb(wiced_bt_gatt_evt_t event,
                 pfn_free(p_event_data->buffer_xmitted.p_app_data);
                 status = WICED_BT_GATT_SUCCESS;
             }
-            
+
+            /* The stack has a buffer free again */
+            bt_notify_on_buffer_transmitted();
         }
             break;
 
@@ -380,9 +546,15 @@ wiced_bt_gatt_status_t bt_app_gatt_req_cb
             break;
 
         case GATT_REQ_READ_MULTI:
+        case GATT_REQ_READ_MULTI_VAR_LENGTH:
+            status = bt_app_gatt_req_read_multi_handler(p_attr_req->conn_id,
+                   p_attr_req->opcode, &p_attr_req->data.read_multiple_req,
+                   p_attr_req->len_requested);
             break;
 
         case GATT_REQ_MTU:
+            bt_att_mtu = MIN(p_attr_req->data.remote_mtu, CY_BT_RX_PDU_SIZE);
+            bt_stream_set_mtu(bt_att_mtu);
             status = wiced_bt_gatt_server_send_mtu_rsp(p_attr_req->conn_id,
                                           p_attr_req->data.remote_mtu,
             CY_BT_RX_PDU_SIZE);
@@ -407,6 +579,10 @@ wiced_bt_gatt_status_t bt_app_gatt_req_cb
             }
             break;
         case GATT_HANDLE_VALUE_CONF:
+            bt_indicate_on_confirm(p_attr_req->data.confirm_handle);
+            status = WICED_BT_GATT_SUCCESS;
+            break;
+
         case GATT_HANDLE_VALUE_NOTIF:
             break;
 
@@ -501,10 +677,14 @@ wiced_bt_gatt_status_t bt_app_gatt_req_read_by_type_handler(uint16_t conn_id,
         }
         else
         {
-            /* Send the response */
+            /* The stack frees the buffer once the response is transmitted */
             status = wiced_bt_gatt_server_send_read_by_type_rsp(conn_id,
                                             opcode, pair_len, used_len,
                                             p_rsp, (void *)bt_app_free_buffer);
+            if (WICED_BT_GATT_SUCCESS == status)
+            {
+                p_rsp = NULL;
+            }
         }
     }
 
@@ -539,7 +719,11 @@ wiced_bt_gatt_status_t bt_app_gatt_req_write_value(uint16_t attr_handle,
     wiced_bt_gatt_status_t gatt_status  = WICED_BT_GATT_INVALID_HANDLE;
     wiced_bool_t isHandleInTable = WICED_FALSE;
     wiced_bool_t validLen = WICED_FALSE;
+
+#if !defined(HOT_PATH_BENCHMARK)
+    /* The benchmark times the write, not the console */
     printf("APP_BT_REQ_WRITE_VALUE\n");
+#endif
 
     /* Check for a matching handle entry */
     for (int i = 0; i < app_gatt_db_ext_attr_tbl_size; i++)
@@ -553,12 +737,35 @@ wiced_bt_gatt_status_t bt_app_gatt_req_write_value(uint16_t attr_handle,
             /* Check if the buffer has space to store the data */
             validLen = (app_gatt_db_ext_attr_tbl[i].max_len >= len);
 
-            if (validLen)
+            /* A client cannot clear the features it has enabled */
+            if (validLen &&
+                    (HDLC_GATT_CLIENT_SUPPORTED_FEATURES_VALUE == attr_handle)
+                    && ((GATT_CLIENT_FEATURES_LEN != len) ||
+                        (0U != (app_gatt_client_supported_features[0] &
+                                (uint8_t) ~p_val[0]))))
+            {
+                gatt_status = WICED_BT_GATT_VALUE_NOT_ALLOWED;
+            }
+            /* The control parameters persist, so only a paired client may
+             * change them */
+            else if (validLen &&
+                    (HDLC_CAPSENSE_CONTROL_VALUE == attr_handle) &&
+                    !bt_bond_is_encrypted())
+            {
+                gatt_status = WICED_BT_GATT_INSUF_AUTHENTICATION;
+            }
+            else if (validLen)
             {
+                /* A control write replaces the value only once applied */
+                gatt_status = (HDLC_CAPSENSE_CONTROL_VALUE == attr_handle) ?
+                        bt_control_write(p_val, len) : WICED_BT_GATT_SUCCESS;
+
                 /* Value fits within the supplied buffer; copy over the value */
-                app_gatt_db_ext_attr_tbl[i].cur_len = len;
-                memcpy(app_gatt_db_ext_attr_tbl[i].p_data, p_val, len);
-                gatt_status = WICED_BT_GATT_SUCCESS;
+                if (WICED_BT_GATT_SUCCESS == gatt_status)
+                {
+                    app_gatt_db_ext_attr_tbl[i].cur_len = len;
+                    memcpy(app_gatt_db_ext_attr_tbl[i].p_data, p_val, len);
+                }
 
                 /* Add code for any action required when this attribute is written.
                  * In this case, we Initialize the characteristic value */
@@ -572,9 +779,14 @@ wiced_bt_gatt_status_t bt_app_gatt_req_write_value(uint16_t attr_handle,
                         }
                         else
                         {
-                            if(GATT_CLIENT_CONFIG_NOTIFICATION ==
-                                    app_capsense_button_client_char_config
-                                    [NOTIFICATION_ENABLED])
+                            /* With both bits set, indications are used */
+                            bt_indicate_enable(0U !=
+                                    (app_capsense_button_client_char_config
+                                     [NOTIFICATION_ENABLED] &
+                                     GATT_CLIENT_CONFIG_INDICATION));
+                            if (0U != (app_capsense_button_client_char_config
+                                    [NOTIFICATION_ENABLED] &
+                                    BUTTON_CLIENT_CONFIG_ENABLED))
                             {
                                 capsense_data.buttoncount= NO_OF_CAPSENSE_BUTTONS;
                                 bt_app_send_notification();
@@ -598,9 +810,35 @@ wiced_bt_gatt_status_t bt_app_gatt_req_write_value(uint16_t attr_handle,
                         }
                         break;
 
+                    case HDLD_CAPSENSE_STREAM_CLIENT_CHAR_CONFIG:
+                        if (CAPSENSE_STREAM_CLIENT_CHAR_CONFIG_LEN != len)
+                        {
+                            gatt_status = WICED_BT_GATT_INVALID_ATTR_LEN;
+                        }
+                        else
+                        {
+                            bt_stream_enable(GATT_CLIENT_CONFIG_NOTIFICATION ==
+                                    app_capsense_stream_client_char_config
+                                    [NOTIFICATION_ENABLED]);
+                        }
+                        break;
+
+                    case HDLD_CAPSENSE_DIAGNOSTICS_CLIENT_CHAR_CONFIG:
+                        if (CAPSENSE_DIAG_CLIENT_CHAR_CONFIG_LEN != len)
+                        {
+                            gatt_status = WICED_BT_GATT_INVALID_ATTR_LEN;
+                        }
+                        break;
+
                     default:
                         break;
                 }
+
+                /* Keep the client configurations of a bonded peer */
+                if (WICED_BT_GATT_SUCCESS == gatt_status)
+                {
+                    bt_bond_on_attr_written(attr_handle);
+                }
             }
             else
             {
@@ -675,6 +913,140 @@ wiced_bt_gatt_status_t bt_app_gatt_req_write_handler(uint16_t conn_id,
 }
 
 
+/*******************************************************************************
+* Function Name: bt_app_gatt_read_update
+********************************************************************************
+* Summary:
+*   Updates the value of an attribute from the application state before it
+*   is read.
+*
+* Parameters:
+*  gatt_db_lookup_table_t *puAttribute : Attribute to read
+*  uint16_t offset                     : Offset of the read
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void bt_app_gatt_read_update(gatt_db_lookup_table_t *puAttribute,
+                                    uint16_t offset)
+{
+    switch ( puAttribute->handle )
+    {
+        case HDLC_CAPSENSE_BUTTON_VALUE:
+            /* CapSense buttons data to be read */
+            app_capsense_button[BUTTON_COUNT] =
+                    capsense_data.buttoncount;
+            app_capsense_button[BUTTON_STATUS] =
+                    capsense_data.buttonstatus1;
+            break;
+
+        case HDLC_CAPSENSE_SLIDER_VALUE:
+            /* CapSense slider data to be read */
+            app_capsense_slider[SLIDER_DATA] = capsense_data.sliderdata;
+            break;
+
+        case HDLC_CAPSENSE_DIAGNOSTICS_VALUE:
+            /* Take a new snapshot only at the start of a long read, so
+             * that read blob requests return a consistent record */
+            if (DIAG_READ_OFFSET_START == offset)
+            {
+                puAttribute->cur_len = power_stats_serialize(
+                        app_capsense_diagnostics, puAttribute->max_len);
+            }
+            break;
+
+        case HDLC_CAPSENSE_CONTROL_VALUE:
+            if (DIAG_READ_OFFSET_START == offset)
+            {
+                puAttribute->cur_len = bt_control_read(
+                        app_capsense_control, puAttribute->max_len);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name : bt_app_gatt_req_read_multi_handler
+* ******************************************************************************
+* Summary :
+*  Process Read Multiple and Read Multiple Variable Length requests. The
+*  values of all requested handles are assembled into one response, which
+*  the stack truncates to the MTU like a long read would be.
+*
+* Parameters:
+*  uint16_t                           conn_id    : Connection ID
+*  wiced_bt_gatt_opcode_t             opcode     : LE GATT request type opcode
+*  wiced_bt_gatt_read_multiple_req_t  p_read_req : Pointer to the requested
+*                                                  handles
+*  uint16_t                           len_req    : Length of data requested
+*
+* Return:
+*  wiced_bt_gatt_status_t  : LE GATT status
+*******************************************************************************/
+wiced_bt_gatt_status_t bt_app_gatt_req_read_multi_handler(uint16_t conn_id,
+        wiced_bt_gatt_opcode_t opcode,
+        wiced_bt_gatt_read_multiple_req_t *p_read_req, uint16_t len_req)
+{
+    wiced_bt_gatt_status_t status;
+    gatt_db_lookup_table_t *puAttribute;
+    uint8_t *p_rsp = bt_app_alloc_buffer(len_req);
+    int used_len = INIT_VALUE_ZERO;
+
+    if (NULL == p_rsp)
+    {
+        printf("bt_app_gatt:no memory found, len_req: %d!!\r\n",len_req);
+        return WICED_BT_GATT_INSUF_RESOURCE;
+    }
+
+    for (uint16_t i = 0U; i < p_read_req->num_handles; i++)
+    {
+        uint16_t attr_handle = (uint16_t) wiced_bt_gatt_get_handle_from_stream(
+                p_read_req->p_handle_stream, i);
+
+        puAttribute = bt_app_find_by_handle(attr_handle);
+        if (NULL == puAttribute)
+        {
+            /* The whole request fails on the first invalid handle */
+            bt_app_free_buffer(p_rsp);
+            wiced_bt_gatt_server_send_error_rsp(conn_id, opcode, attr_handle,
+                                                WICED_BT_GATT_INVALID_HANDLE);
+            return WICED_BT_GATT_INVALID_HANDLE;
+        }
+
+        bt_app_gatt_read_update(puAttribute, DIAG_READ_OFFSET_START);
+
+        int filled = wiced_bt_gatt_put_read_multi_rsp_in_stream(opcode,
+                p_rsp + used_len, len_req - used_len, attr_handle,
+                puAttribute->cur_len, puAttribute->p_data);
+
+        /* The values that do not fit are left out */
+        if (FILLED_VALUE_ZERO == filled)
+        {
+            break;
+        }
+        used_len += filled;
+    }
+
+    printf("bt_app_gatt_read_multi_handler: conn_id:%d handles:%d len:%d\r\n",
+            conn_id, p_read_req->num_handles, used_len);
+
+    /* The stack frees the buffer once the response is transmitted */
+    status = wiced_bt_gatt_server_send_read_multiple_rsp(conn_id, opcode,
+            used_len, p_rsp, (void *)bt_app_free_buffer);
+    if (WICED_BT_GATT_SUCCESS != status)
+    {
+        bt_app_free_buffer(p_rsp);
+    }
+
+    return status;
+}
+
+
 /*******************************************************************************
 * Function Name: bt_app_gatt_req_read_handler
 ********************************************************************************
@@ -713,6 +1085,8 @@ wiced_bt_gatt_status_t bt_app_gatt_req_read_handler( uint16_t conn_id,
     }
     else
     {
+        bt_app_gatt_read_update(puAttribute, p_read_req->offset);
+
         attr_len_to_copy = puAttribute->cur_len;
         printf("bt_app_gatt_read_handler: conn_id:%d handle:0x%x offset:%d "
                 "len:%d\r\n",
@@ -730,24 +1104,6 @@ wiced_bt_gatt_status_t bt_app_gatt_req_read_handler( uint16_t conn_id,
             to_send = MIN(len_req, attr_len_to_copy - p_read_req->offset);
             from = ((uint8_t *)puAttribute->p_data) + p_read_req->offset;
 
-            switch ( p_read_req->handle )
-            {
-                case HDLC_CAPSENSE_BUTTON_VALUE:
-                    /* CapSense buttons data to be read */
-                    app_capsense_button[BUTTON_COUNT] =
-                            capsense_data.buttoncount;
-                    app_capsense_button[BUTTON_STATUS] =
-                            capsense_data.buttonstatus1;
-                    break;
-
-                case HDLC_CAPSENSE_SLIDER_VALUE:
-                    /* CapSense slider data to be read */
-                    app_capsense_slider[SLIDER_DATA] = capsense_data.sliderdata;
-                    break;
-
-                default:
-                    break;
-            }
             status = wiced_bt_gatt_server_send_read_handle_rsp(conn_id, opcode,
                     to_send, from, NULL);
         }
@@ -789,6 +1145,15 @@ wiced_bt_gatt_status_t bt_app_gatt_conn_status_cb
 
             /* Store the connection ID */
             bt_connection_id = p_conn_status->conn_id;
+            bt_notify_on_connect(p_conn_status->conn_id);
+            bt_indicate_on_connect(p_conn_status->conn_id);
+            bt_bond_on_connect(p_conn_status->bd_addr);
+
+            /* Start the connection parameter policy */
+            bt_conn_param_on_connect(p_conn_status->bd_addr);
+
+            /* Request the 2M PHY and the maximum LL data length */
+            bt_link_on_connect(p_conn_status->bd_addr);
         }
         else
         {
@@ -800,11 +1165,20 @@ wiced_bt_gatt_status_t bt_app_gatt_conn_status_cb
 
             /* Set the connection id to zero to indicate disconnected state */
             bt_connection_id = INIT_VALUE_ZERO;
+            bt_notify_on_disconnect();
+            bt_indicate_on_disconnect();
+            bt_bond_on_disconnect();
+
+            /* Stop the connection parameter policy */
+            bt_conn_param_on_disconnect();
+            bt_link_on_disconnect();
+            bt_stream_enable(false);
+            bt_stream_set_mtu(BT_STREAM_DEFAULT_MTU);
+            bt_att_mtu = ATT_DEFAULT_MTU;
 
-            /* Restart the advertisements */
-            result = wiced_bt_start_advertisements
-            (BTM_BLE_ADVERT_UNDIRECTED_HIGH,
-            BLE_ADDR_PUBLIC, NULL);
+            /* Stop the broadcast and restart the advertisements */
+            bt_adv_stop();
+            result = bt_bond_start_advertisements();
 
             /* Failed to start advertisement. Stop program execution */
             if (CY_RSLT_SUCCESS != result)
@@ -885,31 +1259,81 @@ gatt_db_lookup_table_t  *bt_app_find_by_handle(uint16_t handle)
     return result;
 }
 
+/*******************************************************************************
+* Function Name: bt_app_build_payload
+********************************************************************************
+* Summary:
+*  Copies a button or slider value and, in the extended payload format,
+*  appends the next sequence number and the sample time. A value longer
+*  than PAYLOAD_VALUE_MAX is cut.
+*
+* Parameters:
+*  uint8_t *p_buf        : Destination, PAYLOAD_EXTENDED_MAX bytes
+*  const uint8_t *p_val  : Value
+*  uint16_t len          : Value length
+*  uint16_t *p_seq       : Sequence number of the characteristic
+*  uint32_t sample_us    : Sample time of the value
+*
+* Return:
+*  uint16_t: Payload length
+*
+*******************************************************************************/
+static uint16_t bt_app_build_payload(uint8_t *p_buf, const uint8_t *p_val,
+                                     uint16_t len, uint16_t *p_seq,
+                                     uint32_t sample_us)
+{
+    len = MIN(len, PAYLOAD_VALUE_MAX);
+    memcpy(p_buf, p_val, len);
+    if (BT_APP_PAYLOAD_EXTENDED != bt_app_payload_format)
+    {
+        return len;
+    }
+
+    (*p_seq)++;
+    p_buf[len++] = (uint8_t) *p_seq;
+    p_buf[len++] = (uint8_t) (*p_seq >> 8U);
+    p_buf[len++] = (uint8_t) sample_us;
+    p_buf[len++] = (uint8_t) (sample_us >> 8U);
+    p_buf[len++] = (uint8_t) (sample_us >> 16U);
+    p_buf[len++] = (uint8_t) (sample_us >> 24U);
+
+    return len;
+}
+
 /*******************************************************************************
 * Function Name: bt_app_send_notification
 ********************************************************************************
-* Summary: Sends GATT notification.
+* Summary: Queues the button and slider notifications. Button events are
+*          indicated instead when the client enabled indications.
 *******************************************************************************/
 void bt_app_send_notification(void)
 {
-    wiced_bt_gatt_status_t status = WICED_BT_GATT_ERROR;
+    uint8_t payload[PAYLOAD_EXTENDED_MAX];
+    uint16_t len;
 
-    if((GATT_CLIENT_CONFIG_NOTIFICATION == \
-    app_capsense_button_client_char_config[NOTIFICATION_ENABLED])
+    if((0U != (app_capsense_button_client_char_config[NOTIFICATION_ENABLED] &
+               BUTTON_CLIENT_CONFIG_ENABLED))
     && (INIT_VALUE_ZERO != bt_connection_id))
     {
         /* CapSense button data to be send*/
         app_capsense_button[BUTTON_COUNT] = capsense_data.buttoncount;
         app_capsense_button[BUTTON_STATUS] = capsense_data.buttonstatus1;
-        status = wiced_bt_gatt_server_send_notification(bt_connection_id,
-                   HDLC_CAPSENSE_BUTTON_VALUE,
-                   app_gatt_db_ext_attr_tbl[APP_CAPSENSE_BUTTON].cur_len,
-                   app_gatt_db_ext_attr_tbl[APP_CAPSENSE_BUTTON].p_data,NULL);
-        if(WICED_BT_GATT_SUCCESS != status)
+        len = bt_app_build_payload(payload, app_capsense_button,
+                bt_app_find_by_handle(HDLC_CAPSENSE_BUTTON_VALUE)->cur_len,
+                &bt_app_button_seq, capsense_data.button_time_us);
+
+        /* In indication mode, each button event is kept until the client
+         * confirms it. Indications win when both bits are set. */
+        if (0U != (app_capsense_button_client_char_config
+                   [NOTIFICATION_ENABLED] & GATT_CLIENT_CONFIG_INDICATION))
         {
-            printf("Sending CapSense button notification failed\r\n");
+            (void) bt_indicate_queue(HDLC_CAPSENSE_BUTTON_VALUE, payload,
+                                     len);
+        }
+        else
+        {
+            (void) bt_notify_queue(HDLC_CAPSENSE_BUTTON_VALUE, payload, len);
         }
-
     }
 
     if((GATT_CLIENT_CONFIG_NOTIFICATION == \
@@ -918,17 +1342,182 @@ void bt_app_send_notification(void)
     {
         /* CapSense slider data to be send */
         app_capsense_slider[0] = capsense_data.sliderdata;
-        status = wiced_bt_gatt_server_send_notification( bt_connection_id,
-                    HDLC_CAPSENSE_SLIDER_VALUE,
-                    app_gatt_db_ext_attr_tbl[APP_CAPSENSE_SLIDER].cur_len,
-                    app_gatt_db_ext_attr_tbl[APP_CAPSENSE_SLIDER].p_data,NULL);
-        if(WICED_BT_GATT_SUCCESS != status)
-        {
-            printf("Sending CapSense slider notification failed\r\n");
-        }
+        len = bt_app_build_payload(payload, app_capsense_slider,
+                bt_app_find_by_handle(HDLC_CAPSENSE_SLIDER_VALUE)->cur_len,
+                &bt_app_slider_seq, capsense_data.slider_time_us);
+        (void) bt_notify_queue(HDLC_CAPSENSE_SLIDER_VALUE, payload, len);
     }
 }
 
+/*******************************************************************************
+* Function Name: bt_app_get_notify_interval
+********************************************************************************
+* Summary:
+*  Returns the minimum time between two button and slider notifications.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint16_t: Interval in ms
+*
+*******************************************************************************/
+uint16_t bt_app_get_notify_interval(void)
+{
+    return bt_app_notify_interval_ms;
+}
+
+/*******************************************************************************
+* Function Name: bt_app_set_notify_interval
+********************************************************************************
+* Summary:
+*  Sets the minimum time between two button and slider notifications. Touch
+*  changes within the interval are sent together after it.
+*
+* Parameters:
+*  uint16_t interval_ms : Interval in ms
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_app_set_notify_interval(uint16_t interval_ms)
+{
+    bt_app_notify_interval_ms = interval_ms;
+}
+
+/*******************************************************************************
+* Function Name: bt_app_get_payload_format
+********************************************************************************
+* Summary:
+*  Returns the button and slider payload format.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint8_t: BT_APP_PAYLOAD_xx
+*
+*******************************************************************************/
+uint8_t bt_app_get_payload_format(void)
+{
+    return bt_app_payload_format;
+}
+
+/*******************************************************************************
+* Function Name: bt_app_set_payload_format
+********************************************************************************
+* Summary:
+*  Sets the button and slider payload format.
+*
+* Parameters:
+*  uint8_t format : BT_APP_PAYLOAD_xx
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_app_set_payload_format(uint8_t format)
+{
+    bt_app_payload_format = format;
+}
+
+/*******************************************************************************
+* Function Name: bt_app_print_stats
+********************************************************************************
+* Summary:
+*  Prints the state of the connection and the notification counters.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_app_print_stats(void)
+{
+    bt_link_info_t link_info;
+
+    bt_link_get_info(&link_info);
+
+    printf("BLE: connection 0x%x, MTU %u, TX %uM RX %uM PHY, "
+           "TX %u RX %u octets\r\n", bt_connection_id, bt_att_mtu,
+           link_info.tx_phy, link_info.rx_phy, link_info.max_tx_octets,
+           link_info.max_rx_octets);
+    printf("BLE: stream %s\r\n", bt_stream_is_enabled() ? "on" : "off");
+    bt_notify_print_stats();
+    bt_indicate_print_stats();
+    bt_bond_print_stats();
+}
+
+/*******************************************************************************
+* Function Name: bt_app_diagnostics_enabled
+********************************************************************************
+* Summary:
+*  Returns true when a connected client has enabled notifications of the
+*  diagnostics characteristic.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true when diagnostics notifications are enabled
+*
+*******************************************************************************/
+bool bt_app_diagnostics_enabled(void)
+{
+    return (INIT_VALUE_ZERO != bt_connection_id) &&
+           (GATT_CLIENT_CONFIG_NOTIFICATION ==
+            app_capsense_diagnostics_client_char_config[NOTIFICATION_ENABLED]);
+}
+
+/*******************************************************************************
+* Function Name: bt_app_max_notification_len
+********************************************************************************
+* Summary:
+*  Returns the largest diagnostics record that fits into one notification
+*  with the current ATT MTU.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint16_t: Maximum record length in bytes
+*
+*******************************************************************************/
+uint16_t bt_app_max_notification_len(void)
+{
+    return (uint16_t) MIN(bt_att_mtu - ATT_NOTIFICATION_HEADER_SIZE,
+                          app_capsense_diagnostics_len);
+}
+
+/*******************************************************************************
+* Function Name: bt_app_send_diagnostics
+********************************************************************************
+* Summary:
+*  Queues a copy of a diagnostics record for notification by the BT task.
+*  The oldest record is dropped when the queue is full.
+*
+* Parameters:
+*  const uint8_t *p_data : Record to send
+*  uint16_t len          : Length of the record, at most
+*                          bt_app_max_notification_len() bytes
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_app_send_diagnostics(const uint8_t *p_data, uint16_t len)
+{
+    if (!bt_app_diagnostics_enabled() || (len > bt_app_max_notification_len()))
+    {
+        return;
+    }
+
+    (void) bt_notify_queue(HDLC_CAPSENSE_DIAGNOSTICS_VALUE, p_data, len);
+}
+
 /*******************************************************************************
 * Function Name: bt_print_bd_address
 ********************************************************************************
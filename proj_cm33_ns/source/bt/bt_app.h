@@ -57,6 +57,15 @@
 #include "cybt_platform_config.h"
 #include "cycfg_gatt_db.h"
 
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Button and slider payload formats. The extended format appends a u16
+ * sequence number, counted per characteristic, and the u32 sample time in
+ * us of the device timebase, both little endian. */
+#define BT_APP_PAYLOAD_LEGACY               (0U)
+#define BT_APP_PAYLOAD_EXTENDED             (1U)
+
 /*******************************************************************************
 * Global Constants
 *******************************************************************************/
@@ -79,6 +88,14 @@ extern volatile uint16_t bt_connection_id;
 void bt_task(void* param);
 void bt_app_send_notification(void);
 void bt_app_send_indication(void);;
+uint16_t bt_app_get_notify_interval(void);
+void bt_app_set_notify_interval(uint16_t interval_ms);
+uint8_t bt_app_get_payload_format(void);
+void bt_app_set_payload_format(uint8_t format);
+void bt_app_print_stats(void);
+bool bt_app_diagnostics_enabled(void);
+uint16_t bt_app_max_notification_len(void);
+void bt_app_send_diagnostics(const uint8_t *p_data, uint16_t len);
 void  bt_app_init(void);
 void* bt_app_alloc_buffer(int len);
 void  bt_app_free_buffer(uint8_t *p_event_data);
@@ -106,5 +123,9 @@ wiced_bt_gatt_status_t bt_app_gatt_req_read_by_type_handler (uint16_t conn_id,
                                        wiced_bt_gatt_opcode_t opcode,
                                        wiced_bt_gatt_read_by_type_t *p_read_req,
                                        uint16_t len_requested);
+wiced_bt_gatt_status_t bt_app_gatt_req_read_multi_handler(uint16_t conn_id,
+                                  wiced_bt_gatt_opcode_t opcode,
+                                  wiced_bt_gatt_read_multiple_req_t *p_read_req,
+                                  uint16_t len_req);
 
 #endif /* BT_APP_H */
@@ -0,0 +1,881 @@
+/*******************************************************************************
+* File Name: bt_bond.c
+*
+* Description: This file implements the bonding with persisted keys and client
+*              configurations, and the directed advertising to the last peer.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "cy_utils.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "cycfg_gatt_db.h"
+#include "bt_app.h"
+#include "bt_bond.h"
+#include "bt_indicate.h"
+#include "kv_store.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Client configurations saved with a bond: the CCCDs and the client
+ * supported features, each up to 2 bytes */
+#define BT_BOND_CCCD_COUNT                  (5U)
+#define BT_BOND_CCCD_LEN                    (2U)
+
+/* Largest LE key, in bytes */
+#define BT_BOND_MAX_KEY_SIZE                (16U)
+
+/* Keys exchanged in both directions */
+#define BT_BOND_KEYS                                                          \
+    (BTM_LE_KEY_PENC | BTM_LE_KEY_PID | BTM_LE_KEY_PCSRK | BTM_LE_KEY_LENC)
+
+/* No bond slot */
+#define BT_BOND_NONE                        (-1)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Bond record of the KV store */
+typedef struct
+{
+    wiced_bt_device_link_keys_t keys;
+    uint32_t use;                   /* Higher for a more recent connection */
+    uint16_t cccd[BT_BOND_CCCD_COUNT];
+} bt_bond_record_t;
+
+/* Client configurations in the order of bt_bond_record_t.cccd */
+static const uint16_t bt_bond_cccd_handles[BT_BOND_CCCD_COUNT] =
+{
+    HDLD_CAPSENSE_BUTTON_CLIENT_CHAR_CONFIG,
+    HDLD_CAPSENSE_SLIDER_CLIENT_CHAR_CONFIG,
+    HDLD_CAPSENSE_STREAM_CLIENT_CHAR_CONFIG,
+    HDLD_CAPSENSE_DIAGNOSTICS_CLIENT_CHAR_CONFIG,
+    HDLC_GATT_CLIENT_SUPPORTED_FEATURES_VALUE,
+};
+
+/* Bonding state. The addresses of the bonds are kept in RAM, so finding a
+ * peer does not read the store. */
+static struct
+{
+    bool valid[BT_BOND_MAX];
+    wiced_bt_device_address_t bd_addr[BT_BOND_MAX];
+    wiced_bt_ble_address_type_t addr_type[BT_BOND_MAX];
+    uint32_t use[BT_BOND_MAX];
+    uint32_t use_max;
+    int32_t slot;                   /* Bond of the encrypted link */
+    bool restoring;                 /* Writing the saved configurations */
+    bool connected;
+    bool encrypted;                 /* The link is encrypted */
+    bool delivered;                 /* First value of the link delivered */
+    bool directed;                  /* Directed advertising running */
+    volatile bool clear;            /* The BT task removes all bonds */
+    TickType_t start_tick;          /* Scheduler start or disconnection */
+    bt_bond_record_t record;        /* Scratch record, used under the lock */
+    bt_bond_stats_t stats;
+} bond = { .slot = BT_BOND_NONE };
+
+/* Serializes the bond slots between the stack callbacks and the BT task,
+ * which removes the bonds on request of the console */
+static SemaphoreHandle_t bt_bond_mutex;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: bt_bond_elapsed_ms
+********************************************************************************
+* Summary:
+*  Returns the time since the scheduler start or the last disconnection.
+*******************************************************************************/
+static uint32_t bt_bond_elapsed_ms(void)
+{
+    return (uint32_t) ((xTaskGetTickCount() - bond.start_tick) *
+                       portTICK_PERIOD_MS);
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_find
+********************************************************************************
+* Summary:
+*  Returns the bond slot of a peer, or BT_BOND_NONE.
+*******************************************************************************/
+static int32_t bt_bond_find(const wiced_bt_device_address_t bd_addr)
+{
+    for (uint32_t slot = 0U; slot < BT_BOND_MAX; slot++)
+    {
+        if (bond.valid[slot] &&
+                (0 == memcmp(bond.bd_addr[slot], bd_addr,
+                             sizeof(wiced_bt_device_address_t))))
+        {
+            return (int32_t) slot;
+        }
+    }
+
+    return BT_BOND_NONE;
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_load
+********************************************************************************
+* Summary:
+*  Reads the record of a bond slot.
+*******************************************************************************/
+static bool bt_bond_load(uint32_t slot, bt_bond_record_t *p_record)
+{
+    uint16_t len;
+
+    return kv_store_get((uint16_t) (KV_KEY_BOND + slot), p_record,
+                        sizeof(*p_record), &len) &&
+           (sizeof(*p_record) == len);
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_save
+********************************************************************************
+* Summary:
+*  Writes the record of a bond slot and updates the addresses in RAM.
+*******************************************************************************/
+static void bt_bond_save(uint32_t slot, const bt_bond_record_t *p_record)
+{
+    if (!kv_store_set((uint16_t) (KV_KEY_BOND + slot), p_record,
+                      sizeof(*p_record)))
+    {
+        printf("Bond: saving slot %lu failed\r\n", (unsigned long) slot);
+    }
+
+    memcpy(bond.bd_addr[slot], p_record->keys.bd_addr,
+           sizeof(wiced_bt_device_address_t));
+    bond.addr_type[slot] = p_record->keys.key_data.ble_addr_type;
+    bond.use[slot] = p_record->use;
+    bond.valid[slot] = true;
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_get_cccds
+********************************************************************************
+* Summary:
+*  Copies the client configurations of the GATT database into a record.
+*******************************************************************************/
+static void bt_bond_get_cccds(bt_bond_record_t *p_record)
+{
+    for (uint32_t i = 0U; i < BT_BOND_CCCD_COUNT; i++)
+    {
+        gatt_db_lookup_table_t *p_attr =
+                bt_app_find_by_handle(bt_bond_cccd_handles[i]);
+
+        p_record->cccd[i] = p_attr->p_data[0];
+        if (p_attr->max_len >= BT_BOND_CCCD_LEN)
+        {
+            p_record->cccd[i] |= (uint16_t) (p_attr->p_data[1] << 8U);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_restore_cccds
+********************************************************************************
+* Summary:
+*  Writes the saved client configurations as if the client had written
+*  them, so the notifications start without waiting for the client.
+*******************************************************************************/
+static void bt_bond_restore_cccds(const bt_bond_record_t *p_record)
+{
+    bond.restoring = true;
+    for (uint32_t i = 0U; i < BT_BOND_CCCD_COUNT; i++)
+    {
+        gatt_db_lookup_table_t *p_attr =
+                bt_app_find_by_handle(bt_bond_cccd_handles[i]);
+        uint8_t value[BT_BOND_CCCD_LEN] =
+        {
+            (uint8_t) p_record->cccd[i],
+            (uint8_t) (p_record->cccd[i] >> 8U),
+        };
+
+        if (0U != p_record->cccd[i])
+        {
+            (void) bt_app_gatt_req_write_value(bt_bond_cccd_handles[i], value,
+                    (uint16_t) MIN(p_attr->max_len, BT_BOND_CCCD_LEN));
+        }
+    }
+    bond.restoring = false;
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_init
+********************************************************************************
+* Summary:
+*  Creates the lock of the bond slots, loads the bonds from the KV store and
+*  adds them to the address resolution list. Called from bt_app_init()
+*  before the advertising starts.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_bond_init(void)
+{
+    CY_ASSERT(sizeof(bt_bond_record_t) <= KV_VALUE_MAX);
+    CY_ASSERT((KV_KEY_BOND + BT_BOND_MAX) <= KV_KEY_MAX);
+
+    bt_bond_mutex = xSemaphoreCreateMutex();
+    CY_ASSERT(NULL != bt_bond_mutex);
+
+    xSemaphoreTake(bt_bond_mutex, portMAX_DELAY);
+    for (uint32_t slot = 0U; slot < BT_BOND_MAX; slot++)
+    {
+        if (bt_bond_load(slot, &bond.record))
+        {
+            bt_bond_save(slot, &bond.record);
+            (void) wiced_bt_dev_add_device_to_address_resolution_db(
+                    &bond.record.keys);
+            bond.use_max = MAX(bond.use_max, bond.record.use);
+
+            printf("Bond %lu: ", (unsigned long) slot);
+            bt_print_bd_address(bond.bd_addr[slot]);
+        }
+    }
+    xSemaphoreGive(bt_bond_mutex);
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_start_advertisements
+********************************************************************************
+* Summary:
+*  Starts the advertising for a connection. With a bond, a directed
+*  advertisement to the peer that connected last makes it reconnect within
+*  a few ms; when it times out, the undirected advertising follows.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  wiced_result_t: Result of the advertising start
+*
+*******************************************************************************/
+wiced_result_t bt_bond_start_advertisements(void)
+{
+    int32_t last = BT_BOND_NONE;
+    wiced_bt_device_address_t bd_addr;
+    wiced_bt_ble_address_type_t addr_type = BLE_ADDR_PUBLIC;
+
+    xSemaphoreTake(bt_bond_mutex, portMAX_DELAY);
+    for (uint32_t slot = 0U; slot < BT_BOND_MAX; slot++)
+    {
+        if (bond.valid[slot] && ((BT_BOND_NONE == last) ||
+                                 (bond.use[slot] > bond.use[last])))
+        {
+            last = (int32_t) slot;
+        }
+    }
+    if (BT_BOND_NONE != last)
+    {
+        memcpy(bd_addr, bond.bd_addr[last], sizeof(bd_addr));
+        addr_type = bond.addr_type[last];
+    }
+    xSemaphoreGive(bt_bond_mutex);
+
+    if ((BT_BOND_NONE != last) &&
+            (WICED_BT_SUCCESS == wiced_bt_start_advertisements(
+                    BTM_BLE_ADVERT_DIRECTED_HIGH, addr_type, bd_addr)))
+    {
+        bond.directed = true;
+        bond.stats.directed++;
+        return WICED_BT_SUCCESS;
+    }
+
+    return wiced_bt_start_advertisements(BTM_BLE_ADVERT_UNDIRECTED_HIGH,
+                                         BLE_ADDR_PUBLIC, NULL);
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_on_advert_state_changed
+********************************************************************************
+* Summary:
+*  Starts the undirected advertising when the directed advertisement ended
+*  without a connection, for example because the peer uses a private
+*  address.
+*
+* Parameters:
+*  wiced_bt_ble_advert_mode_t mode: New advertising mode
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_bond_on_advert_state_changed(wiced_bt_ble_advert_mode_t mode)
+{
+    bool fallback = bond.directed && (BTM_BLE_ADVERT_OFF == mode) &&
+                    (0U == bt_connection_id);
+
+    bond.directed = (BTM_BLE_ADVERT_DIRECTED_HIGH == mode) ||
+                    (BTM_BLE_ADVERT_DIRECTED_LOW == mode);
+
+    if (fallback)
+    {
+        bond.stats.fallbacks++;
+        if (WICED_BT_SUCCESS != wiced_bt_start_advertisements(
+                BTM_BLE_ADVERT_UNDIRECTED_HIGH, BLE_ADDR_PUBLIC, NULL))
+        {
+            printf("Failed to start advertisement! \r\n");
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_on_connect
+********************************************************************************
+* Summary:
+*  Records the time to the connection.
+*
+* Parameters:
+*  wiced_bt_device_address_t bd_addr : Address of the connected peer
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_bond_on_connect(wiced_bt_device_address_t bd_addr)
+{
+    CY_UNUSED_PARAMETER(bd_addr);
+
+    bond.connected = true;
+    bond.encrypted = false;
+    bond.delivered = false;
+    bond.slot = BT_BOND_NONE;
+    bond.stats.connections++;
+    bond.stats.connect_ms = bt_bond_elapsed_ms();
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_on_disconnect
+********************************************************************************
+* Summary:
+*  Clears the client configurations, which only a bonded peer keeps, and
+*  starts the time to the next connection.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_bond_on_disconnect(void)
+{
+    for (uint32_t i = 0U; i < BT_BOND_CCCD_COUNT; i++)
+    {
+        gatt_db_lookup_table_t *p_attr =
+                bt_app_find_by_handle(bt_bond_cccd_handles[i]);
+
+        memset(p_attr->p_data, 0, p_attr->max_len);
+    }
+    bt_indicate_enable(false);
+
+    bond.connected = false;
+    bond.encrypted = false;
+    bond.slot = BT_BOND_NONE;
+    bond.start_tick = xTaskGetTickCount();
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_on_io_capabilities
+********************************************************************************
+* Summary:
+*  Answers the pairing request: LE Secure Connections with bonding, no
+*  input or output, so the pairing is Just Works.
+*
+* Parameters:
+*  wiced_bt_dev_ble_io_caps_req_t *p_req : Request to complete
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_bond_on_io_capabilities(wiced_bt_dev_ble_io_caps_req_t *p_req)
+{
+    p_req->local_io_cap = BTM_IO_CAPABILITIES_NONE;
+    p_req->oob_data = BTM_OOB_NONE;
+    p_req->auth_req = BTM_LE_AUTH_REQ_SC_BOND;
+    p_req->max_key_size = BT_BOND_MAX_KEY_SIZE;
+    p_req->init_keys = BT_BOND_KEYS;
+    p_req->resp_keys = BT_BOND_KEYS;
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_on_pairing_complete
+********************************************************************************
+* Summary:
+*  Reports the result of a pairing.
+*
+* Parameters:
+*  wiced_bt_dev_pairing_cplt_t *p_complete : Pairing result
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_bond_on_pairing_complete(wiced_bt_dev_pairing_cplt_t *p_complete)
+{
+    uint8_t reason = p_complete->pairing_complete_info.ble.reason;
+
+    printf("Bond: pairing %s, reason 0x%x\r\n",
+           (WICED_BT_SUCCESS == reason) ? "complete" : "failed", reason);
+    if (WICED_BT_SUCCESS == reason)
+    {
+        bond.stats.pairings++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_on_encryption_status
+********************************************************************************
+* Summary:
+*  Records the time to the encryption. When a bonded peer reconnects,
+*  restores its client configurations and marks it as the last peer.
+*
+* Parameters:
+*  wiced_bt_dev_encryption_status_t *p_status : Encryption result
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_bond_on_encryption_status(wiced_bt_dev_encryption_status_t *p_status)
+{
+    int32_t slot;
+
+    if (WICED_BT_SUCCESS != p_status->result)
+    {
+        printf("Bond: encryption failed, result 0x%x\r\n", p_status->result);
+        return;
+    }
+
+    bond.encrypted = true;
+    bond.stats.encrypt_ms = bt_bond_elapsed_ms();
+
+    xSemaphoreTake(bt_bond_mutex, portMAX_DELAY);
+
+    /* After a pairing, the keys update has already selected the slot */
+    slot = bt_bond_find(p_status->bd_addr);
+    if ((BT_BOND_NONE == slot) || (BT_BOND_NONE != bond.slot) ||
+            !bt_bond_load((uint32_t) slot, &bond.record))
+    {
+        xSemaphoreGive(bt_bond_mutex);
+        return;
+    }
+
+    bt_bond_restore_cccds(&bond.record);
+    bond.record.use = ++bond.use_max;
+    bt_bond_save((uint32_t) slot, &bond.record);
+    bond.slot = slot;
+    bond.stats.restored++;
+
+    xSemaphoreGive(bt_bond_mutex);
+
+    printf("Bond: peer of slot %ld reconnected, %lu ms to encryption\r\n",
+           (long) slot, (unsigned long) bond.stats.encrypt_ms);
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_on_link_keys_update
+********************************************************************************
+* Summary:
+*  Saves the keys of a new bond with the current client configurations.
+*  The bond replaces the record of the same peer or the least recently
+*  used one.
+*
+* Parameters:
+*  wiced_bt_device_link_keys_t *p_keys : Keys of the peer
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_bond_on_link_keys_update(wiced_bt_device_link_keys_t *p_keys)
+{
+    int32_t slot;
+
+    xSemaphoreTake(bt_bond_mutex, portMAX_DELAY);
+
+    slot = bt_bond_find(p_keys->bd_addr);
+    if (BT_BOND_NONE == slot)
+    {
+        slot = 0;
+        for (uint32_t i = 0U; i < BT_BOND_MAX; i++)
+        {
+            if (!bond.valid[i])
+            {
+                slot = (int32_t) i;
+                break;
+            }
+            if (bond.use[i] < bond.use[slot])
+            {
+                slot = (int32_t) i;
+            }
+        }
+
+        if (bond.valid[slot])
+        {
+            printf("Bond: replacing slot %ld\r\n", (long) slot);
+            (void) wiced_bt_dev_delete_bonded_device(bond.bd_addr[slot]);
+        }
+    }
+
+    bond.record.keys = *p_keys;
+    bond.record.use = ++bond.use_max;
+    bt_bond_get_cccds(&bond.record);
+    bt_bond_save((uint32_t) slot, &bond.record);
+    (void) wiced_bt_dev_add_device_to_address_resolution_db(p_keys);
+    bond.slot = slot;
+
+    xSemaphoreGive(bt_bond_mutex);
+
+    printf("Bond: keys saved in slot %ld\r\n", (long) slot);
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_on_link_keys_request
+********************************************************************************
+* Summary:
+*  Returns the saved keys of a peer.
+*
+* Parameters:
+*  wiced_bt_device_link_keys_t *p_keys : Peer address, keys destination
+*
+* Return:
+*  wiced_result_t: WICED_BT_SUCCESS when the peer is bonded
+*
+*******************************************************************************/
+wiced_result_t bt_bond_on_link_keys_request(
+        wiced_bt_device_link_keys_t *p_keys)
+{
+    int32_t slot;
+    wiced_result_t result = WICED_BT_ERROR;
+
+    xSemaphoreTake(bt_bond_mutex, portMAX_DELAY);
+
+    slot = bt_bond_find(p_keys->bd_addr);
+    if ((BT_BOND_NONE != slot) &&
+            bt_bond_load((uint32_t) slot, &bond.record))
+    {
+        *p_keys = bond.record.keys;
+        result = WICED_BT_SUCCESS;
+    }
+
+    xSemaphoreGive(bt_bond_mutex);
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_on_local_keys_update
+********************************************************************************
+* Summary:
+*  Saves the local identity keys, so the bonds stay valid after a reset.
+*
+* Parameters:
+*  wiced_bt_local_identity_keys_t *p_keys : Local keys
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_bond_on_local_keys_update(wiced_bt_local_identity_keys_t *p_keys)
+{
+    if (!kv_store_set(KV_KEY_LOCAL_IDENTITY, p_keys, sizeof(*p_keys)))
+    {
+        printf("Bond: saving the local keys failed\r\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_on_local_keys_request
+********************************************************************************
+* Summary:
+*  Returns the saved local identity keys. Without them, the stack creates
+*  new keys.
+*
+* Parameters:
+*  wiced_bt_local_identity_keys_t *p_keys : Keys destination
+*
+* Return:
+*  wiced_result_t: WICED_BT_SUCCESS when the keys were saved
+*
+*******************************************************************************/
+wiced_result_t bt_bond_on_local_keys_request(
+        wiced_bt_local_identity_keys_t *p_keys)
+{
+    uint16_t len;
+
+    return (kv_store_get(KV_KEY_LOCAL_IDENTITY, p_keys, sizeof(*p_keys),
+                         &len) && (sizeof(*p_keys) == len)) ?
+           WICED_BT_SUCCESS : WICED_BT_ERROR;
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_on_attr_written
+********************************************************************************
+* Summary:
+*  Saves the client configurations of a bonded peer when the client
+*  changes one of them.
+*
+* Parameters:
+*  uint16_t handle : Handle of the written attribute
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_bond_on_attr_written(uint16_t handle)
+{
+    bool cccd = false;
+
+    for (uint32_t i = 0U; i < BT_BOND_CCCD_COUNT; i++)
+    {
+        cccd = cccd || (handle == bt_bond_cccd_handles[i]);
+    }
+
+    /* The restore runs with the lock already taken */
+    if (!cccd || bond.restoring)
+    {
+        return;
+    }
+
+    xSemaphoreTake(bt_bond_mutex, portMAX_DELAY);
+    if ((BT_BOND_NONE != bond.slot) &&
+            bt_bond_load((uint32_t) bond.slot, &bond.record))
+    {
+        /* An unchanged record is not written again */
+        bt_bond_get_cccds(&bond.record);
+        bt_bond_save((uint32_t) bond.slot, &bond.record);
+    }
+    xSemaphoreGive(bt_bond_mutex);
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_is_encrypted
+********************************************************************************
+* Summary:
+*  Returns true when the current link is encrypted, after a pairing or with
+*  the keys of a bond.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true when the link is encrypted
+*
+*******************************************************************************/
+bool bt_bond_is_encrypted(void)
+{
+    return bond.connected && bond.encrypted;
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_on_delivered
+********************************************************************************
+* Summary:
+*  Records the time to the first value delivered on the connection. Called
+*  when a notification is transmitted or an indication confirmed.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_bond_on_delivered(void)
+{
+    if (bond.connected && !bond.delivered)
+    {
+        bond.delivered = true;
+        bond.stats.first_data_ms = bt_bond_elapsed_ms();
+    }
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_clear
+********************************************************************************
+* Summary:
+*  Requests the removal of all bonds. The BT task removes them, so the
+*  console never calls the stack or changes the bond slots.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_bond_clear(void)
+{
+    bond.clear = true;
+    xTaskNotify(bt_task_handle, NOTIFIY_OFF, eNoAction);
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_process
+********************************************************************************
+* Summary:
+*  Removes all bonds from the KV store and the stack when requested. Called
+*  by the BT task; the lock keeps the stack callbacks out of a slot while
+*  it is removed. Waits for bt_bond_init().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  TickType_t: Ticks until the function needs to run again
+*
+*******************************************************************************/
+TickType_t bt_bond_process(void)
+{
+    static wiced_bt_device_link_keys_t keys;
+    bool loaded;
+
+    if (!bond.clear || (NULL == bt_bond_mutex))
+    {
+        return portMAX_DELAY;
+    }
+    bond.clear = false;
+
+    for (uint32_t slot = 0U; slot < BT_BOND_MAX; slot++)
+    {
+        /* The stack callbacks may hold the stack while they wait for the
+         * lock, so the stack is called only after it is released */
+        xSemaphoreTake(bt_bond_mutex, portMAX_DELAY);
+        if (!bond.valid[slot])
+        {
+            xSemaphoreGive(bt_bond_mutex);
+            continue;
+        }
+        loaded = bt_bond_load(slot, &bond.record);
+        keys = bond.record.keys;
+        memcpy(keys.bd_addr, bond.bd_addr[slot], sizeof(keys.bd_addr));
+        (void) kv_store_delete((uint16_t) (KV_KEY_BOND + slot));
+        bond.valid[slot] = false;
+        if (bond.slot == (int32_t) slot)
+        {
+            bond.slot = BT_BOND_NONE;
+        }
+        xSemaphoreGive(bt_bond_mutex);
+
+        if (loaded)
+        {
+            (void) wiced_bt_dev_remove_device_from_address_resolution_db(
+                    &keys);
+        }
+        (void) wiced_bt_dev_delete_bonded_device(keys.bd_addr);
+    }
+
+    printf("Bond: all bonds removed\r\n");
+
+    return portMAX_DELAY;
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_get_stats
+********************************************************************************
+* Summary:
+*  Returns the bonding counters and the reconnection times.
+*
+* Parameters:
+*  bt_bond_stats_t *p_stats : Destination
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_bond_get_stats(bt_bond_stats_t *p_stats)
+{
+    *p_stats = bond.stats;
+    p_stats->bonds = 0U;
+    for (uint32_t slot = 0U; slot < BT_BOND_MAX; slot++)
+    {
+        p_stats->bonds += bond.valid[slot] ? 1U : 0U;
+    }
+}
+
+/*******************************************************************************
+* Function Name: bt_bond_print_stats
+********************************************************************************
+* Summary:
+*  Prints the bonds, the bonding counters and the reconnection times.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_bond_print_stats(void)
+{
+    bt_bond_stats_t stats;
+
+    bt_bond_get_stats(&stats);
+
+    printf("BLE bonds: %lu of %u, %lu connections, %lu pairings, "
+           "%lu reconnections, %lu directed (%lu timed out)\r\n",
+           (unsigned long) stats.bonds, BT_BOND_MAX,
+           (unsigned long) stats.connections, (unsigned long) stats.pairings,
+           (unsigned long) stats.restored, (unsigned long) stats.directed,
+           (unsigned long) stats.fallbacks);
+    printf("BLE bonds: connection %lu ms, encryption %lu ms, first value "
+           "%lu ms\r\n", (unsigned long) stats.connect_ms,
+           (unsigned long) stats.encrypt_ms,
+           (unsigned long) stats.first_data_ms);
+
+    for (uint32_t slot = 0U; slot < BT_BOND_MAX; slot++)
+    {
+        if (bond.valid[slot])
+        {
+            printf("Bond %lu (use %lu): ", (unsigned long) slot,
+                   (unsigned long) bond.use[slot]);
+            bt_print_bd_address(bond.bd_addr[slot]);
+        }
+    }
+}
+
+/* [] END OF FILE */
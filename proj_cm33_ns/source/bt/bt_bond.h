@@ -0,0 +1,107 @@
+/*******************************************************************************
+* File Name: bt_bond.h
+*
+* Description: This file is the public interface of bt_bond.c
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef BT_BOND_H
+#define BT_BOND_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "wiced_bt_dev.h"
+#include "wiced_bt_ble.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Bonded peers kept in the KV store, from key KV_KEY_BOND on. A new peer
+ * replaces the one that connected least recently. */
+#define BT_BOND_MAX                         (4U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Bonding counters and the reconnection times. The times are measured from
+ * the scheduler start or from the last disconnection. */
+typedef struct
+{
+    uint32_t bonds;             /* Bonded peers in the store */
+    uint32_t connections;       /* Connections since the reset */
+    uint32_t pairings;          /* Pairings completed */
+    uint32_t restored;          /* Encrypted reconnections of bonded peers */
+    uint32_t directed;          /* Directed advertisements started */
+    uint32_t fallbacks;         /* Directed advertisements that timed out */
+    uint32_t connect_ms;        /* Time to the last connection */
+    uint32_t encrypt_ms;        /* Time to the last encryption */
+    uint32_t first_data_ms;     /* Time to the first delivered value */
+} bt_bond_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void bt_bond_init(void);
+wiced_result_t bt_bond_start_advertisements(void);
+void bt_bond_on_advert_state_changed(wiced_bt_ble_advert_mode_t mode);
+void bt_bond_on_connect(wiced_bt_device_address_t bd_addr);
+void bt_bond_on_disconnect(void);
+void bt_bond_on_io_capabilities(wiced_bt_dev_ble_io_caps_req_t *p_req);
+void bt_bond_on_pairing_complete(wiced_bt_dev_pairing_cplt_t *p_complete);
+void bt_bond_on_encryption_status(
+        wiced_bt_dev_encryption_status_t *p_status);
+void bt_bond_on_link_keys_update(wiced_bt_device_link_keys_t *p_keys);
+wiced_result_t bt_bond_on_link_keys_request(
+        wiced_bt_device_link_keys_t *p_keys);
+void bt_bond_on_local_keys_update(wiced_bt_local_identity_keys_t *p_keys);
+wiced_result_t bt_bond_on_local_keys_request(
+        wiced_bt_local_identity_keys_t *p_keys);
+void bt_bond_on_attr_written(uint16_t handle);
+bool bt_bond_is_encrypted(void);
+void bt_bond_on_delivered(void);
+void bt_bond_clear(void);
+TickType_t bt_bond_process(void);
+void bt_bond_get_stats(bt_bond_stats_t *p_stats);
+void bt_bond_print_stats(void);
+
+#endif /* BT_BOND_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,353 @@
+/*******************************************************************************
+* File Name: bt_conn_param.c
+*
+* Description: This file contains the connection parameter policy. It requests
+*              a short connection interval while the CapSense panel is touched
+*              and relaxes to a long interval with peripheral latency once the
+*              panel has been idle for a while.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "wiced_bt_l2c.h"
+#include "bt_app.h"
+#include "bt_conn_param.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Active profile: 7.5 ms to 15 ms interval, no latency, 2 s timeout.
+ * Intervals are in 1.25 ms units, the timeout in 10 ms units. */
+#define ACTIVE_CONN_INTERVAL_MIN            (6U)
+#define ACTIVE_CONN_INTERVAL_MAX            (12U)
+#define ACTIVE_CONN_LATENCY                 (0U)
+#define ACTIVE_SUPERVISION_TIMEOUT          (200U)
+
+/* Idle profile: 100 ms to 200 ms interval, 4 skipped events, 6 s timeout */
+#define IDLE_CONN_INTERVAL_MIN              (80U)
+#define IDLE_CONN_INTERVAL_MAX              (160U)
+#define IDLE_CONN_LATENCY                   (4U)
+#define IDLE_SUPERVISION_TIMEOUT            (600U)
+
+/* No touch for this long switches to the idle profile (hysteresis) */
+#define IDLE_AFTER_NO_TOUCH_MS              (3000U)
+
+/* Leave the central alone while it discovers the services */
+#define CONNECT_HOLDOFF_MS                  (5000U)
+
+/* Minimum time between two update requests */
+#define MIN_REQUEST_INTERVAL_MS             (1000U)
+
+/* Back off for longer after the central rejected a request */
+#define REJECTED_RETRY_INTERVAL_MS          (10000U)
+
+/* Consider a request lost when no update event arrives in this time */
+#define REQUEST_RESPONSE_TIMEOUT_MS         (5000U)
+
+/* Unit conversion of the connection parameters for logging */
+#define CONN_INTERVAL_UNIT_US               (1250U)
+#define SUPERVISION_TIMEOUT_UNIT_MS         (10U)
+#define US_PER_MS                           (1000U)
+
+#define CONN_PARAM_UPDATE_SUCCESS           (0U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Connection parameters of one profile */
+typedef struct
+{
+    uint16_t interval_min;
+    uint16_t interval_max;
+    uint16_t latency;
+    uint16_t timeout;
+} bt_conn_param_set_t;
+
+static const bt_conn_param_set_t conn_param_profiles[] =
+{
+    [BT_CONN_PARAM_PROFILE_ACTIVE] =
+    {
+        ACTIVE_CONN_INTERVAL_MIN, ACTIVE_CONN_INTERVAL_MAX,
+        ACTIVE_CONN_LATENCY, ACTIVE_SUPERVISION_TIMEOUT
+    },
+    [BT_CONN_PARAM_PROFILE_IDLE] =
+    {
+        IDLE_CONN_INTERVAL_MIN, IDLE_CONN_INTERVAL_MAX,
+        IDLE_CONN_LATENCY, IDLE_SUPERVISION_TIMEOUT
+    },
+};
+
+/* State of the connection parameter policy */
+static struct
+{
+    bool connected;
+    wiced_bt_device_address_t bd_addr;
+    bt_conn_param_profile_t requested;  /* Last requested profile */
+    bool response_pending;              /* Waiting for the update event */
+    TickType_t request_tick;            /* Time of the last request */
+    TickType_t next_request_tick;       /* Earliest time of the next request */
+    volatile TickType_t touch_tick;     /* Time of the last touch */
+    uint32_t requests;
+    uint32_t rejected;
+} conn_param;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: bt_conn_param_on_connect
+********************************************************************************
+* Summary:
+*  Starts the policy for a new connection. The connection counts as active so
+*  that the first request is for the short interval.
+*
+* Parameters:
+*  wiced_bt_device_address_t bd_addr : Address of the connected peer
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_conn_param_on_connect(wiced_bt_device_address_t bd_addr)
+{
+    TickType_t now = xTaskGetTickCount();
+
+    taskENTER_CRITICAL();
+    memcpy(conn_param.bd_addr, bd_addr, sizeof(wiced_bt_device_address_t));
+    conn_param.requested = BT_CONN_PARAM_PROFILE_NONE;
+    conn_param.response_pending = false;
+    conn_param.next_request_tick = now + pdMS_TO_TICKS(CONNECT_HOLDOFF_MS);
+    conn_param.touch_tick = now;
+    conn_param.connected = true;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: bt_conn_param_on_disconnect
+********************************************************************************
+* Summary:
+*  Stops the policy when the connection is closed.
+*******************************************************************************/
+void bt_conn_param_on_disconnect(void)
+{
+    taskENTER_CRITICAL();
+    conn_param.connected = false;
+    conn_param.response_pending = false;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: bt_conn_param_on_update
+********************************************************************************
+* Summary:
+*  Logs the connection parameters negotiated with the central and completes
+*  an outstanding request.
+*
+* Parameters:
+*  wiced_bt_ble_connection_param_update_t *p_update : Update event data
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_conn_param_on_update(wiced_bt_ble_connection_param_update_t *p_update)
+{
+    uint32_t interval_us = (uint32_t) p_update->conn_interval *
+                           CONN_INTERVAL_UNIT_US;
+
+    printf("Bluetooth connection parameter update status: %d\r\n"
+           "parameter interval: %lu.%02lu ms\r\n"
+           "parameter latency: %d events\r\n"
+           "parameter timeout: %lu ms\r\n",
+           p_update->status,
+           (unsigned long) (interval_us / US_PER_MS),
+           (unsigned long) ((interval_us % US_PER_MS) / 10U),
+           p_update->conn_latency,
+           (unsigned long) p_update->supervision_timeout *
+                           SUPERVISION_TIMEOUT_UNIT_MS);
+
+    taskENTER_CRITICAL();
+    if (conn_param.response_pending)
+    {
+        conn_param.response_pending = false;
+
+        if (CONN_PARAM_UPDATE_SUCCESS != p_update->status)
+        {
+            /* Ask again later instead of hammering the central */
+            conn_param.rejected++;
+            conn_param.requested = BT_CONN_PARAM_PROFILE_NONE;
+            conn_param.next_request_tick = xTaskGetTickCount() +
+                    pdMS_TO_TICKS(REJECTED_RETRY_INTERVAL_MS);
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    /* Re-evaluate the policy in the BT task. eNoAction leaves a pending
+     * notification request of the CapSense task intact. */
+    xTaskNotify(bt_task_handle, NOTIFIY_OFF, eNoAction);
+}
+
+/*******************************************************************************
+* Function Name: bt_conn_param_on_touch
+********************************************************************************
+* Summary:
+*  Called by the CapSense task for every sample in which a sensor is touched.
+*  Wakes up the BT task when the short interval has to be requested.
+*******************************************************************************/
+void bt_conn_param_on_touch(void)
+{
+    conn_param.touch_tick = xTaskGetTickCount();
+
+    if (conn_param.connected &&
+            (BT_CONN_PARAM_PROFILE_ACTIVE != conn_param.requested))
+    {
+        xTaskNotify(bt_task_handle, NOTIFIY_OFF, eNoAction);
+    }
+}
+
+/*******************************************************************************
+* Function Name: bt_conn_param_ticks_until
+********************************************************************************
+* Summary:
+*  Returns the ticks left until the given tick, zero if it has passed.
+*******************************************************************************/
+static TickType_t bt_conn_param_ticks_until(TickType_t now, TickType_t tick)
+{
+    TickType_t left = tick - now;
+
+    /* A difference in the upper half of the range is in the past */
+    return (left > (portMAX_DELAY / 2U)) ? 0U : left;
+}
+
+/*******************************************************************************
+* Function Name: bt_conn_param_process
+********************************************************************************
+* Summary:
+*  Evaluates the policy in the BT task and sends an update request when the
+*  desired profile differs from the requested one and the rate limit allows.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  TickType_t: Ticks until the policy has to be evaluated again
+*
+*******************************************************************************/
+TickType_t bt_conn_param_process(void)
+{
+    TickType_t wait = portMAX_DELAY;
+    TickType_t now = xTaskGetTickCount();
+    TickType_t idle_ticks = now - conn_param.touch_tick;
+    TickType_t idle_timeout = pdMS_TO_TICKS(IDLE_AFTER_NO_TOUCH_MS);
+    bt_conn_param_profile_t desired = BT_CONN_PARAM_PROFILE_ACTIVE;
+    wiced_bt_device_address_t bd_addr;
+    bool send_request = false;
+
+    taskENTER_CRITICAL();
+    if (conn_param.connected)
+    {
+        if (idle_ticks >= idle_timeout)
+        {
+            desired = BT_CONN_PARAM_PROFILE_IDLE;
+        }
+        else
+        {
+            /* Evaluate again when the panel may have become idle */
+            wait = idle_timeout - idle_ticks;
+        }
+
+        if (conn_param.response_pending && (0U == bt_conn_param_ticks_until(now,
+                conn_param.request_tick +
+                pdMS_TO_TICKS(REQUEST_RESPONSE_TIMEOUT_MS))))
+        {
+            /* The central never answered, allow a new request */
+            conn_param.response_pending = false;
+        }
+
+        if ((desired != conn_param.requested) && !conn_param.response_pending)
+        {
+            TickType_t holdoff = bt_conn_param_ticks_until(now,
+                    conn_param.next_request_tick);
+
+            if (0U == holdoff)
+            {
+                send_request = true;
+                conn_param.requested = desired;
+                conn_param.response_pending = true;
+                conn_param.request_tick = now;
+                conn_param.next_request_tick = now +
+                        pdMS_TO_TICKS(MIN_REQUEST_INTERVAL_MS);
+                conn_param.requests++;
+                memcpy(bd_addr, conn_param.bd_addr, sizeof(bd_addr));
+            }
+            else
+            {
+                wait = MIN(wait, holdoff);
+            }
+        }
+
+        if (conn_param.response_pending)
+        {
+            wait = MIN(wait, pdMS_TO_TICKS(REQUEST_RESPONSE_TIMEOUT_MS));
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if (send_request)
+    {
+        const bt_conn_param_set_t *p_set = &conn_param_profiles[desired];
+
+        printf("Requesting %s connection parameters\r\n",
+               (BT_CONN_PARAM_PROFILE_ACTIVE == desired) ? "active" : "idle");
+
+        if (!wiced_bt_l2cap_update_ble_conn_params(bd_addr,
+                p_set->interval_min, p_set->interval_max,
+                p_set->latency, p_set->timeout))
+        {
+            printf("Connection parameter update request failed\r\n");
+            taskENTER_CRITICAL();
+            conn_param.response_pending = false;
+            conn_param.requested = BT_CONN_PARAM_PROFILE_NONE;
+            taskEXIT_CRITICAL();
+        }
+    }
+
+    return wait;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,74 @@
+/*******************************************************************************
+* File Name: bt_conn_param.h
+*
+* Description: This file is the public interface of bt_conn_param.c
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef BT_CONN_PARAM_H
+#define BT_CONN_PARAM_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "wiced_bt_dev.h"
+#include "wiced_bt_ble.h"
+
+/*******************************************************************************
+* Global Constants
+*******************************************************************************/
+/* Connection parameter profiles requested by the policy */
+typedef enum
+{
+    BT_CONN_PARAM_PROFILE_NONE,     /* Nothing requested yet */
+    BT_CONN_PARAM_PROFILE_ACTIVE,   /* Short interval while the user touches */
+    BT_CONN_PARAM_PROFILE_IDLE,     /* Long interval with peripheral latency */
+} bt_conn_param_profile_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void bt_conn_param_on_connect(wiced_bt_device_address_t bd_addr);
+void bt_conn_param_on_disconnect(void);
+void bt_conn_param_on_update(wiced_bt_ble_connection_param_update_t *p_update);
+void bt_conn_param_on_touch(void);
+TickType_t bt_conn_param_process(void);
+
+#endif /* BT_CONN_PARAM_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,628 @@
+/*******************************************************************************
+* File Name: bt_control.c
+*
+* Description: This file parses the TLV records written to the control
+*              characteristic, applies them to the CapSense pipeline, the
+*              notifications and the diagnostics readout, and saves them.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "bt_app.h"
+#include "bt_control.h"
+#include "i2c_capsense.h"
+#include "capsense_diag.h"
+#include "kv_store.h"
+#include "bt_time.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Accepted ranges of the record values */
+#define CONTROL_SAMPLE_PERIOD_MIN_MS        (2U)
+#define CONTROL_SAMPLE_PERIOD_MAX_MS        (1000U)
+#define CONTROL_POSITION_FILTER_MAX         (4U)
+#define CONTROL_NOTIFY_INTERVAL_MAX_MS      (1000U)
+#define CONTROL_DIAG_PERIOD_MAX_MS          (60000U)
+#define CONTROL_DIAG_OUTPUTS                (CAPSENSE_DIAG_OUTPUT_CONSOLE | \
+                                             CAPSENSE_DIAG_OUTPUT_BLE)
+
+/* Value lengths of the record types */
+#define CONTROL_U8_LEN                      (1U)
+#define CONTROL_U16_LEN                     (2U)
+#define CONTROL_LED_MAP_LEN                 (2U)
+#define CONTROL_DIAG_LEN                    (3U)
+#define CONTROL_U32_LEN                     (4U)
+
+/* Largest record value */
+#define CONTROL_VALUE_MAX                   (4U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* All parameters the control characteristic can change. A write is staged
+ * in a copy and applied only after all records are valid. */
+typedef struct
+{
+    capsense_tuning_t tuning;
+    uint16_t notify_interval_ms;
+    uint32_t diag_period_ms;
+    uint8_t diag_outputs;
+    uint8_t payload_format;
+} bt_control_config_t;
+
+/* Serializes the writes of the GATT client and of the debug console */
+static SemaphoreHandle_t bt_control_mutex;
+
+/* Set by a write, cleared by the BT task when it saves the parameters */
+static volatile bool bt_control_dirty = false;
+
+/* Saved parameters, used by the BT task only */
+static uint8_t bt_control_saved[KV_VALUE_MAX];
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: bt_control_init
+********************************************************************************
+* Summary:
+*  Creates the lock of the parameter writes. Called before the tasks start.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true on success
+*
+*******************************************************************************/
+bool bt_control_init(void)
+{
+    bt_control_mutex = xSemaphoreCreateMutex();
+
+    return (NULL != bt_control_mutex);
+}
+
+/*******************************************************************************
+* Function Name: bt_control_get_u16
+********************************************************************************
+* Summary:
+*  Reads a little endian u16 record value.
+*******************************************************************************/
+static uint16_t bt_control_get_u16(const uint8_t *p_value)
+{
+    return (uint16_t) (p_value[0] | ((uint16_t) p_value[1] << 8U));
+}
+
+/*******************************************************************************
+* Function Name: bt_control_get_config
+********************************************************************************
+* Summary:
+*  Reads the current parameters from their owners.
+*******************************************************************************/
+static void bt_control_get_config(bt_control_config_t *p_config)
+{
+    i2c_capsense_get_tuning(&p_config->tuning);
+    p_config->notify_interval_ms = bt_app_get_notify_interval();
+    capsense_diag_get_configuration(&p_config->diag_period_ms,
+                                    &p_config->diag_outputs);
+    p_config->payload_format = bt_app_get_payload_format();
+}
+
+/*******************************************************************************
+* Function Name: bt_control_stage
+********************************************************************************
+* Summary:
+*  Checks one record and stores its value in the staged parameters.
+*
+* Parameters:
+*  bt_control_config_t *p_config : Staged parameters
+*  uint8_t type                  : Record type, BT_CONTROL_xx
+*  const uint8_t *p_value        : Record value
+*  uint8_t len                   : Record value length
+*
+* Return:
+*  wiced_bt_gatt_status_t: WICED_BT_GATT_SUCCESS, or the error to report
+*
+*******************************************************************************/
+static wiced_bt_gatt_status_t bt_control_stage(bt_control_config_t *p_config,
+                                               uint8_t type,
+                                               const uint8_t *p_value,
+                                               uint8_t len)
+{
+    wiced_bt_gatt_status_t status = WICED_BT_GATT_OUT_OF_RANGE;
+    uint16_t value;
+
+    switch (type)
+    {
+        case BT_CONTROL_SAMPLE_PERIOD:
+        case BT_CONTROL_STREAM_SAMPLE_PERIOD:
+            if (CONTROL_U16_LEN != len)
+            {
+                status = WICED_BT_GATT_INVALID_ATTR_LEN;
+                break;
+            }
+            value = bt_control_get_u16(p_value);
+            if ((value >= CONTROL_SAMPLE_PERIOD_MIN_MS) &&
+                    (value <= CONTROL_SAMPLE_PERIOD_MAX_MS))
+            {
+                if (BT_CONTROL_SAMPLE_PERIOD == type)
+                {
+                    p_config->tuning.sample_period_ms = value;
+                }
+                else
+                {
+                    p_config->tuning.stream_sample_period_ms = value;
+                }
+                status = WICED_BT_GATT_SUCCESS;
+            }
+            break;
+
+        case BT_CONTROL_POSITION_FILTER:
+            if (CONTROL_U8_LEN != len)
+            {
+                status = WICED_BT_GATT_INVALID_ATTR_LEN;
+            }
+            else if (p_value[0] <= CONTROL_POSITION_FILTER_MAX)
+            {
+                p_config->tuning.position_filter = p_value[0];
+                status = WICED_BT_GATT_SUCCESS;
+            }
+            break;
+
+        case BT_CONTROL_NOTIFY_INTERVAL:
+            if (CONTROL_U16_LEN != len)
+            {
+                status = WICED_BT_GATT_INVALID_ATTR_LEN;
+                break;
+            }
+            value = bt_control_get_u16(p_value);
+            if (value <= CONTROL_NOTIFY_INTERVAL_MAX_MS)
+            {
+                p_config->notify_interval_ms = value;
+                status = WICED_BT_GATT_SUCCESS;
+            }
+            break;
+
+        case BT_CONTROL_LED_MAP:
+            if (CONTROL_LED_MAP_LEN != len)
+            {
+                status = WICED_BT_GATT_INVALID_ATTR_LEN;
+            }
+            else if ((p_value[0] < CAPSENSE_SENSOR_COUNT) &&
+                    ((p_value[1] <= LED_SET_BRIGHTNESS) ||
+                     (CAPSENSE_LED_NONE == p_value[1])))
+            {
+                p_config->tuning.led[p_value[0]] = p_value[1];
+                status = WICED_BT_GATT_SUCCESS;
+            }
+            break;
+
+        case BT_CONTROL_DIAGNOSTICS:
+            if (CONTROL_DIAG_LEN != len)
+            {
+                status = WICED_BT_GATT_INVALID_ATTR_LEN;
+                break;
+            }
+            value = bt_control_get_u16(p_value);
+            if ((value <= CONTROL_DIAG_PERIOD_MAX_MS) &&
+                    (0U == (p_value[2] & ~CONTROL_DIAG_OUTPUTS)))
+            {
+                p_config->diag_period_ms = value;
+                p_config->diag_outputs = p_value[2];
+                status = WICED_BT_GATT_SUCCESS;
+            }
+            break;
+
+        case BT_CONTROL_PAYLOAD_FORMAT:
+            if (CONTROL_U8_LEN != len)
+            {
+                status = WICED_BT_GATT_INVALID_ATTR_LEN;
+            }
+            else if (p_value[0] <= BT_APP_PAYLOAD_EXTENDED)
+            {
+                p_config->payload_format = p_value[0];
+                status = WICED_BT_GATT_SUCCESS;
+            }
+            break;
+
+        case BT_CONTROL_DEVICE_TIME:
+            /* Read only; accepted so that a read can be written back */
+            status = (CONTROL_U32_LEN == len) ? WICED_BT_GATT_SUCCESS :
+                    WICED_BT_GATT_INVALID_ATTR_LEN;
+            break;
+
+        default:
+            /* Unknown record type */
+            break;
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: bt_control_apply
+********************************************************************************
+* Summary:
+*  Applies a list of TLV records. All records are checked against a copy of
+*  the current parameters first; the parameters change only when every
+*  record is valid, and then all of them change together.
+*
+* Parameters:
+*  const uint8_t *p_val : TLV records
+*  uint16_t len         : Length of the records
+*
+* Return:
+*  wiced_bt_gatt_status_t: WICED_BT_GATT_SUCCESS, or the error of the first
+*  invalid record
+*
+*******************************************************************************/
+static wiced_bt_gatt_status_t bt_control_apply(const uint8_t *p_val,
+                                               uint16_t len)
+{
+    bt_control_config_t config;
+    wiced_bt_gatt_status_t status = WICED_BT_GATT_SUCCESS;
+    uint16_t pos = 0U;
+
+    bt_control_get_config(&config);
+
+    while ((WICED_BT_GATT_SUCCESS == status) && (pos < len))
+    {
+        uint8_t value_len;
+
+        if ((uint32_t) (len - pos) < BT_CONTROL_TLV_HEADER_SIZE)
+        {
+            status = WICED_BT_GATT_INVALID_ATTR_LEN;
+            break;
+        }
+
+        value_len = p_val[pos + 1U];
+        if ((uint32_t) (len - pos - BT_CONTROL_TLV_HEADER_SIZE) < value_len)
+        {
+            status = WICED_BT_GATT_INVALID_ATTR_LEN;
+            break;
+        }
+
+        status = bt_control_stage(&config, p_val[pos],
+                                  &p_val[pos + BT_CONTROL_TLV_HEADER_SIZE],
+                                  value_len);
+        if (WICED_BT_GATT_SUCCESS == status)
+        {
+            pos = (uint16_t) (pos + BT_CONTROL_TLV_HEADER_SIZE + value_len);
+        }
+    }
+
+    if (WICED_BT_GATT_SUCCESS != status)
+    {
+        printf("Control write rejected at offset %u: 0x%x\r\n",
+               (unsigned int) pos, status);
+        return status;
+    }
+
+    i2c_capsense_set_tuning(&config.tuning);
+    bt_app_set_notify_interval(config.notify_interval_ms);
+    capsense_diag_configure(config.diag_period_ms, config.diag_outputs);
+    bt_app_set_payload_format(config.payload_format);
+
+    printf("Control: sample %u/%u ms, filter %u, notify %u ms, "
+           "diagnostics %u ms, format %u\r\n",
+           config.tuning.sample_period_ms,
+           config.tuning.stream_sample_period_ms,
+           config.tuning.position_filter, config.notify_interval_ms,
+           (unsigned int) config.diag_period_ms, config.payload_format);
+
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: bt_control_write
+********************************************************************************
+* Summary:
+*  Handles a write to the control characteristic. A valid write is applied
+*  at once; the BT task then saves the resulting parameters, so they are
+*  restored after a reset. The stack callback never waits for the RRAM.
+*
+* Parameters:
+*  const uint8_t *p_val : Written TLV records
+*  uint16_t len         : Length of the written value
+*
+* Return:
+*  wiced_bt_gatt_status_t: WICED_BT_GATT_SUCCESS, or the error of the first
+*  invalid record
+*
+*******************************************************************************/
+wiced_bt_gatt_status_t bt_control_write(const uint8_t *p_val, uint16_t len)
+{
+    wiced_bt_gatt_status_t status;
+
+    /* Held only to apply or serialize the parameters, never for a save */
+    xSemaphoreTake(bt_control_mutex, portMAX_DELAY);
+    status = bt_control_apply(p_val, len);
+    if (WICED_BT_GATT_SUCCESS == status)
+    {
+        bt_control_dirty = true;
+    }
+    xSemaphoreGive(bt_control_mutex);
+
+    if (WICED_BT_GATT_SUCCESS == status)
+    {
+        xTaskNotify(bt_task_handle, NOTIFIY_OFF, eNoAction);
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: bt_control_process
+********************************************************************************
+* Summary:
+*  Saves the parameters after a write. Called by the BT task; a save may
+*  compact a whole KV store sector.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  TickType_t: Ticks until the function needs to run again
+*
+*******************************************************************************/
+TickType_t bt_control_process(void)
+{
+    uint16_t saved_len;
+
+    if (!bt_control_dirty)
+    {
+        return portMAX_DELAY;
+    }
+
+    /* A write after the snapshot sets the flag again */
+    xSemaphoreTake(bt_control_mutex, portMAX_DELAY);
+    bt_control_dirty = false;
+    saved_len = bt_control_serialize(bt_control_saved,
+                                     sizeof(bt_control_saved));
+    xSemaphoreGive(bt_control_mutex);
+
+    if (!kv_store_set(KV_KEY_CONTROL, bt_control_saved, saved_len))
+    {
+        printf("Control: saving the parameters failed\r\n");
+    }
+
+    return portMAX_DELAY;
+}
+
+/*******************************************************************************
+* Function Name: bt_control_load
+********************************************************************************
+* Summary:
+*  Applies the parameters saved by the last control write. Without saved
+*  parameters, or when they are not valid in this firmware, the defaults
+*  stay in use.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_control_load(void)
+{
+    uint16_t len;
+
+    xSemaphoreTake(bt_control_mutex, portMAX_DELAY);
+
+    if (kv_store_get(KV_KEY_CONTROL, bt_control_saved,
+                     sizeof(bt_control_saved), &len))
+    {
+        printf("Control: restoring the saved parameters\r\n");
+        (void) bt_control_apply(bt_control_saved, len);
+    }
+
+    xSemaphoreGive(bt_control_mutex);
+}
+
+/*******************************************************************************
+* Function Name: bt_control_print
+********************************************************************************
+* Summary:
+*  Prints the current parameters.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_control_print(void)
+{
+    bt_control_config_t config;
+
+    bt_control_get_config(&config);
+
+    printf("Control: sample %u ms, stream sample %u ms, filter %u, "
+           "notify %u ms\r\n", config.tuning.sample_period_ms,
+           config.tuning.stream_sample_period_ms,
+           config.tuning.position_filter, config.notify_interval_ms);
+    for (uint32_t id = 0U; id < CAPSENSE_SENSOR_COUNT; id++)
+    {
+        printf("Control: sensor %lu LED command %u\r\n", (unsigned long) id,
+               config.tuning.led[id]);
+    }
+    printf("Control: diagnostics %lu ms, outputs 0x%x\r\n",
+           (unsigned long) config.diag_period_ms, config.diag_outputs);
+    printf("Control: payload format %u, device time %lu us\r\n",
+           config.payload_format, (unsigned long) bt_time_now_us());
+}
+
+/*******************************************************************************
+* Function Name: bt_control_put
+********************************************************************************
+* Summary:
+*  Appends one record to a buffer if it fits.
+*
+* Parameters:
+*  uint8_t *p_buf         : Destination buffer
+*  uint16_t pos           : Current length of the buffer contents
+*  uint16_t max_len       : Size of the buffer
+*  uint8_t type           : Record type, BT_CONTROL_xx
+*  const uint8_t *p_value : Record value
+*  uint8_t len            : Record value length
+*
+* Return:
+*  uint16_t: New length of the buffer contents
+*
+*******************************************************************************/
+static uint16_t bt_control_put(uint8_t *p_buf, uint16_t pos, uint16_t max_len,
+                               uint8_t type, const uint8_t *p_value,
+                               uint8_t len)
+{
+    if ((uint32_t) (max_len - pos) >= (BT_CONTROL_TLV_HEADER_SIZE + len))
+    {
+        p_buf[pos++] = type;
+        p_buf[pos++] = len;
+        for (uint8_t i = 0U; i < len; i++)
+        {
+            p_buf[pos++] = p_value[i];
+        }
+    }
+
+    return pos;
+}
+
+/*******************************************************************************
+* Function Name: bt_control_serialize
+********************************************************************************
+* Summary:
+*  Writes the current parameters as TLV records, in the format a client
+*  writes them. Reading the characteristic and writing the result back
+*  changes nothing.
+*
+* Parameters:
+*  uint8_t *p_buf   : Destination buffer
+*  uint16_t max_len : Size of the buffer
+*
+* Return:
+*  uint16_t: Number of bytes written
+*
+*******************************************************************************/
+uint16_t bt_control_serialize(uint8_t *p_buf, uint16_t max_len)
+{
+    bt_control_config_t config;
+    uint8_t value[CONTROL_VALUE_MAX];
+    uint16_t pos = 0U;
+
+    bt_control_get_config(&config);
+
+    value[0] = (uint8_t) config.tuning.sample_period_ms;
+    value[1] = (uint8_t) (config.tuning.sample_period_ms >> 8U);
+    pos = bt_control_put(p_buf, pos, max_len, BT_CONTROL_SAMPLE_PERIOD,
+                         value, CONTROL_U16_LEN);
+
+    value[0] = (uint8_t) config.tuning.stream_sample_period_ms;
+    value[1] = (uint8_t) (config.tuning.stream_sample_period_ms >> 8U);
+    pos = bt_control_put(p_buf, pos, max_len,
+                         BT_CONTROL_STREAM_SAMPLE_PERIOD, value,
+                         CONTROL_U16_LEN);
+
+    value[0] = config.tuning.position_filter;
+    pos = bt_control_put(p_buf, pos, max_len, BT_CONTROL_POSITION_FILTER,
+                         value, CONTROL_U8_LEN);
+
+    value[0] = (uint8_t) config.notify_interval_ms;
+    value[1] = (uint8_t) (config.notify_interval_ms >> 8U);
+    pos = bt_control_put(p_buf, pos, max_len, BT_CONTROL_NOTIFY_INTERVAL,
+                         value, CONTROL_U16_LEN);
+
+    for (uint8_t id = 0U; id < CAPSENSE_SENSOR_COUNT; id++)
+    {
+        value[0] = id;
+        value[1] = config.tuning.led[id];
+        pos = bt_control_put(p_buf, pos, max_len, BT_CONTROL_LED_MAP,
+                             value, CONTROL_LED_MAP_LEN);
+    }
+
+    value[0] = (uint8_t) config.diag_period_ms;
+    value[1] = (uint8_t) (config.diag_period_ms >> 8U);
+    value[2] = config.diag_outputs;
+    pos = bt_control_put(p_buf, pos, max_len, BT_CONTROL_DIAGNOSTICS,
+                         value, CONTROL_DIAG_LEN);
+
+    value[0] = config.payload_format;
+    pos = bt_control_put(p_buf, pos, max_len, BT_CONTROL_PAYLOAD_FORMAT,
+                         value, CONTROL_U8_LEN);
+
+    return pos;
+}
+
+/*******************************************************************************
+* Function Name: bt_control_read
+********************************************************************************
+* Summary:
+*  Builds the value of a control characteristic read: the parameters, then
+*  the device time. A client estimates the offset between its clock and the
+*  device time from the time it sent the read and the time the response
+*  arrived: offset = device time - (sent + received) / 2, with an error of
+*  at most half the round trip.
+*
+* Parameters:
+*  uint8_t *p_buf   : Destination buffer
+*  uint16_t max_len : Size of the buffer
+*
+* Return:
+*  uint16_t: Number of bytes written
+*
+*******************************************************************************/
+uint16_t bt_control_read(uint8_t *p_buf, uint16_t max_len)
+{
+    uint8_t value[CONTROL_VALUE_MAX];
+    uint16_t pos = bt_control_serialize(p_buf, max_len);
+    uint32_t now_us = bt_time_now_us();
+
+    value[0] = (uint8_t) now_us;
+    value[1] = (uint8_t) (now_us >> 8U);
+    value[2] = (uint8_t) (now_us >> 16U);
+    value[3] = (uint8_t) (now_us >> 24U);
+
+    return bt_control_put(p_buf, pos, max_len, BT_CONTROL_DEVICE_TIME,
+                          value, CONTROL_U32_LEN);
+}
+
+/* [] END OF FILE */
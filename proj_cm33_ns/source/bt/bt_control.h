@@ -0,0 +1,84 @@
+/*******************************************************************************
+* File Name: bt_control.h
+*
+* Description: This file is the public interface of bt_control.c
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef BT_CONTROL_H
+#define BT_CONTROL_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "wiced_bt_gatt.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* The control characteristic carries a list of TLV records:
+ * type (u8), value length (u8) and value. Multi-byte values are little
+ * endian. A write applies all records or, if one is invalid, none. */
+#define BT_CONTROL_TLV_HEADER_SIZE          (2U)
+
+/* Record types */
+#define BT_CONTROL_SAMPLE_PERIOD            (0x01U) /* u16 ms */
+#define BT_CONTROL_STREAM_SAMPLE_PERIOD     (0x02U) /* u16 ms */
+#define BT_CONTROL_POSITION_FILTER          (0x03U) /* u8 strength */
+#define BT_CONTROL_NOTIFY_INTERVAL          (0x04U) /* u16 ms */
+#define BT_CONTROL_LED_MAP                  (0x05U) /* u8 sensor, u8 led */
+#define BT_CONTROL_DIAGNOSTICS              (0x06U) /* u16 ms, u8 outputs */
+#define BT_CONTROL_PAYLOAD_FORMAT           (0x07U) /* u8 BT_APP_PAYLOAD_xx */
+#define BT_CONTROL_DEVICE_TIME              (0x08U) /* u32 us, read only */
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool bt_control_init(void);
+wiced_bt_gatt_status_t bt_control_write(const uint8_t *p_val, uint16_t len);
+TickType_t bt_control_process(void);
+void bt_control_load(void);
+void bt_control_print(void);
+uint16_t bt_control_serialize(uint8_t *p_buf, uint16_t max_len);
+uint16_t bt_control_read(uint8_t *p_buf, uint16_t max_len);
+
+#endif /* BT_CONTROL_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,713 @@
+/*******************************************************************************
+* File Name: bt_gatt_rec.c
+*
+* Description: This file contains the recording back end of the GATT server API.
+*              Every PDU the application sends is time stamped and logged. In the
+*              simulated mode, the PDUs are completed on a modelled link with a limited
+*              MTU and number of buffers, and a client is injected, so the GATT
+*              throughput and latency can be measured without a peer.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#define BT_GATT_REC_IMPLEMENTATION
+
+#include <stdio.h>
+#include <string.h>
+#include "cy_utils.h"
+#include "cycfg_gatt_db.h"
+#include "bt_app.h"
+#include "bt_gatt_rec.h"
+
+#if defined(BT_GATT_RECORD)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Connection ID of the injected client */
+#define SIM_CONN_ID                         (0x7F01U)
+
+/* Bytes a notification adds to its value on the link: ATT opcode and
+ * handle, L2CAP header */
+#define SIM_NOTIFICATION_OVERHEAD           (3U + 4U)
+
+#define ATT_DEFAULT_MTU                     (23U)
+#define ATT_NOTIFICATION_HEADER_SIZE        (3U)
+#define ATT_READ_RSP_HEADER_SIZE            (1U)
+#define ATT_READ_BY_TYPE_RSP_HEADER_SIZE    (2U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Recorded PDU */
+typedef struct
+{
+    uint32_t tick;              /* Time the application sent it, in ms */
+    uint16_t conn_id;
+    uint16_t handle;
+    uint16_t len;               /* Attribute value length */
+    uint8_t opcode;             /* BT_GATT_REC_OP_xx */
+    uint8_t status;             /* Status returned to the application */
+} bt_gatt_rec_entry_t;
+
+/* Notification or indication occupying a buffer of the simulated link */
+typedef struct
+{
+    uint8_t *p_data;
+    void *p_app_ctx;
+    uint16_t handle;
+    bool indication;            /* The client confirms it on reception */
+    TickType_t sent_tick;
+    TickType_t done_tick;
+} bt_gatt_rec_buffer_t;
+
+static struct
+{
+    bt_gatt_rec_entry_t entries[BT_GATT_REC_LOG_SIZE];
+    uint32_t head;
+} gatt_log;
+
+static struct
+{
+    bool connected;
+    uint16_t mtu;
+    bt_gatt_rec_buffer_t buffers[BT_GATT_REC_SIM_BUFFERS];
+    uint32_t head;
+    uint32_t tail;
+    TickType_t link_free_tick;  /* Time the link finishes the queued PDUs */
+} sim_link;
+
+static struct
+{
+    uint32_t pdus;
+    uint32_t notifications;
+    uint32_t indications;
+    uint32_t notification_bytes;
+    uint32_t rejected;
+    uint32_t latency_sum_ms;
+    uint32_t latency_max_ms;
+    uint32_t completed;
+    TickType_t start_tick;
+} gatt_stats;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: bt_gatt_rec_log
+********************************************************************************
+* Summary:
+*  Records one PDU and returns its status.
+*******************************************************************************/
+static wiced_bt_gatt_status_t bt_gatt_rec_log(uint8_t opcode,
+        uint16_t conn_id, uint16_t handle, uint16_t len,
+        wiced_bt_gatt_status_t status)
+{
+    bt_gatt_rec_entry_t *p_entry;
+
+    taskENTER_CRITICAL();
+    p_entry = &gatt_log.entries[gatt_log.head % BT_GATT_REC_LOG_SIZE];
+    p_entry->tick = xTaskGetTickCount();
+    p_entry->conn_id = conn_id;
+    p_entry->handle = handle;
+    p_entry->len = len;
+    p_entry->opcode = opcode;
+    p_entry->status = (uint8_t) status;
+    gatt_log.head++;
+    gatt_stats.pdus++;
+    taskEXIT_CRITICAL();
+
+    return status;
+}
+
+#if (BT_GATT_REC_SIMULATE)
+/*******************************************************************************
+* Function Name: bt_gatt_rec_check
+********************************************************************************
+* Summary:
+*  Checks a PDU against the simulated link: the client must be connected
+*  and the value must fit the MTU after the ATT header.
+*
+* Parameters:
+*  uint16_t conn_id     : Connection ID of the PDU
+*  uint16_t len         : Value length
+*  uint16_t header_size : ATT header size of the PDU
+*
+* Return:
+*  wiced_bt_gatt_status_t: WICED_BT_GATT_SUCCESS if the PDU can be sent
+*
+*******************************************************************************/
+static wiced_bt_gatt_status_t bt_gatt_rec_check(uint16_t conn_id,
+        uint16_t len, uint16_t header_size)
+{
+    if (!sim_link.connected || (SIM_CONN_ID != conn_id))
+    {
+        return WICED_BT_GATT_ERROR;
+    }
+
+    if ((len + header_size) > sim_link.mtu)
+    {
+        return WICED_BT_GATT_ILLEGAL_PARAMETER;
+    }
+
+    return WICED_BT_GATT_SUCCESS;
+}
+#endif /* (BT_GATT_REC_SIMULATE) */
+
+/*******************************************************************************
+* Function Name: bt_gatt_rec_db_init
+********************************************************************************
+* Summary:
+*  Records the GATT database and passes it to the stack, which keeps serving
+*  the real clients in both modes.
+*******************************************************************************/
+wiced_bt_gatt_status_t bt_gatt_rec_db_init(const uint8_t *p_db,
+        uint32_t db_len, wiced_bt_db_hash_t hash)
+{
+    return bt_gatt_rec_log(BT_GATT_REC_OP_DB_INIT, 0U, 0U, (uint16_t) db_len,
+            wiced_bt_gatt_db_init(p_db, db_len, hash));
+}
+
+#if (BT_GATT_REC_SIMULATE)
+/*******************************************************************************
+* Function Name: bt_gatt_rec_sim_send
+********************************************************************************
+* Summary:
+*  Sends a notification or indication on the simulated link. It takes a
+*  link buffer until its transmission time at BT_GATT_REC_SIM_BYTES_PER_MS
+*  has passed. Without a free buffer it is refused like a congested stack
+*  would, and the application keeps the buffer.
+*
+* Parameters:
+*  uint8_t opcode       : BT_GATT_REC_OP_NOTIFICATION or
+*                         BT_GATT_REC_OP_INDICATION
+*  uint16_t conn_id     : Connection ID
+*  uint16_t attr_handle : Attribute handle
+*  uint16_t val_len     : Value length
+*  uint8_t *p_val       : Value
+*  void *p_app_ctx      : Context returned with GATT_APP_BUFFER_TRANSMITTED_EVT
+*
+* Return:
+*  wiced_bt_gatt_status_t: Status codes in wiced_bt_gatt_status_e
+*
+*******************************************************************************/
+static wiced_bt_gatt_status_t bt_gatt_rec_sim_send(uint8_t opcode,
+        uint16_t conn_id, uint16_t attr_handle, uint16_t val_len,
+        uint8_t *p_val, void *p_app_ctx)
+{
+    wiced_bt_gatt_status_t status = bt_gatt_rec_check(conn_id, val_len,
+            ATT_NOTIFICATION_HEADER_SIZE);
+    TickType_t now = xTaskGetTickCount();
+    bt_gatt_rec_buffer_t *p_buffer;
+    TickType_t airtime;
+
+    if ((WICED_BT_GATT_SUCCESS == status) &&
+            ((sim_link.head - sim_link.tail) >= BT_GATT_REC_SIM_BUFFERS))
+    {
+        status = WICED_BT_GATT_NO_RESOURCES;
+    }
+
+    if (WICED_BT_GATT_SUCCESS != status)
+    {
+        gatt_stats.rejected++;
+        return bt_gatt_rec_log(opcode, conn_id, attr_handle, val_len, status);
+    }
+
+    /* The link sends the queued PDUs one after the other */
+    airtime = pdMS_TO_TICKS((val_len + SIM_NOTIFICATION_OVERHEAD +
+            BT_GATT_REC_SIM_BYTES_PER_MS - 1U) / BT_GATT_REC_SIM_BYTES_PER_MS);
+    if ((sim_link.head == sim_link.tail) ||
+            ((int32_t) (now - sim_link.link_free_tick) > 0))
+    {
+        sim_link.link_free_tick = now;
+    }
+    sim_link.link_free_tick += airtime;
+
+    p_buffer = &sim_link.buffers[sim_link.head % BT_GATT_REC_SIM_BUFFERS];
+    p_buffer->p_data = p_val;
+    p_buffer->p_app_ctx = p_app_ctx;
+    p_buffer->handle = attr_handle;
+    p_buffer->indication = (BT_GATT_REC_OP_INDICATION == opcode);
+    p_buffer->sent_tick = now;
+    p_buffer->done_tick = sim_link.link_free_tick;
+    sim_link.head++;
+
+    if (p_buffer->indication)
+    {
+        gatt_stats.indications++;
+    }
+    else
+    {
+        gatt_stats.notifications++;
+    }
+    gatt_stats.notification_bytes += val_len;
+
+    /* Wake up the BT task to complete the transmission */
+    xTaskNotify(bt_task_handle, NOTIFIY_OFF, eNoAction);
+
+    return bt_gatt_rec_log(opcode, conn_id, attr_handle, val_len, status);
+}
+#endif /* (BT_GATT_REC_SIMULATE) */
+
+/*******************************************************************************
+* Function Name: bt_gatt_rec_send_notification
+********************************************************************************
+* Summary:
+*  Records a notification. In the simulated mode, it is sent on the
+*  simulated link.
+*
+* Parameters:
+*  uint16_t conn_id     : Connection ID
+*  uint16_t attr_handle : Attribute handle
+*  uint16_t val_len     : Value length
+*  uint8_t *p_val       : Value
+*  void *p_app_ctx      : Context returned with GATT_APP_BUFFER_TRANSMITTED_EVT
+*
+* Return:
+*  wiced_bt_gatt_status_t: Status codes in wiced_bt_gatt_status_e
+*
+*******************************************************************************/
+wiced_bt_gatt_status_t bt_gatt_rec_send_notification(uint16_t conn_id,
+        uint16_t attr_handle, uint16_t val_len, uint8_t *p_val,
+        void *p_app_ctx)
+{
+#if (BT_GATT_REC_SIMULATE)
+    return bt_gatt_rec_sim_send(BT_GATT_REC_OP_NOTIFICATION, conn_id,
+            attr_handle, val_len, p_val, p_app_ctx);
+#else
+    return bt_gatt_rec_log(BT_GATT_REC_OP_NOTIFICATION, conn_id, attr_handle,
+            val_len, wiced_bt_gatt_server_send_notification(conn_id,
+                    attr_handle, val_len, p_val, p_app_ctx));
+#endif
+}
+
+/*******************************************************************************
+* Function Name: bt_gatt_rec_send_indication
+********************************************************************************
+* Summary:
+*  Records an indication. In the simulated mode, it is sent on the
+*  simulated link and the client confirms it once transmitted.
+*
+* Parameters:
+*  uint16_t conn_id     : Connection ID
+*  uint16_t attr_handle : Attribute handle
+*  uint16_t val_len     : Value length
+*  uint8_t *p_val       : Value
+*  void *p_app_ctx      : Context returned with GATT_APP_BUFFER_TRANSMITTED_EVT
+*
+* Return:
+*  wiced_bt_gatt_status_t: Status codes in wiced_bt_gatt_status_e
+*
+*******************************************************************************/
+wiced_bt_gatt_status_t bt_gatt_rec_send_indication(uint16_t conn_id,
+        uint16_t attr_handle, uint16_t val_len, uint8_t *p_val,
+        void *p_app_ctx)
+{
+#if (BT_GATT_REC_SIMULATE)
+    return bt_gatt_rec_sim_send(BT_GATT_REC_OP_INDICATION, conn_id,
+            attr_handle, val_len, p_val, p_app_ctx);
+#else
+    return bt_gatt_rec_log(BT_GATT_REC_OP_INDICATION, conn_id, attr_handle,
+            val_len, wiced_bt_gatt_server_send_indication(conn_id,
+                    attr_handle, val_len, p_val, p_app_ctx));
+#endif
+}
+
+/*******************************************************************************
+* Function Name: bt_gatt_rec_send_read_handle_rsp
+********************************************************************************
+* Summary:
+*  Records a Read or Read Blob Response.
+*******************************************************************************/
+wiced_bt_gatt_status_t bt_gatt_rec_send_read_handle_rsp(uint16_t conn_id,
+        wiced_bt_gatt_opcode_t opcode, uint16_t len, uint8_t *p_attr,
+        void *p_app_ctx)
+{
+#if (BT_GATT_REC_SIMULATE)
+    CY_UNUSED_PARAMETER(opcode);
+    CY_UNUSED_PARAMETER(p_attr);
+    CY_UNUSED_PARAMETER(p_app_ctx);
+
+    return bt_gatt_rec_log(BT_GATT_REC_OP_READ_RSP, conn_id, 0U, len,
+            bt_gatt_rec_check(conn_id, len, ATT_READ_RSP_HEADER_SIZE));
+#else
+    return bt_gatt_rec_log(BT_GATT_REC_OP_READ_RSP, conn_id, 0U, len,
+            wiced_bt_gatt_server_send_read_handle_rsp(conn_id, opcode, len,
+                    p_attr, p_app_ctx));
+#endif
+}
+
+/*******************************************************************************
+* Function Name: bt_gatt_rec_send_read_by_type_rsp
+********************************************************************************
+* Summary:
+*  Records a Read By Type Response. The simulated link releases the buffer
+*  as for Read Multiple.
+*******************************************************************************/
+wiced_bt_gatt_status_t bt_gatt_rec_send_read_by_type_rsp(uint16_t conn_id,
+        wiced_bt_gatt_opcode_t opcode, uint8_t type_len, uint16_t data_len,
+        uint8_t *p_data, void *p_app_ctx)
+{
+#if (BT_GATT_REC_SIMULATE)
+    wiced_bt_gatt_status_t status = bt_gatt_rec_check(conn_id, data_len,
+            ATT_READ_BY_TYPE_RSP_HEADER_SIZE);
+
+    CY_UNUSED_PARAMETER(opcode);
+    CY_UNUSED_PARAMETER(type_len);
+
+    if ((WICED_BT_GATT_SUCCESS == status) && (NULL != p_app_ctx))
+    {
+        ((void (*)(uint8_t *)) p_app_ctx)(p_data);
+    }
+
+    return bt_gatt_rec_log(BT_GATT_REC_OP_READ_BY_TYPE_RSP, conn_id, 0U,
+            data_len, status);
+#else
+    return bt_gatt_rec_log(BT_GATT_REC_OP_READ_BY_TYPE_RSP, conn_id, 0U,
+            data_len, wiced_bt_gatt_server_send_read_by_type_rsp(conn_id,
+                    opcode, type_len, data_len, p_data, p_app_ctx));
+#endif
+}
+
+/*******************************************************************************
+* Function Name: bt_gatt_rec_send_read_multiple_rsp
+********************************************************************************
+* Summary:
+*  Records a Read Multiple or Read Multiple Variable Length Response. The
+*  simulated link transmits the response at once and releases the buffer
+*  through the application context, as the stack does once it is sent.
+*******************************************************************************/
+wiced_bt_gatt_status_t bt_gatt_rec_send_read_multiple_rsp(uint16_t conn_id,
+        wiced_bt_gatt_opcode_t opcode, uint16_t len, uint8_t *p_rsp,
+        void *p_app_ctx)
+{
+    uint8_t rec_opcode = (GATT_REQ_READ_MULTI == opcode) ?
+            BT_GATT_REC_OP_READ_MULTI_RSP : BT_GATT_REC_OP_READ_MULTI_VAR_RSP;
+#if (BT_GATT_REC_SIMULATE)
+    wiced_bt_gatt_status_t status = bt_gatt_rec_check(conn_id, len,
+            ATT_READ_RSP_HEADER_SIZE);
+
+    if ((WICED_BT_GATT_SUCCESS == status) && (NULL != p_app_ctx))
+    {
+        ((void (*)(uint8_t *)) p_app_ctx)(p_rsp);
+    }
+
+    return bt_gatt_rec_log(rec_opcode, conn_id, 0U, len, status);
+#else
+    return bt_gatt_rec_log(rec_opcode, conn_id, 0U, len,
+            wiced_bt_gatt_server_send_read_multiple_rsp(conn_id, opcode, len,
+                    p_rsp, p_app_ctx));
+#endif
+}
+
+/*******************************************************************************
+* Function Name: bt_gatt_rec_send_mtu_rsp
+********************************************************************************
+* Summary:
+*  Records an Exchange MTU Response. The simulated link uses the smaller of
+*  both MTUs.
+*******************************************************************************/
+wiced_bt_gatt_status_t bt_gatt_rec_send_mtu_rsp(uint16_t conn_id,
+        uint16_t remote_mtu, uint16_t local_mtu)
+{
+#if (BT_GATT_REC_SIMULATE)
+    sim_link.mtu = MIN(remote_mtu, local_mtu);
+
+    return bt_gatt_rec_log(BT_GATT_REC_OP_MTU_RSP, conn_id, 0U, local_mtu,
+            bt_gatt_rec_check(conn_id, 0U, 0U));
+#else
+    return bt_gatt_rec_log(BT_GATT_REC_OP_MTU_RSP, conn_id, 0U, local_mtu,
+            wiced_bt_gatt_server_send_mtu_rsp(conn_id, remote_mtu,
+                    local_mtu));
+#endif
+}
+
+/*******************************************************************************
+* Function Name: bt_gatt_rec_send_write_rsp
+********************************************************************************
+* Summary:
+*  Records a Write Response.
+*******************************************************************************/
+wiced_bt_gatt_status_t bt_gatt_rec_send_write_rsp(uint16_t conn_id,
+        wiced_bt_gatt_opcode_t opcode, uint16_t handle)
+{
+#if (BT_GATT_REC_SIMULATE)
+    CY_UNUSED_PARAMETER(opcode);
+
+    return bt_gatt_rec_log(BT_GATT_REC_OP_WRITE_RSP, conn_id, handle, 0U,
+            bt_gatt_rec_check(conn_id, 0U, 0U));
+#else
+    return bt_gatt_rec_log(BT_GATT_REC_OP_WRITE_RSP, conn_id, handle, 0U,
+            wiced_bt_gatt_server_send_write_rsp(conn_id, opcode, handle));
+#endif
+}
+
+/*******************************************************************************
+* Function Name: bt_gatt_rec_send_error_rsp
+********************************************************************************
+* Summary:
+*  Records an Error Response. The error code is kept in the length field.
+*******************************************************************************/
+wiced_bt_gatt_status_t bt_gatt_rec_send_error_rsp(uint16_t conn_id,
+        wiced_bt_gatt_opcode_t opcode, uint16_t handle,
+        wiced_bt_gatt_status_t status)
+{
+#if (BT_GATT_REC_SIMULATE)
+    CY_UNUSED_PARAMETER(opcode);
+
+    return bt_gatt_rec_log(BT_GATT_REC_OP_ERROR_RSP, conn_id, handle,
+            (uint16_t) status, bt_gatt_rec_check(conn_id, 0U, 0U));
+#else
+    return bt_gatt_rec_log(BT_GATT_REC_OP_ERROR_RSP, conn_id, handle,
+            (uint16_t) status, wiced_bt_gatt_server_send_error_rsp(conn_id,
+                    opcode, handle, status));
+#endif
+}
+
+/*******************************************************************************
+* Function Name: bt_gatt_rec_inject_connection
+********************************************************************************
+* Summary:
+*  Delivers a connection or disconnection of the simulated client to the
+*  application, as the stack would.
+*
+* Parameters:
+*  bool connected : true to connect the client, false to disconnect it
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_gatt_rec_inject_connection(bool connected)
+{
+    static wiced_bt_device_address_t sim_addr =
+            {0x00U, 0xA0U, 0x50U, 0x5AU, 0x5AU, 0x01U};
+    wiced_bt_gatt_event_data_t event = {0};
+
+    sim_link.connected = connected;
+    sim_link.mtu = ATT_DEFAULT_MTU;
+    sim_link.tail = sim_link.head;
+
+    event.connection_status.bd_addr = sim_addr;
+    event.connection_status.conn_id = SIM_CONN_ID;
+    event.connection_status.connected = connected ? WICED_TRUE : WICED_FALSE;
+    event.connection_status.link_role = HCI_ROLE_PERIPHERAL;
+    event.connection_status.transport = BT_TRANSPORT_LE;
+
+    (void) bt_app_gatt_event_cb(GATT_CONNECTION_STATUS_EVT, &event);
+}
+
+/*******************************************************************************
+* Function Name: bt_gatt_rec_inject_mtu
+********************************************************************************
+* Summary:
+*  Delivers an Exchange MTU Request of the simulated client.
+*******************************************************************************/
+void bt_gatt_rec_inject_mtu(uint16_t mtu)
+{
+    wiced_bt_gatt_event_data_t event = {0};
+
+    event.attribute_request.conn_id = SIM_CONN_ID;
+    event.attribute_request.opcode = GATT_REQ_MTU;
+    event.attribute_request.data.remote_mtu = mtu;
+
+    (void) bt_app_gatt_event_cb(GATT_ATTRIBUTE_REQUEST_EVT, &event);
+}
+
+/*******************************************************************************
+* Function Name: bt_gatt_rec_inject_write
+********************************************************************************
+* Summary:
+*  Delivers a Write Request of the simulated client.
+*******************************************************************************/
+void bt_gatt_rec_inject_write(uint16_t handle, uint8_t *p_val, uint16_t len)
+{
+    wiced_bt_gatt_event_data_t event = {0};
+
+    event.attribute_request.conn_id = SIM_CONN_ID;
+    event.attribute_request.opcode = GATT_REQ_WRITE;
+    event.attribute_request.data.write_req.handle = handle;
+    event.attribute_request.data.write_req.p_val = p_val;
+    event.attribute_request.data.write_req.val_len = len;
+    event.attribute_request.len_requested = len;
+
+    (void) bt_app_gatt_event_cb(GATT_ATTRIBUTE_REQUEST_EVT, &event);
+}
+
+/*******************************************************************************
+* Function Name: bt_gatt_rec_start
+********************************************************************************
+* Summary:
+*  In the simulated mode, connects the simulated client, exchanges the MTU
+*  and enables the button, slider and stream notifications. Called once the
+*  GATT database is initialized.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_gatt_rec_start(void)
+{
+#if (BT_GATT_REC_SIMULATE)
+    static uint8_t cccd_notify[] = {GATT_CLIENT_CONFIG_NOTIFICATION, 0U};
+#endif
+
+    gatt_stats.start_tick = xTaskGetTickCount();
+
+#if (BT_GATT_REC_SIMULATE)
+    bt_gatt_rec_inject_connection(true);
+    bt_gatt_rec_inject_mtu(BT_GATT_REC_SIM_MTU);
+    bt_gatt_rec_inject_write(HDLD_CAPSENSE_BUTTON_CLIENT_CHAR_CONFIG,
+                             cccd_notify, sizeof(cccd_notify));
+    bt_gatt_rec_inject_write(HDLD_CAPSENSE_SLIDER_CLIENT_CHAR_CONFIG,
+                             cccd_notify, sizeof(cccd_notify));
+    bt_gatt_rec_inject_write(HDLD_CAPSENSE_STREAM_CLIENT_CHAR_CONFIG,
+                             cccd_notify, sizeof(cccd_notify));
+#endif
+}
+
+/*******************************************************************************
+* Function Name: bt_gatt_rec_process
+********************************************************************************
+* Summary:
+*  Completes the notifications and indications whose transmission time has
+*  passed and hands their buffers back with GATT_APP_BUFFER_TRANSMITTED_EVT.
+*  The indications are then confirmed by the client. Called from the BT
+*  task.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  TickType_t: Ticks until the next notification completes
+*
+*******************************************************************************/
+TickType_t bt_gatt_rec_process(void)
+{
+    TickType_t now = xTaskGetTickCount();
+
+    while (sim_link.tail != sim_link.head)
+    {
+        bt_gatt_rec_buffer_t *p_buffer =
+                &sim_link.buffers[sim_link.tail % BT_GATT_REC_SIM_BUFFERS];
+        wiced_bt_gatt_event_data_t event = {0};
+        uint32_t latency;
+
+        if ((int32_t) (p_buffer->done_tick - now) > 0)
+        {
+            return p_buffer->done_tick - now;
+        }
+
+        latency = now - p_buffer->sent_tick;
+        gatt_stats.latency_sum_ms += latency;
+        gatt_stats.latency_max_ms = MAX(gatt_stats.latency_max_ms, latency);
+        gatt_stats.completed++;
+        sim_link.tail++;
+
+        event.buffer_xmitted.p_app_data = p_buffer->p_data;
+        event.buffer_xmitted.p_app_ctxt = p_buffer->p_app_ctx;
+        (void) bt_app_gatt_event_cb(GATT_APP_BUFFER_TRANSMITTED_EVT, &event);
+
+        if (p_buffer->indication)
+        {
+            memset(&event, 0, sizeof(event));
+            event.attribute_request.conn_id = SIM_CONN_ID;
+            event.attribute_request.opcode = GATT_HANDLE_VALUE_CONF;
+            event.attribute_request.data.confirm_handle = p_buffer->handle;
+            (void) bt_app_gatt_event_cb(GATT_ATTRIBUTE_REQUEST_EVT, &event);
+        }
+    }
+
+    return portMAX_DELAY;
+}
+
+/*******************************************************************************
+* Function Name: bt_gatt_rec_dump
+********************************************************************************
+* Summary:
+*  Prints the recorded PDUs, oldest first, as comma separated lines: time in
+*  ms, connection ID, ATT opcode, handle, length and status.
+*******************************************************************************/
+void bt_gatt_rec_dump(void)
+{
+    uint32_t head = gatt_log.head;
+    uint32_t first = (head > BT_GATT_REC_LOG_SIZE) ?
+            (head - BT_GATT_REC_LOG_SIZE) : 0U;
+
+    printf("gatt,tick,conn,op,handle,len,status\r\n");
+    for (uint32_t i = first; i != head; i++)
+    {
+        const bt_gatt_rec_entry_t *p_entry =
+                &gatt_log.entries[i % BT_GATT_REC_LOG_SIZE];
+
+        printf("gatt,%lu,0x%04x,0x%02x,0x%04x,%u,0x%02x\r\n",
+               (unsigned long) p_entry->tick, p_entry->conn_id,
+               p_entry->opcode, p_entry->handle, p_entry->len,
+               p_entry->status);
+    }
+}
+
+/*******************************************************************************
+* Function Name: bt_gatt_rec_print_stats
+********************************************************************************
+* Summary:
+*  Prints the recorded PDUs and, in the simulated mode, the notification
+*  throughput and the average and maximum time from send to completion.
+*******************************************************************************/
+void bt_gatt_rec_print_stats(void)
+{
+    uint32_t elapsed_ms = xTaskGetTickCount() - gatt_stats.start_tick;
+    uint32_t completed = gatt_stats.completed;
+
+    printf("GATT rec: %lu PDUs, %lu notifications, %lu indications, "
+           "%lu rejected, %lu B/s, latency %lu ms avg, %lu ms max\r\n",
+           (unsigned long) gatt_stats.pdus,
+           (unsigned long) gatt_stats.notifications,
+           (unsigned long) gatt_stats.indications,
+           (unsigned long) gatt_stats.rejected,
+           (unsigned long) ((0U != elapsed_ms) ? (uint32_t) (((uint64_t)
+                   gatt_stats.notification_bytes * 1000U) / elapsed_ms) : 0U),
+           (unsigned long) ((0U != completed) ?
+                   (gatt_stats.latency_sum_ms / completed) : 0U),
+           (unsigned long) gatt_stats.latency_max_ms);
+}
+
+#endif /* defined(BT_GATT_RECORD) */
+
+/* [] END OF FILE */
@@ -0,0 +1,139 @@
+/*******************************************************************************
+* File Name: bt_gatt_rec.h
+*
+* Description: This file contains the declarations of the recording back end of
+*              the GATT server API. Build with BT_GATT_RECORD defined to route the GATT
+*              server calls of the application through it.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef BT_GATT_REC_H
+#define BT_GATT_REC_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "wiced_bt_gatt.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* 1: complete the PDUs on a simulated link and inject a client, so the
+ * GATT path can be measured without a peer. 0: pass the PDUs to the stack
+ * and only record them. */
+#define BT_GATT_REC_SIMULATE                (1U)
+
+/* Simulated link: ATT MTU of the client, stack buffers for notifications
+ * and ATT payload throughput */
+#define BT_GATT_REC_SIM_MTU                 (247U)
+#define BT_GATT_REC_SIM_BUFFERS             (4U)
+#define BT_GATT_REC_SIM_BYTES_PER_MS        (64U)
+
+/* PDUs kept for bt_gatt_rec_dump() */
+#define BT_GATT_REC_LOG_SIZE                (256U)
+
+/* ATT opcodes of the recorded PDUs */
+#define BT_GATT_REC_OP_ERROR_RSP            (0x01U)
+#define BT_GATT_REC_OP_MTU_RSP              (0x03U)
+#define BT_GATT_REC_OP_READ_BY_TYPE_RSP     (0x09U)
+#define BT_GATT_REC_OP_READ_RSP             (0x0BU)
+#define BT_GATT_REC_OP_READ_MULTI_RSP       (0x0FU)
+#define BT_GATT_REC_OP_WRITE_RSP            (0x13U)
+#define BT_GATT_REC_OP_NOTIFICATION         (0x1BU)
+#define BT_GATT_REC_OP_INDICATION           (0x1DU)
+#define BT_GATT_REC_OP_READ_MULTI_VAR_RSP   (0x21U)
+#define BT_GATT_REC_OP_DB_INIT              (0x00U)
+
+/* Route the GATT server calls of the application through the recorder */
+#if defined(BT_GATT_RECORD) && !defined(BT_GATT_REC_IMPLEMENTATION)
+#define wiced_bt_gatt_db_init               bt_gatt_rec_db_init
+#define wiced_bt_gatt_server_send_notification \
+                                            bt_gatt_rec_send_notification
+#define wiced_bt_gatt_server_send_indication \
+                                            bt_gatt_rec_send_indication
+#define wiced_bt_gatt_server_send_read_handle_rsp \
+                                            bt_gatt_rec_send_read_handle_rsp
+#define wiced_bt_gatt_server_send_read_by_type_rsp \
+                                            bt_gatt_rec_send_read_by_type_rsp
+#define wiced_bt_gatt_server_send_read_multiple_rsp \
+                                            bt_gatt_rec_send_read_multiple_rsp
+#define wiced_bt_gatt_server_send_mtu_rsp   bt_gatt_rec_send_mtu_rsp
+#define wiced_bt_gatt_server_send_write_rsp bt_gatt_rec_send_write_rsp
+#define wiced_bt_gatt_server_send_error_rsp bt_gatt_rec_send_error_rsp
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+#if defined(BT_GATT_RECORD)
+wiced_bt_gatt_status_t bt_gatt_rec_db_init(const uint8_t *p_db,
+        uint32_t db_len, wiced_bt_db_hash_t hash);
+wiced_bt_gatt_status_t bt_gatt_rec_send_notification(uint16_t conn_id,
+        uint16_t attr_handle, uint16_t val_len, uint8_t *p_val,
+        void *p_app_ctx);
+wiced_bt_gatt_status_t bt_gatt_rec_send_indication(uint16_t conn_id,
+        uint16_t attr_handle, uint16_t val_len, uint8_t *p_val,
+        void *p_app_ctx);
+wiced_bt_gatt_status_t bt_gatt_rec_send_read_handle_rsp(uint16_t conn_id,
+        wiced_bt_gatt_opcode_t opcode, uint16_t len, uint8_t *p_attr,
+        void *p_app_ctx);
+wiced_bt_gatt_status_t bt_gatt_rec_send_read_by_type_rsp(uint16_t conn_id,
+        wiced_bt_gatt_opcode_t opcode, uint8_t type_len, uint16_t data_len,
+        uint8_t *p_data, void *p_app_ctx);
+wiced_bt_gatt_status_t bt_gatt_rec_send_read_multiple_rsp(uint16_t conn_id,
+        wiced_bt_gatt_opcode_t opcode, uint16_t len, uint8_t *p_rsp,
+        void *p_app_ctx);
+wiced_bt_gatt_status_t bt_gatt_rec_send_mtu_rsp(uint16_t conn_id,
+        uint16_t remote_mtu, uint16_t local_mtu);
+wiced_bt_gatt_status_t bt_gatt_rec_send_write_rsp(uint16_t conn_id,
+        wiced_bt_gatt_opcode_t opcode, uint16_t handle);
+wiced_bt_gatt_status_t bt_gatt_rec_send_error_rsp(uint16_t conn_id,
+        wiced_bt_gatt_opcode_t opcode, uint16_t handle,
+        wiced_bt_gatt_status_t status);
+
+void bt_gatt_rec_inject_connection(bool connected);
+void bt_gatt_rec_inject_mtu(uint16_t mtu);
+void bt_gatt_rec_inject_write(uint16_t handle, uint8_t *p_val, uint16_t len);
+void bt_gatt_rec_start(void);
+TickType_t bt_gatt_rec_process(void);
+void bt_gatt_rec_dump(void);
+void bt_gatt_rec_print_stats(void);
+#endif /* defined(BT_GATT_RECORD) */
+
+#endif /* BT_GATT_REC_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,424 @@
+/*******************************************************************************
+* File Name: bt_indicate.c
+*
+* Description: This file sends the queued values as indications, one at a
+*              time, and tracks their confirmations.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "bt_app.h"
+#include "bt_indicate.h"
+#include "bt_bond.h"
+#include "bt_gatt_rec.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Value waiting for confirmation */
+typedef struct
+{
+    uint16_t handle;
+    uint16_t len;
+    uint8_t value[BT_INDICATE_VALUE_MAX];
+    bool resend;                /* Sent on an earlier connection */
+} bt_indicate_entry_t;
+
+/* Queue state. Values are queued by the BT and BT stack tasks, confirmed
+ * in the BT stack task and sent by the BT task; the queue and counters are
+ * changed in critical sections. The oldest value is the one in flight. */
+static struct
+{
+    volatile uint16_t conn_id;
+    volatile bool enabled;      /* Client enabled the indications */
+    bool in_flight;             /* Oldest value sent, not yet confirmed */
+    bool timed_out;             /* Waiting for the link to close */
+    TickType_t sent_tick;
+    TickType_t retry_tick;      /* Time of the last refused send */
+    uint32_t first;
+    uint32_t count;
+    bt_indicate_entry_t entries[BT_INDICATE_QUEUE_LENGTH];
+    bt_indicate_stats_t stats;
+} indicate;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: bt_indicate_on_connect
+********************************************************************************
+* Summary:
+*  Starts sending on a new connection. Values not confirmed on the previous
+*  connection are sent again first.
+*
+* Parameters:
+*  uint16_t conn_id : Connection ID
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_indicate_on_connect(uint16_t conn_id)
+{
+    indicate.conn_id = conn_id;
+
+    /* Wake up the BT task without changing its notification value */
+    xTaskNotify(bt_task_handle, NOTIFIY_OFF, eNoAction);
+}
+
+/*******************************************************************************
+* Function Name: bt_indicate_on_disconnect
+********************************************************************************
+* Summary:
+*  Stops sending. The queued values, including the one in flight, are kept
+*  for the next connection.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_indicate_on_disconnect(void)
+{
+    taskENTER_CRITICAL();
+    indicate.conn_id = 0U;
+    if (indicate.in_flight)
+    {
+        indicate.entries[indicate.first].resend = true;
+        indicate.in_flight = false;
+    }
+    indicate.timed_out = false;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: bt_indicate_enable
+********************************************************************************
+* Summary:
+*  Follows the client characteristic configuration of the indicated
+*  characteristic.
+*
+* Parameters:
+*  bool enabled : true when the client enabled the indications
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_indicate_enable(bool enabled)
+{
+    indicate.enabled = enabled;
+
+    /* Wake up the BT task without changing its notification value */
+    xTaskNotify(bt_task_handle, NOTIFIY_OFF, eNoAction);
+}
+
+/*******************************************************************************
+* Function Name: bt_indicate_on_confirm
+********************************************************************************
+* Summary:
+*  Removes the confirmed value from the queue and records the round-trip
+*  time. Called from the GATT_HANDLE_VALUE_CONF request.
+*
+* Parameters:
+*  uint16_t handle : Handle of the confirmed attribute
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_indicate_on_confirm(uint16_t handle)
+{
+    uint32_t rtt_ms;
+    bool confirmed = false;
+
+    taskENTER_CRITICAL();
+    if (indicate.in_flight &&
+            (handle == indicate.entries[indicate.first].handle))
+    {
+        rtt_ms = (uint32_t) ((xTaskGetTickCount() - indicate.sent_tick) *
+                             portTICK_PERIOD_MS);
+        indicate.first = (indicate.first + 1U) % BT_INDICATE_QUEUE_LENGTH;
+        indicate.count--;
+        indicate.in_flight = false;
+
+        indicate.stats.confirmed++;
+        indicate.stats.pending = indicate.count;
+        indicate.stats.rtt_last_ms = rtt_ms;
+        indicate.stats.rtt_sum_ms += rtt_ms;
+        if ((1U == indicate.stats.confirmed) ||
+                (rtt_ms < indicate.stats.rtt_min_ms))
+        {
+            indicate.stats.rtt_min_ms = rtt_ms;
+        }
+        if (rtt_ms > indicate.stats.rtt_max_ms)
+        {
+            indicate.stats.rtt_max_ms = rtt_ms;
+        }
+        confirmed = true;
+    }
+    taskEXIT_CRITICAL();
+
+    if (confirmed)
+    {
+        bt_bond_on_delivered();
+
+        /* Wake up the BT task to send the next value */
+        xTaskNotify(bt_task_handle, NOTIFIY_OFF, eNoAction);
+    }
+}
+
+/*******************************************************************************
+* Function Name: bt_indicate_queue
+********************************************************************************
+* Summary:
+*  Queues a copy of a value for indication. When the queue is full, the
+*  oldest value that is not in flight is dropped. The caller checks that
+*  the client enabled the indication.
+*
+* Parameters:
+*  uint16_t handle       : Value handle
+*  const uint8_t *p_val  : Value
+*  uint16_t len          : Value length, at most BT_INDICATE_VALUE_MAX
+*
+* Return:
+*  bool: true when the value was queued
+*
+*******************************************************************************/
+bool bt_indicate_queue(uint16_t handle, const uint8_t *p_val, uint16_t len)
+{
+    bt_indicate_entry_t *p_entry;
+
+    if (len > BT_INDICATE_VALUE_MAX)
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    if (BT_INDICATE_QUEUE_LENGTH == indicate.count)
+    {
+        /* Drop the oldest value; the one in flight stays at the front */
+        uint32_t drop = indicate.in_flight ?
+                ((indicate.first + 1U) % BT_INDICATE_QUEUE_LENGTH) :
+                indicate.first;
+
+        while (drop != indicate.first)
+        {
+            uint32_t prev = (drop + BT_INDICATE_QUEUE_LENGTH - 1U) %
+                            BT_INDICATE_QUEUE_LENGTH;
+
+            indicate.entries[drop] = indicate.entries[prev];
+            drop = prev;
+        }
+        indicate.first = (indicate.first + 1U) % BT_INDICATE_QUEUE_LENGTH;
+        indicate.count--;
+        indicate.stats.dropped++;
+    }
+
+    p_entry = &indicate.entries[(indicate.first + indicate.count) %
+                                BT_INDICATE_QUEUE_LENGTH];
+    p_entry->handle = handle;
+    p_entry->len = len;
+    p_entry->resend = false;
+    memcpy(p_entry->value, p_val, len);
+    indicate.count++;
+
+    indicate.stats.queued++;
+    indicate.stats.pending = indicate.count;
+    taskEXIT_CRITICAL();
+
+    /* Wake up the BT task without changing its notification value */
+    xTaskNotify(bt_task_handle, NOTIFIY_OFF, eNoAction);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: bt_indicate_process
+********************************************************************************
+* Summary:
+*  Sends the oldest queued value once the previous one is confirmed; ATT
+*  allows one indication in flight per connection. Closes the link when the
+*  confirmation does not arrive within BT_INDICATE_TIMEOUT_MS. Called from
+*  the BT task only.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  TickType_t: Ticks until the function needs to run again
+*
+*******************************************************************************/
+TickType_t bt_indicate_process(void)
+{
+    TickType_t timeout_ticks = pdMS_TO_TICKS(BT_INDICATE_TIMEOUT_MS);
+    TickType_t retry_ticks = pdMS_TO_TICKS(BT_INDICATE_RETRY_MS);
+    TickType_t now = xTaskGetTickCount();
+    uint16_t conn_id = indicate.conn_id;
+    bt_indicate_entry_t entry;
+    uint8_t *p_data;
+
+    if ((0U == conn_id) || !indicate.enabled || indicate.timed_out ||
+            (0U == indicate.count))
+    {
+        return portMAX_DELAY;
+    }
+
+    if (indicate.in_flight)
+    {
+        TickType_t elapsed = now - indicate.sent_tick;
+
+        if (elapsed < timeout_ticks)
+        {
+            return timeout_ticks - elapsed;
+        }
+
+        /* ATT allows no further indication on this connection. Close it;
+         * the value is sent again after the client reconnects. */
+        taskENTER_CRITICAL();
+        indicate.stats.timeouts++;
+        taskEXIT_CRITICAL();
+        indicate.timed_out = true;
+        printf("Indication not confirmed in %u ms, disconnecting\r\n",
+               (unsigned int) BT_INDICATE_TIMEOUT_MS);
+        (void) wiced_bt_gatt_disconnect(conn_id);
+        return portMAX_DELAY;
+    }
+
+    if ((now - indicate.retry_tick) < retry_ticks)
+    {
+        return retry_ticks - (now - indicate.retry_tick);
+    }
+
+    /* The stack keeps the buffer until the indication is transmitted */
+    p_data = bt_app_alloc_buffer(BT_INDICATE_VALUE_MAX);
+    if (NULL == p_data)
+    {
+        indicate.retry_tick = now;
+        return retry_ticks;
+    }
+
+    /* Marked in flight before sending, as the confirmation can arrive
+     * before the call returns, and so that a full queue keeps it */
+    taskENTER_CRITICAL();
+    entry = indicate.entries[indicate.first];
+    indicate.sent_tick = now;
+    indicate.in_flight = true;
+    taskEXIT_CRITICAL();
+    memcpy(p_data, entry.value, entry.len);
+
+    if (WICED_BT_GATT_SUCCESS != wiced_bt_gatt_server_send_indication(
+            conn_id, entry.handle, entry.len, p_data,
+            (void *) bt_app_free_buffer))
+    {
+        bt_app_free_buffer(p_data);
+        taskENTER_CRITICAL();
+        indicate.in_flight = false;
+        taskEXIT_CRITICAL();
+        indicate.retry_tick = now;
+        return retry_ticks;
+    }
+
+    taskENTER_CRITICAL();
+    indicate.stats.sent++;
+    if (entry.resend)
+    {
+        indicate.stats.retransmitted++;
+    }
+    taskEXIT_CRITICAL();
+
+    return timeout_ticks;
+}
+
+/*******************************************************************************
+* Function Name: bt_indicate_get_stats
+********************************************************************************
+* Summary:
+*  Returns the indication counters.
+*
+* Parameters:
+*  bt_indicate_stats_t *p_stats : Destination
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_indicate_get_stats(bt_indicate_stats_t *p_stats)
+{
+    taskENTER_CRITICAL();
+    *p_stats = indicate.stats;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: bt_indicate_print_stats
+********************************************************************************
+* Summary:
+*  Prints the indication counters and round-trip times.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_indicate_print_stats(void)
+{
+    bt_indicate_stats_t stats;
+
+    bt_indicate_get_stats(&stats);
+
+    printf("Indications: %lu queued, %lu sent, %lu confirmed, %lu resent, "
+           "%lu timeouts, %lu dropped, %lu pending\r\n",
+           (unsigned long) stats.queued, (unsigned long) stats.sent,
+           (unsigned long) stats.confirmed,
+           (unsigned long) stats.retransmitted,
+           (unsigned long) stats.timeouts, (unsigned long) stats.dropped,
+           (unsigned long) stats.pending);
+    printf("Indication RTT: %lu ms last, %lu ms min, %lu ms avg, "
+           "%lu ms max\r\n", (unsigned long) stats.rtt_last_ms,
+           (unsigned long) stats.rtt_min_ms,
+           (unsigned long) ((0U != stats.confirmed) ?
+                   (stats.rtt_sum_ms / stats.confirmed) : 0U),
+           (unsigned long) stats.rtt_max_ms);
+}
+
+/* [] END OF FILE */
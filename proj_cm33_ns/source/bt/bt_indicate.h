@@ -0,0 +1,101 @@
+/*******************************************************************************
+* File Name: bt_indicate.h
+*
+* Description: This file contains the declarations of the indication queue.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef BT_INDICATE_H
+#define BT_INDICATE_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Values waiting for confirmation, including the one in flight */
+#define BT_INDICATE_QUEUE_LENGTH            (16U)
+
+/* Largest value that can be queued, room for the extended payload */
+#define BT_INDICATE_VALUE_MAX               (16U)
+
+/* Time the client has to confirm an indication. The link is closed when it
+ * expires, and the value is sent again on the next connection. */
+#define BT_INDICATE_TIMEOUT_MS              (5000U)
+
+/* Retry after the stack refused an indication */
+#define BT_INDICATE_RETRY_MS                (20U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Indication counters */
+typedef struct
+{
+    uint32_t queued;            /* Values handed to the queue */
+    uint32_t sent;              /* Indications accepted by the stack */
+    uint32_t confirmed;         /* Confirmations received */
+    uint32_t retransmitted;     /* Values sent again after a disconnection */
+    uint32_t timeouts;          /* Confirmations not received in time */
+    uint32_t dropped;           /* Values lost because the queue was full */
+    uint32_t pending;           /* Values not yet confirmed */
+    uint32_t rtt_last_ms;       /* Round-trip time of the last indication */
+    uint32_t rtt_min_ms;
+    uint32_t rtt_max_ms;
+    uint32_t rtt_sum_ms;
+} bt_indicate_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void bt_indicate_on_connect(uint16_t conn_id);
+void bt_indicate_on_disconnect(void);
+void bt_indicate_enable(bool enabled);
+void bt_indicate_on_confirm(uint16_t handle);
+bool bt_indicate_queue(uint16_t handle, const uint8_t *p_val, uint16_t len);
+TickType_t bt_indicate_process(void);
+void bt_indicate_get_stats(bt_indicate_stats_t *p_stats);
+void bt_indicate_print_stats(void);
+
+#endif /* BT_INDICATE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,381 @@
+/*******************************************************************************
+* File Name: bt_link.c
+*
+* Description: This file negotiates the LE 2M PHY and the maximum LL data
+*              length on every connection and tracks the outcome, so that the
+*              streaming features know the air throughput of the link.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "bt_app.h"
+#include "bt_link.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Maximum LL payload and the matching TX time on an uncoded PHY */
+#define DLE_MAX_TX_OCTETS                   (251U)
+#define DLE_MAX_TX_TIME_US                  (2120U)
+
+/* Time to wait for the PHY and data length update events. A peer that does
+ * not answer keeps the 1M PHY and the 27 byte payload. */
+#define NEGOTIATION_TIMEOUT_MS              (2000U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* State of the link layer negotiation */
+static struct
+{
+    bool connected;
+    wiced_bt_device_address_t bd_addr;
+    TickType_t request_tick;        /* Time of the pending request */
+    bt_link_info_t info;
+} link;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: bt_link_print
+********************************************************************************
+* Summary:
+*  Prints the link layer properties of the current connection.
+*******************************************************************************/
+static void bt_link_print(void)
+{
+    static const char * const state_names[] =
+    {
+        [BT_LINK_NEGOTIATION_IDLE]     = "not requested",
+        [BT_LINK_NEGOTIATION_PENDING]  = "pending",
+        [BT_LINK_NEGOTIATION_DONE]     = "accepted",
+        [BT_LINK_NEGOTIATION_FALLBACK] = "fallback",
+    };
+    bt_link_info_t info;
+
+    bt_link_get_info(&info);
+
+    printf("Bluetooth link: TX %dM RX %dM PHY (%s), "
+           "TX %d RX %d octets (%s)\r\n",
+           info.tx_phy, info.rx_phy, state_names[info.phy_state],
+           info.max_tx_octets, info.max_rx_octets,
+           state_names[info.dle_state]);
+}
+
+/*******************************************************************************
+* Function Name: bt_link_request_data_length
+********************************************************************************
+* Summary:
+*  Requests the maximum LL data length. Called once the PHY negotiation is
+*  complete, so that the peer handles one LL procedure at a time. The
+*  caller has ended the PHY negotiation in a critical section, so only one
+*  of the stack callbacks and the BT task gets here per connection.
+*******************************************************************************/
+static void bt_link_request_data_length(void)
+{
+    wiced_bt_device_address_t bd_addr;
+    wiced_result_t result;
+
+    /* Pending before the request, so an early event is not missed */
+    taskENTER_CRITICAL();
+    memcpy(bd_addr, link.bd_addr, sizeof(bd_addr));
+    link.info.dle_state = BT_LINK_NEGOTIATION_PENDING;
+    link.request_tick = xTaskGetTickCount();
+    taskEXIT_CRITICAL();
+
+    result = wiced_bt_ble_set_data_packet_length(bd_addr,
+            DLE_MAX_TX_OCTETS, DLE_MAX_TX_TIME_US);
+
+    if (WICED_BT_SUCCESS != result)
+    {
+        printf("Data length request failed: 0x%x\r\n", result);
+        taskENTER_CRITICAL();
+        if (BT_LINK_NEGOTIATION_PENDING == link.info.dle_state)
+        {
+            link.info.dle_state = BT_LINK_NEGOTIATION_FALLBACK;
+        }
+        taskEXIT_CRITICAL();
+        bt_link_print();
+    }
+}
+
+/*******************************************************************************
+* Function Name: bt_link_on_connect
+********************************************************************************
+* Summary:
+*  Resets the link properties and requests the 2M PHY for both directions.
+*
+* Parameters:
+*  wiced_bt_device_address_t bd_addr : Address of the connected peer
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_link_on_connect(wiced_bt_device_address_t bd_addr)
+{
+    wiced_bt_ble_phy_preferences_t phy_preferences;
+    wiced_result_t result;
+    bool request_data_length = false;
+
+    taskENTER_CRITICAL();
+    memset(&link, 0, sizeof(link));
+    memcpy(link.bd_addr, bd_addr, sizeof(wiced_bt_device_address_t));
+    link.connected = true;
+    link.info.tx_phy = BT_LINK_PHY_1M;
+    link.info.rx_phy = BT_LINK_PHY_1M;
+    link.info.max_tx_octets = BT_LINK_DEFAULT_OCTETS;
+    link.info.max_rx_octets = BT_LINK_DEFAULT_OCTETS;
+    link.info.phy_state = BT_LINK_NEGOTIATION_PENDING;
+    link.request_tick = xTaskGetTickCount();
+    taskEXIT_CRITICAL();
+
+    /* Prefer 2M, allow 1M for peers without 2M support */
+    memcpy(phy_preferences.remote_bd_addr, bd_addr,
+           sizeof(wiced_bt_device_address_t));
+    phy_preferences.tx_phys = BTM_BLE_PREFER_2M_PHY | BTM_BLE_PREFER_1M_PHY;
+    phy_preferences.rx_phys = BTM_BLE_PREFER_2M_PHY | BTM_BLE_PREFER_1M_PHY;
+    phy_preferences.phy_opts = BTM_BLE_PREFER_NO_LELR;
+
+    result = wiced_bt_ble_set_phy(&phy_preferences);
+
+    if (WICED_BT_SUCCESS != result)
+    {
+        /* Stay on 1M and continue with the data length */
+        printf("2M PHY request failed: 0x%x\r\n", result);
+        taskENTER_CRITICAL();
+        if (BT_LINK_NEGOTIATION_PENDING == link.info.phy_state)
+        {
+            link.info.phy_state = BT_LINK_NEGOTIATION_FALLBACK;
+            request_data_length = true;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    if (request_data_length)
+    {
+        bt_link_request_data_length();
+    }
+}
+
+/*******************************************************************************
+* Function Name: bt_link_on_disconnect
+********************************************************************************
+* Summary:
+*  Prints the outcome of the negotiation of the closed connection.
+*******************************************************************************/
+void bt_link_on_disconnect(void)
+{
+    bool connected;
+
+    taskENTER_CRITICAL();
+    connected = link.connected;
+    link.connected = false;
+    taskEXIT_CRITICAL();
+
+    if (connected)
+    {
+        bt_link_print();
+    }
+}
+
+/*******************************************************************************
+* Function Name: bt_link_on_phy_update
+********************************************************************************
+* Summary:
+*  Records the PHY selected by the controllers and starts the data length
+*  negotiation.
+*
+* Parameters:
+*  wiced_bt_ble_phy_update_t *p_update : PHY update event data
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_link_on_phy_update(wiced_bt_ble_phy_update_t *p_update)
+{
+    bool request_data_length = false;
+
+    /* Print the updated BLE physical link */
+    printf("Bluetooth phy update selected TX - %dM\r\n"
+           "Bluetooth phy update selected RX - %dM\r\n",
+           p_update->tx_phy,
+           p_update->rx_phy);
+
+    taskENTER_CRITICAL();
+    if (link.connected)
+    {
+        if (WICED_BT_SUCCESS == p_update->status)
+        {
+            link.info.tx_phy = p_update->tx_phy;
+            link.info.rx_phy = p_update->rx_phy;
+        }
+
+        /* The peer may also start a PHY update of its own, and a late
+         * answer after the timeout finds the negotiation already ended */
+        if (BT_LINK_NEGOTIATION_PENDING == link.info.phy_state)
+        {
+            link.info.phy_state = ((BT_LINK_PHY_2M == link.info.tx_phy) &&
+                    (BT_LINK_PHY_2M == link.info.rx_phy)) ?
+                    BT_LINK_NEGOTIATION_DONE : BT_LINK_NEGOTIATION_FALLBACK;
+            request_data_length = true;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if (request_data_length)
+    {
+        bt_link_request_data_length();
+    }
+}
+
+/*******************************************************************************
+* Function Name: bt_link_on_data_length_update
+********************************************************************************
+* Summary:
+*  Records the LL data length in effect on the connection.
+*
+* Parameters:
+*  wiced_bt_ble_phy_data_length_update_t *p_update : Data length event data
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_link_on_data_length_update(
+        wiced_bt_ble_phy_data_length_update_t *p_update)
+{
+    bool connected;
+
+    taskENTER_CRITICAL();
+    connected = link.connected;
+    if (connected)
+    {
+        link.info.max_tx_octets = p_update->max_tx_octets;
+        link.info.max_rx_octets = p_update->max_rx_octets;
+
+        if (BT_LINK_NEGOTIATION_PENDING == link.info.dle_state)
+        {
+            link.info.dle_state =
+                    (p_update->max_tx_octets > BT_LINK_DEFAULT_OCTETS) ?
+                    BT_LINK_NEGOTIATION_DONE : BT_LINK_NEGOTIATION_FALLBACK;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if (connected)
+    {
+        bt_link_print();
+    }
+}
+
+/*******************************************************************************
+* Function Name: bt_link_process
+********************************************************************************
+* Summary:
+*  Falls back to the default PHY or data length when the peer did not answer
+*  a request in time. Called from the BT task. The state changes in a
+*  critical section, since the answers arrive in the stack callbacks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  TickType_t: Ticks until the next timeout, portMAX_DELAY if none
+*
+*******************************************************************************/
+TickType_t bt_link_process(void)
+{
+    TickType_t timeout = pdMS_TO_TICKS(NEGOTIATION_TIMEOUT_MS);
+    TickType_t wait = portMAX_DELAY;
+    bool request_data_length = false;
+    bool dle_fallback = false;
+
+    taskENTER_CRITICAL();
+    if (link.connected &&
+            ((BT_LINK_NEGOTIATION_PENDING == link.info.phy_state) ||
+             (BT_LINK_NEGOTIATION_PENDING == link.info.dle_state)))
+    {
+        TickType_t elapsed = xTaskGetTickCount() - link.request_tick;
+
+        if (elapsed < timeout)
+        {
+            wait = timeout - elapsed;
+        }
+        else if (BT_LINK_NEGOTIATION_PENDING == link.info.phy_state)
+        {
+            link.info.phy_state = BT_LINK_NEGOTIATION_FALLBACK;
+            request_data_length = true;
+            wait = timeout;
+        }
+        else
+        {
+            link.info.dle_state = BT_LINK_NEGOTIATION_FALLBACK;
+            dle_fallback = true;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if (request_data_length)
+    {
+        bt_link_request_data_length();
+    }
+    if (dle_fallback)
+    {
+        bt_link_print();
+    }
+
+    return wait;
+}
+
+/*******************************************************************************
+* Function Name: bt_link_get_info
+********************************************************************************
+* Summary:
+*  Returns the link layer properties of the current connection.
+*******************************************************************************/
+void bt_link_get_info(bt_link_info_t *p_info)
+{
+    taskENTER_CRITICAL();
+    *p_info = link.info;
+    taskEXIT_CRITICAL();
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,96 @@
+/*******************************************************************************
+* File Name: bt_link.h
+*
+* Description: This file is the public interface of bt_link.c
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef BT_LINK_H
+#define BT_LINK_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "wiced_bt_dev.h"
+#include "wiced_bt_ble.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* LL payload size and PHY in effect before any negotiation */
+#define BT_LINK_DEFAULT_OCTETS              (27U)
+#define BT_LINK_PHY_1M                      (1U)
+#define BT_LINK_PHY_2M                      (2U)
+
+/*******************************************************************************
+* Global Constants
+*******************************************************************************/
+/* Outcome of a link layer negotiation */
+typedef enum
+{
+    BT_LINK_NEGOTIATION_IDLE,       /* Not requested on this connection */
+    BT_LINK_NEGOTIATION_PENDING,    /* Requested, waiting for the event */
+    BT_LINK_NEGOTIATION_DONE,       /* Peer accepted the requested value */
+    BT_LINK_NEGOTIATION_FALLBACK,   /* Peer refused, default value kept */
+} bt_link_negotiation_t;
+
+/* Link layer properties of the current connection */
+typedef struct
+{
+    uint8_t tx_phy;                         /* TX PHY, BT_LINK_PHY_xx */
+    uint8_t rx_phy;                         /* RX PHY, BT_LINK_PHY_xx */
+    uint16_t max_tx_octets;                 /* LL TX payload size */
+    uint16_t max_rx_octets;                 /* LL RX payload size */
+    bt_link_negotiation_t phy_state;        /* 2M PHY negotiation outcome */
+    bt_link_negotiation_t dle_state;        /* DLE negotiation outcome */
+} bt_link_info_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void bt_link_on_connect(wiced_bt_device_address_t bd_addr);
+void bt_link_on_disconnect(void);
+void bt_link_on_phy_update(wiced_bt_ble_phy_update_t *p_update);
+void bt_link_on_data_length_update(
+        wiced_bt_ble_phy_data_length_update_t *p_update);
+TickType_t bt_link_process(void);
+void bt_link_get_info(bt_link_info_t *p_info);
+
+#endif /* BT_LINK_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,499 @@
+/*******************************************************************************
+* File Name: bt_notify.c
+*
+* Description: This file queues the outgoing notifications and sends them as
+*              the stack accepts them.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "bt_app.h"
+#include "bt_notify.h"
+#include "bt_bond.h"
+#include "bt_gatt_rec.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Notifications handed to the stack and not yet transmitted. More would
+ * only wait in the stack, where they can no longer be coalesced. */
+#define BT_NOTIFY_IN_FLIGHT_MAX             (3U)
+
+/* Retry after the stack refused a notification, in case no transmitted
+ * event follows */
+#define BT_NOTIFY_RETRY_MS                  (20U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Queued value, allocated with bt_app_alloc_buffer() */
+typedef struct
+{
+    uint8_t *p_data;
+    uint16_t len;
+} bt_notify_entry_t;
+
+/* Values of one characteristic, oldest first */
+typedef struct
+{
+    uint8_t first;
+    uint8_t count;
+    bt_notify_entry_t entries[BT_NOTIFY_DEPTH_MAX];
+} bt_notify_ring_t;
+
+/* Constant attributes of the queued characteristics */
+typedef struct
+{
+    uint16_t handle;
+    uint8_t policy;
+    uint8_t depth;
+} bt_notify_char_t;
+
+#define BT_NOTIFY_CHAR(name, handle, policy, depth)                           \
+    { (handle), (policy), (depth) },
+
+static const bt_notify_char_t bt_notify_chars[BT_NOTIFY_CHAR_COUNT] =
+{
+    BT_NOTIFY_TABLE(BT_NOTIFY_CHAR)
+};
+
+#undef BT_NOTIFY_CHAR
+
+/* Queue state. Values are queued by the BT, BT stack and diagnostics tasks
+ * and sent by the BT task only; the rings and counters are changed in
+ * critical sections. */
+static struct
+{
+    volatile uint16_t conn_id;
+    volatile bool congested;        /* Stack refused the last send */
+    TickType_t congested_tick;
+    uint32_t next;                  /* Characteristic to send first */
+    bt_notify_ring_t rings[BT_NOTIFY_CHAR_COUNT];
+    bt_notify_stats_t stats;
+} notify;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: bt_notify_find
+********************************************************************************
+* Summary:
+*  Returns the identifier of a characteristic, or BT_NOTIFY_CHAR_COUNT.
+*******************************************************************************/
+static uint32_t bt_notify_find(uint16_t handle)
+{
+    uint32_t id = 0U;
+
+    while ((id < BT_NOTIFY_CHAR_COUNT) &&
+           (handle != bt_notify_chars[id].handle))
+    {
+        id++;
+    }
+
+    return id;
+}
+
+/*******************************************************************************
+* Function Name: bt_notify_take
+********************************************************************************
+* Summary:
+*  Removes the oldest value of the next characteristic with waiting values.
+*  The characteristics take turns. The caller owns the value buffer.
+*
+* Parameters:
+*  uint32_t *p_id              : Characteristic of the value
+*  bt_notify_entry_t *p_entry  : Value
+*
+* Return:
+*  bool: false when no value is waiting
+*
+*******************************************************************************/
+static bool bt_notify_take(uint32_t *p_id, bt_notify_entry_t *p_entry)
+{
+    bool found = false;
+
+    taskENTER_CRITICAL();
+    for (uint32_t i = 0U; !found && (i < BT_NOTIFY_CHAR_COUNT); i++)
+    {
+        uint32_t id = (notify.next + i) % BT_NOTIFY_CHAR_COUNT;
+        bt_notify_ring_t *p_ring = &notify.rings[id];
+
+        if (0U != p_ring->count)
+        {
+            *p_entry = p_ring->entries[p_ring->first];
+            p_ring->first = (uint8_t) ((p_ring->first + 1U) %
+                                       bt_notify_chars[id].depth);
+            p_ring->count--;
+            notify.next = id + 1U;
+            *p_id = id;
+            found = true;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return found;
+}
+
+/*******************************************************************************
+* Function Name: bt_notify_put_back
+********************************************************************************
+* Summary:
+*  Returns a value the stack refused to the front of its queue. If newer
+*  values filled the queue in the meantime, or the connection is gone, the
+*  value is dropped.
+*
+* Parameters:
+*  uint32_t id                      : Characteristic of the value
+*  const bt_notify_entry_t *p_entry : Value
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void bt_notify_put_back(uint32_t id, const bt_notify_entry_t *p_entry)
+{
+    bt_notify_ring_t *p_ring = &notify.rings[id];
+    uint8_t depth = bt_notify_chars[id].depth;
+    bool kept = false;
+
+    taskENTER_CRITICAL();
+    if ((0U != notify.conn_id) && (p_ring->count < depth))
+    {
+        p_ring->first = (uint8_t) ((p_ring->first + depth - 1U) % depth);
+        p_ring->entries[p_ring->first] = *p_entry;
+        p_ring->count++;
+        kept = true;
+    }
+    else if (BT_NOTIFY_LATEST == bt_notify_chars[id].policy)
+    {
+        notify.stats.coalesced++;
+    }
+    else
+    {
+        notify.stats.dropped++;
+    }
+    taskEXIT_CRITICAL();
+
+    if (!kept)
+    {
+        bt_app_free_buffer(p_entry->p_data);
+    }
+}
+
+/*******************************************************************************
+* Function Name: bt_notify_transmitted
+********************************************************************************
+* Summary:
+*  Buffer release function of the queued notifications, called through the
+*  context of GATT_APP_BUFFER_TRANSMITTED_EVT.
+*******************************************************************************/
+static void bt_notify_transmitted(uint8_t *p_data)
+{
+    bt_app_free_buffer(p_data);
+
+    taskENTER_CRITICAL();
+    if (0U != notify.stats.in_flight)
+    {
+        notify.stats.in_flight--;
+    }
+    taskEXIT_CRITICAL();
+
+    bt_bond_on_delivered();
+}
+
+/*******************************************************************************
+* Function Name: bt_notify_on_connect
+********************************************************************************
+* Summary:
+*  Starts queuing for a new connection.
+*
+* Parameters:
+*  uint16_t conn_id : Connection ID
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_notify_on_connect(uint16_t conn_id)
+{
+    notify.congested = false;
+    notify.stats.in_flight = 0U;
+    notify.conn_id = conn_id;
+}
+
+/*******************************************************************************
+* Function Name: bt_notify_on_disconnect
+********************************************************************************
+* Summary:
+*  Stops queuing and drops the waiting values.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_notify_on_disconnect(void)
+{
+    bt_notify_entry_t entry;
+    uint32_t id;
+
+    notify.conn_id = 0U;
+
+    while (bt_notify_take(&id, &entry))
+    {
+        bt_app_free_buffer(entry.p_data);
+    }
+}
+
+/*******************************************************************************
+* Function Name: bt_notify_on_buffer_transmitted
+********************************************************************************
+* Summary:
+*  Called for every GATT_APP_BUFFER_TRANSMITTED_EVT. The stack has a free
+*  buffer again, so the BT task resumes sending.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_notify_on_buffer_transmitted(void)
+{
+    notify.congested = false;
+
+    /* Wake up the BT task without changing its notification value */
+    xTaskNotify(bt_task_handle, NOTIFIY_OFF, eNoAction);
+}
+
+/*******************************************************************************
+* Function Name: bt_notify_queue
+********************************************************************************
+* Summary:
+*  Queues a copy of a value for notification. A full queue replaces its
+*  newest value (BT_NOTIFY_LATEST) or drops its oldest (BT_NOTIFY_FIFO).
+*  The caller checks that the client enabled the notification.
+*
+* Parameters:
+*  uint16_t handle       : Value handle from BT_NOTIFY_TABLE
+*  const uint8_t *p_val  : Value
+*  uint16_t len          : Value length
+*
+* Return:
+*  bool: true when the value was queued
+*
+*******************************************************************************/
+bool bt_notify_queue(uint16_t handle, const uint8_t *p_val, uint16_t len)
+{
+    uint32_t id = bt_notify_find(handle);
+    uint8_t *p_discard = NULL;
+    bt_notify_entry_t entry;
+    bt_notify_ring_t *p_ring;
+    uint8_t depth;
+
+    if ((BT_NOTIFY_CHAR_COUNT == id) || (0U == notify.conn_id))
+    {
+        return false;
+    }
+
+    entry.p_data = bt_app_alloc_buffer(len);
+    entry.len = len;
+    if (NULL == entry.p_data)
+    {
+        taskENTER_CRITICAL();
+        notify.stats.dropped++;
+        taskEXIT_CRITICAL();
+        return false;
+    }
+    memcpy(entry.p_data, p_val, len);
+
+    p_ring = &notify.rings[id];
+    depth = bt_notify_chars[id].depth;
+
+    taskENTER_CRITICAL();
+    notify.stats.queued++;
+    if (p_ring->count < depth)
+    {
+        p_ring->entries[(p_ring->first + p_ring->count) % depth] = entry;
+        p_ring->count++;
+    }
+    else if (BT_NOTIFY_LATEST == bt_notify_chars[id].policy)
+    {
+        /* Replace the newest value */
+        uint32_t newest = (p_ring->first + p_ring->count - 1U) % depth;
+
+        p_discard = p_ring->entries[newest].p_data;
+        p_ring->entries[newest] = entry;
+        notify.stats.coalesced++;
+    }
+    else
+    {
+        /* Drop the oldest value */
+        p_discard = p_ring->entries[p_ring->first].p_data;
+        p_ring->entries[p_ring->first] = entry;
+        p_ring->first = (uint8_t) ((p_ring->first + 1U) % depth);
+        notify.stats.dropped++;
+    }
+    taskEXIT_CRITICAL();
+
+    if (NULL != p_discard)
+    {
+        bt_app_free_buffer(p_discard);
+    }
+
+    /* Wake up the BT task without changing its notification value */
+    xTaskNotify(bt_task_handle, NOTIFIY_OFF, eNoAction);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: bt_notify_process
+********************************************************************************
+* Summary:
+*  Sends the waiting values while the stack accepts them. When the stack
+*  refuses one, sending pauses until a buffer is transmitted or the retry
+*  time has passed. Called from the BT task only.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  TickType_t: Ticks until the function needs to run again
+*
+*******************************************************************************/
+TickType_t bt_notify_process(void)
+{
+    TickType_t retry_ticks = pdMS_TO_TICKS(BT_NOTIFY_RETRY_MS);
+    bt_notify_entry_t entry;
+    uint32_t id;
+
+    if (notify.congested)
+    {
+        TickType_t elapsed = xTaskGetTickCount() - notify.congested_tick;
+
+        if (elapsed < retry_ticks)
+        {
+            return retry_ticks - elapsed;
+        }
+        notify.congested = false;
+    }
+
+    while ((notify.stats.in_flight < BT_NOTIFY_IN_FLIGHT_MAX) &&
+           bt_notify_take(&id, &entry))
+    {
+        if (WICED_BT_GATT_SUCCESS != wiced_bt_gatt_server_send_notification(
+                notify.conn_id, bt_notify_chars[id].handle, entry.len,
+                entry.p_data, (void *) bt_notify_transmitted))
+        {
+            notify.congested_tick = xTaskGetTickCount();
+            notify.congested = true;
+
+            taskENTER_CRITICAL();
+            notify.stats.congested++;
+            taskEXIT_CRITICAL();
+
+            bt_notify_put_back(id, &entry);
+            return retry_ticks;
+        }
+
+        taskENTER_CRITICAL();
+        notify.stats.sent++;
+        notify.stats.in_flight++;
+        if (notify.stats.in_flight > notify.stats.in_flight_max)
+        {
+            notify.stats.in_flight_max = notify.stats.in_flight;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    return portMAX_DELAY;
+}
+
+/*******************************************************************************
+* Function Name: bt_notify_get_stats
+********************************************************************************
+* Summary:
+*  Returns the queue counters.
+*
+* Parameters:
+*  bt_notify_stats_t *p_stats : Destination
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_notify_get_stats(bt_notify_stats_t *p_stats)
+{
+    taskENTER_CRITICAL();
+    *p_stats = notify.stats;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: bt_notify_print_stats
+********************************************************************************
+* Summary:
+*  Prints the queue counters.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_notify_print_stats(void)
+{
+    bt_notify_stats_t stats;
+
+    bt_notify_get_stats(&stats);
+
+    printf("Notifications: %lu queued, %lu sent, %lu coalesced, %lu dropped, "
+           "%lu refused, %lu in flight (max %lu)\r\n",
+           (unsigned long) stats.queued, (unsigned long) stats.sent,
+           (unsigned long) stats.coalesced, (unsigned long) stats.dropped,
+           (unsigned long) stats.congested, (unsigned long) stats.in_flight,
+           (unsigned long) stats.in_flight_max);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,115 @@
+/*******************************************************************************
+* File Name: bt_notify.h
+*
+* Description: This file is the public interface of bt_notify.c
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef BT_NOTIFY_H
+#define BT_NOTIFY_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cycfg_gatt_db.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Queue policies */
+#define BT_NOTIFY_LATEST                    (0U)    /* Newest value wins */
+#define BT_NOTIFY_FIFO                      (1U)    /* All values in order */
+
+/* Characteristics sent through the queue.
+ *   name   : BT_NOTIFY_CHAR_<name> identifier
+ *   handle : Value handle
+ *   policy : BT_NOTIFY_LATEST replaces the waiting value with a new one,
+ *            BT_NOTIFY_FIFO keeps up to depth values and drops the oldest
+ *   depth  : Values that can wait, 1 for BT_NOTIFY_LATEST
+ * X(name, handle, policy, depth) */
+#define BT_NOTIFY_TABLE(X)                                                    \
+    X(BUTTON, HDLC_CAPSENSE_BUTTON_VALUE, BT_NOTIFY_FIFO, 8U)                 \
+    X(SLIDER, HDLC_CAPSENSE_SLIDER_VALUE, BT_NOTIFY_LATEST, 1U)               \
+    X(DIAGNOSTICS, HDLC_CAPSENSE_DIAGNOSTICS_VALUE, BT_NOTIFY_FIFO, 8U)
+
+/* Largest depth in the table */
+#define BT_NOTIFY_DEPTH_MAX                 (8U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+#define BT_NOTIFY_CHAR_ID(name, handle, policy, depth)                        \
+    BT_NOTIFY_CHAR_##name,
+
+/* Queued characteristic identifiers, in table order */
+typedef enum
+{
+    BT_NOTIFY_TABLE(BT_NOTIFY_CHAR_ID)
+    BT_NOTIFY_CHAR_COUNT
+} bt_notify_char_id_t;
+
+#undef BT_NOTIFY_CHAR_ID
+
+/* Queue counters */
+typedef struct
+{
+    uint32_t queued;            /* Values handed to the queue */
+    uint32_t sent;              /* Values accepted by the stack */
+    uint32_t coalesced;         /* Values replaced by a newer one */
+    uint32_t dropped;           /* Values lost because the queue was full */
+    uint32_t congested;         /* Sends refused by the stack */
+    uint32_t in_flight;         /* Values the stack has not yet sent */
+    uint32_t in_flight_max;
+} bt_notify_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void bt_notify_on_connect(uint16_t conn_id);
+void bt_notify_on_disconnect(void);
+void bt_notify_on_buffer_transmitted(void);
+bool bt_notify_queue(uint16_t handle, const uint8_t *p_val, uint16_t len);
+TickType_t bt_notify_process(void);
+void bt_notify_get_stats(bt_notify_stats_t *p_stats);
+void bt_notify_print_stats(void);
+
+#endif /* BT_NOTIFY_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,425 @@
+/*******************************************************************************
+* File Name: bt_periodic.c
+*
+* Description: This file contains the touch telemetry sent over LE periodic
+*              advertising. Touch events are batched, time stamped and published in
+*              the periodic advertising data of a non-connectable extended advertising
+*              set, so synchronised observers receive them without connecting.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "cycfg_gap.h"
+#include "wiced_bt_ble.h"
+#include "bt_app.h"
+#include "bt_adv.h"
+#include "bt_periodic.h"
+
+#if defined(BT_PERIODIC_ADV)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Advertising set used for the telemetry. The legacy advertisements use the
+ * default set. */
+#define EXT_ADV_HANDLE                      (1U)
+#define EXT_ADV_SID                         (1U)
+
+/* Interval of the extended advertisements that point observers to the
+ * periodic train, in 0.625 ms units (1 s) */
+#define EXT_ADV_INTERVAL                    (1600U)
+
+#define EXT_ADV_EVENT_NONCONN_NONSCAN       (0U)
+#define EXT_ADV_TX_POWER_NO_PREFERENCE      (127)
+#define EXT_ADV_SECONDARY_MAX_SKIP          (0U)
+#define EXT_ADV_SCAN_REQ_NOTIFY_DISABLE     (0U)
+#define EXT_ADV_DATA_MAX                    (64U)
+
+/* Periodic advertising interval in 1.25 ms units */
+#define PERIODIC_ADV_INTERVAL               ((BT_PERIODIC_INTERVAL_MS * 4U) / 5U)
+#define PERIODIC_ADV_PROPERTIES             (0U)
+#define PERIODIC_ADV_ENABLE                 (1U)
+
+/* Length and type byte of the AD structure */
+#define AD_HEADER_SIZE                      (2U)
+
+#define EVENT_AGE_MAX                       (0xFFFFU)
+#define PERCENT_SCALE                       (100U)
+#define MS_PER_SECOND                       (1000U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Time stamped touch event */
+typedef struct
+{
+    uint32_t tick;
+    uint8_t sensor;
+    uint8_t event;
+    uint8_t position;
+} bt_periodic_record_t;
+
+/* Latest events. Every payload carries the whole window, so an observer
+ * that misses a periodic event still gets the events in the next one. */
+static struct
+{
+    bt_periodic_record_t ring[BT_PERIODIC_EVENTS_MAX];
+    uint32_t head;              /* Events published, also the next sequence */
+    uint32_t sent_head;         /* head of the last payload */
+    TickType_t update_tick;     /* Time of the last payload */
+    bool started;
+} periodic;
+
+/* Payload utilisation and update rate */
+static struct
+{
+    uint32_t updates;
+    uint32_t bytes;
+    uint32_t lost;
+    TickType_t start_tick;
+} periodic_stats;
+
+static uint8_t periodic_data[BT_PERIODIC_DATA_MAX];
+static uint8_t ext_adv_data[EXT_ADV_DATA_MAX];
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: bt_periodic_pack
+********************************************************************************
+* Summary:
+*  Builds the periodic advertising data from the event window.
+*
+* Parameters:
+*  uint32_t now       : Payload time in ms
+*  uint32_t *p_head   : Returns the event count included in the payload
+*
+* Return:
+*  uint16_t: Payload length
+*
+*******************************************************************************/
+static uint16_t bt_periodic_pack(uint32_t now, uint32_t *p_head)
+{
+    uint8_t *p = &periodic_data[AD_HEADER_SIZE + BT_PERIODIC_HEADER_SIZE];
+    uint32_t head;
+    uint32_t count;
+    uint32_t first;
+    uint16_t len;
+
+    taskENTER_CRITICAL();
+    head = periodic.head;
+    count = MIN(head, BT_PERIODIC_EVENTS_MAX);
+    first = head - count;
+
+    for (uint32_t i = first; i != head; i++)
+    {
+        const bt_periodic_record_t *p_rec =
+                &periodic.ring[i % BT_PERIODIC_EVENTS_MAX];
+        uint32_t age = MIN(now - p_rec->tick, EVENT_AGE_MAX);
+
+        *p++ = (uint8_t) age;
+        *p++ = (uint8_t) (age >> 8U);
+        *p++ = p_rec->sensor;
+        *p++ = p_rec->event;
+        *p++ = p_rec->position;
+    }
+    taskEXIT_CRITICAL();
+
+    len = (uint16_t) (p - periodic_data);
+    periodic_data[0] = (uint8_t) (len - 1U);
+    periodic_data[1] = BTM_BLE_ADVERT_TYPE_MANUFACTURER;
+    periodic_data[2] = (uint8_t) BT_ADV_COMPANY_ID;
+    periodic_data[3] = (uint8_t) (BT_ADV_COMPANY_ID >> 8U);
+    periodic_data[4] = BT_PERIODIC_RECORD_TYPE_EVENTS;
+    periodic_data[5] = (uint8_t) first;
+    periodic_data[6] = (uint8_t) (first >> 8U);
+    periodic_data[7] = (uint8_t) now;
+    periodic_data[8] = (uint8_t) (now >> 8U);
+    periodic_data[9] = (uint8_t) (now >> 16U);
+    periodic_data[10] = (uint8_t) (now >> 24U);
+    periodic_data[11] = (uint8_t) count;
+
+    *p_head = head;
+    return len;
+}
+
+/*******************************************************************************
+* Function Name: bt_periodic_init
+********************************************************************************
+* Summary:
+*  Creates a non-connectable extended advertising set that carries the
+*  device name and starts periodic advertising on it. A controller without
+*  support for the extended advertising commands is reported on the console
+*  and the telemetry stays off.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_periodic_init(void)
+{
+    wiced_bt_device_address_t peer_addr = {0U};
+    wiced_bt_ble_ext_adv_duration_config_t duration =
+    {
+        .adv_handle = EXT_ADV_HANDLE,
+        .adv_duration = 0U,
+        .max_ext_adv_events = 0U,
+    };
+    uint16_t name_len = (uint16_t) MIN(strlen((const char *)
+            app_gap_device_name), EXT_ADV_DATA_MAX - AD_HEADER_SIZE);
+    uint32_t head;
+    uint16_t len;
+
+    if (WICED_BT_SUCCESS != wiced_bt_ble_set_ext_adv_parameters(
+            EXT_ADV_HANDLE, EXT_ADV_EVENT_NONCONN_NONSCAN,
+            EXT_ADV_INTERVAL, EXT_ADV_INTERVAL,
+            BTM_BLE_DEFAULT_ADVERT_CHNL_MAP, BLE_ADDR_PUBLIC,
+            BLE_ADDR_PUBLIC, peer_addr,
+            BTM_BLE_ADV_POLICY_ACCEPT_CONN_AND_SCAN,
+            EXT_ADV_TX_POWER_NO_PREFERENCE, BTM_BLE_PREFER_1M_PHY,
+            EXT_ADV_SECONDARY_MAX_SKIP, BTM_BLE_PREFER_1M_PHY,
+            EXT_ADV_SID, EXT_ADV_SCAN_REQ_NOTIFY_DISABLE))
+    {
+        printf("Extended advertising not supported, telemetry off\r\n");
+        return;
+    }
+
+    /* Observers find the train by the name in the extended advertisements */
+    ext_adv_data[0] = (uint8_t) (name_len + 1U);
+    ext_adv_data[1] = BTM_BLE_ADVERT_TYPE_NAME_COMPLETE;
+    memcpy(&ext_adv_data[AD_HEADER_SIZE], app_gap_device_name, name_len);
+    (void) wiced_bt_ble_set_ext_adv_data(EXT_ADV_HANDLE,
+            AD_HEADER_SIZE + name_len, ext_adv_data);
+
+    len = bt_periodic_pack(xTaskGetTickCount(), &head);
+    if ((WICED_BT_SUCCESS != wiced_bt_ble_set_periodic_adv_params(
+                EXT_ADV_HANDLE, PERIODIC_ADV_INTERVAL, PERIODIC_ADV_INTERVAL,
+                PERIODIC_ADV_PROPERTIES)) ||
+            (WICED_BT_SUCCESS != wiced_bt_ble_set_periodic_adv_data(
+                EXT_ADV_HANDLE, len, periodic_data)) ||
+            (WICED_BT_SUCCESS != wiced_bt_ble_start_periodic_adv(
+                EXT_ADV_HANDLE, PERIODIC_ADV_ENABLE)) ||
+            (WICED_BT_SUCCESS != wiced_bt_ble_start_ext_adv(
+                WICED_TRUE, 1U, &duration)))
+    {
+        printf("Failed to start periodic advertising\r\n");
+        return;
+    }
+
+    printf("Periodic advertising: %u ms interval, %u events per payload\r\n",
+           BT_PERIODIC_INTERVAL_MS, BT_PERIODIC_EVENTS_MAX);
+
+    periodic.sent_head = head;
+    periodic.update_tick = xTaskGetTickCount();
+    periodic_stats.start_tick = periodic.update_tick;
+    periodic.started = true;
+}
+
+/*******************************************************************************
+* Function Name: bt_periodic_publish
+********************************************************************************
+* Summary:
+*  Queues the touch, release and move events between two sensor states and
+*  wakes up the BT task. Called by the CapSense task. When the window is
+*  full, the oldest event is dropped.
+*
+* Parameters:
+*  const capsense_state_t *p_prev : Previous sensor state
+*  const capsense_state_t *p_cur  : Current sensor state
+*  uint32_t events                : capsense_model_events() of the states
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_periodic_publish(const capsense_state_t *p_prev,
+                         const capsense_state_t *p_cur, uint32_t events)
+{
+    uint32_t released = p_prev->touched & ~p_cur->touched;
+    uint32_t tick = xTaskGetTickCount();
+
+    if (!periodic.started || (0U == (events | released)))
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    for (uint32_t id = 0U; id < CAPSENSE_SENSOR_COUNT; id++)
+    {
+        uint32_t mask = 1UL << id;
+        bt_periodic_record_t *p_rec;
+
+        if (0U == ((events | released) & mask))
+        {
+            continue;
+        }
+
+        p_rec = &periodic.ring[periodic.head % BT_PERIODIC_EVENTS_MAX];
+        p_rec->tick = tick;
+        p_rec->sensor = (uint8_t) id;
+        p_rec->position = p_cur->position[capsense_sensors.slot[id]];
+
+        if (0U != (released & mask))
+        {
+            p_rec->event = BT_PERIODIC_EVENT_RELEASE;
+        }
+        else if (0U != (p_prev->touched & mask))
+        {
+            p_rec->event = BT_PERIODIC_EVENT_MOVE;
+        }
+        else
+        {
+            p_rec->event = BT_PERIODIC_EVENT_TOUCH;
+        }
+        periodic.head++;
+    }
+    taskEXIT_CRITICAL();
+
+    xTaskNotify(bt_task_handle, NOTIFIY_OFF, eNoAction);
+}
+
+/*******************************************************************************
+* Function Name: bt_periodic_process
+********************************************************************************
+* Summary:
+*  Publishes new events in the periodic advertising data, at most once per
+*  periodic advertising interval, since the controller only sends the
+*  latest data. Called from the BT task.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  TickType_t: Ticks until pending events can be published
+*
+*******************************************************************************/
+TickType_t bt_periodic_process(void)
+{
+    TickType_t now = xTaskGetTickCount();
+    TickType_t elapsed = now - periodic.update_tick;
+    uint32_t head;
+    uint16_t len;
+
+    if (!periodic.started || (periodic.head == periodic.sent_head))
+    {
+        return portMAX_DELAY;
+    }
+
+    if (elapsed < pdMS_TO_TICKS(BT_PERIODIC_INTERVAL_MS))
+    {
+        return pdMS_TO_TICKS(BT_PERIODIC_INTERVAL_MS) - elapsed;
+    }
+
+    len = bt_periodic_pack(now, &head);
+    if (WICED_BT_SUCCESS != wiced_bt_ble_set_periodic_adv_data(
+            EXT_ADV_HANDLE, len, periodic_data))
+    {
+        /* Publish the window again with the next interval */
+        return pdMS_TO_TICKS(BT_PERIODIC_INTERVAL_MS);
+    }
+
+    /* Events that left the window before they were published */
+    if ((head - periodic.sent_head) > BT_PERIODIC_EVENTS_MAX)
+    {
+        periodic_stats.lost += head - periodic.sent_head -
+                BT_PERIODIC_EVENTS_MAX;
+    }
+    periodic.sent_head = head;
+
+    periodic.update_tick = now;
+    periodic_stats.updates++;
+    periodic_stats.bytes += len;
+
+    return portMAX_DELAY;
+}
+
+/*******************************************************************************
+* Function Name: bt_periodic_print_stats
+********************************************************************************
+* Summary:
+*  Prints the payload updates, the achieved update rate, the average use of
+*  the periodic advertising payload and the events lost before publishing.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_periodic_print_stats(void)
+{
+    uint32_t updates = periodic_stats.updates;
+    uint32_t elapsed_ms = xTaskGetTickCount() - periodic_stats.start_tick;
+    uint32_t rate = 0U;
+    uint32_t utilisation = 0U;
+
+    if (!periodic.started)
+    {
+        return;
+    }
+
+    /* Updates per second in hundredths, payload use in percent */
+    if (0U != elapsed_ms)
+    {
+        rate = (uint32_t) (((uint64_t) updates * MS_PER_SECOND *
+                            PERCENT_SCALE) / elapsed_ms);
+    }
+    if (0U != updates)
+    {
+        utilisation = (uint32_t) (((uint64_t) periodic_stats.bytes *
+                PERCENT_SCALE) / ((uint64_t) updates * BT_PERIODIC_DATA_MAX));
+    }
+
+    printf("Periodic adv: %lu updates, %lu.%02lu updates/s, payload %lu%% "
+           "of %u bytes, %lu events, %lu lost\r\n",
+           (unsigned long) updates, (unsigned long) (rate / PERCENT_SCALE),
+           (unsigned long) (rate % PERCENT_SCALE),
+           (unsigned long) utilisation,
+           BT_PERIODIC_DATA_MAX, (unsigned long) periodic.head,
+           (unsigned long) periodic_stats.lost);
+}
+
+#endif /* defined(BT_PERIODIC_ADV) */
+
+/* [] END OF FILE */
@@ -0,0 +1,98 @@
+/*******************************************************************************
+* File Name: bt_periodic.h
+*
+* Description: This file contains the declarations of the touch telemetry sent
+*              over LE periodic advertising.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+#ifndef BT_PERIODIC_H
+#define BT_PERIODIC_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "capsense_model.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Periodic advertising interval. Every periodic event carries the latest
+ * payload, so it is also the maximum update rate. */
+#define BT_PERIODIC_INTERVAL_MS             (100U)
+
+/* Periodic advertising data that fits one HCI command */
+#define BT_PERIODIC_DATA_MAX                (252U)
+
+/* Manufacturer data: company ID (u16), record type, sequence number of the
+ * first event (u16), payload time in ms (u32) and event count (u8) */
+#define BT_PERIODIC_RECORD_TYPE_EVENTS      (0x02U)
+#define BT_PERIODIC_HEADER_SIZE             (10U)
+
+/* Event: age relative to the payload time in ms (u16), sensor ID (u8),
+ * event type (u8) and position in percent (u8) */
+#define BT_PERIODIC_EVENT_SIZE              (5U)
+
+/* Events in one payload, after the AD structure length and type */
+#define BT_PERIODIC_EVENTS_MAX              ((BT_PERIODIC_DATA_MAX - 2U - \
+                                              BT_PERIODIC_HEADER_SIZE) / \
+                                              BT_PERIODIC_EVENT_SIZE)
+
+/*******************************************************************************
+* Global Constants
+*******************************************************************************/
+/* Touch event types */
+typedef enum
+{
+    BT_PERIODIC_EVENT_TOUCH = 1,    /* Sensor touched */
+    BT_PERIODIC_EVENT_RELEASE,      /* Sensor released */
+    BT_PERIODIC_EVENT_MOVE,         /* Slider or touchpad position changed */
+} bt_periodic_event_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+#if defined(BT_PERIODIC_ADV)
+void bt_periodic_init(void);
+void bt_periodic_publish(const capsense_state_t *p_prev,
+                         const capsense_state_t *p_cur, uint32_t events);
+TickType_t bt_periodic_process(void);
+void bt_periodic_print_stats(void);
+#endif
+
+#endif /* BT_PERIODIC_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,537 @@
+/*******************************************************************************
+* File Name: bt_stream.c
+*
+* Description: This file contains the CapSense streaming characteristic. Raw
+*              samples are time stamped, queued and packed into MTU sized
+*              notifications that carry a sequence number, so that a client can
+*              detect lost notifications.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "cycfg_gatt_db.h"
+#include "bt_app.h"
+#include "bt_link.h"
+#include "bt_stream.h"
+#include "bt_gatt_rec.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of samples that can wait for transmission */
+#define STREAM_RING_SIZE                    (128U)
+
+/* Send a partially filled notification once its oldest sample is this old */
+#define STREAM_MAX_LATENCY_MS               (50U)
+
+#define STREAM_LOST_MAX                     (0xFFU)
+
+#if defined(BT_STREAM_BENCHMARK)
+/* Simulated link used by the benchmark */
+#define BENCH_CONN_INTERVAL_US              (7500U)
+#define BENCH_DURATION_US                   (10000000UL)
+#define BENCH_IFS_US                        (150U)
+#define BENCH_L2CAP_HEADER_SIZE             (4U)
+#define BENCH_US_PER_MS                     (1000U)
+#define BENCH_US_PER_SEC                    (1000000UL)
+#endif /* defined(BT_STREAM_BENCHMARK) */
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Time stamped raw sample waiting for transmission */
+typedef struct
+{
+    uint32_t tick;
+    uint8_t data[BT_STREAM_SAMPLE_SIZE];
+} bt_stream_sample_t;
+
+/* Stream state. The CapSense task produces, the BT task consumes. */
+static struct
+{
+    volatile bool enabled;
+    uint16_t mtu;
+    uint16_t sequence;
+    uint8_t lost;                       /* Samples dropped since last send */
+    volatile uint32_t head;             /* Next slot to write */
+    volatile uint32_t tail;             /* Next slot to send */
+    bt_stream_sample_t ring[STREAM_RING_SIZE];
+} stream =
+{
+    .mtu = BT_STREAM_DEFAULT_MTU,
+};
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: bt_stream_samples_per_notification
+********************************************************************************
+* Summary:
+*  Returns how many samples fit into one notification at the current MTU.
+*******************************************************************************/
+static uint32_t bt_stream_samples_per_notification(void)
+{
+    return (stream.mtu - BT_STREAM_ATT_HEADER_SIZE - BT_STREAM_HEADER_SIZE) /
+            BT_STREAM_RECORD_SIZE;
+}
+
+/*******************************************************************************
+* Function Name: bt_stream_count
+********************************************************************************
+* Summary:
+*  Returns the number of queued samples.
+*******************************************************************************/
+static uint32_t bt_stream_count(void)
+{
+    return stream.head - stream.tail;
+}
+
+/*******************************************************************************
+* Function Name: bt_stream_put
+********************************************************************************
+* Summary:
+*  Queues one sample. When the queue is full, the oldest sample is dropped
+*  and reported in the next notification.
+*
+* Parameters:
+*  uint32_t tick          : Sample time in ms
+*  const uint8_t *p_data  : BT_STREAM_SAMPLE_SIZE bytes of sample data
+*
+* Return:
+*  uint32_t: Number of queued samples
+*
+*******************************************************************************/
+static uint32_t bt_stream_put(uint32_t tick, const uint8_t *p_data)
+{
+    uint32_t count;
+
+    taskENTER_CRITICAL();
+    if (STREAM_RING_SIZE == bt_stream_count())
+    {
+        stream.tail++;
+        if (STREAM_LOST_MAX > stream.lost)
+        {
+            stream.lost++;
+        }
+    }
+
+    bt_stream_sample_t *p_sample = &stream.ring[stream.head % STREAM_RING_SIZE];
+    p_sample->tick = tick;
+    memcpy(p_sample->data, p_data, BT_STREAM_SAMPLE_SIZE);
+    stream.head++;
+    count = bt_stream_count();
+    taskEXIT_CRITICAL();
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: bt_stream_pack
+********************************************************************************
+* Summary:
+*  Packs as many queued samples as fit into one notification. The samples
+*  stay queued until bt_stream_commit() is called, so a notification that
+*  could not be sent is rebuilt later.
+*
+* Parameters:
+*  uint8_t *p_buf     : Notification buffer of at least MTU - 3 bytes
+*  uint32_t *p_count  : Number of packed samples
+*
+* Return:
+*  uint16_t: Length of the notification
+*
+*******************************************************************************/
+static uint16_t bt_stream_pack(uint8_t *p_buf, uint32_t *p_count)
+{
+    uint32_t count;
+    uint32_t tail;
+    uint32_t first_tick;
+    uint8_t *p = p_buf + BT_STREAM_HEADER_SIZE;
+
+    taskENTER_CRITICAL();
+    tail = stream.tail;
+    count = MIN(bt_stream_count(), bt_stream_samples_per_notification());
+    first_tick = stream.ring[tail % STREAM_RING_SIZE].tick;
+
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        const bt_stream_sample_t *p_sample =
+                &stream.ring[(tail + i) % STREAM_RING_SIZE];
+        uint16_t offset = (uint16_t) (p_sample->tick - first_tick);
+
+        *p++ = (uint8_t) offset;
+        *p++ = (uint8_t) (offset >> 8U);
+        memcpy(p, p_sample->data, BT_STREAM_SAMPLE_SIZE);
+        p += BT_STREAM_SAMPLE_SIZE;
+    }
+
+    p_buf[0] = (uint8_t) stream.sequence;
+    p_buf[1] = (uint8_t) (stream.sequence >> 8U);
+    p_buf[2] = (uint8_t) first_tick;
+    p_buf[3] = (uint8_t) (first_tick >> 8U);
+    p_buf[4] = (uint8_t) (first_tick >> 16U);
+    p_buf[5] = (uint8_t) (first_tick >> 24U);
+    p_buf[6] = (uint8_t) count;
+    p_buf[7] = stream.lost;
+    taskEXIT_CRITICAL();
+
+    *p_count = count;
+    return (uint16_t) (p - p_buf);
+}
+
+/*******************************************************************************
+* Function Name: bt_stream_commit
+********************************************************************************
+* Summary:
+*  Removes the samples of a sent notification from the queue.
+*******************************************************************************/
+static void bt_stream_commit(uint32_t count)
+{
+    taskENTER_CRITICAL();
+    stream.tail += count;
+    stream.sequence++;
+    stream.lost = 0U;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: bt_stream_set_mtu
+********************************************************************************
+* Summary:
+*  Sets the ATT MTU negotiated on the connection.
+*******************************************************************************/
+void bt_stream_set_mtu(uint16_t mtu)
+{
+    stream.mtu = MAX(mtu, (uint16_t) BT_STREAM_DEFAULT_MTU);
+}
+
+/*******************************************************************************
+* Function Name: bt_stream_enable
+********************************************************************************
+* Summary:
+*  Starts or stops the stream. Starting it discards old samples and restarts
+*  the sequence numbers.
+*******************************************************************************/
+void bt_stream_enable(bool enable)
+{
+    taskENTER_CRITICAL();
+    stream.tail = stream.head;
+    stream.sequence = 0U;
+    stream.lost = 0U;
+    stream.enabled = enable;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: bt_stream_is_enabled
+********************************************************************************
+* Summary:
+*  Returns true while a client is subscribed to the stream.
+*******************************************************************************/
+bool bt_stream_is_enabled(void)
+{
+    return stream.enabled;
+}
+
+/*******************************************************************************
+* Function Name: bt_stream_push
+********************************************************************************
+* Summary:
+*  Queues one raw sample, time stamped with the current tick. Called by the
+*  CapSense task. Wakes up the BT task once a notification is full.
+*
+* Parameters:
+*  const uint8_t *p_sample : BT_STREAM_SAMPLE_SIZE bytes of raw data
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_stream_push(const uint8_t *p_sample)
+{
+    if (!stream.enabled)
+    {
+        return;
+    }
+
+    if (bt_stream_put(xTaskGetTickCount(), p_sample) >=
+            bt_stream_samples_per_notification())
+    {
+        xTaskNotify(bt_task_handle, NOTIFIY_OFF, eNoAction);
+    }
+}
+
+/*******************************************************************************
+* Function Name: bt_stream_process
+********************************************************************************
+* Summary:
+*  Sends full notifications, and partial ones whose oldest sample reached
+*  the latency limit. Called from the BT task. Samples stay queued when the
+*  stack has no buffer left, and are sent on the next call.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  TickType_t: Ticks until queued samples reach the latency limit
+*
+*******************************************************************************/
+TickType_t bt_stream_process(void)
+{
+    TickType_t max_latency = pdMS_TO_TICKS(STREAM_MAX_LATENCY_MS);
+
+    if (!stream.enabled || (0U == bt_connection_id))
+    {
+        return portMAX_DELAY;
+    }
+
+    while (0U != bt_stream_count())
+    {
+        TickType_t age = xTaskGetTickCount() -
+                stream.ring[stream.tail % STREAM_RING_SIZE].tick;
+        uint32_t count;
+        uint8_t *p_buf;
+        uint16_t len;
+
+        if ((bt_stream_count() < bt_stream_samples_per_notification()) &&
+                (age < max_latency))
+        {
+            return max_latency - age;
+        }
+
+        /* The buffer is freed by the stack once it has been transmitted */
+        p_buf = bt_app_alloc_buffer(stream.mtu - BT_STREAM_ATT_HEADER_SIZE);
+        if (NULL == p_buf)
+        {
+            return max_latency;
+        }
+
+        len = bt_stream_pack(p_buf, &count);
+        if (WICED_BT_GATT_SUCCESS != wiced_bt_gatt_server_send_notification(
+                bt_connection_id, HDLC_CAPSENSE_STREAM_VALUE, len, p_buf,
+                (void *) bt_app_free_buffer))
+        {
+            /* Stack congested, retry with the next wakeup */
+            bt_app_free_buffer(p_buf);
+            return max_latency;
+        }
+
+        bt_stream_commit(count);
+    }
+
+    return portMAX_DELAY;
+}
+
+#if defined(HOT_PATH_BENCHMARK)
+/*******************************************************************************
+* Function Name: bt_stream_bench_pack
+********************************************************************************
+* Summary:
+*  Assembles one full notification for the hot path benchmark. The samples
+*  are queued on the first call and stay queued, so later calls only time
+*  the assembly. bt_stream_enable(false) drops them.
+*
+* Parameters:
+*  uint8_t *p_buf : Buffer of the ATT MTU size
+*
+* Return:
+*  uint16_t: Notification length
+*
+*******************************************************************************/
+uint16_t bt_stream_bench_pack(uint8_t *p_buf)
+{
+    uint8_t sample[BT_STREAM_SAMPLE_SIZE] = {0U};
+    uint32_t count;
+
+    while (bt_stream_count() < bt_stream_samples_per_notification())
+    {
+        (void) bt_stream_put(xTaskGetTickCount(), sample);
+    }
+
+    return bt_stream_pack(p_buf, &count);
+}
+#endif /* defined(HOT_PATH_BENCHMARK) */
+
+#if defined(BT_STREAM_BENCHMARK)
+
+/* Simulated link of one benchmark run */
+typedef struct
+{
+    uint8_t phy;                    /* BT_LINK_PHY_1M or BT_LINK_PHY_2M */
+    uint16_t octets;                /* LL payload size */
+    uint16_t mtu;                   /* ATT MTU */
+} bench_link_t;
+
+/* State of the simulated controller */
+static struct
+{
+    const bench_link_t *p_link;
+    uint64_t now_us;                /* Start of the current event */
+    uint32_t event_used_us;         /* Air time used in the current event */
+    uint32_t events;
+    uint32_t bytes;
+} bench;
+
+/*******************************************************************************
+* Function Name: bench_pdu_air_time
+********************************************************************************
+* Summary:
+*  Returns the air time of one LL data PDU from the peripheral including the
+*  empty PDU of the central and both inter frame spaces.
+*******************************************************************************/
+static uint32_t bench_pdu_air_time(uint16_t payload)
+{
+    /* Preamble, access address, header and CRC: 10 bytes on 1M, 11 on 2M.
+     * The empty PDU of the central takes 80 us on 1M and 44 us on 2M. */
+    uint32_t tx_us = (BT_LINK_PHY_2M == bench.p_link->phy) ?
+            ((11U + payload) * 4U) : ((10U + payload) * 8U);
+    uint32_t rx_us = (BT_LINK_PHY_2M == bench.p_link->phy) ? 44U : 80U;
+
+    return tx_us + BENCH_IFS_US + rx_us + BENCH_IFS_US;
+}
+
+/*******************************************************************************
+* Function Name: bench_send_notification
+********************************************************************************
+* Summary:
+*  Stand-in for the Bluetooth stack: fragments one notification into LL PDUs
+*  and places them into connection events of the simulated link.
+*******************************************************************************/
+static void bench_send_notification(uint16_t len)
+{
+    uint32_t remaining = len + BT_STREAM_ATT_HEADER_SIZE +
+            BENCH_L2CAP_HEADER_SIZE;
+
+    while (0U != remaining)
+    {
+        uint16_t payload = (uint16_t) MIN(remaining, bench.p_link->octets);
+        uint32_t air_us = bench_pdu_air_time(payload);
+
+        if ((bench.event_used_us + air_us) > BENCH_CONN_INTERVAL_US)
+        {
+            /* The PDU does not fit, continue in the next event */
+            bench.now_us += BENCH_CONN_INTERVAL_US;
+            bench.event_used_us = 0U;
+            bench.events++;
+        }
+
+        bench.event_used_us += air_us;
+        remaining -= payload;
+    }
+
+    bench.bytes += len;
+}
+
+/*******************************************************************************
+* Function Name: bt_stream_benchmark
+********************************************************************************
+* Summary:
+*  Measures the sustained sample rate of the stream over simulated links.
+*  Samples are produced as fast as the link takes them and packed by the
+*  same code as on a real connection. Prints samples per second, payload
+*  bytes per connection event and CPU cycles per notification.
+*******************************************************************************/
+void bt_stream_benchmark(void)
+{
+    static const bench_link_t links[] =
+    {
+        { BT_LINK_PHY_1M, BT_LINK_DEFAULT_OCTETS, BT_STREAM_DEFAULT_MTU },
+        { BT_LINK_PHY_1M, 251U, 247U },
+        { BT_LINK_PHY_2M, BT_LINK_DEFAULT_OCTETS, BT_STREAM_DEFAULT_MTU },
+        { BT_LINK_PHY_2M, 251U, 247U },
+    };
+    static uint8_t buf[CY_BT_RX_PDU_SIZE];
+    uint8_t sample[BT_STREAM_SAMPLE_SIZE] = {0U};
+
+    /* Enable the DWT cycle counter */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for (uint32_t i = 0U; i < (sizeof(links) / sizeof(links[0])); i++)
+    {
+        uint32_t samples = 0U;
+        uint32_t notifications = 0U;
+        uint32_t cycles = 0U;
+
+        memset(&bench, 0, sizeof(bench));
+        bench.p_link = &links[i];
+        bt_stream_set_mtu(links[i].mtu);
+        bt_stream_enable(true);
+
+        while (bench.now_us < BENCH_DURATION_US)
+        {
+            uint32_t count;
+            uint32_t start;
+            uint16_t len;
+
+            /* Produce samples at the current simulated time */
+            while (bt_stream_count() < bt_stream_samples_per_notification())
+            {
+                sample[0]++;
+                (void) bt_stream_put((uint32_t) (bench.now_us / BENCH_US_PER_MS),
+                                     sample);
+            }
+
+            start = DWT->CYCCNT;
+            len = bt_stream_pack(buf, &count);
+            bt_stream_commit(count);
+            cycles += DWT->CYCCNT - start;
+
+            bench_send_notification(len);
+            samples += count;
+            notifications++;
+        }
+
+        bt_stream_enable(false);
+
+        printf("stream_bench phy=%dM octets=%d mtu=%d: %lu samples/s, "
+               "%lu bytes/event, %lu cycles/notification\r\n",
+               links[i].phy, links[i].octets, links[i].mtu,
+               (unsigned long) (((uint64_t) samples * BENCH_US_PER_SEC) /
+                                bench.now_us),
+               (unsigned long) (bench.bytes / bench.events),
+               (unsigned long) (cycles / notifications));
+    }
+
+    bt_stream_set_mtu(BT_STREAM_DEFAULT_MTU);
+}
+
+#endif /* defined(BT_STREAM_BENCHMARK) */
+
+/* [] END OF FILE */
@@ -0,0 +1,89 @@
+/*******************************************************************************
+* File Name: bt_stream.h
+*
+* Description: This file is the public interface of bt_stream.c
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef BT_STREAM_H
+#define BT_STREAM_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* CapSense bytes carried by one stream sample: touched sensors (u8) and
+ * slider position (u16) */
+#define BT_STREAM_SAMPLE_SIZE               (3U)
+
+/* Notification header: sequence (u16), first sample time in ms (u32),
+ * sample count (u8) and samples lost before this notification (u8) */
+#define BT_STREAM_HEADER_SIZE               (8U)
+
+/* Sample record: time offset to the first sample in ms (u16) and data */
+#define BT_STREAM_RECORD_SIZE               (2U + BT_STREAM_SAMPLE_SIZE)
+
+/* ATT MTU before the exchange and the ATT notification header size */
+#define BT_STREAM_DEFAULT_MTU               (23U)
+#define BT_STREAM_ATT_HEADER_SIZE           (3U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void bt_stream_set_mtu(uint16_t mtu);
+void bt_stream_enable(bool enable);
+bool bt_stream_is_enabled(void);
+void bt_stream_push(const uint8_t *p_sample);
+TickType_t bt_stream_process(void);
+
+#if defined(BT_STREAM_BENCHMARK)
+void bt_stream_benchmark(void);
+#endif
+
+#if defined(HOT_PATH_BENCHMARK)
+uint16_t bt_stream_bench_pack(uint8_t *p_buf);
+#endif
+
+#endif /* BT_STREAM_H */
+
+/* [] END OF FILE */
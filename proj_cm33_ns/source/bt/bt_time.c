@@ -0,0 +1,125 @@
+/*******************************************************************************
+* File Name: bt_time.c
+*
+* Description: This file implements the device timebase used to timestamp
+*              the touch samples.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "bt_time.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BT_TIME_USEC_PER_SEC                (1000000UL)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static struct
+{
+    mtb_hal_lptimer_t *lptimer;
+    uint32_t last;              /* LPTimer count of the last reading */
+    uint32_t wraps;             /* LPTimer overflows seen */
+} bt_time;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: bt_time_init
+********************************************************************************
+* Summary:
+*  Starts the timebase on the LPTimer of the tickless idle mode, which keeps
+*  counting in Deep Sleep.
+*
+* Parameters:
+*  mtb_hal_lptimer_t *lptimer : LPTimer, set up by the caller
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bt_time_init(mtb_hal_lptimer_t *lptimer)
+{
+    bt_time.lptimer = lptimer;
+    bt_time.last = mtb_hal_lptimer_read(lptimer);
+    bt_time.wraps = 0U;
+}
+
+/*******************************************************************************
+* Function Name: bt_time_now_us
+********************************************************************************
+* Summary:
+*  Returns the device time in microseconds, at the 30.5 us resolution of the
+*  LPTimer. The value wraps after 2^32 us (71.6 minutes). The LPTimer
+*  overflows are counted when the time is read, so it must be read at least
+*  once per overflow period (36.4 hours). Can be called from any task.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Device time in us, or zero before initialization
+*
+*******************************************************************************/
+uint32_t bt_time_now_us(void)
+{
+    uint64_t ticks;
+    uint32_t count;
+
+    if (NULL == bt_time.lptimer)
+    {
+        return 0U;
+    }
+
+    taskENTER_CRITICAL();
+    count = mtb_hal_lptimer_read(bt_time.lptimer);
+    if (count < bt_time.last)
+    {
+        bt_time.wraps++;
+    }
+    bt_time.last = count;
+    ticks = ((uint64_t) bt_time.wraps << 32U) | count;
+    taskEXIT_CRITICAL();
+
+    return (uint32_t) ((ticks * BT_TIME_USEC_PER_SEC) / BT_TIME_LPTIMER_HZ);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,66 @@
+/*******************************************************************************
+* File Name: bt_time.h
+*
+* Description: This file contains the declarations of the device timebase
+*              used to timestamp the touch samples.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef BT_TIME_H
+#define BT_TIME_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include "cybsp.h"
+#include "mtb_hal.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Frequency of the LPTimer the timebase counts */
+#define BT_TIME_LPTIMER_HZ                  (32768U)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void bt_time_init(mtb_hal_lptimer_t *lptimer);
+uint32_t bt_time_now_us(void);
+
+#endif /* BT_TIME_H */
+
+/* [] END OF FILE */
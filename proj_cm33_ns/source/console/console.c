@@ -0,0 +1,731 @@
+/*******************************************************************************
+* File Name: console.c
+*
+* Description: This file implements an interactive command console on the
+*              debug UART. Received characters are moved to the console task
+*              by the UART interrupt; the task edits the line and runs the
+*              commands at the lowest application priority.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION)
+#include <malloc.h>
+#endif
+#include "cybsp.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "retarget_io_init.h"
+#include "console.h"
+#include "bt_app.h"
+#include "bt_bond.h"
+#include "bt_control.h"
+#include "bt_periodic.h"
+#include "bt_gatt_rec.h"
+#include "i2c_capsense.h"
+#include "i2c_recovery.h"
+#include "kv_store.h"
+#include "power_stats.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Longest command line and largest number of words on it */
+#define CONSOLE_LINE_MAX                    (64U)
+#define CONSOLE_ARGS_MAX                    (5U)
+
+/* Characters buffered between the UART interrupt and the console task */
+#define CONSOLE_RX_BUFFER_SIZE              (64U)
+#define CONSOLE_RX_TRIGGER_LEVEL            (1U)
+
+/* Characters moved from the RX FIFO per buffer write */
+#define CONSOLE_RX_CHUNK                    (8U)
+
+/* The console is below everything that calls the stack */
+#define CONSOLE_UART_INTERRUPT_PRIORITY     (7U)
+
+/* Largest value of a control record built by the set command */
+#define CONSOLE_RECORD_VALUE_MAX            (3U)
+
+/* Tasks listed by the tasks command */
+#define CONSOLE_TASKS_MAX                   (16U)
+
+/* Deep sleep is held off for this time after a character was received, so
+ * that a command can be typed. */
+#define CONSOLE_AWAKE_MS                    (10000U)
+
+/* Control characters of the line editor */
+#define CONSOLE_CHAR_BACKSPACE              ('\b')
+#define CONSOLE_CHAR_DELETE                 (0x7FU)
+#define CONSOLE_CHAR_CLEAR_LINE             (0x15U)     /* Ctrl-U */
+
+#define CONSOLE_PROMPT                      "> "
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Command table entry */
+typedef struct
+{
+    const char *name;
+    const char *help;
+    void (*handler)(uint32_t argc, char *argv[]);
+} console_command_t;
+
+/* Parameter of the set command: control record type and the size of
+ * each argument in bytes */
+typedef struct
+{
+    const char *name;
+    uint8_t type;
+    uint8_t arg_size[2];
+} console_param_t;
+
+/* Characters received by the UART interrupt */
+static StreamBufferHandle_t console_rx_buffer;
+
+/* Characters lost because the console task did not keep up */
+static volatile uint32_t console_rx_overruns;
+
+/* Tick of the last received character or wake-up */
+static volatile TickType_t console_rx_tick;
+
+/* Task list of the tasks command */
+static TaskStatus_t console_tasks[CONSOLE_TASKS_MAX];
+
+static void console_cmd_help(uint32_t argc, char *argv[]);
+static void console_cmd_tasks(uint32_t argc, char *argv[]);
+static void console_cmd_heap(uint32_t argc, char *argv[]);
+static void console_cmd_stats(uint32_t argc, char *argv[]);
+static void console_cmd_ble(uint32_t argc, char *argv[]);
+static void console_cmd_trace(uint32_t argc, char *argv[]);
+static void console_cmd_bonds(uint32_t argc, char *argv[]);
+static void console_cmd_get(uint32_t argc, char *argv[]);
+static void console_cmd_set(uint32_t argc, char *argv[]);
+
+static const console_command_t console_commands[] =
+{
+    { "help",  "List the commands",                         console_cmd_help  },
+    { "tasks", "Task states and stack watermarks (words)",  console_cmd_tasks },
+    { "heap",  "Heap use",                                  console_cmd_heap  },
+    { "stats", "Power, sampling, I2C and store statistics", console_cmd_stats },
+    { "ble",   "Connection and notification counters",      console_cmd_ble   },
+    { "trace", "Dump the GATT PDU record",                  console_cmd_trace },
+    { "bonds", "Bonds and reconnection times, or 'clear'",  console_cmd_bonds },
+    { "get",   "Show the runtime parameters",               console_cmd_get   },
+    { "set",   "set <param> <value>..., see 'set' alone",   console_cmd_set   },
+};
+
+static const console_param_t console_params[] =
+{
+    { "sample", BT_CONTROL_SAMPLE_PERIOD,        { 2U, 0U } },
+    { "stream", BT_CONTROL_STREAM_SAMPLE_PERIOD, { 2U, 0U } },
+    { "filter", BT_CONTROL_POSITION_FILTER,      { 1U, 0U } },
+    { "notify", BT_CONTROL_NOTIFY_INTERVAL,      { 2U, 0U } },
+    { "led",    BT_CONTROL_LED_MAP,              { 1U, 1U } },
+    { "diag",   BT_CONTROL_DIAGNOSTICS,          { 2U, 1U } },
+    { "format", BT_CONTROL_PAYLOAD_FORMAT,       { 1U, 0U } },
+};
+
+#if (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP)
+
+static cy_en_syspm_status_t console_syspm_callback(
+        cy_stc_syspm_callback_params_t *callbackParams,
+        cy_en_syspm_callback_mode_t mode);
+
+/* SysPm callback parameter structure for the console */
+static cy_stc_syspm_callback_params_t console_syspm_cb_params =
+{
+    .context            = NULL,
+    .base               = CYBSP_DEBUG_UART_HW
+};
+
+/* SysPm callback structure for the console */
+static cy_stc_syspm_callback_t console_syspm_cb =
+{
+    .callback           = &console_syspm_callback,
+    .skipMode           = SYSPM_SKIP_MODE,
+    .type               = CY_SYSPM_DEEPSLEEP,
+    .callbackParams     = &console_syspm_cb_params,
+    .prevItm            = NULL,
+    .nextItm            = NULL,
+    .order              = SYSPM_CALLBACK_ORDER
+};
+
+#endif /* (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP) */
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: console_uart_isr
+********************************************************************************
+* Summary:
+*  Moves the received characters from the RX FIFO to the console task.
+*******************************************************************************/
+static void console_uart_isr(void)
+{
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    uint8_t chunk[CONSOLE_RX_CHUNK];
+    uint32_t count;
+
+    do
+    {
+        count = Cy_SCB_UART_GetArray(CYBSP_DEBUG_UART_HW, chunk,
+                                     sizeof(chunk));
+        if ((count > 0U) &&
+                (xStreamBufferSendFromISR(console_rx_buffer, chunk, count,
+                                          &higher_priority_task_woken) <
+                 count))
+        {
+            console_rx_overruns++;
+        }
+    } while (sizeof(chunk) == count);
+
+    Cy_SCB_ClearRxInterrupt(CYBSP_DEBUG_UART_HW, CY_SCB_RX_INTR_NOT_EMPTY);
+    console_rx_tick = xTaskGetTickCountFromISR();
+
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+#if (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP)
+
+/*******************************************************************************
+* Function Name: console_wakeup_isr
+********************************************************************************
+* Summary:
+*  Falling edge on the RX pin during deep sleep. The UART does not receive
+*  in deep sleep, so the character that woke the device is lost; the
+*  following ones are received while deep sleep is held off.
+*******************************************************************************/
+static void console_wakeup_isr(void)
+{
+    Cy_GPIO_ClearInterrupt(CYBSP_DEBUG_UART_RX_PORT, CYBSP_DEBUG_UART_RX_PIN);
+    Cy_GPIO_SetInterruptMask(CYBSP_DEBUG_UART_RX_PORT,
+                             CYBSP_DEBUG_UART_RX_PIN, 0U);
+    console_rx_tick = xTaskGetTickCountFromISR();
+}
+
+/*******************************************************************************
+* Function Name: console_syspm_callback
+********************************************************************************
+* Summary:
+*  Holds off deep sleep while a command is typed, and arms the wake-up on
+*  the RX pin for the deep sleep.
+*
+* Parameters:
+*  cy_stc_syspm_callback_params_t *callbackParams : SysPm callback parameters
+*  cy_en_syspm_callback_mode_t mode               : SysPm callback mode
+*
+* Return:
+*  cy_en_syspm_status_t: CY_SYSPM_SUCCESS or CY_SYSPM_FAIL
+*
+*******************************************************************************/
+static cy_en_syspm_status_t console_syspm_callback(
+        cy_stc_syspm_callback_params_t *callbackParams,
+        cy_en_syspm_callback_mode_t mode)
+{
+    cy_en_syspm_status_t retVal = CY_SYSPM_SUCCESS;
+
+    CY_UNUSED_PARAMETER(callbackParams);
+
+    switch (mode)
+    {
+        case CY_SYSPM_CHECK_READY:
+            if ((xTaskGetTickCount() - console_rx_tick) <
+                    pdMS_TO_TICKS(CONSOLE_AWAKE_MS))
+            {
+                retVal = CY_SYSPM_FAIL;
+            }
+            break;
+
+        case CY_SYSPM_CHECK_FAIL:
+            /* Nothing was changed in CHECK_READY, nothing to undo */
+            break;
+
+        case CY_SYSPM_BEFORE_TRANSITION:
+            Cy_GPIO_ClearInterrupt(CYBSP_DEBUG_UART_RX_PORT,
+                                   CYBSP_DEBUG_UART_RX_PIN);
+            Cy_GPIO_SetInterruptMask(CYBSP_DEBUG_UART_RX_PORT,
+                                     CYBSP_DEBUG_UART_RX_PIN, 1U);
+            break;
+
+        case CY_SYSPM_AFTER_TRANSITION:
+            Cy_GPIO_SetInterruptMask(CYBSP_DEBUG_UART_RX_PORT,
+                                     CYBSP_DEBUG_UART_RX_PIN, 0U);
+            break;
+
+        default:
+            retVal = CY_SYSPM_FAIL;
+            break;
+    }
+
+    return retVal;
+}
+
+#endif /* (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP) */
+
+/*******************************************************************************
+* Function Name: console_init
+********************************************************************************
+* Summary:
+*  Creates the receive buffer and enables the RX interrupt of the debug
+*  UART, and the RX pin wake-up from deep sleep.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void console_init(void)
+{
+    cy_stc_sysint_t uart_intr_cfg =
+    {
+        .intrSrc = CYBSP_DEBUG_UART_IRQ,
+        .intrPriority = CONSOLE_UART_INTERRUPT_PRIORITY
+    };
+
+    console_rx_buffer = xStreamBufferCreate(CONSOLE_RX_BUFFER_SIZE,
+                                            CONSOLE_RX_TRIGGER_LEVEL);
+    if (NULL == console_rx_buffer)
+    {
+        handle_app_error();
+    }
+
+    if (CY_SYSINT_SUCCESS != Cy_SysInt_Init(&uart_intr_cfg,
+                                            console_uart_isr))
+    {
+        handle_app_error();
+    }
+
+    Cy_SCB_ClearRxInterrupt(CYBSP_DEBUG_UART_HW, CY_SCB_RX_INTR_NOT_EMPTY);
+    Cy_SCB_SetRxInterruptMask(CYBSP_DEBUG_UART_HW, CY_SCB_RX_INTR_NOT_EMPTY);
+    NVIC_EnableIRQ(uart_intr_cfg.intrSrc);
+
+#if (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP)
+    cy_stc_sysint_t wakeup_intr_cfg =
+    {
+        .intrSrc = CYBSP_DEBUG_UART_RX_IRQ,
+        .intrPriority = CONSOLE_UART_INTERRUPT_PRIORITY
+    };
+
+    if (CY_SYSINT_SUCCESS != Cy_SysInt_Init(&wakeup_intr_cfg,
+                                            console_wakeup_isr))
+    {
+        handle_app_error();
+    }
+
+    Cy_GPIO_SetInterruptEdge(CYBSP_DEBUG_UART_RX_PORT,
+                             CYBSP_DEBUG_UART_RX_PIN, CY_GPIO_INTR_FALLING);
+    NVIC_EnableIRQ(wakeup_intr_cfg.intrSrc);
+
+    Cy_SysPm_RegisterCallback(&console_syspm_cb);
+#endif /* (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP) */
+}
+
+/*******************************************************************************
+* Function Name: console_parse_u32
+********************************************************************************
+* Summary:
+*  Parses a decimal or 0x-prefixed hexadecimal number.
+*******************************************************************************/
+static bool console_parse_u32(const char *p_text, uint32_t *p_value)
+{
+    char *p_end;
+
+    *p_value = (uint32_t) strtoul(p_text, &p_end, 0);
+
+    return ('\0' != *p_text) && ('\0' == *p_end) && ('-' != *p_text);
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_help
+********************************************************************************
+* Summary:
+*  Lists the commands.
+*******************************************************************************/
+static void console_cmd_help(uint32_t argc, char *argv[])
+{
+    CY_UNUSED_PARAMETER(argc);
+    CY_UNUSED_PARAMETER(argv);
+
+    for (uint32_t i = 0U; i < CY_ARRAY_SIZE(console_commands); i++)
+    {
+        printf("  %-6s %s\r\n", console_commands[i].name,
+               console_commands[i].help);
+    }
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_tasks
+********************************************************************************
+* Summary:
+*  Lists the tasks with their state, priority and the least free stack.
+*******************************************************************************/
+static void console_cmd_tasks(uint32_t argc, char *argv[])
+{
+    static const char state_names[] = "XRBSDI";  /* eTaskState order */
+    UBaseType_t count;
+
+    CY_UNUSED_PARAMETER(argc);
+    CY_UNUSED_PARAMETER(argv);
+
+    count = uxTaskGetSystemState(console_tasks, CONSOLE_TASKS_MAX, NULL);
+    if (0U == count)
+    {
+        printf("More than %u tasks\r\n", CONSOLE_TASKS_MAX);
+        return;
+    }
+
+    printf("  %-*s state prio stack\r\n", configMAX_TASK_NAME_LEN,
+           "task");
+    for (UBaseType_t i = 0U; i < count; i++)
+    {
+        printf("  %-*s %c     %-4lu %u\r\n", configMAX_TASK_NAME_LEN,
+               console_tasks[i].pcTaskName,
+               state_names[console_tasks[i].eCurrentState],
+               (unsigned long) console_tasks[i].uxCurrentPriority,
+               (unsigned int) console_tasks[i].usStackHighWaterMark);
+    }
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_heap
+********************************************************************************
+* Summary:
+*  Prints the heap use. The FreeRTOS heap is the C library heap
+*  (heap_3), so the C library statistics cover both.
+*******************************************************************************/
+static void console_cmd_heap(uint32_t argc, char *argv[])
+{
+    CY_UNUSED_PARAMETER(argc);
+    CY_UNUSED_PARAMETER(argv);
+
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION)
+    struct mallinfo info = mallinfo();
+
+    printf("Heap: %lu bytes in use, %lu free, %lu reserved (peak)\r\n",
+           (unsigned long) info.uordblks, (unsigned long) info.fordblks,
+           (unsigned long) info.arena);
+#else
+    printf("Heap statistics are not available with this toolchain\r\n");
+#endif
+    printf("Console: %lu characters lost\r\n",
+           (unsigned long) console_rx_overruns);
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_stats
+********************************************************************************
+* Summary:
+*  Prints the power, sampling, I2C and store statistics.
+*******************************************************************************/
+static void console_cmd_stats(uint32_t argc, char *argv[])
+{
+    CY_UNUSED_PARAMETER(argc);
+    CY_UNUSED_PARAMETER(argv);
+
+    power_stats_print();
+    i2c_recovery_print_stats();
+    i2c_capsense_print_stats();
+    kv_store_print_stats();
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_ble
+********************************************************************************
+* Summary:
+*  Prints the connection state and the notification counters.
+*******************************************************************************/
+static void console_cmd_ble(uint32_t argc, char *argv[])
+{
+    CY_UNUSED_PARAMETER(argc);
+    CY_UNUSED_PARAMETER(argv);
+
+    bt_app_print_stats();
+#if defined(BT_PERIODIC_ADV)
+    bt_periodic_print_stats();
+#endif
+#if defined(BT_GATT_RECORD)
+    bt_gatt_rec_print_stats();
+#endif
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_trace
+********************************************************************************
+* Summary:
+*  Dumps the GATT PDU record.
+*******************************************************************************/
+static void console_cmd_trace(uint32_t argc, char *argv[])
+{
+    CY_UNUSED_PARAMETER(argc);
+    CY_UNUSED_PARAMETER(argv);
+
+#if defined(BT_GATT_RECORD)
+    bt_gatt_rec_dump();
+#else
+    printf("Build with BT_GATT_RECORD to record the GATT PDUs\r\n");
+#endif
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_bonds
+********************************************************************************
+* Summary:
+*  Lists the bonds and the reconnection times, or removes all bonds.
+*******************************************************************************/
+static void console_cmd_bonds(uint32_t argc, char *argv[])
+{
+    if ((argc > 1U) && (0 == strcmp(argv[1], "clear")))
+    {
+        bt_bond_clear();
+        printf("Removing the bonds\r\n");
+    }
+    else
+    {
+        bt_bond_print_stats();
+    }
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_get
+********************************************************************************
+* Summary:
+*  Prints the runtime parameters.
+*******************************************************************************/
+static void console_cmd_get(uint32_t argc, char *argv[])
+{
+    CY_UNUSED_PARAMETER(argc);
+    CY_UNUSED_PARAMETER(argv);
+
+    bt_control_print();
+}
+
+/*******************************************************************************
+* Function Name: console_cmd_set
+********************************************************************************
+* Summary:
+*  Changes a runtime parameter. The arguments are encoded as a control
+*  record, so they are checked, applied and saved exactly like a write to
+*  the control characteristic.
+*******************************************************************************/
+static void console_cmd_set(uint32_t argc, char *argv[])
+{
+    uint8_t record[BT_CONTROL_TLV_HEADER_SIZE + CONSOLE_RECORD_VALUE_MAX];
+    const console_param_t *p_param = NULL;
+    uint32_t len = BT_CONTROL_TLV_HEADER_SIZE;
+    uint32_t arg = 2U;
+    wiced_bt_gatt_status_t status;
+
+    for (uint32_t i = 0U; (argc > 1U) && (i < CY_ARRAY_SIZE(console_params));
+         i++)
+    {
+        if (0 == strcmp(argv[1], console_params[i].name))
+        {
+            p_param = &console_params[i];
+        }
+    }
+
+    if (NULL == p_param)
+    {
+        printf("  set sample <ms> | stream <ms> | filter <0..4> | "
+               "notify <ms>\r\n"
+               "  set led <sensor> <0 on, 1 off, 2 brightness, 255 none>\r\n"
+               "  set diag <ms> <outputs: 1 console, 2 BLE>\r\n"
+               "  set format <0 legacy, 1 extended>\r\n");
+        return;
+    }
+
+    for (uint32_t i = 0U; (i < CY_ARRAY_SIZE(p_param->arg_size)) &&
+         (0U != p_param->arg_size[i]); i++, arg++)
+    {
+        uint32_t value;
+        uint32_t size = p_param->arg_size[i];
+
+        if ((arg >= argc) || !console_parse_u32(argv[arg], &value) ||
+                ((size < sizeof(value)) && ((value >> (8U * size)) != 0U)))
+        {
+            printf("Invalid value\r\n");
+            return;
+        }
+
+        for (uint32_t byte = 0U; byte < size; byte++)
+        {
+            record[len++] = (uint8_t) (value >> (8U * byte));
+        }
+    }
+
+    record[0] = p_param->type;
+    record[1] = (uint8_t) (len - BT_CONTROL_TLV_HEADER_SIZE);
+    status = bt_control_write(record, (uint16_t) len);
+    if (WICED_BT_GATT_SUCCESS != status)
+    {
+        printf("Rejected: 0x%x\r\n", status);
+    }
+}
+
+/*******************************************************************************
+* Function Name: console_execute
+********************************************************************************
+* Summary:
+*  Splits a line into words and runs the command.
+*
+* Parameters:
+*  char *p_line : Command line, modified
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void console_execute(char *p_line)
+{
+    char *argv[CONSOLE_ARGS_MAX];
+    uint32_t argc = 0U;
+    char *p_save;
+
+    for (char *p_word = strtok_r(p_line, " ", &p_save);
+         (NULL != p_word) && (argc < CONSOLE_ARGS_MAX);
+         p_word = strtok_r(NULL, " ", &p_save))
+    {
+        argv[argc++] = p_word;
+    }
+
+    if (0U == argc)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0U; i < CY_ARRAY_SIZE(console_commands); i++)
+    {
+        if (0 == strcmp(argv[0], console_commands[i].name))
+        {
+            console_commands[i].handler(argc, argv);
+            return;
+        }
+    }
+
+    printf("Unknown command '%s', try 'help'\r\n", argv[0]);
+}
+
+/*******************************************************************************
+* Function Name: console_task
+********************************************************************************
+* Summary:
+*  Edits the command line with the received characters and runs each
+*  command when Enter is pressed. Backspace deletes a character and Ctrl-U
+*  the line. The task only waits for characters, so the other tasks are
+*  never delayed by the console.
+*
+* Parameters:
+*  void *param : Task parameter defined during task creation (unused)
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void console_task(void *param)
+{
+    char line[CONSOLE_LINE_MAX];
+    uint32_t len = 0U;
+    uint8_t c;
+    uint8_t prev = 0U;
+
+    /* Suppress warning for unused parameter */
+    CY_UNUSED_PARAMETER(param);
+
+    console_init();
+
+    printf("Console ready, type 'help' and Enter\r\n");
+    printf(CONSOLE_PROMPT);
+    fflush(stdout);
+
+    for (;;)
+    {
+        (void) xStreamBufferReceive(console_rx_buffer, &c, sizeof(c),
+                                    portMAX_DELAY);
+
+        if (('\n' == c) && ('\r' == prev))
+        {
+            /* Second half of a CR LF line end */
+        }
+        else if (('\r' == c) || ('\n' == c))
+        {
+            printf("\r\n");
+            line[len] = '\0';
+            console_execute(line);
+            len = 0U;
+            printf(CONSOLE_PROMPT);
+        }
+        else if ((CONSOLE_CHAR_BACKSPACE == c) ||
+                 (CONSOLE_CHAR_DELETE == c))
+        {
+            if (len > 0U)
+            {
+                len--;
+                printf("\b \b");
+            }
+        }
+        else if (CONSOLE_CHAR_CLEAR_LINE == c)
+        {
+            for (; len > 0U; len--)
+            {
+                printf("\b \b");
+            }
+        }
+        else if ((c >= ' ') && (c < CONSOLE_CHAR_DELETE) &&
+                 (len < (CONSOLE_LINE_MAX - 1U)))
+        {
+            line[len++] = (char) c;
+            putchar(c);
+        }
+        else
+        {
+            /* Ignore other control characters and overlong lines */
+        }
+
+        prev = c;
+        fflush(stdout);
+    }
+}
+
+/* [] END OF FILE */
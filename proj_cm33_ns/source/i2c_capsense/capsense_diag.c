@@ -0,0 +1,294 @@
+/*******************************************************************************
+* File Name: capsense_diag.c
+*
+* Description: This file contains the CapSense diagnostics readout. The
+*              CapSense task reads raw counts, baselines and diff counts from the
+*              extended EZI2C register map at a configurable rate and hands them
+*              to a low priority task that prints or notifies them, so that the
+*              button and slider path is not delayed.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "capsense_diag.h"
+#include "bt_app.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Default readout period and destinations */
+#define CAPSENSE_DIAG_DEFAULT_PERIOD_MS     (1000U)
+#define CAPSENSE_DIAG_DEFAULT_OUTPUTS       (CAPSENSE_DIAG_OUTPUT_BLE)
+
+/* Record header: type, index of the first sensor and sensor count */
+#define CAPSENSE_DIAG_RECORD_HEADER_SIZE    (3U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+TaskHandle_t capsense_diag_task_handle;
+
+/* Readout of one sensor */
+typedef struct
+{
+    uint16_t raw;
+    uint16_t baseline;
+    uint16_t diff;
+} capsense_diag_sensor_t;
+
+/* Readout configuration and the latest snapshot */
+static struct
+{
+    volatile uint32_t period_ms;
+    volatile uint8_t outputs;
+    TickType_t last_tick;
+    uint32_t sequence;
+    capsense_diag_sensor_t sensors[CAPSENSE_DIAG_SENSOR_COUNT];
+} diag =
+{
+    .period_ms = CAPSENSE_DIAG_DEFAULT_PERIOD_MS,
+    .outputs = CAPSENSE_DIAG_DEFAULT_OUTPUTS,
+};
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: capsense_diag_configure
+********************************************************************************
+* Summary:
+*  Sets the readout period and destinations.
+*
+* Parameters:
+*  uint32_t period_ms : Readout period, zero stops the readout
+*  uint8_t outputs    : CAPSENSE_DIAG_OUTPUT_xx mask
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void capsense_diag_configure(uint32_t period_ms, uint8_t outputs)
+{
+    diag.period_ms = period_ms;
+    diag.outputs = outputs;
+}
+
+/*******************************************************************************
+* Function Name: capsense_diag_get_configuration
+********************************************************************************
+* Summary:
+*  Returns the readout period and destinations.
+*
+* Parameters:
+*  uint32_t *p_period_ms : Readout period destination
+*  uint8_t *p_outputs    : CAPSENSE_DIAG_OUTPUT_xx mask destination
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void capsense_diag_get_configuration(uint32_t *p_period_ms,
+                                     uint8_t *p_outputs)
+{
+    *p_period_ms = diag.period_ms;
+    *p_outputs = diag.outputs;
+}
+
+/*******************************************************************************
+* Function Name: capsense_diag_is_due
+********************************************************************************
+* Summary:
+*  Called by the CapSense task after each sample. Returns true when the
+*  sensor data has to be read, that is when a destination is active and the
+*  readout period has passed.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true when the sensor data has to be read now
+*
+*******************************************************************************/
+bool capsense_diag_is_due(void)
+{
+    bool active = (0U != (diag.outputs & CAPSENSE_DIAG_OUTPUT_CONSOLE)) ||
+            ((0U != (diag.outputs & CAPSENSE_DIAG_OUTPUT_BLE)) &&
+             bt_app_diagnostics_enabled());
+
+    TickType_t now = xTaskGetTickCount();
+    bool due = active && (0U != diag.period_ms) &&
+            ((now - diag.last_tick) >= pdMS_TO_TICKS(diag.period_ms));
+
+    /* A failed read is retried in the next period, not in the next sample */
+    if (due)
+    {
+        diag.last_tick = now;
+    }
+
+    return due;
+}
+
+/*******************************************************************************
+* Function Name: capsense_diag_submit
+********************************************************************************
+* Summary:
+*  Stores the sensor registers read by the CapSense task and wakes up the
+*  diagnostics task to output them.
+*
+* Parameters:
+*  const uint8_t *p_regs : CAPSENSE_DIAG_REGS_SIZE bytes read at
+*                          CAPSENSE_DIAG_OFFSET
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void capsense_diag_submit(const uint8_t *p_regs)
+{
+    taskENTER_CRITICAL();
+    for (uint32_t i = 0U; i < CAPSENSE_DIAG_SENSOR_COUNT; i++)
+    {
+        const uint8_t *p = &p_regs[i * CAPSENSE_DIAG_SENSOR_SIZE];
+
+        diag.sensors[i].raw = (uint16_t) (p[0] | (p[1] << 8U));
+        diag.sensors[i].baseline = (uint16_t) (p[2] | (p[3] << 8U));
+        diag.sensors[i].diff = (uint16_t) (p[4] | (p[5] << 8U));
+    }
+    diag.sequence++;
+    taskEXIT_CRITICAL();
+
+    xTaskNotifyGive(capsense_diag_task_handle);
+}
+
+/*******************************************************************************
+* Function Name: capsense_diag_notify
+********************************************************************************
+* Summary:
+*  Sends the sensor data as diagnostics records. Each record holds as many
+*  sensors as fit into one notification.
+*
+* Parameters:
+*  const capsense_diag_sensor_t *p_sensors : Snapshot of all sensors
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void capsense_diag_notify(const capsense_diag_sensor_t *p_sensors)
+{
+    uint8_t record[CAPSENSE_DIAG_RECORD_HEADER_SIZE + CAPSENSE_DIAG_REGS_SIZE];
+    uint32_t per_record = (bt_app_max_notification_len() -
+            CAPSENSE_DIAG_RECORD_HEADER_SIZE) / CAPSENSE_DIAG_SENSOR_SIZE;
+    uint32_t first = 0U;
+
+    while (first < CAPSENSE_DIAG_SENSOR_COUNT)
+    {
+        uint32_t count = MIN(per_record, CAPSENSE_DIAG_SENSOR_COUNT - first);
+        uint8_t *p = &record[CAPSENSE_DIAG_RECORD_HEADER_SIZE];
+
+        record[0] = CAPSENSE_DIAG_RECORD_TYPE;
+        record[1] = (uint8_t) first;
+        record[2] = (uint8_t) count;
+
+        for (uint32_t i = first; i < (first + count); i++)
+        {
+            *p++ = (uint8_t) p_sensors[i].raw;
+            *p++ = (uint8_t) (p_sensors[i].raw >> 8U);
+            *p++ = (uint8_t) p_sensors[i].baseline;
+            *p++ = (uint8_t) (p_sensors[i].baseline >> 8U);
+            *p++ = (uint8_t) p_sensors[i].diff;
+            *p++ = (uint8_t) (p_sensors[i].diff >> 8U);
+        }
+
+        bt_app_send_diagnostics(record, (uint16_t) (p - record));
+        first += count;
+    }
+}
+
+/*******************************************************************************
+* Function Name: capsense_diag_task
+********************************************************************************
+* Summary:
+*  Low priority task that outputs the sensor data submitted by the CapSense
+*  task on the debug console and/or the diagnostics characteristic.
+*
+* Parameters:
+*  void *param : Task parameter defined during task creation (unused)
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void capsense_diag_task(void *param)
+{
+    capsense_diag_sensor_t sensors[CAPSENSE_DIAG_SENSOR_COUNT];
+    uint32_t sequence;
+
+    /* Suppress warning for unused parameter */
+    CY_UNUSED_PARAMETER(param);
+
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        /* Work on a copy so that the CapSense task is never blocked */
+        taskENTER_CRITICAL();
+        memcpy(sensors, diag.sensors, sizeof(sensors));
+        sequence = diag.sequence;
+        taskEXIT_CRITICAL();
+
+        if (0U != (diag.outputs & CAPSENSE_DIAG_OUTPUT_CONSOLE))
+        {
+            printf("CapSense diag #%lu\r\n", (unsigned long) sequence);
+            for (uint32_t i = 0U; i < CAPSENSE_DIAG_SENSOR_COUNT; i++)
+            {
+                printf("  sensor %lu: raw %5u base %5u diff %5u\r\n",
+                       (unsigned long) i, sensors[i].raw,
+                       sensors[i].baseline, sensors[i].diff);
+            }
+        }
+
+        if ((0U != (diag.outputs & CAPSENSE_DIAG_OUTPUT_BLE)) &&
+                bt_app_diagnostics_enabled())
+        {
+            capsense_diag_notify(sensors);
+        }
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,80 @@
+/*******************************************************************************
+* File Name: capsense_diag.h
+*
+* Description: This file is the public interface of capsense_diag.c
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef CAPSENSE_DIAG_H
+#define CAPSENSE_DIAG_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "capsense_regs.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Record type of the sensor data in the diagnostics characteristic */
+#define CAPSENSE_DIAG_RECORD_TYPE           (0x02U)
+
+/* Destinations of the sensor data */
+#define CAPSENSE_DIAG_OUTPUT_CONSOLE        (0x01U)
+#define CAPSENSE_DIAG_OUTPUT_BLE            (0x02U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern TaskHandle_t capsense_diag_task_handle;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void capsense_diag_task(void *param);
+void capsense_diag_configure(uint32_t period_ms, uint8_t outputs);
+void capsense_diag_get_configuration(uint32_t *p_period_ms,
+                                     uint8_t *p_outputs);
+bool capsense_diag_is_due(void);
+void capsense_diag_submit(const uint8_t *p_regs);
+
+#endif /* CAPSENSE_DIAG_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,275 @@
+/*******************************************************************************
+* File Name: capsense_frame.c
+*
+* Description: This file contains the decoder of the touch frames sent by the
+*              PSoC 4000T. The format is detected from the first byte, so the
+*              same image works with the legacy ASCII firmware and with firmware
+*              sending versioned binary frames.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "capsense_frame.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define LEGACY_BUTTON0_INDEX                (0U)
+#define LEGACY_BUTTON1_INDEX                (1U)
+#define LEGACY_SLIDER_INDEX                 (2U)
+#define LEGACY_BUTTON0_NOT_PRESSED          (0U)
+#define LEGACY_BUTTON1_NOT_PRESSED          (1U)
+
+#define V1_MAGIC_INDEX                      (0U)
+#define V1_VERSION_INDEX                    (1U)
+
+/* Offsets in the frame body, which starts at the change counter */
+#define V1_COUNTER_INDEX                    (0U)
+#define V1_SENSORS_INDEX                    (1U)
+#define V1_SLIDER_INDEX                     (3U)
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: capsense_frame_detect
+********************************************************************************
+* Summary:
+*  Detects the frame format from the first byte. The legacy frame starts
+*  with a button state character, which can never be the binary magic.
+*
+* Parameters:
+*  const uint8_t *p_raw : Frame as read from offset 0
+*
+* Return:
+*  capsense_frame_format_t: Detected format or CAPSENSE_FRAME_FORMAT_UNKNOWN
+*
+*******************************************************************************/
+capsense_frame_format_t capsense_frame_detect(const uint8_t *p_raw)
+{
+    capsense_frame_format_t format = CAPSENSE_FRAME_FORMAT_UNKNOWN;
+
+    if (CAPSENSE_FRAME_MAGIC == p_raw[V1_MAGIC_INDEX])
+    {
+        if (CAPSENSE_FRAME_VERSION_1 == p_raw[V1_VERSION_INDEX])
+        {
+            format = CAPSENSE_FRAME_FORMAT_V1;
+        }
+    }
+    else if ((p_raw[LEGACY_BUTTON0_INDEX] >= CAPSENSE_FRAME_LEGACY_ASCII_BASE) &&
+             (p_raw[LEGACY_BUTTON0_INDEX] <= (CAPSENSE_FRAME_LEGACY_ASCII_BASE +
+                                    CAPSENSE_FRAME_LEGACY_STATE_MAX)))
+    {
+        format = CAPSENSE_FRAME_FORMAT_LEGACY;
+    }
+
+    return format;
+}
+
+/*******************************************************************************
+* Function Name: capsense_frame_size
+********************************************************************************
+* Summary:
+*  Returns the number of bytes to read for a format. An unknown format needs
+*  the largest frame, so that any format can be decoded.
+*******************************************************************************/
+uint32_t capsense_frame_size(capsense_frame_format_t format)
+{
+    return (CAPSENSE_FRAME_FORMAT_LEGACY == format) ?
+            CAPSENSE_FRAME_LEGACY_SIZE : CAPSENSE_FRAME_SIZE_MAX;
+}
+
+/*******************************************************************************
+* Function Name: capsense_frame_decode_legacy
+********************************************************************************
+* Summary:
+*  Decodes a legacy ASCII frame. Returns false when a value is out of range.
+*******************************************************************************/
+static bool capsense_frame_decode_legacy(const uint8_t *p_raw,
+                                         capsense_frame_t *p_frame)
+{
+    uint8_t button0 = p_raw[LEGACY_BUTTON0_INDEX] -
+                      CAPSENSE_FRAME_LEGACY_ASCII_BASE;
+    uint8_t button1 = p_raw[LEGACY_BUTTON1_INDEX] -
+                      CAPSENSE_FRAME_LEGACY_ASCII_BASE;
+    uint8_t slider = p_raw[LEGACY_SLIDER_INDEX];
+
+    if ((button0 > CAPSENSE_FRAME_LEGACY_STATE_MAX) ||
+            (button1 > CAPSENSE_FRAME_LEGACY_STATE_MAX) ||
+            (slider > CAPSENSE_FRAME_LEGACY_SLIDER_MAX))
+    {
+        return false;
+    }
+
+    p_frame->format = CAPSENSE_FRAME_FORMAT_LEGACY;
+    p_frame->has_counter = false;
+    p_frame->counter = 0U;
+    p_frame->sensors =
+            ((LEGACY_BUTTON0_NOT_PRESSED != button0) ?
+                    CAPSENSE_FRAME_SENSOR_BUTTON0 : 0U) |
+            ((LEGACY_BUTTON1_NOT_PRESSED != button1) ?
+                    CAPSENSE_FRAME_SENSOR_BUTTON1 : 0U) |
+            ((0U != slider) ? CAPSENSE_FRAME_SENSOR_SLIDER : 0U);
+    memset(p_frame->position, 0, sizeof(p_frame->position));
+    p_frame->position[CAPSENSE_FRAME_SLIDER_SLOT] = slider;
+    p_frame->position_max = CAPSENSE_FRAME_LEGACY_SLIDER_MAX;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: capsense_frame_decode_v1_body
+********************************************************************************
+* Summary:
+*  Decodes a binary version 1 frame without its header, starting at the
+*  change counter. Used for the reads that start at the counter once the
+*  format is known.
+*
+* Parameters:
+*  const uint8_t *p_body     : CAPSENSE_FRAME_V1_BODY_SIZE bytes from the
+*                              change counter on
+*  capsense_frame_t *p_frame : Decoded frame, only written on success
+*
+* Return:
+*  bool: false when the checksum does not match or the slider position is
+*        out of range
+*
+*******************************************************************************/
+bool capsense_frame_decode_v1_body(const uint8_t *p_body,
+                                   capsense_frame_t *p_frame)
+{
+    uint8_t sum = 0U;
+    uint16_t slider_pos;
+
+    for (uint32_t i = 0U; i < CAPSENSE_FRAME_V1_BODY_SIZE; i++)
+    {
+        sum += p_body[i];
+    }
+
+    slider_pos = (uint16_t) (p_body[V1_SLIDER_INDEX] |
+                             (p_body[V1_SLIDER_INDEX + 1U] << 8U));
+
+    if ((CAPSENSE_FRAME_V1_CHECK_SUM != sum) ||
+            (slider_pos > CAPSENSE_FRAME_V1_SLIDER_MAX))
+    {
+        return false;
+    }
+
+    p_frame->format = CAPSENSE_FRAME_FORMAT_V1;
+    p_frame->has_counter = true;
+    p_frame->counter = p_body[V1_COUNTER_INDEX];
+    p_frame->sensors = (uint16_t) (p_body[V1_SENSORS_INDEX] |
+                                   (p_body[V1_SENSORS_INDEX + 1U] << 8U));
+    memset(p_frame->position, 0, sizeof(p_frame->position));
+    p_frame->position[CAPSENSE_FRAME_SLIDER_SLOT] = slider_pos;
+    p_frame->position_max = CAPSENSE_FRAME_V1_SLIDER_MAX;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: capsense_frame_decode
+********************************************************************************
+* Summary:
+*  Detects the format of a frame read from offset 0 and decodes it.
+*
+* Parameters:
+*  const uint8_t *p_raw      : Frame as read from offset 0
+*  uint32_t len              : Number of bytes read
+*  capsense_frame_t *p_frame : Decoded frame, only written on success
+*
+* Return:
+*  bool: false when the format is unknown, the frame is too short for its
+*        format or a value is invalid
+*
+*******************************************************************************/
+bool capsense_frame_decode(const uint8_t *p_raw, uint32_t len,
+                           capsense_frame_t *p_frame)
+{
+    capsense_frame_format_t format = capsense_frame_detect(p_raw);
+    bool valid = false;
+
+    if (len >= capsense_frame_size(format))
+    {
+        switch (format)
+        {
+            case CAPSENSE_FRAME_FORMAT_LEGACY:
+                valid = capsense_frame_decode_legacy(p_raw, p_frame);
+                break;
+
+            case CAPSENSE_FRAME_FORMAT_V1:
+                valid = capsense_frame_decode_v1_body(
+                        &p_raw[CAPSENSE_FRAME_V1_COUNTER_INDEX], p_frame);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return valid;
+}
+
+/*******************************************************************************
+* Function Name: capsense_frame_format_name
+********************************************************************************
+* Summary:
+*  Returns a printable name of a frame format.
+*******************************************************************************/
+const char *capsense_frame_format_name(capsense_frame_format_t format)
+{
+    const char *p_name;
+
+    switch (format)
+    {
+        case CAPSENSE_FRAME_FORMAT_LEGACY:
+            p_name = "legacy ASCII";
+            break;
+
+        case CAPSENSE_FRAME_FORMAT_V1:
+            p_name = "binary v1";
+            break;
+
+        default:
+            p_name = "unknown";
+            break;
+    }
+
+    return p_name;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,128 @@
+/*******************************************************************************
+* File Name: capsense_frame.h
+*
+* Description: This file is the public interface of capsense_frame.c
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef CAPSENSE_FRAME_H
+#define CAPSENSE_FRAME_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Legacy ASCII frame: button 0 and button 1 state as characters, slider
+ * position 1..100 or 0 when not touched */
+#define CAPSENSE_FRAME_LEGACY_SIZE          (3U)
+#define CAPSENSE_FRAME_LEGACY_ASCII_BASE    (30U)
+#define CAPSENSE_FRAME_LEGACY_STATE_MAX     (2U)
+#define CAPSENSE_FRAME_LEGACY_SLIDER_MAX    (100U)
+
+/* Binary frame, version 1:
+ *   0  magic (CAPSENSE_FRAME_MAGIC)
+ *   1  version
+ *   2  change counter, incremented by the PSoC 4000T on every state change
+ *   3  touched sensors bitmap, uint16 little endian
+ *   5  slider position 0..CAPSENSE_FRAME_V1_SLIDER_MAX, uint16 little endian
+ *   7  checksum: bytes 2..7 add up to CAPSENSE_FRAME_V1_CHECK_SUM
+ * The checksum starts at the change counter, so a read that starts at the
+ * counter can be checked without the header. It is the complement of the
+ * sum of bytes 2..6, so a body read as all zeros does not pass. */
+#define CAPSENSE_FRAME_MAGIC                (0xC5U)
+#define CAPSENSE_FRAME_VERSION_1            (0x01U)
+#define CAPSENSE_FRAME_V1_SIZE              (8U)
+#define CAPSENSE_FRAME_V1_COUNTER_INDEX     (2U)
+#define CAPSENSE_FRAME_V1_BODY_SIZE         (CAPSENSE_FRAME_V1_SIZE - \
+                                            CAPSENSE_FRAME_V1_COUNTER_INDEX)
+#define CAPSENSE_FRAME_V1_SLIDER_MAX        (1000U)
+#define CAPSENSE_FRAME_V1_CHECK_SUM         (0xFFU)
+
+/* Largest frame of any supported format */
+#define CAPSENSE_FRAME_SIZE_MAX             (CAPSENSE_FRAME_V1_SIZE)
+
+/* Position slots of a decoded frame. Both formats fill slot 0 with the
+ * slider position. */
+#define CAPSENSE_FRAME_POSITIONS_MAX        (4U)
+#define CAPSENSE_FRAME_SLIDER_SLOT          (0U)
+
+/* Bits of the touched sensors bitmap */
+#define CAPSENSE_FRAME_SENSOR_BUTTON0       (0x0001U)
+#define CAPSENSE_FRAME_SENSOR_BUTTON1       (0x0002U)
+#define CAPSENSE_FRAME_SENSOR_SLIDER        (0x0004U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Frame formats sent by the PSoC 4000T firmware */
+typedef enum
+{
+    CAPSENSE_FRAME_FORMAT_UNKNOWN,
+    CAPSENSE_FRAME_FORMAT_LEGACY,
+    CAPSENSE_FRAME_FORMAT_V1,
+} capsense_frame_format_t;
+
+/* Decoded frame, independent of the format */
+typedef struct
+{
+    capsense_frame_format_t format;
+    bool has_counter;                   /* The format has a change counter */
+    uint8_t counter;
+    uint16_t sensors;                   /* CAPSENSE_FRAME_SENSOR_xx bitmap */
+    uint16_t position[CAPSENSE_FRAME_POSITIONS_MAX]; /* Slider and touchpad
+                                           positions, valid while touched */
+    uint16_t position_max;              /* Full scale of the positions */
+} capsense_frame_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+capsense_frame_format_t capsense_frame_detect(const uint8_t *p_raw);
+uint32_t capsense_frame_size(capsense_frame_format_t format);
+bool capsense_frame_decode(const uint8_t *p_raw, uint32_t len,
+                           capsense_frame_t *p_frame);
+bool capsense_frame_decode_v1_body(const uint8_t *p_body,
+                                   capsense_frame_t *p_frame);
+const char *capsense_frame_format_name(capsense_frame_format_t format);
+
+#endif /* CAPSENSE_FRAME_H */
+
+/* [] END OF FILE */
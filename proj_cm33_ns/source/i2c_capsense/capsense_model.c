@@ -0,0 +1,147 @@
+/*******************************************************************************
+* File Name: capsense_model.c
+*
+* Description: This file contains the sensor model generated from the sensor
+*              table in capsense_model.h. Decode and edge detection work on
+*              bitmaps and position arrays for all sensors at once, so adding
+*              sensors to the table needs no new code.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include "capsense_model.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+#define CAPSENSE_TYPE_COLUMN(name, type, mask, slot, led, gatt)   (type),
+#define CAPSENSE_MASK_COLUMN(name, type, mask, slot, led, gatt)   (mask),
+#define CAPSENSE_SLOT_COLUMN(name, type, mask, slot, led, gatt)   (slot),
+#define CAPSENSE_LED_COLUMN(name, type, mask, slot, led, gatt)    (led),
+#define CAPSENSE_GATT_COLUMN(name, type, mask, slot, led, gatt)   (gatt),
+
+/* Attributes of the sensors, one array per column of the table */
+const capsense_sensor_table_t capsense_sensors =
+{
+    .type = { CAPSENSE_SENSOR_TABLE(CAPSENSE_TYPE_COLUMN) },
+    .mask = { CAPSENSE_SENSOR_TABLE(CAPSENSE_MASK_COLUMN) },
+    .slot = { CAPSENSE_SENSOR_TABLE(CAPSENSE_SLOT_COLUMN) },
+    .led  = { CAPSENSE_SENSOR_TABLE(CAPSENSE_LED_COLUMN) },
+    .gatt = { CAPSENSE_SENSOR_TABLE(CAPSENSE_GATT_COLUMN) },
+};
+
+#undef CAPSENSE_TYPE_COLUMN
+#undef CAPSENSE_MASK_COLUMN
+#undef CAPSENSE_SLOT_COLUMN
+#undef CAPSENSE_LED_COLUMN
+#undef CAPSENSE_GATT_COLUMN
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: capsense_model_decode
+********************************************************************************
+* Summary:
+*  Converts a decoded frame to the sensor state: one touched bit per sensor
+*  and the positions scaled to CAPSENSE_POSITION_PERCENT_MAX.
+*
+* Parameters:
+*  const capsense_frame_t *p_frame : Decoded frame
+*  capsense_state_t *p_state       : Sensor state
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void capsense_model_decode(const capsense_frame_t *p_frame,
+                           capsense_state_t *p_state)
+{
+    uint32_t touched = 0U;
+
+    for (uint32_t i = 0U; i < CAPSENSE_SENSOR_COUNT; i++)
+    {
+        touched |= ((uint32_t) (0U != (p_frame->sensors &
+                                       capsense_sensors.mask[i]))) << i;
+    }
+    p_state->touched = touched;
+
+    for (uint32_t slot = 0U; slot < CAPSENSE_FRAME_POSITIONS_MAX; slot++)
+    {
+        p_state->position[slot] = (uint8_t) (((uint32_t) p_frame->position[slot] *
+                CAPSENSE_POSITION_PERCENT_MAX) / p_frame->position_max);
+    }
+}
+
+/*******************************************************************************
+* Function Name: capsense_model_events
+********************************************************************************
+* Summary:
+*  Returns the sensors that need handling: buttons touched since the previous
+*  state, and sliders and touchpads that are newly touched or moved while
+*  touched.
+*
+* Parameters:
+*  const capsense_state_t *p_prev : Previous sensor state
+*  const capsense_state_t *p_cur  : Current sensor state
+*
+* Return:
+*  uint32_t: CAPSENSE_SENSOR_MASK_xx bitmap of the sensors
+*
+*******************************************************************************/
+uint32_t capsense_model_events(const capsense_state_t *p_prev,
+                               const capsense_state_t *p_cur)
+{
+    uint32_t new_touches = p_cur->touched & ~p_prev->touched;
+    uint32_t moved = 0U;
+
+    for (uint32_t i = 0U; i < CAPSENSE_SENSOR_COUNT; i++)
+    {
+        /* A touchpad also compares its y slot, the others compare their
+         * only slot twice */
+        uint32_t x = capsense_sensors.slot[i];
+        uint32_t y = x + (uint32_t) (CAPSENSE_SENSOR_TOUCHPAD ==
+                                     capsense_sensors.type[i]);
+
+        moved |= ((uint32_t) ((p_cur->position[x] != p_prev->position[x]) ||
+                              (p_cur->position[y] != p_prev->position[y]))) << i;
+    }
+
+    return (new_touches & CAPSENSE_BUTTON_MASK) |
+           (p_cur->touched & (new_touches | moved) & ~CAPSENSE_BUTTON_MASK);
+}
+
+/* [] END OF FILE */
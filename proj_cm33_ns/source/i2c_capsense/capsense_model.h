@@ -0,0 +1,156 @@
+/*******************************************************************************
+* File Name: capsense_model.h
+*
+* Description: This file holds the sensor table of the board and the public
+*              interface of capsense_model.c
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef CAPSENSE_MODEL_H
+#define CAPSENSE_MODEL_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+#include "board.h"
+#include "capsense_frame.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Sensor types */
+#define CAPSENSE_SENSOR_BUTTON              (0U)
+#define CAPSENSE_SENSOR_SLIDER              (1U)
+#define CAPSENSE_SENSOR_TOUCHPAD            (2U)
+
+/* LED column value of sensors that do not drive the LED */
+#define CAPSENSE_LED_NONE                   (0xFFU)
+
+/* GATT column: button number reported in the button characteristic, or
+ * the slider characteristic, or nothing */
+#define CAPSENSE_GATT_NONE                  (0x00U)
+#define CAPSENSE_GATT_SLIDER                (0xFFU)
+
+/* Sensor table of the board. Everything else is generated from it.
+ *   name : CAPSENSE_SENSOR_<name> identifier
+ *   type : CAPSENSE_SENSOR_xx
+ *   mask : CAPSENSE_FRAME_SENSOR_xx bit of the sensor in the frame
+ *   slot : First position slot of a slider (one slot) or touchpad (x, y)
+ *   led  : led_command_t sent on a new touch or move, or CAPSENSE_LED_NONE
+ *   gatt : CAPSENSE_GATT_xx or the button number
+ * X(name, type, mask, slot, led, gatt) */
+#define CAPSENSE_SENSOR_TABLE(X)                                              \
+    X(BUTTON0, CAPSENSE_SENSOR_BUTTON, CAPSENSE_FRAME_SENSOR_BUTTON0, 0U,     \
+      LED_TURN_ON, 1U)                                                        \
+    X(BUTTON1, CAPSENSE_SENSOR_BUTTON, CAPSENSE_FRAME_SENSOR_BUTTON1, 0U,     \
+      LED_TURN_OFF, 2U)                                                       \
+    X(SLIDER0, CAPSENSE_SENSOR_SLIDER, CAPSENSE_FRAME_SENSOR_SLIDER,          \
+      CAPSENSE_FRAME_SLIDER_SLOT, LED_SET_BRIGHTNESS, CAPSENSE_GATT_SLIDER)
+
+/* Position range after scaling, used for the LED brightness and the GATT
+ * slider data */
+#define CAPSENSE_POSITION_PERCENT_MAX       (100U)
+
+/* Generated counts and masks */
+#define CAPSENSE_COUNT_BUTTON(name, type, mask, slot, led, gatt)              \
+    + ((CAPSENSE_SENSOR_BUTTON == (type)) ? 1U : 0U)
+#define CAPSENSE_BUTTON_COUNT   (0U CAPSENSE_SENSOR_TABLE(CAPSENSE_COUNT_BUTTON))
+
+#define CAPSENSE_MASK_BUTTON(name, type, mask, slot, led, gatt)               \
+    | ((CAPSENSE_SENSOR_BUTTON == (type)) ? CAPSENSE_SENSOR_MASK_##name : 0U)
+#define CAPSENSE_BUTTON_MASK    (0U CAPSENSE_SENSOR_TABLE(CAPSENSE_MASK_BUTTON))
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+#define CAPSENSE_SENSOR_ID(name, type, mask, slot, led, gatt)                 \
+    CAPSENSE_SENSOR_##name,
+
+/* Sensor identifiers, in table order */
+typedef enum
+{
+    CAPSENSE_SENSOR_TABLE(CAPSENSE_SENSOR_ID)
+    CAPSENSE_SENSOR_COUNT
+} capsense_sensor_id_t;
+
+#undef CAPSENSE_SENSOR_ID
+
+#define CAPSENSE_SENSOR_MASK_ID(name, type, mask, slot, led, gatt)            \
+    CAPSENSE_SENSOR_MASK_##name = (1UL << CAPSENSE_SENSOR_##name),
+
+/* Bit of each sensor in the touched bitmaps */
+enum
+{
+    CAPSENSE_SENSOR_TABLE(CAPSENSE_SENSOR_MASK_ID)
+};
+
+#undef CAPSENSE_SENSOR_MASK_ID
+
+/* State of all sensors. Touches are one bitmap, positions are scaled to
+ * CAPSENSE_POSITION_PERCENT_MAX. */
+typedef struct
+{
+    uint32_t touched;
+    uint8_t position[CAPSENSE_FRAME_POSITIONS_MAX];
+} capsense_state_t;
+
+/* Constant attributes of the sensors, generated from the table */
+typedef struct
+{
+    uint8_t type[CAPSENSE_SENSOR_COUNT];
+    uint16_t mask[CAPSENSE_SENSOR_COUNT];
+    uint8_t slot[CAPSENSE_SENSOR_COUNT];
+    uint8_t led[CAPSENSE_SENSOR_COUNT];
+    uint8_t gatt[CAPSENSE_SENSOR_COUNT];
+} capsense_sensor_table_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern const capsense_sensor_table_t capsense_sensors;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void capsense_model_decode(const capsense_frame_t *p_frame,
+                           capsense_state_t *p_state);
+uint32_t capsense_model_events(const capsense_state_t *p_prev,
+                               const capsense_state_t *p_cur);
+
+#endif /* CAPSENSE_MODEL_H */
+
+/* [] END OF FILE */
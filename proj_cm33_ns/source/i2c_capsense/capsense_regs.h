@@ -0,0 +1,104 @@
+/*******************************************************************************
+* File Name: capsense_regs.h
+*
+* Description: This file describes the EZI2C register map of the PSoC 4000T
+*              CapSense firmware
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef CAPSENSE_REGS_H
+#define CAPSENSE_REGS_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include "ezi2c_client.h"
+#include "capsense_frame.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Touch frame, see capsense_frame.h for the formats. The binary frame body
+ * starts at the change counter. */
+#define CAPSENSE_FRAME_OFFSET               (0x00U)
+#define CAPSENSE_COUNTER_OFFSET             (CAPSENSE_FRAME_OFFSET + \
+                                            CAPSENSE_FRAME_V1_COUNTER_INDEX)
+#define CAPSENSE_COUNTER_SIZE               (1U)
+
+/* Sensor data: raw count, baseline and diff count of each sensor as little
+ * endian 16-bit values */
+#define CAPSENSE_DIAG_OFFSET                (0x10U)
+#define CAPSENSE_DIAG_SENSOR_COUNT          (7U)
+#define CAPSENSE_DIAG_SENSOR_SIZE           (6U)
+#define CAPSENSE_DIAG_REGS_SIZE             (CAPSENSE_DIAG_SENSOR_COUNT * \
+                                            CAPSENSE_DIAG_SENSOR_SIZE)
+
+/* Register map, sorted by offset: X(name, offset, size). The touch frame is
+ * read as the short legacy frame or as the binary frame body once the format
+ * has been detected, else with the size of the largest format. */
+#define CAPSENSE_REG_MAP(X)                                                   \
+    X(FRAME_LEGACY, CAPSENSE_FRAME_OFFSET,   CAPSENSE_FRAME_LEGACY_SIZE)      \
+    X(FRAME,        CAPSENSE_FRAME_OFFSET,   CAPSENSE_FRAME_SIZE_MAX)         \
+    X(COUNTER,      CAPSENSE_COUNTER_OFFSET, CAPSENSE_COUNTER_SIZE)           \
+    X(FRAME_BODY,   CAPSENSE_COUNTER_OFFSET, CAPSENSE_FRAME_V1_BODY_SIZE)     \
+    X(DIAG,         CAPSENSE_DIAG_OFFSET,    CAPSENSE_DIAG_REGS_SIZE)
+
+/* Size of an image of the whole map */
+#define CAPSENSE_REG_IMAGE_SIZE             (CAPSENSE_DIAG_OFFSET + \
+                                            CAPSENSE_DIAG_REGS_SIZE)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+#define CAPSENSE_REG_ID(name, offset, size)     CAPSENSE_REG_##name,
+
+/* Region identifiers, usable with EZI2C_REGION_MASK() */
+typedef enum
+{
+    CAPSENSE_REG_MAP(CAPSENSE_REG_ID)
+    CAPSENSE_REG_COUNT
+} capsense_reg_id_t;
+
+#undef CAPSENSE_REG_ID
+
+/* Regions holding the touch frame */
+#define CAPSENSE_REG_FRAMES         (EZI2C_REGION_MASK(CAPSENSE_REG_FRAME_LEGACY) | \
+                                     EZI2C_REGION_MASK(CAPSENSE_REG_FRAME) | \
+                                     EZI2C_REGION_MASK(CAPSENSE_REG_FRAME_BODY))
+
+#endif /* CAPSENSE_REGS_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,442 @@
+/*******************************************************************************
+* File Name: ezi2c_client.c
+*
+* Description: This file contains a client for EZI2C register maps. Reads
+*              are offset-addressed bursts of any length. The client tracks the
+*              base offset of the slave to skip the offset write when possible,
+*              and merges or orders the regions of a register map to spend as
+*              few SCL clocks as possible per sample.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "cybsp.h"
+#include "ezi2c_client.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* SCL clocks of the bus conditions, used for the bus time accounting */
+#define EZI2C_START_CLOCKS                  (1U)
+#define EZI2C_BYTE_CLOCKS                   (9U)
+#define EZI2C_STOP_CLOCKS                   (1U)
+
+#if defined(EZI2C_CLIENT_BENCHMARK)
+#define BENCH_SAMPLES                       (1000U)
+#define BENCH_SCL_HZ                        (400000UL)
+#define BENCH_US_PER_SEC                    (1000000UL)
+#define BENCH_SIM_ADDRESS                   (0x08U)
+#define BENCH_SIM_BUFFER_SIZE               (256U)
+#define BENCH_REGION_TOUCH                  (0U)
+#define BENCH_REGION_DIAG                   (1U)
+#endif /* defined(EZI2C_CLIENT_BENCHMARK) */
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Contiguous block read in one transaction */
+typedef struct
+{
+    uint8_t offset;
+    uint16_t end;                       /* First offset after the block */
+    uint32_t mask;                      /* Regions covered by the block */
+} ezi2c_block_t;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: ezi2c_client_init
+********************************************************************************
+* Summary:
+*  Initializes a client of the EZI2C slave at the given address.
+*
+* Parameters:
+*  ezi2c_client_t *p_client      : Client to initialize
+*  const ezi2c_bus_ops_t *p_ops  : Bus primitives
+*  void *p_bus                   : Bus instance passed to the primitives
+*  uint8_t address               : 7-bit slave address
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ezi2c_client_init(ezi2c_client_t *p_client, const ezi2c_bus_ops_t *p_ops,
+                       void *p_bus, uint8_t address)
+{
+    memset(p_client, 0, sizeof(*p_client));
+    p_client->p_ops = p_ops;
+    p_client->p_bus = p_bus;
+    p_client->address = address;
+    p_client->merge_gap = EZI2C_CLIENT_MERGE_GAP_DEFAULT;
+    p_client->offset = EZI2C_OFFSET_UNKNOWN;
+}
+
+/*******************************************************************************
+* Function Name: ezi2c_client_invalidate
+********************************************************************************
+* Summary:
+*  Forgets the base offset of the slave, e.g. after a bus reset. The next
+*  read writes the offset again.
+*******************************************************************************/
+void ezi2c_client_invalidate(ezi2c_client_t *p_client)
+{
+    p_client->offset = EZI2C_OFFSET_UNKNOWN;
+}
+
+/*******************************************************************************
+* Function Name: ezi2c_client_read
+********************************************************************************
+* Summary:
+*  Reads len bytes starting at offset in one transaction. The EZI2C slave
+*  starts every read at its base offset, so the offset is only written when
+*  it differs from the last one written:
+*    offset known:   START+R, data, STOP
+*    offset changed: START+W, offset, RESTART+R, data, STOP
+*
+* Parameters:
+*  ezi2c_client_t *p_client : Client
+*  uint8_t offset           : Offset of the first byte
+*  uint8_t *p_data          : Destination of the data
+*  uint32_t len             : Number of bytes, at least one
+*
+* Return:
+*  cy_en_scb_i2c_status_t: Status of the first failed step or success
+*
+*******************************************************************************/
+cy_en_scb_i2c_status_t ezi2c_client_read(ezi2c_client_t *p_client,
+                                         uint8_t offset, uint8_t *p_data,
+                                         uint32_t len)
+{
+    const ezi2c_bus_ops_t *p_ops = p_client->p_ops;
+    ezi2c_client_stats_t *p_stats = &p_client->stats;
+    cy_en_scb_i2c_status_t status;
+
+    p_stats->transactions++;
+    p_stats->bus_clocks += EZI2C_START_CLOCKS + EZI2C_BYTE_CLOCKS;
+
+    if (p_client->offset == (int16_t) offset)
+    {
+        status = p_ops->start(p_client->p_bus, p_client->address,
+                              CY_SCB_I2C_READ_XFER);
+    }
+    else
+    {
+        p_stats->offset_writes++;
+        p_stats->bus_clocks += EZI2C_BYTE_CLOCKS + EZI2C_START_CLOCKS +
+                               EZI2C_BYTE_CLOCKS;
+
+        /* The slave may have taken the offset even if a later step fails */
+        p_client->offset = EZI2C_OFFSET_UNKNOWN;
+
+        status = p_ops->start(p_client->p_bus, p_client->address,
+                              CY_SCB_I2C_WRITE_XFER);
+        if (CY_SCB_I2C_SUCCESS == status)
+        {
+            status = p_ops->write_byte(p_client->p_bus, offset);
+        }
+        if (CY_SCB_I2C_SUCCESS == status)
+        {
+            p_client->offset = (int16_t) offset;
+            status = p_ops->restart(p_client->p_bus, p_client->address,
+                                    CY_SCB_I2C_READ_XFER);
+        }
+    }
+
+    while ((CY_SCB_I2C_SUCCESS == status) && (0U != len))
+    {
+        /* NAK the last byte to end the read */
+        len--;
+        status = p_ops->read_byte(p_client->p_bus, p_data, (0U != len));
+        p_data++;
+        p_stats->bytes_read++;
+        p_stats->bus_clocks += EZI2C_BYTE_CLOCKS;
+    }
+
+    p_ops->stop(p_client->p_bus);
+    p_stats->bus_clocks += EZI2C_STOP_CLOCKS;
+
+    if (CY_SCB_I2C_SUCCESS != status)
+    {
+        p_stats->errors++;
+        p_client->last_error = status;
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: ezi2c_client_read_regions
+********************************************************************************
+* Summary:
+*  Reads the selected regions of a register map into an image of the map.
+*  Regions closer than merge_gap bytes are read as one block. The block at
+*  the current base offset of the slave is read first, so it needs no offset
+*  write; the others follow in ascending order.
+*
+* Parameters:
+*  ezi2c_client_t *p_client    : Client
+*  const ezi2c_region_t *p_map : Register map, sorted by offset
+*  uint32_t map_size           : Number of regions in the map
+*  uint32_t mask               : EZI2C_REGION_MASK() of the regions to read
+*  uint8_t *p_image            : Image of the map; each region is stored at
+*                                its offset
+*
+* Return:
+*  uint32_t: Mask of the regions that were read successfully
+*
+*******************************************************************************/
+uint32_t ezi2c_client_read_regions(ezi2c_client_t *p_client,
+                                   const ezi2c_region_t *p_map,
+                                   uint32_t map_size, uint32_t mask,
+                                   uint8_t *p_image)
+{
+    ezi2c_block_t blocks[EZI2C_CLIENT_REGIONS_MAX];
+    uint32_t count = 0U;
+    uint32_t first = 0U;
+    uint32_t done = 0U;
+
+    CY_ASSERT(map_size <= EZI2C_CLIENT_REGIONS_MAX);
+
+    /* Merge the selected regions into blocks */
+    for (uint32_t i = 0U; i < map_size; i++)
+    {
+        const ezi2c_region_t *p_region = &p_map[i];
+        uint16_t end = (uint16_t) p_region->offset + p_region->size;
+
+        if (0U == (mask & EZI2C_REGION_MASK(i)))
+        {
+            continue;
+        }
+
+        if ((0U != count) &&
+                (p_region->offset <= (blocks[count - 1U].end + p_client->merge_gap)))
+        {
+            CY_ASSERT(p_region->offset >= blocks[count - 1U].offset);
+            if (end > blocks[count - 1U].end)
+            {
+                blocks[count - 1U].end = end;
+            }
+            blocks[count - 1U].mask |= EZI2C_REGION_MASK(i);
+        }
+        else
+        {
+            blocks[count].offset = p_region->offset;
+            blocks[count].end = end;
+            blocks[count].mask = EZI2C_REGION_MASK(i);
+            count++;
+        }
+    }
+
+    /* Start with the block that needs no offset write */
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        if (p_client->offset == (int16_t) blocks[i].offset)
+        {
+            first = i;
+            break;
+        }
+    }
+
+    for (uint32_t n = 0U; n < count; n++)
+    {
+        uint32_t i = (first + n) % count;
+
+        if (CY_SCB_I2C_SUCCESS == ezi2c_client_read(p_client, blocks[i].offset,
+                &p_image[blocks[i].offset], blocks[i].end - blocks[i].offset))
+        {
+            done |= blocks[i].mask;
+        }
+    }
+
+    return done;
+}
+
+#if defined(EZI2C_CLIENT_BENCHMARK)
+
+/* Simulated EZI2C slave with the buffer semantics of the PDL EZI2C driver:
+ * the first byte of a write sets the base offset, reads start at it. */
+typedef struct
+{
+    uint8_t buffer[BENCH_SIM_BUFFER_SIZE];
+    uint8_t base;
+    uint32_t index;
+    bool offset_phase;
+} bench_sim_t;
+
+static bench_sim_t bench_sim;
+
+static cy_en_scb_i2c_status_t bench_sim_start(void *p_bus, uint8_t address,
+                                              cy_en_scb_i2c_direction_t direction)
+{
+    bench_sim_t *p_sim = (bench_sim_t *) p_bus;
+
+    if (BENCH_SIM_ADDRESS != address)
+    {
+        return CY_SCB_I2C_MASTER_MANUAL_ADDR_NAK;
+    }
+
+    p_sim->offset_phase = (CY_SCB_I2C_WRITE_XFER == direction);
+    p_sim->index = p_sim->base;
+    return CY_SCB_I2C_SUCCESS;
+}
+
+static cy_en_scb_i2c_status_t bench_sim_write_byte(void *p_bus, uint8_t byte)
+{
+    bench_sim_t *p_sim = (bench_sim_t *) p_bus;
+
+    if (p_sim->offset_phase)
+    {
+        p_sim->base = byte;
+        p_sim->index = byte;
+        p_sim->offset_phase = false;
+    }
+    else if (p_sim->index < BENCH_SIM_BUFFER_SIZE)
+    {
+        p_sim->buffer[p_sim->index++] = byte;
+    }
+
+    return CY_SCB_I2C_SUCCESS;
+}
+
+static cy_en_scb_i2c_status_t bench_sim_read_byte(void *p_bus, uint8_t *p_byte,
+                                                  bool ack)
+{
+    bench_sim_t *p_sim = (bench_sim_t *) p_bus;
+
+    CY_UNUSED_PARAMETER(ack);
+
+    /* The EZI2C slave returns 0xFF past the end of its buffer */
+    *p_byte = (p_sim->index < BENCH_SIM_BUFFER_SIZE) ?
+              p_sim->buffer[p_sim->index++] : 0xFFU;
+    return CY_SCB_I2C_SUCCESS;
+}
+
+static void bench_sim_stop(void *p_bus)
+{
+    CY_UNUSED_PARAMETER(p_bus);
+}
+
+static const ezi2c_bus_ops_t bench_sim_ops =
+{
+    .start      = bench_sim_start,
+    .restart    = bench_sim_start,
+    .write_byte = bench_sim_write_byte,
+    .read_byte  = bench_sim_read_byte,
+    .stop       = bench_sim_stop,
+};
+
+/*******************************************************************************
+* Function Name: ezi2c_client_benchmark
+********************************************************************************
+* Summary:
+*  Reads the CapSense register map from a simulated slave with different
+*  region selections and merge gaps. Prints SCL clocks, bus time at 400 kHz,
+*  offset writes and CPU cycles per sample.
+*******************************************************************************/
+void ezi2c_client_benchmark(void)
+{
+    /* Touch frame at 0x00 and sensor data at 0x10, see capsense_regs.h */
+    static const ezi2c_region_t map[] =
+    {
+        [BENCH_REGION_TOUCH] = { 0x00U, 3U },
+        [BENCH_REGION_DIAG]  = { 0x10U, 42U },
+    };
+    static const struct
+    {
+        const char *name;
+        uint32_t mask;
+        uint8_t merge_gap;
+    } cases[] =
+    {
+        { "touch", EZI2C_REGION_MASK(BENCH_REGION_TOUCH),
+          EZI2C_CLIENT_MERGE_GAP_DEFAULT },
+        { "touch+diag split", EZI2C_REGION_MASK(BENCH_REGION_TOUCH) |
+          EZI2C_REGION_MASK(BENCH_REGION_DIAG), EZI2C_CLIENT_MERGE_GAP_DEFAULT },
+        { "touch+diag merged", EZI2C_REGION_MASK(BENCH_REGION_TOUCH) |
+          EZI2C_REGION_MASK(BENCH_REGION_DIAG), UINT8_MAX },
+    };
+    static uint8_t image[BENCH_SIM_BUFFER_SIZE];
+    ezi2c_client_t client;
+
+    for (uint32_t i = 0U; i < BENCH_SIM_BUFFER_SIZE; i++)
+    {
+        bench_sim.buffer[i] = (uint8_t) i;
+    }
+
+    /* Enable the DWT cycle counter */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for (uint32_t i = 0U; i < (sizeof(cases) / sizeof(cases[0])); i++)
+    {
+        uint32_t cycles = 0U;
+
+        bench_sim.base = 0U;
+        ezi2c_client_init(&client, &bench_sim_ops, &bench_sim,
+                          BENCH_SIM_ADDRESS);
+        client.merge_gap = cases[i].merge_gap;
+
+        for (uint32_t n = 0U; n < BENCH_SAMPLES; n++)
+        {
+            uint32_t start = DWT->CYCCNT;
+            uint32_t done = ezi2c_client_read_regions(&client, map,
+                    sizeof(map) / sizeof(map[0]), cases[i].mask, image);
+            cycles += DWT->CYCCNT - start;
+
+            CY_ASSERT(done == cases[i].mask);
+            CY_UNUSED_PARAMETER(done);
+        }
+
+        printf("ezi2c_bench %s: %lu clocks/sample (%lu us at 400 kHz), "
+               "%lu.%02lu offset writes/sample, %lu cycles/sample\r\n",
+               cases[i].name,
+               (unsigned long) (client.stats.bus_clocks / BENCH_SAMPLES),
+               (unsigned long) (((uint64_t) client.stats.bus_clocks *
+                                 BENCH_US_PER_SEC) /
+                                ((uint64_t) BENCH_SCL_HZ * BENCH_SAMPLES)),
+               (unsigned long) (client.stats.offset_writes / BENCH_SAMPLES),
+               (unsigned long) (((client.stats.offset_writes * 100U) /
+                                 BENCH_SAMPLES) % 100U),
+               (unsigned long) (cycles / BENCH_SAMPLES));
+    }
+}
+
+#endif /* defined(EZI2C_CLIENT_BENCHMARK) */
+
+/* [] END OF FILE */
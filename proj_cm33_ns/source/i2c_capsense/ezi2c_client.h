@@ -0,0 +1,133 @@
+/*******************************************************************************
+* File Name: ezi2c_client.h
+*
+* Description: This file is the public interface of ezi2c_client.c
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef EZI2C_CLIENT_H
+#define EZI2C_CLIENT_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "cy_scb_i2c.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Base offset of the slave is not known, the next read writes it */
+#define EZI2C_OFFSET_UNKNOWN                (-1)
+
+/* Regions closer than this many bytes are read in one transaction. Reading
+ * a byte costs 9 SCL clocks, a new offset-addressed transaction about 30. */
+#define EZI2C_CLIENT_MERGE_GAP_DEFAULT      (3U)
+
+/* Maximum number of regions in one register map */
+#define EZI2C_CLIENT_REGIONS_MAX            (32U)
+
+/* Bit of a region in the mask of ezi2c_client_read_regions() */
+#define EZI2C_REGION_MASK(id)               (1UL << (id))
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Bus primitives of an I2C master. The SCB implementation lives with the
+ * application, the benchmark uses a simulated EZI2C slave. */
+typedef struct
+{
+    cy_en_scb_i2c_status_t (*start)(void *p_bus, uint8_t address,
+                                    cy_en_scb_i2c_direction_t direction);
+    cy_en_scb_i2c_status_t (*restart)(void *p_bus, uint8_t address,
+                                      cy_en_scb_i2c_direction_t direction);
+    cy_en_scb_i2c_status_t (*write_byte)(void *p_bus, uint8_t byte);
+    cy_en_scb_i2c_status_t (*read_byte)(void *p_bus, uint8_t *p_byte,
+                                        bool ack);
+    void (*stop)(void *p_bus);
+} ezi2c_bus_ops_t;
+
+/* Region of an EZI2C register map */
+typedef struct
+{
+    uint8_t offset;
+    uint8_t size;
+} ezi2c_region_t;
+
+/* Bus usage counters */
+typedef struct
+{
+    uint32_t transactions;              /* START conditions */
+    uint32_t offset_writes;             /* Transactions that set the offset */
+    uint32_t bytes_read;
+    uint32_t bus_clocks;                /* SCL clocks incl. START and STOP */
+    uint32_t errors;
+} ezi2c_client_stats_t;
+
+/* Client of one EZI2C slave */
+typedef struct
+{
+    const ezi2c_bus_ops_t *p_ops;
+    void *p_bus;
+    uint8_t address;
+    uint8_t merge_gap;
+    int16_t offset;                     /* Base offset of the slave */
+    cy_en_scb_i2c_status_t last_error;  /* Status of the last failed read */
+    ezi2c_client_stats_t stats;
+} ezi2c_client_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void ezi2c_client_init(ezi2c_client_t *p_client, const ezi2c_bus_ops_t *p_ops,
+                       void *p_bus, uint8_t address);
+cy_en_scb_i2c_status_t ezi2c_client_read(ezi2c_client_t *p_client,
+                                         uint8_t offset, uint8_t *p_data,
+                                         uint32_t len);
+uint32_t ezi2c_client_read_regions(ezi2c_client_t *p_client,
+                                   const ezi2c_region_t *p_map,
+                                   uint32_t map_size, uint32_t mask,
+                                   uint8_t *p_image);
+void ezi2c_client_invalidate(ezi2c_client_t *p_client);
+
+#if defined(EZI2C_CLIENT_BENCHMARK)
+void ezi2c_client_benchmark(void);
+#endif
+
+#endif /* EZI2C_CLIENT_H */
+
+/* [] END OF FILE */
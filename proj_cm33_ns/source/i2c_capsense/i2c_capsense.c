@@ -39,6 +39,7 @@
 /*******************************************************************************
 * Header files includes
 *******************************************************************************/
+#include <stdio.h>
 #include "i2c_capsense.h"
 #include "FreeRTOS.h"
 #include "task.h"
@@ -46,27 +47,63 @@
 #include "timers.h"
 #include "board.h"
 #include "bt_app.h"
+#include "bt_conn_param.h"
+#include "bt_stream.h"
+#include "bt_periodic.h"
+#include "bt_time.h"
+#include "capsense_diag.h"
+#include "capsense_regs.h"
+#include "capsense_frame.h"
+#include "capsense_model.h"
+#include "ezi2c_client.h"
+#include "i2c_recovery.h"
 #include "cybsp.h"
+#include "retarget_io_init.h"
 
 /*******************************************************************************
 * Macros
 *******************************************************************************/
-#define INTERGER_ASCII_DIFFERENCE    (30U)
-#define CAPSENSE_READ_BUFFER_SIZE    (3U)
 #define I2C_SLAVE_ADDRESS            (0x8)
-#define I2C_SEND_RECEIVE_TIMEOUT_MS  (0U)
-#define BUTTON0_INDEX                (0U)
-#define BUTTON1_INDEX                (1U)
-#define SLIDER_INDEX                 (2U)
-#define I2C_READ_SIZE_MIN            (0U)
-#define I2C_READ_SIZE_MAX            (1U)
-#define CAPSENSE_BTN0_NOT_PRESSED    (0U)
-#define CAPSENSE_BTN1_NOT_PRESSED    (1U)
-#define CAPSENSE_BTN0_PRESSED        (1U)
-#define CAPSENSE_BTN1_PRESSED        (2U)
+/* Timeout of each bus operation. Zero would wait forever on a stuck bus. */
+#define I2C_SEND_RECEIVE_TIMEOUT_MS  (1U)
 #define XTASK_NOTIFY_UL_VALUE        (1U)
 #define XQUEUE_TICKS_TO_WAIT         (0U)
-#define SLIDER_POS_NOT_CHANGED       (0U)
+
+/* Stream sample: touched sensors (low byte) and slider position (u16) */
+#define STREAM_SENSORS_INDEX         (0U)
+#define STREAM_SLIDER_INDEX          (1U)
+
+/* Error recovery: a failed or invalid touch frame is read again after a
+ * backoff that doubles with every retry. Recovery of one sample, including
+ * bus clears and the reads, ends within CAPSENSE_I2C_RECOVERY_BUDGET_MS; the
+ * sample is then dropped and the previous touch state is kept. */
+#define CAPSENSE_I2C_RETRIES_MAX         (3U)
+#define CAPSENSE_I2C_BACKOFF_MS          (1U)
+#define CAPSENSE_I2C_RECOVERY_BUDGET_MS  (10U)
+
+/* Worst case duration of one touch frame read: one operation timing out
+ * plus the bus clear */
+#define CAPSENSE_I2C_ATTEMPT_MAX_MS      (I2C_SEND_RECEIVE_TIMEOUT_MS + 1U)
+
+/* Default period between two CapSense samples. The task blocks between
+ * samples so that the idle task can put the device into deep sleep. */
+#define CAPSENSE_SAMPLE_PERIOD_MS    (20U)
+
+/* Default sample period while a client is subscribed to the raw stream */
+#define CAPSENSE_STREAM_SAMPLE_PERIOD_MS (5U)
+
+/* Default slider and touchpad smoothing, off */
+#define CAPSENSE_POSITION_FILTER     (0U)
+
+/* Fraction bits of the filtered positions */
+#define CAPSENSE_FILTER_FRAC_BITS    (8U)
+
+/* Change counter short read: with frames that carry a change counter, a
+ * poll reads only the counter and reads and decodes the full frame only
+ * when it changed. The full frame is still read every
+ * CAPSENSE_FULL_READ_INTERVAL polls. */
+#define CAPSENSE_SHORT_READ_ENABLE       (1U)
+#define CAPSENSE_FULL_READ_INTERVAL      (50U)
 
 /*******************************************************************************
 * Global Variables
@@ -76,20 +113,652 @@ QueueHandle_t capsense_command_q;
 /* Variables used for storing buttons and slider data */
 capsense_data_t capsense_data = {0};
 
-uint8_t buffer[CAPSENSE_READ_BUFFER_SIZE];
-static uint32_t button0_status;
-static uint32_t button1_status;
-static uint16_t slider_pos;
-static uint32_t button0_status_prev;
-static uint32_t button1_status_prev;
-static uint16_t slider_pos_prev;
-static uint8_t size;
-static uint8_t *data;
+/* Last valid touch frame, kept while the bus is recovering. Starts with no
+ * sensor touched. */
+static capsense_frame_t capsense_frame =
+{
+    .format = CAPSENSE_FRAME_FORMAT_UNKNOWN,
+    .position_max = CAPSENSE_FRAME_LEGACY_SLIDER_MAX,
+};
+
+/* Frame format sent by the PSoC 4000T, detected from the frames read */
+static capsense_frame_format_t capsense_frame_format =
+        CAPSENSE_FRAME_FORMAT_UNKNOWN;
+
+/* Poll counters: polls answered by the change counter alone and polls that
+ * read the full frame, with their CPU cycles including the bus time */
+static struct
+{
+    uint32_t idle_polls;
+    uint32_t full_polls;
+    uint64_t idle_cycles;
+    uint64_t full_cycles;
+    uint32_t polls_since_full_read;
+} capsense_poll_stats;
+
+/* Sensor state of the previous frame */
+static capsense_state_t capsense_state_prev;
+
+#define CAPSENSE_TUNING_LED(name, type, mask, slot, led, gatt)    (led),
+
+/* Runtime parameters, set by i2c_capsense_set_tuning(). The task takes a
+ * copy at the start of every sample. */
+static capsense_tuning_t capsense_tuning =
+{
+    .sample_period_ms = CAPSENSE_SAMPLE_PERIOD_MS,
+    .stream_sample_period_ms = CAPSENSE_STREAM_SAMPLE_PERIOD_MS,
+    .position_filter = CAPSENSE_POSITION_FILTER,
+    .led = { CAPSENSE_SENSOR_TABLE(CAPSENSE_TUNING_LED) },
+};
+
+#undef CAPSENSE_TUNING_LED
+
+/* Filtered positions with CAPSENSE_FILTER_FRAC_BITS fraction bits */
+static uint32_t capsense_position_acc[CAPSENSE_FRAME_POSITIONS_MAX];
+
+#define CAPSENSE_REG_REGION(name, offset, size)     { (offset), (size) },
+
+/* EZI2C register map of the PSoC 4000T */
+static const ezi2c_region_t capsense_reg_map[CAPSENSE_REG_COUNT] =
+{
+    CAPSENSE_REG_MAP(CAPSENSE_REG_REGION)
+};
+
+#undef CAPSENSE_REG_REGION
+
+/* Image of the register map, filled by the region reads */
+static uint8_t capsense_reg_image[CAPSENSE_REG_IMAGE_SIZE];
+
+/* Client of the PSoC 4000T EZI2C slave */
+static ezi2c_client_t capsense_client;
+
+/* I2C controller context, shared with the SysPm callback */
+static cy_stc_scb_i2c_context_t CYBSP_I2C_CONTROLLER_context;
+
+/* SCB and pins of the CapSense I2C bus, for the bus recovery */
+static const i2c_recovery_bus_t capsense_bus =
+{
+    .base       = CYBSP_I2C_CONTROLLER_HW,
+    .context    = &CYBSP_I2C_CONTROLLER_context,
+    .config     = &CYBSP_I2C_CONTROLLER_config,
+    .scl_port   = CYBSP_I2C_SCL_PORT,
+    .scl_pin    = CYBSP_I2C_SCL_PIN,
+    .scl_hsiom  = CYBSP_I2C_SCL_HSIOM,
+    .sda_port   = CYBSP_I2C_SDA_PORT,
+    .sda_pin    = CYBSP_I2C_SDA_PIN,
+    .sda_hsiom  = CYBSP_I2C_SDA_HSIOM,
+};
+
+/* Set while an I2C transaction is in flight to refuse deep sleep entry */
+static volatile bool i2c_transfer_active = false;
+
+#if defined(HOT_PATH_BENCHMARK)
+/* The CapSense task, set once it has initialized the I2C controller */
+static TaskHandle_t volatile capsense_task_handle = NULL;
+#endif
+
+#if (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP)
+
+static cy_en_syspm_status_t i2c_capsense_syspm_callback(
+        cy_stc_syspm_callback_params_t *callbackParams,
+        cy_en_syspm_callback_mode_t mode);
+
+/* SysPm callback parameter structure for the I2C controller */
+static cy_stc_syspm_callback_params_t i2c_syspm_cb_params =
+{
+    .context            = &CYBSP_I2C_CONTROLLER_context,
+    .base               = CYBSP_I2C_CONTROLLER_HW
+};
+
+/* SysPm callback structure for the I2C controller */
+static cy_stc_syspm_callback_t i2c_syspm_cb =
+{
+    .callback           = &i2c_capsense_syspm_callback,
+    .skipMode           = SYSPM_SKIP_MODE,
+    .type               = CY_SYSPM_DEEPSLEEP,
+    .callbackParams     = &i2c_syspm_cb_params,
+    .prevItm            = NULL,
+    .nextItm            = NULL,
+    .order              = SYSPM_CALLBACK_ORDER
+};
+
+#endif /* (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP) */
 
 /*******************************************************************************
 * Function Definitions
 *******************************************************************************/
 
+/*******************************************************************************
+* Function Name: i2c_controller_init
+********************************************************************************
+* Summary:
+*  Initializes and enables the SCB block in I2C master mode. Called once at
+*  task start-up and again on every deep sleep wakeup.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  cy_en_scb_i2c_status_t: Status of the I2C initialization
+*
+*******************************************************************************/
+static cy_en_scb_i2c_status_t i2c_controller_init(void)
+{
+    cy_en_scb_i2c_status_t status;
+
+    /* Initialize and enable the I2C in master mode. */
+    status = Cy_SCB_I2C_Init(CYBSP_I2C_CONTROLLER_HW,
+            &CYBSP_I2C_CONTROLLER_config, &CYBSP_I2C_CONTROLLER_context);
+
+    if (CY_SCB_I2C_SUCCESS == status)
+    {
+        /* Enable I2C master hardware. */
+        Cy_SCB_I2C_Enable(CYBSP_I2C_CONTROLLER_HW);
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: i2c_scb_start
+********************************************************************************
+* Summary:
+*  EZI2C client bus primitives on the SCB I2C master. A START is sent as a
+*  repeated start while the previous transaction is still open.
+*******************************************************************************/
+static cy_en_scb_i2c_status_t i2c_scb_start(void *p_bus, uint8_t address,
+                                            cy_en_scb_i2c_direction_t direction)
+{
+    cy_stc_scb_i2c_context_t *context = (cy_stc_scb_i2c_context_t *) p_bus;
+
+    return (CY_SCB_I2C_IDLE == context->state) ?
+            Cy_SCB_I2C_MasterSendStart(CYBSP_I2C_CONTROLLER_HW, address,
+                    direction, I2C_SEND_RECEIVE_TIMEOUT_MS, context) :
+            Cy_SCB_I2C_MasterSendReStart(CYBSP_I2C_CONTROLLER_HW, address,
+                    direction, I2C_SEND_RECEIVE_TIMEOUT_MS, context);
+}
+
+static cy_en_scb_i2c_status_t i2c_scb_restart(void *p_bus, uint8_t address,
+                                              cy_en_scb_i2c_direction_t direction)
+{
+    return Cy_SCB_I2C_MasterSendReStart(CYBSP_I2C_CONTROLLER_HW, address,
+            direction, I2C_SEND_RECEIVE_TIMEOUT_MS,
+            (cy_stc_scb_i2c_context_t *) p_bus);
+}
+
+static cy_en_scb_i2c_status_t i2c_scb_write_byte(void *p_bus, uint8_t byte)
+{
+    return Cy_SCB_I2C_MasterWriteByte(CYBSP_I2C_CONTROLLER_HW, byte,
+            I2C_SEND_RECEIVE_TIMEOUT_MS, (cy_stc_scb_i2c_context_t *) p_bus);
+}
+
+static cy_en_scb_i2c_status_t i2c_scb_read_byte(void *p_bus, uint8_t *p_byte,
+                                                bool ack)
+{
+    return Cy_SCB_I2C_MasterReadByte(CYBSP_I2C_CONTROLLER_HW,
+            ack ? CY_SCB_I2C_ACK : CY_SCB_I2C_NAK, p_byte,
+            I2C_SEND_RECEIVE_TIMEOUT_MS, (cy_stc_scb_i2c_context_t *) p_bus);
+}
+
+/* SCB in I2C mode is very time sensitive. In practice we have to request
+ * STOP after each block, otherwise it may break the transmission. */
+static void i2c_scb_stop(void *p_bus)
+{
+    (void) Cy_SCB_I2C_MasterSendStop(CYBSP_I2C_CONTROLLER_HW,
+            I2C_SEND_RECEIVE_TIMEOUT_MS, (cy_stc_scb_i2c_context_t *) p_bus);
+}
+
+static const ezi2c_bus_ops_t i2c_scb_ops =
+{
+    .start      = i2c_scb_start,
+    .restart    = i2c_scb_restart,
+    .write_byte = i2c_scb_write_byte,
+    .read_byte  = i2c_scb_read_byte,
+    .stop       = i2c_scb_stop,
+};
+
+/*******************************************************************************
+* Function Name: capsense_frame_region
+********************************************************************************
+* Summary:
+*  Returns the region to read for the touch frame: the short legacy frame or
+*  the binary frame body once the format is known, else the largest frame,
+*  so that the format can be detected.
+*******************************************************************************/
+static uint32_t capsense_frame_region(void)
+{
+    uint32_t region;
+
+    switch (capsense_frame_format)
+    {
+        case CAPSENSE_FRAME_FORMAT_LEGACY:
+            region = EZI2C_REGION_MASK(CAPSENSE_REG_FRAME_LEGACY);
+            break;
+
+        case CAPSENSE_FRAME_FORMAT_V1:
+            /* Starts at the change counter, like the short read, so that
+             * neither needs an offset write */
+            region = EZI2C_REGION_MASK(CAPSENSE_REG_FRAME_BODY);
+            break;
+
+        default:
+            region = EZI2C_REGION_MASK(CAPSENSE_REG_FRAME);
+            break;
+    }
+
+    return region;
+}
+
+/*******************************************************************************
+* Function Name: capsense_frame_update
+********************************************************************************
+* Summary:
+*  Decodes the touch frame in the register image. A valid frame replaces the
+*  current one. A frame that does not decode in the expected format may come
+*  from re-flashed PSoC 4000T firmware, so the format is detected again.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true when the frame was valid
+*
+*******************************************************************************/
+static bool capsense_frame_update(void)
+{
+    capsense_frame_t frame;
+    bool valid;
+
+    if (CAPSENSE_FRAME_FORMAT_V1 == capsense_frame_format)
+    {
+        valid = capsense_frame_decode_v1_body(
+                &capsense_reg_image[CAPSENSE_COUNTER_OFFSET], &frame);
+    }
+    else
+    {
+        valid = capsense_frame_decode(
+                &capsense_reg_image[CAPSENSE_FRAME_OFFSET],
+                capsense_frame_size(capsense_frame_format), &frame);
+    }
+
+    if (!valid)
+    {
+        capsense_frame_format = CAPSENSE_FRAME_FORMAT_UNKNOWN;
+        return false;
+    }
+
+    if (frame.format != capsense_frame_format)
+    {
+        printf("CapSense frame format: %s\r\n",
+               capsense_frame_format_name(frame.format));
+        capsense_frame_format = frame.format;
+    }
+
+    capsense_frame = frame;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: capsense_frame_unchanged
+********************************************************************************
+* Summary:
+*  Short read of the change counter. Returns true when the counter matches
+*  the current frame, so the full frame does not need to be read. Read
+*  errors return false and are handled by the full frame read. While the
+*  position filter runs on a touched slider or touchpad, every sample is a
+*  full read so that the filtered position settles.
+*
+* Parameters:
+*  const capsense_tuning_t *p_tuning : Parameters of this sample
+*
+* Return:
+*  bool: true when the sensor state did not change
+*
+*******************************************************************************/
+static bool capsense_frame_unchanged(const capsense_tuning_t *p_tuning)
+{
+    uint32_t regions_read;
+
+    if ((0U == CAPSENSE_SHORT_READ_ENABLE) || !capsense_frame.has_counter ||
+            ((0U != p_tuning->position_filter) &&
+             (0U != (capsense_state_prev.touched & ~CAPSENSE_BUTTON_MASK))) ||
+            (CAPSENSE_FRAME_FORMAT_V1 != capsense_frame_format) ||
+            (capsense_poll_stats.polls_since_full_read >=
+             CAPSENSE_FULL_READ_INTERVAL))
+    {
+        return false;
+    }
+
+    i2c_transfer_active = true;
+    regions_read = ezi2c_client_read_regions(&capsense_client,
+            capsense_reg_map, CAPSENSE_REG_COUNT,
+            EZI2C_REGION_MASK(CAPSENSE_REG_COUNTER), capsense_reg_image);
+    i2c_transfer_active = false;
+
+    return (0U != regions_read) &&
+           (capsense_reg_image[CAPSENSE_COUNTER_OFFSET] ==
+            capsense_frame.counter);
+}
+
+/*******************************************************************************
+* Function Name: i2c_capsense_read
+********************************************************************************
+* Summary:
+*  Reads the touch frame and the given other regions of the register map
+*  and decodes the frame. When the touch frame cannot
+*  be read or is out of range, the error is counted and the touch frame is
+*  read again after a backoff of 1, 2, 4 ms. Errors that may leave the bus
+*  held low also clear the bus and re-initialize the SCB. The sample is
+*  given up once the next attempt could exceed the recovery budget, or when
+*  the bus clear fails; the next sample starts over.
+*
+* Parameters:
+*  uint32_t regions : EZI2C_REGION_MASK() of the other regions to read
+*
+* Return:
+*  uint32_t: Mask of the regions read; the touch frame bit is only set for
+*            a valid frame, which is then in capsense_frame
+*
+*******************************************************************************/
+static uint32_t i2c_capsense_read(uint32_t regions)
+{
+    uint32_t backoff_ms = CAPSENSE_I2C_BACKOFF_MS;
+    TickType_t first_error = 0U;
+    uint32_t regions_read;
+
+    regions |= capsense_frame_region();
+
+    for (uint32_t attempt = 0U; ; attempt++)
+    {
+        i2c_recovery_error_t error;
+        uint32_t elapsed_ms;
+
+        /* Block deep sleep entry until the STOP condition is sent */
+        i2c_transfer_active = true;
+        regions_read = ezi2c_client_read_regions(&capsense_client,
+                capsense_reg_map, CAPSENSE_REG_COUNT, regions,
+                capsense_reg_image);
+        i2c_transfer_active = false;
+
+        if (0U == (regions_read & CAPSENSE_REG_FRAMES))
+        {
+            error = i2c_recovery_classify(capsense_client.last_error);
+        }
+        else if (!capsense_frame_update())
+        {
+            regions_read &= ~CAPSENSE_REG_FRAMES;
+            error = I2C_RECOVERY_ERR_FRAME;
+        }
+        else
+        {
+            /* Other regions are best effort and not retried */
+            if (regions_read != regions)
+            {
+                i2c_recovery_count_error(
+                        i2c_recovery_classify(capsense_client.last_error));
+            }
+
+            if (0U != attempt)
+            {
+                i2c_recovery_count_result(true, (xTaskGetTickCount() -
+                        first_error) * portTICK_PERIOD_MS);
+            }
+            break;
+        }
+
+        i2c_recovery_count_error(error);
+
+        if (0U == attempt)
+        {
+            first_error = xTaskGetTickCount();
+        }
+        elapsed_ms = (xTaskGetTickCount() - first_error) * portTICK_PERIOD_MS;
+
+        if ((attempt >= CAPSENSE_I2C_RETRIES_MAX) ||
+                ((elapsed_ms + backoff_ms + CAPSENSE_I2C_ATTEMPT_MAX_MS) >
+                 CAPSENSE_I2C_RECOVERY_BUDGET_MS))
+        {
+            i2c_recovery_count_result(false, elapsed_ms);
+            break;
+        }
+
+        if (i2c_recovery_needs_bus_clear(error))
+        {
+            /* The slave may have seen a partial offset write */
+            ezi2c_client_invalidate(&capsense_client);
+
+            if (CY_SCB_I2C_SUCCESS != i2c_recovery_clear_bus(&capsense_bus))
+            {
+                /* Counted as stuck; the next period clears it again */
+                i2c_recovery_count_result(false, elapsed_ms);
+                break;
+            }
+        }
+
+        /* Retry the touch frame only */
+        regions = capsense_frame_region();
+        vTaskDelay(pdMS_TO_TICKS(backoff_ms));
+        backoff_ms *= 2U;
+        i2c_recovery_count_retry();
+    }
+
+    return regions_read;
+}
+
+#if (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP)
+
+/*******************************************************************************
+* Function Name: i2c_capsense_syspm_callback
+********************************************************************************
+* Summary:
+*  Deep sleep callback for the I2C controller.
+*  1. CHECK_READY refuses the transition while a transaction is in flight or
+*     the bus is still busy.
+*  2. BEFORE_TRANSITION disables the SCB so that it enters deep sleep idle.
+*  3. AFTER_TRANSITION re-initializes the SCB from the configurator settings,
+*     so the next sample can start immediately after wakeup.
+*
+* Parameters:
+*  cy_stc_syspm_callback_params_t *callbackParams : SysPm callback parameters
+*  cy_en_syspm_callback_mode_t mode               : SysPm callback mode
+*
+* Return:
+*  cy_en_syspm_status_t: CY_SYSPM_SUCCESS or CY_SYSPM_FAIL
+*
+*******************************************************************************/
+static cy_en_syspm_status_t i2c_capsense_syspm_callback(
+        cy_stc_syspm_callback_params_t *callbackParams,
+        cy_en_syspm_callback_mode_t mode)
+{
+    cy_en_syspm_status_t retVal = CY_SYSPM_SUCCESS;
+    CySCB_Type *base = (CySCB_Type *) callbackParams->base;
+    cy_stc_scb_i2c_context_t *context =
+            (cy_stc_scb_i2c_context_t *) callbackParams->context;
+
+    switch (mode)
+    {
+        case CY_SYSPM_CHECK_READY:
+            /* Do not enter deep sleep in the middle of a transaction */
+            if (i2c_transfer_active ||
+                    (CY_SCB_I2C_IDLE != context->state) ||
+                    Cy_SCB_I2C_IsBusBusy(base))
+            {
+                retVal = CY_SYSPM_FAIL;
+            }
+            break;
+
+        case CY_SYSPM_CHECK_FAIL:
+            /* Nothing was changed in CHECK_READY, nothing to undo */
+            break;
+
+        case CY_SYSPM_BEFORE_TRANSITION:
+            Cy_SCB_I2C_Disable(base, context);
+            break;
+
+        case CY_SYSPM_AFTER_TRANSITION:
+            if (CY_SCB_I2C_SUCCESS != i2c_controller_init())
+            {
+                retVal = CY_SYSPM_FAIL;
+            }
+            break;
+
+        default:
+            retVal = CY_SYSPM_FAIL;
+            break;
+    }
+
+    return retVal;
+}
+
+#endif /* (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP) */
+
+/*******************************************************************************
+* Function Name: capsense_position_filter
+********************************************************************************
+* Summary:
+*  Smooths the positions of the touched sliders and touchpads with an
+*  exponential moving average: each sample moves the position by 1/2^n of
+*  the distance to the new value. A new touch starts at its raw position.
+*
+* Parameters:
+*  capsense_state_t *p_state : Sensor state, the positions are replaced
+*  uint8_t strength          : Filter strength n, 0 turns the filter off
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void capsense_position_filter(capsense_state_t *p_state,
+                                     uint8_t strength)
+{
+    for (uint32_t i = 0U; i < CAPSENSE_SENSOR_COUNT; i++)
+    {
+        uint32_t mask = 1UL << i;
+        uint32_t first = capsense_sensors.slot[i];
+        uint32_t last = first + (uint32_t) (CAPSENSE_SENSOR_TOUCHPAD ==
+                                            capsense_sensors.type[i]);
+        bool new_touch = (0U == (capsense_state_prev.touched & mask));
+
+        if ((CAPSENSE_SENSOR_BUTTON == capsense_sensors.type[i]) ||
+                (0U == (p_state->touched & mask)))
+        {
+            continue;
+        }
+
+        for (uint32_t slot = first; slot <= last; slot++)
+        {
+            uint32_t in = (uint32_t) p_state->position[slot] <<
+                    CAPSENSE_FILTER_FRAC_BITS;
+            uint32_t acc = capsense_position_acc[slot];
+
+            acc = ((0U == strength) || new_touch) ? in :
+                    (acc - (acc >> strength) + (in >> strength));
+            capsense_position_acc[slot] = acc;
+            p_state->position[slot] = (uint8_t) ((acc +
+                    (1UL << (CAPSENSE_FILTER_FRAC_BITS - 1U))) >>
+                    CAPSENSE_FILTER_FRAC_BITS);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: capsense_frame_process
+********************************************************************************
+* Summary:
+*  Detects new touches and moves in the current frame with the sensor model
+*  and sends the LED command the tuning assigns and the BLE notification the
+*  sensor table assigns to them.
+*
+* Parameters:
+*  const capsense_tuning_t *p_tuning : Parameters of this sample
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void capsense_frame_process(const capsense_tuning_t *p_tuning)
+{
+    /* Variables used for storing command and data for LED Task */
+    led_command_data_t led_cmd_data;
+    bool send_led_command = false;
+    bool send_bt_command = false;
+
+    capsense_state_t state;
+    uint32_t events;
+    uint32_t sample_time_us = 0U;
+
+    capsense_model_decode(&capsense_frame, &state);
+    capsense_position_filter(&state, p_tuning->position_filter);
+    events = capsense_model_events(&capsense_state_prev, &state);
+
+    /* Sample time of the frame, sent with the extended payload format */
+    if (0U != events)
+    {
+        sample_time_us = bt_time_now_us();
+    }
+
+#if defined(BT_PERIODIC_ADV)
+    bt_periodic_publish(&capsense_state_prev, &state, events);
+#endif
+
+    /* Handle the sensors in table order, the last LED command wins */
+    while (0U != events)
+    {
+        uint32_t id = __CLZ(__RBIT(events));
+        uint8_t position = state.position[capsense_sensors.slot[id]];
+        uint8_t led = p_tuning->led[id];
+        uint8_t gatt = capsense_sensors.gatt[id];
+
+        events &= events - 1U;
+
+        if (CAPSENSE_LED_NONE != led)
+        {
+            led_cmd_data.command = (led_command_t) led;
+            led_cmd_data.brightness = position;
+            send_led_command = true;
+        }
+
+        if (CAPSENSE_GATT_SLIDER == gatt)
+        {
+            capsense_data.sliderdata = position;
+            capsense_data.slider_time_us = sample_time_us;
+            send_bt_command = true;
+        }
+        else if (CAPSENSE_GATT_NONE != gatt)
+        {
+            capsense_data.buttonstatus1 = gatt;
+            capsense_data.button_time_us = sample_time_us;
+            send_bt_command = true;
+        }
+    }
+
+    /* Released buttons are only advertised, wake up the BT task for them */
+    if (capsense_data.buttons != (state.touched & CAPSENSE_BUTTON_MASK))
+    {
+        capsense_data.buttons = state.touched & CAPSENSE_BUTTON_MASK;
+        if (!send_bt_command)
+        {
+            xTaskNotify(bt_task_handle, NOTIFIY_OFF, eNoAction);
+        }
+    }
+
+    /* Send command to update LED state */
+    if(send_led_command)
+    {
+        xQueueSendToBack(led_command_data_q, &led_cmd_data,
+                XQUEUE_TICKS_TO_WAIT);
+    }
+
+    if(send_bt_command)
+    {
+        xTaskNotify(bt_task_handle, XTASK_NOTIFY_UL_VALUE,
+                eSetValueWithOverwrite);
+    }
+
+    /* Update previous touch status */
+    capsense_state_prev = state;
+}
+
 /*******************************************************************************
 * Function Name: capsense_task
 ********************************************************************************
@@ -108,131 +777,270 @@ static uint8_t *data;
 void i2c_capsense_task(void* param)
 {
     cy_en_scb_i2c_status_t initStatus;
-    cy_stc_scb_i2c_context_t CYBSP_I2C_CONTROLLER_context;
+    TickType_t last_wake_time;
+
+    /* Suppress warning for unused parameter */
+    CY_UNUSED_PARAMETER(param);
 
     /* Initialize and enable the I2C in master mode. */
-    initStatus = Cy_SCB_I2C_Init(CYBSP_I2C_CONTROLLER_HW,
-            &CYBSP_I2C_CONTROLLER_config, &CYBSP_I2C_CONTROLLER_context);
+    initStatus = i2c_controller_init();
 
     if(initStatus != CY_SCB_I2C_SUCCESS)
     {
         CY_ASSERT(0u);
     }
 
-    /* Enable I2C master hardware. */
-    Cy_SCB_I2C_Enable(CYBSP_I2C_CONTROLLER_HW);
+#if (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP)
+
+    /* SysPm callback registration for the I2C controller */
+    Cy_SysPm_RegisterCallback(&i2c_syspm_cb);
+
+#endif /* (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP) */
+
+    /* Enable the DWT cycle counter for the poll statistics */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    ezi2c_client_init(&capsense_client, &i2c_scb_ops,
+                      &CYBSP_I2C_CONTROLLER_context, I2C_SLAVE_ADDRESS);
+
+#if defined(EZI2C_CLIENT_BENCHMARK)
+    /* Measure the bus time of the register map reads */
+    ezi2c_client_benchmark();
+#endif
+
+#if defined(HOT_PATH_BENCHMARK)
+    /* The benchmark may take over the bus from now on */
+    capsense_task_handle = xTaskGetCurrentTaskHandle();
+#endif
+
+    last_wake_time = xTaskGetTickCount();
 
     for(;;)
     {
-        /* Variables used for storing command and data for LED Task */
-        led_command_data_t led_cmd_data;
-        bool send_led_command = false;
-        bool send_bt_command = false;
+        uint32_t regions = 0U;
+        uint32_t regions_read;
+        bool diag_due = capsense_diag_is_due();
+        uint32_t poll_start = DWT->CYCCNT;
+        capsense_tuning_t tuning;
+        bool unchanged;
 
-        cy_en_scb_i2c_command_t ack = CY_SCB_I2C_ACK;
-        size =CAPSENSE_READ_BUFFER_SIZE;
-        data = &buffer[BUTTON0_INDEX];
+        /* Parameters of this sample, changed as one set */
+        taskENTER_CRITICAL();
+        tuning = capsense_tuning;
+        taskEXIT_CRITICAL();
 
-        /* Start transaction, send dev_addr */
-        cy_en_scb_i2c_status_t status = CYBSP_I2C_CONTROLLER_context.state ==
-                CY_SCB_I2C_IDLE ? Cy_SCB_I2C_MasterSendStart(CYBSP_I2C_CONTROLLER_HW,
-                I2C_SLAVE_ADDRESS, CY_SCB_I2C_READ_XFER, I2C_SEND_RECEIVE_TIMEOUT_MS,
-                &CYBSP_I2C_CONTROLLER_context):
-        Cy_SCB_I2C_MasterSendReStart(CYBSP_I2C_CONTROLLER_HW,
-                I2C_SLAVE_ADDRESS, CY_SCB_I2C_READ_XFER,
-                I2C_SEND_RECEIVE_TIMEOUT_MS, &CYBSP_I2C_CONTROLLER_context);
+        /* Read the sensor data in the same pass when it is due */
+        if (diag_due)
+        {
+            regions |= EZI2C_REGION_MASK(CAPSENSE_REG_DIAG);
+        }
 
-        if (CY_SCB_I2C_SUCCESS == status)
+        /* Skip the frame read and the touch detection while the change
+         * counter is unchanged */
+        unchanged = capsense_frame_unchanged(&tuning);
+        if (unchanged)
         {
-            while (size > I2C_READ_SIZE_MIN) 
+            capsense_poll_stats.polls_since_full_read++;
+            capsense_poll_stats.idle_polls++;
+            capsense_poll_stats.idle_cycles += DWT->CYCCNT - poll_start;
+
+            /* Only the regions other than the frame are left to read */
+            regions_read = EZI2C_REGION_MASK(CAPSENSE_REG_COUNTER);
+            if (0U != regions)
             {
-                if (size == I2C_READ_SIZE_MAX)
-                {
-                    ack = CY_SCB_I2C_NAK;
-                }
-                status = Cy_SCB_I2C_MasterReadByte(CYBSP_I2C_CONTROLLER_HW, ack,
-                        (uint8_t *) data,I2C_SEND_RECEIVE_TIMEOUT_MS,
-                        &CYBSP_I2C_CONTROLLER_context);
-                if (status != CY_SCB_I2C_SUCCESS)
-                {
-                    break;
-                }
-                ++data;
-                --size;
+                i2c_transfer_active = true;
+                regions_read |= ezi2c_client_read_regions(&capsense_client,
+                        capsense_reg_map, CAPSENSE_REG_COUNT, regions,
+                        capsense_reg_image);
+                i2c_transfer_active = false;
             }
         }
-        /* SCB in I2C mode is very time sensitive. In practice we
-         * have to request STOP after each block, otherwise it may break
-         * the transmission 
-         */
-        Cy_SCB_I2C_MasterSendStop(CYBSP_I2C_CONTROLLER_HW,
-                I2C_SEND_RECEIVE_TIMEOUT_MS, &CYBSP_I2C_CONTROLLER_context);
-
-       /* Subtract the received ASCII value with the integer
-        * ASCII difference to obtain the integer value
-        */
-        buffer[BUTTON0_INDEX]-=INTERGER_ASCII_DIFFERENCE;
-        buffer[BUTTON1_INDEX]-=INTERGER_ASCII_DIFFERENCE;
-
-        /* Copy the value in the received buffer to the status variable */
-        button0_status = buffer[BUTTON0_INDEX];
-        button1_status = buffer[BUTTON1_INDEX];
-        slider_pos = buffer[SLIDER_INDEX];
-
-        /* Detect new touch on Button0 */
-        if ((CAPSENSE_BTN0_NOT_PRESSED != button0_status)
-                &&(CAPSENSE_BTN0_NOT_PRESSED == button0_status_prev))
-        {
-            led_cmd_data.command = LED_TURN_ON;
-            send_led_command = true;
-            capsense_data.buttonstatus1 = CAPSENSE_BTN0_PRESSED;
-            send_bt_command = true;
-        }
-
-        /* Detect new touch on Button1 */
-        if ((CAPSENSE_BTN1_NOT_PRESSED != button1_status) &&
-                (CAPSENSE_BTN1_NOT_PRESSED == button1_status_prev))
+        else
         {
-            led_cmd_data.command = LED_TURN_OFF;
-            send_led_command = true;
-            capsense_data.buttonstatus1 = CAPSENSE_BTN1_PRESSED;
-            send_bt_command = true;
+            /* Without a valid frame, capsense_frame keeps the last touch
+             * state, so a bus error cannot fire a touch event */
+            regions_read = i2c_capsense_read(regions);
+            if (0U != (regions_read & CAPSENSE_REG_FRAMES))
+            {
+                capsense_poll_stats.polls_since_full_read = 0U;
+                capsense_frame_process(&tuning);
+            }
+
+            capsense_poll_stats.full_polls++;
+            capsense_poll_stats.full_cycles += DWT->CYCCNT - poll_start;
         }
 
-        /* Detect the new touch on slider */
-        if ((SLIDER_POS_NOT_CHANGED != slider_pos) && (slider_pos
-                != slider_pos_prev))
+        /* Queue the frame for the stream characteristic */
+        if ((unchanged || (0U != (regions_read & CAPSENSE_REG_FRAMES))) &&
+                bt_stream_is_enabled())
         {
-            led_cmd_data.command = LED_SET_BRIGHTNESS;
+            uint8_t sample[BT_STREAM_SAMPLE_SIZE];
 
-            /* Setting brightness value */
-            led_cmd_data.brightness = slider_pos;
-            send_led_command = true;
+            sample[STREAM_SENSORS_INDEX] = (uint8_t) capsense_frame.sensors;
+            sample[STREAM_SLIDER_INDEX] = (uint8_t)
+                    capsense_frame.position[CAPSENSE_FRAME_SLIDER_SLOT];
+            sample[STREAM_SLIDER_INDEX + 1U] = (uint8_t)
+                    (capsense_frame.position[CAPSENSE_FRAME_SLIDER_SLOT] >> 8U);
+            bt_stream_push(sample);
+        }
 
-            /* Setting ble app data value */
-            capsense_data.sliderdata = slider_pos;
-            send_bt_command = true;
+        /* Keep the short connection interval while a sensor is touched */
+        if (0U != capsense_frame.sensors)
+        {
+            bt_conn_param_on_touch();
         }
 
-        /* Send command to update LED state */
-        if(send_led_command)
+        /* Hand the sensor data to the diagnostics task */
+        if (diag_due &&
+                (0U != (regions_read & EZI2C_REGION_MASK(CAPSENSE_REG_DIAG))))
         {
-            xQueueSendToBack(led_command_data_q, &led_cmd_data,
-                    XQUEUE_TICKS_TO_WAIT);
+            capsense_diag_submit(&capsense_reg_image[CAPSENSE_DIAG_OFFSET]);
         }
 
-        if(send_bt_command)
+        /* Sleep until the next sample is due. The system may enter deep
+         * sleep here when no other task is ready to run. */
+        vTaskDelayUntil(&last_wake_time,
+                pdMS_TO_TICKS(bt_stream_is_enabled() ?
+                        tuning.stream_sample_period_ms :
+                        tuning.sample_period_ms));
+    }
+}
+
+/*******************************************************************************
+* Function Name: i2c_capsense_print_stats
+********************************************************************************
+* Summary:
+*  Prints the poll counters on the debug console: polls answered by the
+*  change counter, full frame reads, bus bytes saved compared to reading the
+*  full frame every poll, and the average CPU cycles of both kinds of poll.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void i2c_capsense_print_stats(void)
+{
+    uint32_t idle_polls = capsense_poll_stats.idle_polls;
+    uint32_t full_polls = capsense_poll_stats.full_polls;
+
+    printf("CapSense polls: %lu idle, %lu full, %lu bus bytes saved, "
+           "%lu cycles/idle poll, %lu cycles/full poll\r\n",
+           (unsigned long) idle_polls, (unsigned long) full_polls,
+           (unsigned long) (idle_polls * (CAPSENSE_FRAME_V1_BODY_SIZE -
+                                          CAPSENSE_COUNTER_SIZE)),
+           (unsigned long) ((0U != idle_polls) ?
+                   (capsense_poll_stats.idle_cycles / idle_polls) : 0U),
+           (unsigned long) ((0U != full_polls) ?
+                   (capsense_poll_stats.full_cycles / full_polls) : 0U));
+}
+
+/*******************************************************************************
+* Function Name: i2c_capsense_get_tuning
+********************************************************************************
+* Summary:
+*  Returns the current runtime parameters of the pipeline.
+*
+* Parameters:
+*  capsense_tuning_t *p_tuning : Parameters destination
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void i2c_capsense_get_tuning(capsense_tuning_t *p_tuning)
+{
+    taskENTER_CRITICAL();
+    *p_tuning = capsense_tuning;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: i2c_capsense_set_tuning
+********************************************************************************
+* Summary:
+*  Replaces the runtime parameters of the pipeline. The CapSense task uses
+*  the new set from its next sample on; a sample never mixes old and new
+*  parameters. The caller validates the values.
+*
+* Parameters:
+*  const capsense_tuning_t *p_tuning : New parameters
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void i2c_capsense_set_tuning(const capsense_tuning_t *p_tuning)
+{
+    taskENTER_CRITICAL();
+    capsense_tuning = *p_tuning;
+    taskEXIT_CRITICAL();
+}
+
+#if defined(HOT_PATH_BENCHMARK)
+
+/*******************************************************************************
+* Function Name: i2c_capsense_bench_begin
+********************************************************************************
+* Summary:
+*  Suspends the CapSense task between two transactions, so that the
+*  benchmark has the I2C controller to itself. Waits until the task has
+*  initialized the controller. The task is not resumed; the benchmark build
+*  halts after the results.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void i2c_capsense_bench_begin(void)
+{
+    while (NULL == capsense_task_handle)
+    {
+        vTaskDelay(pdMS_TO_TICKS(1U));
+    }
+
+    for (;;)
+    {
+        vTaskSuspend(capsense_task_handle);
+        if (!i2c_transfer_active)
         {
-            xTaskNotify(bt_task_handle, XTASK_NOTIFY_UL_VALUE,
-                    eSetValueWithoutOverwrite);
+            break;
         }
 
-        /* Update previous touch status */
-        button0_status_prev = button0_status;
-        button1_status_prev = button1_status;
-        slider_pos_prev = slider_pos;
+        /* Let the task finish the transaction */
+        vTaskResume(capsense_task_handle);
+        vTaskDelay(pdMS_TO_TICKS(1U));
     }
 }
 
+/*******************************************************************************
+* Function Name: i2c_capsense_bench_read
+********************************************************************************
+* Summary:
+*  Reads the touch frame once, as a sample does, without the retries.
+*  Called after i2c_capsense_bench_begin().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true when the frame was read
+*
+*******************************************************************************/
+bool i2c_capsense_bench_read(void)
+{
+    uint32_t regions = capsense_frame_region();
+
+    return regions == ezi2c_client_read_regions(&capsense_client,
+            capsense_reg_map, CAPSENSE_REG_COUNT, regions, capsense_reg_image);
+}
+
+#endif /* defined(HOT_PATH_BENCHMARK) */
 
 /* END OF FILE [] */
@@ -45,9 +45,12 @@
 /*******************************************************************************
 * Header file includes
 *******************************************************************************/
+#include <stdbool.h>
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
+#include "cybsp.h"
+#include "capsense_model.h"
 
 /*******************************************************************************
 * Global Constants
@@ -57,9 +60,25 @@ typedef struct
 {
     uint8_t sliderdata;         /* Contains CapSense slider data */
     uint8_t buttoncount;        /* Contains CapSense button count */
-    uint8_t buttonstatus1;      /* Contains CapSense button status  */
+    uint8_t buttonstatus1;      /* Number of the last touched button */
+    uint32_t buttons;           /* Touched buttons, CAPSENSE_SENSOR_MASK_xx */
+    uint32_t slider_time_us;    /* Sample time of sliderdata, bt_time_now_us */
+    uint32_t button_time_us;    /* Sample time of buttonstatus1 */
 }capsense_data_t;
 
+/* Pipeline parameters that can be changed at runtime, see
+ * i2c_capsense_set_tuning() */
+typedef struct
+{
+    uint16_t sample_period_ms;          /* Sample period */
+    uint16_t stream_sample_period_ms;   /* Sample period while streaming */
+    uint8_t position_filter;            /* Slider and touchpad smoothing:
+                                         * 0 is off, n averages over about
+                                         * 2^n samples */
+    uint8_t led[CAPSENSE_SENSOR_COUNT]; /* led_command_t of each sensor, or
+                                         * CAPSENSE_LED_NONE */
+} capsense_tuning_t;
+
 /*******************************************************************************
 * Global Variables
 *******************************************************************************/
@@ -70,6 +89,13 @@ extern capsense_data_t capsense_data;
 * Function Prototypes
 *******************************************************************************/
 void i2c_capsense_task(void* param);
+void i2c_capsense_print_stats(void);
+void i2c_capsense_get_tuning(capsense_tuning_t *p_tuning);
+void i2c_capsense_set_tuning(const capsense_tuning_t *p_tuning);
+#if defined(HOT_PATH_BENCHMARK)
+void i2c_capsense_bench_begin(void);
+bool i2c_capsense_bench_read(void);
+#endif
 
 
 #endif /* CAPSENSE_H */
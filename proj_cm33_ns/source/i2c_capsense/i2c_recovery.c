@@ -0,0 +1,329 @@
+/*******************************************************************************
+* File Name: i2c_recovery.c
+*
+* Description: This file contains the I2C error accounting and bus recovery
+*              used by the CapSense task: classification and counting of errors,
+*              and the release of a bus held low by a slave by clocking SCL nine
+*              times, sending STOP and re-initializing the SCB.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "i2c_recovery.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* A slave holding SDA low releases it within one byte and the ACK bit */
+#define I2C_RECOVERY_SCL_PULSES             (9U)
+
+/* Half period of the recovery clock, 100 kHz */
+#define I2C_RECOVERY_HALF_PERIOD_US         (5U)
+
+#define GPIO_LOW                            (0U)
+#define GPIO_HIGH                           (1U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static i2c_recovery_stats_t recovery_stats;
+
+static const char *const recovery_error_names[I2C_RECOVERY_ERR_COUNT] =
+{
+    [I2C_RECOVERY_ERR_ADDR_NAK]  = "addr nak",
+    [I2C_RECOVERY_ERR_DATA_NAK]  = "data nak",
+    [I2C_RECOVERY_ERR_ARB_LOST]  = "arb lost",
+    [I2C_RECOVERY_ERR_BUS_ERROR] = "bus error",
+    [I2C_RECOVERY_ERR_TIMEOUT]   = "timeout",
+    [I2C_RECOVERY_ERR_FRAME]     = "bad frame",
+    [I2C_RECOVERY_ERR_OTHER]     = "other",
+};
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: i2c_recovery_classify
+********************************************************************************
+* Summary:
+*  Maps a failed SCB I2C master status to an error class.
+*
+* Parameters:
+*  cy_en_scb_i2c_status_t status : Status of the failed operation
+*
+* Return:
+*  i2c_recovery_error_t: Error class
+*
+*******************************************************************************/
+i2c_recovery_error_t i2c_recovery_classify(cy_en_scb_i2c_status_t status)
+{
+    i2c_recovery_error_t error;
+
+    switch (status)
+    {
+        case CY_SCB_I2C_MASTER_MANUAL_ADDR_NAK:
+            error = I2C_RECOVERY_ERR_ADDR_NAK;
+            break;
+
+        case CY_SCB_I2C_MASTER_MANUAL_NAK:
+            error = I2C_RECOVERY_ERR_DATA_NAK;
+            break;
+
+        case CY_SCB_I2C_MASTER_MANUAL_ARB_LOST:
+            error = I2C_RECOVERY_ERR_ARB_LOST;
+            break;
+
+        case CY_SCB_I2C_MASTER_MANUAL_BUS_ERR:
+            error = I2C_RECOVERY_ERR_BUS_ERROR;
+            break;
+
+        case CY_SCB_I2C_MASTER_MANUAL_TIMEOUT:
+            error = I2C_RECOVERY_ERR_TIMEOUT;
+            break;
+
+        default:
+            error = I2C_RECOVERY_ERR_OTHER;
+            break;
+    }
+
+    return error;
+}
+
+/*******************************************************************************
+* Function Name: i2c_recovery_needs_bus_clear
+********************************************************************************
+* Summary:
+*  Returns true for errors that may leave the bus or the SCB in a bad state.
+*  A NAK or an out of range frame ends the transaction cleanly and only
+*  needs a retry.
+*******************************************************************************/
+bool i2c_recovery_needs_bus_clear(i2c_recovery_error_t error)
+{
+    return (I2C_RECOVERY_ERR_ADDR_NAK != error) &&
+           (I2C_RECOVERY_ERR_DATA_NAK != error) &&
+           (I2C_RECOVERY_ERR_FRAME != error);
+}
+
+/*******************************************************************************
+* Function Name: i2c_recovery_count_error
+********************************************************************************
+* Summary:
+*  Counts one error of the given class.
+*******************************************************************************/
+void i2c_recovery_count_error(i2c_recovery_error_t error)
+{
+    taskENTER_CRITICAL();
+    recovery_stats.errors[error]++;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: i2c_recovery_count_retry
+********************************************************************************
+* Summary:
+*  Counts one repeated read.
+*******************************************************************************/
+void i2c_recovery_count_retry(void)
+{
+    taskENTER_CRITICAL();
+    recovery_stats.retries++;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: i2c_recovery_count_result
+********************************************************************************
+* Summary:
+*  Records the outcome of a sample that needed recovery.
+*
+* Parameters:
+*  bool success         : false when the time budget ran out
+*  uint32_t recovery_ms : Time from the first error to the outcome
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void i2c_recovery_count_result(bool success, uint32_t recovery_ms)
+{
+    taskENTER_CRITICAL();
+    if (!success)
+    {
+        recovery_stats.budget_exhausted++;
+    }
+    if (recovery_ms > recovery_stats.max_recovery_ms)
+    {
+        recovery_stats.max_recovery_ms = recovery_ms;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: i2c_recovery_clear_bus
+********************************************************************************
+* Summary:
+*  Releases a bus held low by a slave that lost track of the transfer:
+*  1. Disables the SCB and takes over SCL and SDA as open drain GPIOs.
+*  2. Clocks SCL up to nine times until the slave releases SDA.
+*  3. Sends a STOP condition.
+*  4. Gives the pins back to the SCB and re-initializes it.
+*  Takes at most about 110 us. A bus still held low or a failed
+*  re-initialization is counted as stuck.
+*
+* Parameters:
+*  const i2c_recovery_bus_t *p_bus : SCB and pins of the bus
+*
+* Return:
+*  cy_en_scb_i2c_status_t: Status of the SCB re-initialization, or
+*                          CY_SCB_I2C_MASTER_MANUAL_BUS_ERR when SDA is
+*                          still low
+*
+*******************************************************************************/
+cy_en_scb_i2c_status_t i2c_recovery_clear_bus(const i2c_recovery_bus_t *p_bus)
+{
+    uint32_t scl_drivemode = Cy_GPIO_GetDrivemode(p_bus->scl_port,
+                                                  p_bus->scl_pin);
+    uint32_t sda_drivemode = Cy_GPIO_GetDrivemode(p_bus->sda_port,
+                                                  p_bus->sda_pin);
+    cy_en_scb_i2c_status_t status;
+    bool released;
+
+    Cy_SCB_I2C_Disable(p_bus->base, p_bus->context);
+
+    /* Take over both lines, released */
+    Cy_GPIO_Write(p_bus->scl_port, p_bus->scl_pin, GPIO_HIGH);
+    Cy_GPIO_Write(p_bus->sda_port, p_bus->sda_pin, GPIO_HIGH);
+    Cy_GPIO_SetDrivemode(p_bus->scl_port, p_bus->scl_pin,
+                         CY_GPIO_DM_OD_DRIVESLOW);
+    Cy_GPIO_SetDrivemode(p_bus->sda_port, p_bus->sda_pin,
+                         CY_GPIO_DM_OD_DRIVESLOW);
+    Cy_GPIO_SetHSIOM(p_bus->scl_port, p_bus->scl_pin, HSIOM_SEL_GPIO);
+    Cy_GPIO_SetHSIOM(p_bus->sda_port, p_bus->sda_pin, HSIOM_SEL_GPIO);
+    Cy_SysLib_DelayUs(I2C_RECOVERY_HALF_PERIOD_US);
+
+    /* Clock out the rest of the byte the slave is sending */
+    for (uint32_t i = 0U; (i < I2C_RECOVERY_SCL_PULSES) &&
+            (GPIO_LOW == Cy_GPIO_Read(p_bus->sda_port, p_bus->sda_pin)); i++)
+    {
+        Cy_GPIO_Write(p_bus->scl_port, p_bus->scl_pin, GPIO_LOW);
+        Cy_SysLib_DelayUs(I2C_RECOVERY_HALF_PERIOD_US);
+        Cy_GPIO_Write(p_bus->scl_port, p_bus->scl_pin, GPIO_HIGH);
+        Cy_SysLib_DelayUs(I2C_RECOVERY_HALF_PERIOD_US);
+    }
+
+    /* STOP: SDA rises while SCL is high */
+    Cy_GPIO_Write(p_bus->scl_port, p_bus->scl_pin, GPIO_LOW);
+    Cy_SysLib_DelayUs(I2C_RECOVERY_HALF_PERIOD_US);
+    Cy_GPIO_Write(p_bus->sda_port, p_bus->sda_pin, GPIO_LOW);
+    Cy_SysLib_DelayUs(I2C_RECOVERY_HALF_PERIOD_US);
+    Cy_GPIO_Write(p_bus->scl_port, p_bus->scl_pin, GPIO_HIGH);
+    Cy_SysLib_DelayUs(I2C_RECOVERY_HALF_PERIOD_US);
+    Cy_GPIO_Write(p_bus->sda_port, p_bus->sda_pin, GPIO_HIGH);
+    Cy_SysLib_DelayUs(I2C_RECOVERY_HALF_PERIOD_US);
+
+    released = (GPIO_LOW != Cy_GPIO_Read(p_bus->sda_port, p_bus->sda_pin));
+
+    /* Give the pins back to the SCB */
+    Cy_GPIO_SetHSIOM(p_bus->scl_port, p_bus->scl_pin, p_bus->scl_hsiom);
+    Cy_GPIO_SetHSIOM(p_bus->sda_port, p_bus->sda_pin, p_bus->sda_hsiom);
+    Cy_GPIO_SetDrivemode(p_bus->scl_port, p_bus->scl_pin, scl_drivemode);
+    Cy_GPIO_SetDrivemode(p_bus->sda_port, p_bus->sda_pin, sda_drivemode);
+
+    status = Cy_SCB_I2C_Init(p_bus->base, p_bus->config, p_bus->context);
+    if (CY_SCB_I2C_SUCCESS == status)
+    {
+        Cy_SCB_I2C_Enable(p_bus->base);
+        if (!released)
+        {
+            status = CY_SCB_I2C_MASTER_MANUAL_BUS_ERR;
+        }
+    }
+
+    taskENTER_CRITICAL();
+    recovery_stats.bus_clears++;
+    if (CY_SCB_I2C_SUCCESS != status)
+    {
+        recovery_stats.bus_stuck++;
+    }
+    taskEXIT_CRITICAL();
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: i2c_recovery_get_stats
+********************************************************************************
+* Summary:
+*  Copies the recovery counters.
+*******************************************************************************/
+void i2c_recovery_get_stats(i2c_recovery_stats_t *p_stats)
+{
+    taskENTER_CRITICAL();
+    memcpy(p_stats, &recovery_stats, sizeof(*p_stats));
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: i2c_recovery_print_stats
+********************************************************************************
+* Summary:
+*  Prints the recovery counters on the debug console.
+*******************************************************************************/
+void i2c_recovery_print_stats(void)
+{
+    i2c_recovery_stats_t stats;
+
+    i2c_recovery_get_stats(&stats);
+
+    printf("I2C errors:");
+    for (uint32_t i = 0U; i < I2C_RECOVERY_ERR_COUNT; i++)
+    {
+        printf(" %s %lu,", recovery_error_names[i],
+               (unsigned long) stats.errors[i]);
+    }
+    printf("\r\nI2C recovery: %lu retries, %lu bus clears, %lu stuck, "
+           "%lu given up, max %lu ms\r\n",
+           (unsigned long) stats.retries, (unsigned long) stats.bus_clears,
+           (unsigned long) stats.bus_stuck,
+           (unsigned long) stats.budget_exhausted,
+           (unsigned long) stats.max_recovery_ms);
+}
+
+/* [] END OF FILE */
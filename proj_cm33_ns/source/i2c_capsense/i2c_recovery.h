@@ -0,0 +1,106 @@
+/*******************************************************************************
+* File Name: i2c_recovery.h
+*
+* Description: This file is the public interface of i2c_recovery.c
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef I2C_RECOVERY_H
+#define I2C_RECOVERY_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Error classes counted by the recovery */
+typedef enum
+{
+    I2C_RECOVERY_ERR_ADDR_NAK,          /* Slave did not acknowledge address */
+    I2C_RECOVERY_ERR_DATA_NAK,          /* Slave did not acknowledge data */
+    I2C_RECOVERY_ERR_ARB_LOST,          /* Arbitration lost */
+    I2C_RECOVERY_ERR_BUS_ERROR,         /* Misplaced START or STOP */
+    I2C_RECOVERY_ERR_TIMEOUT,           /* Byte did not complete in time */
+    I2C_RECOVERY_ERR_FRAME,             /* Frame read but out of range */
+    I2C_RECOVERY_ERR_OTHER,
+    I2C_RECOVERY_ERR_COUNT
+} i2c_recovery_error_t;
+
+/* Recovery counters */
+typedef struct
+{
+    uint32_t errors[I2C_RECOVERY_ERR_COUNT];
+    uint32_t retries;                   /* Reads repeated after an error */
+    uint32_t bus_clears;                /* SCL recoveries with SCB re-init */
+    uint32_t bus_stuck;                 /* Bus clears that failed */
+    uint32_t budget_exhausted;          /* Samples given up on */
+    uint32_t max_recovery_ms;           /* Longest recovery of one sample */
+} i2c_recovery_stats_t;
+
+/* Pins and SCB of the bus to recover */
+typedef struct
+{
+    CySCB_Type *base;
+    cy_stc_scb_i2c_context_t *context;
+    const cy_stc_scb_i2c_config_t *config;
+    GPIO_PRT_Type *scl_port;
+    uint32_t scl_pin;
+    en_hsiom_sel_t scl_hsiom;
+    GPIO_PRT_Type *sda_port;
+    uint32_t sda_pin;
+    en_hsiom_sel_t sda_hsiom;
+} i2c_recovery_bus_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+i2c_recovery_error_t i2c_recovery_classify(cy_en_scb_i2c_status_t status);
+void i2c_recovery_count_error(i2c_recovery_error_t error);
+void i2c_recovery_count_retry(void);
+void i2c_recovery_count_result(bool success, uint32_t recovery_ms);
+bool i2c_recovery_needs_bus_clear(i2c_recovery_error_t error);
+cy_en_scb_i2c_status_t i2c_recovery_clear_bus(const i2c_recovery_bus_t *p_bus);
+void i2c_recovery_get_stats(i2c_recovery_stats_t *p_stats);
+void i2c_recovery_print_stats(void);
+
+#endif /* I2C_RECOVERY_H */
+
+/* [] END OF FILE */
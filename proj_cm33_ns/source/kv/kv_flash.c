@@ -0,0 +1,134 @@
+/*******************************************************************************
+* File Name: kv_flash.c
+*
+* Description: This file implements the key-value store memory interface on
+*              the RRAM of the PSOC Edge E84.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "cy_rram.h"
+#include "kv_flash.h"
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: kv_flash_read
+********************************************************************************
+* Summary:
+*  Reads from the store region. The RRAM is memory mapped.
+*
+* Parameters:
+*  uint32_t offset : Offset in the region
+*  void *p_data    : Destination
+*  uint32_t len    : Number of bytes to read
+*
+* Return:
+*  bool: true on success
+*
+*******************************************************************************/
+bool kv_flash_read(uint32_t offset, void *p_data, uint32_t len)
+{
+    if ((offset > KV_FLASH_SIZE) || (len > (KV_FLASH_SIZE - offset)))
+    {
+        return false;
+    }
+
+    memcpy(p_data, (const void *) (KV_FLASH_START + offset), len);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: kv_flash_write
+********************************************************************************
+* Summary:
+*  Writes to the store region.
+*
+* Parameters:
+*  uint32_t offset      : Offset in the region
+*  const void *p_data   : Data to write
+*  uint32_t len         : Number of bytes to write
+*
+* Return:
+*  bool: true on success
+*
+*******************************************************************************/
+bool kv_flash_write(uint32_t offset, const void *p_data, uint32_t len)
+{
+    if ((offset > KV_FLASH_SIZE) || (len > (KV_FLASH_SIZE - offset)))
+    {
+        return false;
+    }
+
+    return (CY_RRAM_SUCCESS == Cy_RRAM_NvmWriteByteArray(RRAMC0,
+            KV_FLASH_START + offset, (const uint8_t *) p_data, len));
+}
+
+/*******************************************************************************
+* Function Name: kv_flash_erase_sector
+********************************************************************************
+* Summary:
+*  Erases one sector. RRAM has no erase operation, so the sector is written
+*  with the erased value; the store then works the same way on RRAM and on
+*  flash.
+*
+* Parameters:
+*  uint32_t offset : Offset of the sector in the region
+*
+* Return:
+*  bool: true on success
+*
+*******************************************************************************/
+bool kv_flash_erase_sector(uint32_t offset)
+{
+    uint8_t erased[KV_FLASH_PROGRAM_SIZE];
+    bool ok = (0U == (offset % KV_FLASH_SECTOR_SIZE));
+
+    memset(erased, KV_FLASH_ERASED, sizeof(erased));
+
+    for (uint32_t pos = 0U; ok && (pos < KV_FLASH_SECTOR_SIZE);
+         pos += KV_FLASH_PROGRAM_SIZE)
+    {
+        ok = kv_flash_write(offset + pos, erased, sizeof(erased));
+    }
+
+    return ok;
+}
+
+/* [] END OF FILE */
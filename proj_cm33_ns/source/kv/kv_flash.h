@@ -0,0 +1,81 @@
+/*******************************************************************************
+* File Name: kv_flash.h
+*
+* Description: This file is the interface between the key-value store and the
+*              non-volatile memory that holds it.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef KV_FLASH_H
+#define KV_FLASH_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "cybsp.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Region of the store: the non-secure user RRAM region */
+#define KV_FLASH_START                      (CYMEM_CM33_0_user_nvm_START)
+#define KV_FLASH_SIZE                       (CYMEM_CM33_0_user_nvm_SIZE)
+
+/* The region is used as a ring of sectors. Each sector is erased as a
+ * whole before it is written again. */
+#define KV_FLASH_SECTOR_SIZE                (0x2000U)
+#define KV_FLASH_SECTOR_COUNT               (KV_FLASH_SIZE / \
+                                             KV_FLASH_SECTOR_SIZE)
+
+/* Write unit. Records start on a write unit, so that writing a record
+ * never rewrites a byte of an earlier one. */
+#define KV_FLASH_PROGRAM_SIZE               (16U)
+
+/* Value of erased bytes */
+#define KV_FLASH_ERASED                     (0xFFU)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool kv_flash_read(uint32_t offset, void *p_data, uint32_t len);
+bool kv_flash_write(uint32_t offset, const void *p_data, uint32_t len);
+bool kv_flash_erase_sector(uint32_t offset);
+
+#endif /* KV_FLASH_H */
+
+/* [] END OF FILE */
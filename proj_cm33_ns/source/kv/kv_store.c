@@ -0,0 +1,614 @@
+/*******************************************************************************
+* File Name: kv_store.c
+*
+* Description: This file implements a log-structured key-value store for small
+*              configuration values in non-volatile memory.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "kv_flash.h"
+#include "kv_store.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Layout. The region is a ring of sectors; one sector takes the writes.
+ * A sector starts with a header and holds a log of records. Every change
+ * appends a record, the newest record of a key holds its value. When the
+ * sector is full, the current values are copied to the next sector of the
+ * ring and its header is written last, with the next sequence number. So
+ * all sectors are erased equally often, and a reset during the copy leaves
+ * the previous sector in use. */
+#define KV_SECTOR_MAGIC                     (0x3153564BUL)  /* "KVS1" */
+
+/* Record length flag of a deleted key */
+#define KV_RECORD_DELETED                   (0x8000U)
+
+/* Key and length of the free space after the last record */
+#define KV_RECORD_ERASED                    (0xFFFFU)
+
+/* CRC-32 (IEEE 802.3) */
+#define KV_CRC_INIT                         (0xFFFFFFFFUL)
+#define KV_CRC_POLYNOMIAL                   (0xEDB88320UL)
+
+/* Size of a record or header rounded up to whole write units */
+#define KV_ALIGN(size)                      ((((size) + \
+                                              KV_FLASH_PROGRAM_SIZE - 1U) / \
+                                             KV_FLASH_PROGRAM_SIZE) * \
+                                             KV_FLASH_PROGRAM_SIZE)
+
+#define KV_SECTOR_HEADER_SIZE   (KV_ALIGN(sizeof(kv_sector_header_t)))
+#define KV_RECORD_SIZE(value_len)                                             \
+    (KV_ALIGN(sizeof(kv_record_header_t) + (value_len)))
+#define KV_RECORD_SIZE_MAX                  (KV_RECORD_SIZE(KV_VALUE_MAX))
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Sector header */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t sequence;              /* Increments with every new sector */
+    uint32_t crc;                   /* Of magic and sequence */
+} kv_sector_header_t;
+
+/* Record header, followed by the value */
+typedef struct
+{
+    uint16_t key;
+    uint16_t len;                   /* Value length, KV_RECORD_DELETED */
+    uint32_t crc;                   /* Of key, len and value */
+} kv_record_header_t;
+
+/* Store state. The index holds the offset of the newest record of every
+ * key, so a lookup reads the value without searching the log. */
+static struct
+{
+    bool mounted;
+    bool full;                      /* Next write starts a new sector */
+    uint32_t sector;
+    uint32_t sequence;
+    uint32_t used;                  /* Bytes used in the sector */
+    uint16_t offset[KV_KEY_MAX];    /* Record offset, 0 for no value */
+    uint16_t len[KV_KEY_MAX];       /* Value length */
+    kv_store_stats_t scan;          /* Boot scan cost */
+} kv;
+
+/* Serializes the accesses of the tasks. The record and value scratch
+ * buffers are used under the lock, which keeps them off the task stacks. */
+static SemaphoreHandle_t kv_mutex;
+static uint8_t kv_record[KV_RECORD_SIZE_MAX];
+static uint8_t kv_value[KV_VALUE_MAX];
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: kv_store_crc
+********************************************************************************
+* Summary:
+*  Continues a CRC-32 over a block of bytes. Start with KV_CRC_INIT and
+*  invert the final value.
+*******************************************************************************/
+static uint32_t kv_store_crc(uint32_t crc, const void *p_data, uint32_t len)
+{
+    const uint8_t *p = (const uint8_t *) p_data;
+
+    while (len-- > 0U)
+    {
+        crc ^= *p++;
+        for (uint32_t bit = 0U; bit < 8U; bit++)
+        {
+            crc = (crc >> 1U) ^ ((0U != (crc & 1U)) ? KV_CRC_POLYNOMIAL : 0U);
+        }
+    }
+
+    return crc;
+}
+
+/*******************************************************************************
+* Function Name: kv_store_sector_crc
+********************************************************************************
+* Summary:
+*  Returns the CRC of a sector header.
+*******************************************************************************/
+static uint32_t kv_store_sector_crc(const kv_sector_header_t *p_header)
+{
+    return ~kv_store_crc(KV_CRC_INIT, p_header,
+                         offsetof(kv_sector_header_t, crc));
+}
+
+/*******************************************************************************
+* Function Name: kv_store_record_crc
+********************************************************************************
+* Summary:
+*  Returns the CRC of a record.
+*******************************************************************************/
+static uint32_t kv_store_record_crc(const kv_record_header_t *p_header,
+                                    const void *p_value, uint16_t value_len)
+{
+    uint32_t crc = kv_store_crc(KV_CRC_INIT, p_header,
+                                offsetof(kv_record_header_t, crc));
+
+    return ~kv_store_crc(crc, p_value, value_len);
+}
+
+/*******************************************************************************
+* Function Name: kv_store_sector_base
+********************************************************************************
+* Summary:
+*  Returns the offset of a sector in the region.
+*******************************************************************************/
+static uint32_t kv_store_sector_base(uint32_t sector)
+{
+    return sector * KV_FLASH_SECTOR_SIZE;
+}
+
+/*******************************************************************************
+* Function Name: kv_store_next_sector
+********************************************************************************
+* Summary:
+*  Copies the current values into the next sector of the ring and makes it
+*  the one that takes the writes. Also formats the store when no sector is
+*  in use yet.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true on success
+*
+*******************************************************************************/
+static bool kv_store_next_sector(void)
+{
+    uint16_t offset[KV_KEY_MAX] = { 0U };
+    uint32_t next = (kv.sector + 1U) % KV_FLASH_SECTOR_COUNT;
+    uint32_t from = kv_store_sector_base(kv.sector);
+    uint32_t to = kv_store_sector_base(next);
+    uint32_t pos = KV_SECTOR_HEADER_SIZE;
+    kv_sector_header_t header;
+    bool ok = kv_flash_erase_sector(to);
+
+    for (uint32_t key = 0U; ok && (key < KV_KEY_MAX); key++)
+    {
+        uint32_t size = KV_RECORD_SIZE(kv.len[key]);
+
+        if (0U != kv.offset[key])
+        {
+            ok = kv_flash_read(from + kv.offset[key], kv_record, size) &&
+                 kv_flash_write(to + pos, kv_record, size);
+            offset[key] = (uint16_t) pos;
+            pos += size;
+        }
+    }
+
+    /* The header makes the sector valid, so it is written last */
+    memset(&header, KV_FLASH_ERASED, sizeof(header));
+    header.magic = KV_SECTOR_MAGIC;
+    header.sequence = kv.sequence + 1U;
+    header.crc = kv_store_sector_crc(&header);
+    ok = ok && kv_flash_write(to, &header, sizeof(header));
+
+    if (ok)
+    {
+        kv.sector = next;
+        kv.sequence = header.sequence;
+        kv.used = pos;
+        kv.full = false;
+        memcpy(kv.offset, offset, sizeof(kv.offset));
+    }
+    else
+    {
+        printf("KV store: writing sector %lu failed\r\n",
+               (unsigned long) next);
+    }
+
+    return ok;
+}
+
+/*******************************************************************************
+* Function Name: kv_store_append
+********************************************************************************
+* Summary:
+*  Appends a record to the log and updates the index. Starts a new sector
+*  when the record does not fit, and fails when it still does not fit.
+*
+* Parameters:
+*  uint16_t key         : Key
+*  uint16_t len         : Value length, with KV_RECORD_DELETED to delete
+*  const void *p_value  : Value
+*
+* Return:
+*  bool: true on success
+*
+*******************************************************************************/
+static bool kv_store_append(uint16_t key, uint16_t len, const void *p_value)
+{
+    kv_record_header_t header =
+    {
+        .key = key,
+        .len = len,
+    };
+    uint16_t value_len = len & (uint16_t) ~KV_RECORD_DELETED;
+    uint32_t size = KV_RECORD_SIZE(value_len);
+
+    if ((kv.full || ((kv.used + size) > KV_FLASH_SECTOR_SIZE)) &&
+            !kv_store_next_sector())
+    {
+        return false;
+    }
+
+    /* The live values may leave no room even in a compacted sector */
+    if ((kv.used + size) > KV_FLASH_SECTOR_SIZE)
+    {
+        printf("KV store: no room for key %u\r\n", (unsigned int) key);
+        return false;
+    }
+
+    header.crc = kv_store_record_crc(&header, p_value, value_len);
+    memset(kv_record, KV_FLASH_ERASED, size);
+    memcpy(kv_record, &header, sizeof(header));
+    if (0U != value_len)
+    {
+        memcpy(&kv_record[sizeof(header)], p_value, value_len);
+    }
+
+    if (!kv_flash_write(kv_store_sector_base(kv.sector) + kv.used, kv_record,
+                        size))
+    {
+        /* The record may be partly written; continue in a new sector */
+        kv.full = true;
+        return false;
+    }
+
+    kv.offset[key] = (0U != (len & KV_RECORD_DELETED)) ? 0U :
+            (uint16_t) kv.used;
+    kv.len[key] = value_len;
+    kv.used += size;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: kv_store_scan
+********************************************************************************
+* Summary:
+*  Reads the log of the current sector and builds the index. The scan stops
+*  at the free space or at the first damaged record, so it reads at most one
+*  sector. After a damaged record, the next write starts a new sector.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void kv_store_scan(void)
+{
+    uint32_t base = kv_store_sector_base(kv.sector);
+    uint32_t pos = KV_SECTOR_HEADER_SIZE;
+    kv_record_header_t header;
+
+    while ((pos + sizeof(header)) <= KV_FLASH_SECTOR_SIZE)
+    {
+        uint16_t value_len;
+        uint32_t size;
+
+        if (!kv_flash_read(base + pos, &header, sizeof(header)))
+        {
+            kv.full = true;
+            break;
+        }
+        kv.scan.scan_bytes += sizeof(header);
+
+        if ((KV_RECORD_ERASED == header.key) &&
+                (KV_RECORD_ERASED == header.len))
+        {
+            break;
+        }
+
+        value_len = header.len & (uint16_t) ~KV_RECORD_DELETED;
+        size = KV_RECORD_SIZE(value_len);
+        if ((header.key >= KV_KEY_MAX) || (value_len > KV_VALUE_MAX) ||
+                ((pos + size) > KV_FLASH_SECTOR_SIZE) ||
+                !kv_flash_read(base + pos + sizeof(header), kv_value,
+                               value_len) ||
+                (header.crc != kv_store_record_crc(&header, kv_value,
+                                                   value_len)))
+        {
+            kv.scan.errors++;
+            kv.full = true;
+            break;
+        }
+        kv.scan.scan_bytes += value_len;
+        kv.scan.scan_records++;
+
+        kv.offset[header.key] =
+                (0U != (header.len & KV_RECORD_DELETED)) ? 0U : (uint16_t) pos;
+        kv.len[header.key] = value_len;
+        pos += size;
+    }
+
+    kv.used = pos;
+}
+
+/*******************************************************************************
+* Function Name: kv_store_init
+********************************************************************************
+* Summary:
+*  Finds the sector in use and builds the index from its log. Formats the
+*  store if no sector is valid. The scan reads the sector headers and at
+*  most one sector; the cost is returned by kv_store_get_stats(). Called
+*  before the tasks start.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true when the store can be used
+*
+*******************************************************************************/
+bool kv_store_init(void)
+{
+    kv_sector_header_t header;
+    bool found = false;
+
+    memset(&kv, 0, sizeof(kv));
+    kv_mutex = xSemaphoreCreateMutex();
+    if (NULL == kv_mutex)
+    {
+        return false;
+    }
+    kv.sector = KV_FLASH_SECTOR_COUNT - 1U;
+    kv.scan.scan_bytes_max = (KV_FLASH_SECTOR_COUNT * sizeof(header)) +
+            KV_FLASH_SECTOR_SIZE - KV_SECTOR_HEADER_SIZE;
+
+    /* Sequence numbers are compared as serial numbers, so the newest sector
+     * is still found after the number wraps around */
+    for (uint32_t sector = 0U; sector < KV_FLASH_SECTOR_COUNT; sector++)
+    {
+        if (kv_flash_read(kv_store_sector_base(sector), &header,
+                          sizeof(header)) &&
+                (KV_SECTOR_MAGIC == header.magic) &&
+                (kv_store_sector_crc(&header) == header.crc) &&
+                (!found || ((int32_t) (header.sequence - kv.sequence) > 0)))
+        {
+            found = true;
+            kv.sector = sector;
+            kv.sequence = header.sequence;
+        }
+        kv.scan.scan_bytes += sizeof(header);
+    }
+
+    if (!found)
+    {
+        printf("KV store: no valid sector, formatting\r\n");
+        kv.mounted = kv_store_next_sector();
+    }
+    else
+    {
+        kv_store_scan();
+        kv.mounted = true;
+    }
+
+    return kv.mounted;
+}
+
+/*******************************************************************************
+* Function Name: kv_store_read
+********************************************************************************
+* Summary:
+*  Reads the value of a key. The caller holds the lock.
+*******************************************************************************/
+static bool kv_store_read(uint16_t key, void *p_value, uint16_t max_len,
+                          uint16_t *p_len)
+{
+    if ((0U == kv.offset[key]) || (kv.len[key] > max_len))
+    {
+        return false;
+    }
+
+    *p_len = kv.len[key];
+
+    return kv_flash_read(kv_store_sector_base(kv.sector) + kv.offset[key] +
+                         sizeof(kv_record_header_t), p_value, kv.len[key]);
+}
+
+/*******************************************************************************
+* Function Name: kv_store_get
+********************************************************************************
+* Summary:
+*  Reads the value of a key.
+*
+* Parameters:
+*  uint16_t key       : Key
+*  void *p_value      : Value destination
+*  uint16_t max_len   : Size of the destination
+*  uint16_t *p_len    : Value length destination
+*
+* Return:
+*  bool: true when the key has a value that fits into the destination
+*
+*******************************************************************************/
+bool kv_store_get(uint16_t key, void *p_value, uint16_t max_len,
+                  uint16_t *p_len)
+{
+    bool ok;
+
+    if (!kv.mounted || (key >= KV_KEY_MAX))
+    {
+        return false;
+    }
+
+    xSemaphoreTake(kv_mutex, portMAX_DELAY);
+    ok = kv_store_read(key, p_value, max_len, p_len);
+    xSemaphoreGive(kv_mutex);
+
+    return ok;
+}
+
+/*******************************************************************************
+* Function Name: kv_store_set
+********************************************************************************
+* Summary:
+*  Sets the value of a key. Writing the value a key already has does not
+*  write to the memory.
+*
+* Parameters:
+*  uint16_t key         : Key
+*  const void *p_value  : Value
+*  uint16_t len         : Value length, up to KV_VALUE_MAX
+*
+* Return:
+*  bool: true on success
+*
+*******************************************************************************/
+bool kv_store_set(uint16_t key, const void *p_value, uint16_t len)
+{
+    uint16_t current_len;
+    bool ok = true;
+
+    if (!kv.mounted || (key >= KV_KEY_MAX) || (len > KV_VALUE_MAX))
+    {
+        return false;
+    }
+
+    xSemaphoreTake(kv_mutex, portMAX_DELAY);
+    if (!kv_store_read(key, kv_value, sizeof(kv_value), &current_len) ||
+            (current_len != len) || (0 != memcmp(kv_value, p_value, len)))
+    {
+        ok = kv_store_append(key, len, p_value);
+    }
+    xSemaphoreGive(kv_mutex);
+
+    return ok;
+}
+
+/*******************************************************************************
+* Function Name: kv_store_delete
+********************************************************************************
+* Summary:
+*  Removes the value of a key.
+*
+* Parameters:
+*  uint16_t key : Key
+*
+* Return:
+*  bool: true on success
+*
+*******************************************************************************/
+bool kv_store_delete(uint16_t key)
+{
+    bool ok;
+
+    if (!kv.mounted || (key >= KV_KEY_MAX))
+    {
+        return false;
+    }
+
+    xSemaphoreTake(kv_mutex, portMAX_DELAY);
+    ok = (0U == kv.offset[key]) ||
+         kv_store_append(key, KV_RECORD_DELETED, NULL);
+    xSemaphoreGive(kv_mutex);
+
+    return ok;
+}
+
+/*******************************************************************************
+* Function Name: kv_store_get_stats
+********************************************************************************
+* Summary:
+*  Returns the store state and the cost of the boot scan.
+*
+* Parameters:
+*  kv_store_stats_t *p_stats : Destination
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void kv_store_get_stats(kv_store_stats_t *p_stats)
+{
+    *p_stats = kv.scan;
+    p_stats->sector = kv.sector;
+    p_stats->sequence = kv.sequence;
+    p_stats->used = kv.used;
+    p_stats->keys = 0U;
+    for (uint32_t key = 0U; key < KV_KEY_MAX; key++)
+    {
+        p_stats->keys += (0U != kv.offset[key]) ? 1U : 0U;
+    }
+}
+
+/*******************************************************************************
+* Function Name: kv_store_print_stats
+********************************************************************************
+* Summary:
+*  Prints the store state and the cost of the boot scan.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void kv_store_print_stats(void)
+{
+    kv_store_stats_t stats;
+
+    kv_store_get_stats(&stats);
+
+    printf("KV store: sector %lu, sequence %lu, %lu keys, %lu of %u bytes "
+           "used\r\n", (unsigned long) stats.sector,
+           (unsigned long) stats.sequence, (unsigned long) stats.keys,
+           (unsigned long) stats.used, KV_FLASH_SECTOR_SIZE);
+    printf("KV store boot scan: %lu records, %lu bytes read (bound %lu), "
+           "%lu damaged\r\n", (unsigned long) stats.scan_records,
+           (unsigned long) stats.scan_bytes,
+           (unsigned long) stats.scan_bytes_max,
+           (unsigned long) stats.errors);
+}
+
+/* [] END OF FILE */
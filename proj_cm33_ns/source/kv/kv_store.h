@@ -0,0 +1,92 @@
+/*******************************************************************************
+* File Name: kv_store.h
+*
+* Description: This file is the public interface of kv_store.c
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef KV_STORE_H
+#define KV_STORE_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Keys of the stored values. Keys are below KV_KEY_MAX. */
+#define KV_KEY_CONTROL                      (1U)    /* Control TLV records */
+#define KV_KEY_LOCAL_IDENTITY               (2U)    /* Local identity keys */
+#define KV_KEY_BOND                         (3U)    /* First bond record */
+
+#define KV_KEY_MAX                          (16U)
+
+/* Largest value */
+#define KV_VALUE_MAX                        (256U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Store state and the cost of the boot scan */
+typedef struct
+{
+    uint32_t sector;            /* Sector that takes the writes */
+    uint32_t sequence;          /* Sectors filled so far, plus one */
+    uint32_t used;              /* Bytes used in the sector */
+    uint32_t keys;              /* Keys with a value */
+    uint32_t scan_records;      /* Records read by the boot scan */
+    uint32_t scan_bytes;        /* Bytes read by the boot scan */
+    uint32_t scan_bytes_max;    /* Bound of scan_bytes */
+    uint32_t errors;            /* Damaged records found by the boot scan */
+} kv_store_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool kv_store_init(void);
+bool kv_store_get(uint16_t key, void *p_value, uint16_t max_len,
+                  uint16_t *p_len);
+bool kv_store_set(uint16_t key, const void *p_value, uint16_t len);
+bool kv_store_delete(uint16_t key);
+void kv_store_get_stats(kv_store_stats_t *p_stats);
+void kv_store_print_stats(void);
+
+#endif /* KV_STORE_H */
+
+/* [] END OF FILE */
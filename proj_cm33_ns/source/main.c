@@ -42,6 +42,8 @@
 #include <FreeRTOS.h>
 #include <task.h>
 #include <i2c_capsense.h>
+#include "capsense_diag.h"
+#include "i2c_recovery.h"
 #include "cyabs_rtos_impl.h"
 #include <task.h>
 #include "cy_time.h"
@@ -53,7 +55,16 @@
 #include "cybt_platform_config.h"
 #include "board.h"
 #include "bt_app.h"
+#include "bt_periodic.h"
+#include "bt_gatt_rec.h"
 #include "retarget_io_init.h"
+#include "power_stats.h"
+#include "bench_timer.h"
+#include "kv_store.h"
+#include "bt_control.h"
+#include "bt_time.h"
+#include "console.h"
+#include "timers.h"
 
 /*******************************************************************************
 * Macros
@@ -73,6 +84,16 @@
 #define CAPSENSE_TASK_PRIORITY              (2U)
 #define CAPSENSE_TASK_STACK_SIZE            (256U)
 
+/* Task parameters for the CapSense diagnostics task. It only formats and
+ * forwards data, so it runs below the BT and CapSense tasks. */
+#define CAPSENSE_DIAG_TASK_PRIORITY         (1U)
+#define CAPSENSE_DIAG_TASK_STACK_SIZE       (384U)
+
+/* Task parameters for the debug console. It runs at the lowest application
+ * priority, so commands never delay the BT and CapSense tasks. */
+#define CONSOLE_TASK_PRIORITY               (1U)
+#define CONSOLE_TASK_STACK_SIZE             (512U)
+
 /* Queue lengths of message queues used in this project */
 #define SINGLE_ELEMENT_QUEUE                (1U)
 
@@ -84,6 +105,12 @@
 /* Define the LPTimer interrupt priority number. '1' implies highest priority */
 #define APP_LPTIMER_INTERRUPT_PRIORITY      (1U)
 
+/* Microseconds per second, for the boot scan time of the KV store */
+#define USEC_PER_SEC                        (1000000UL)
+
+/* Period of the power statistics report on the debug console */
+#define POWER_STATS_REPORT_PERIOD_MS        (60000U)
+
 /*******************************************************************************
 * Global Variables
 *******************************************************************************/
@@ -185,6 +212,42 @@ static void setup_tickless_idle_timer(void)
      * tickless idle mode
      */
     cyabs_rtos_set_lptimer(&lptimer_obj);
+
+    /* Account power state residency and wakeup sources of this CPU */
+    power_stats_init(&lptimer_obj);
+
+    /* Timestamp the touch samples with the same LPTimer */
+    bt_time_init(&lptimer_obj);
+}
+
+/*******************************************************************************
+* Function Name: power_stats_report_cb
+********************************************************************************
+* Summary:
+*  Timer callback that prints the power statistics of both CPUs, the
+*  CapSense I2C error counters, the CapSense poll counters, the periodic
+*  advertising telemetry counters and the recorded GATT traffic.
+*
+* Parameters:
+*  TimerHandle_t timer : Handle of the expired timer (unused)
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void power_stats_report_cb(TimerHandle_t timer)
+{
+    CY_UNUSED_PARAMETER(timer);
+
+    power_stats_print();
+    i2c_recovery_print_stats();
+    i2c_capsense_print_stats();
+#if defined(BT_PERIODIC_ADV)
+    bt_periodic_print_stats();
+#endif
+#if defined(BT_GATT_RECORD)
+    bt_gatt_rec_print_stats();
+#endif
 }
 
 /*******************************************************************************
@@ -259,6 +322,19 @@ int main(void)
     printf("PSOC Edge MCU: Bluetooth LE CapSense Buttons & Slider\r\n");
     printf("==========================================================\r\n\n");
 
+    /* Mount the store of the saved parameters and report the scan cost */
+    uint32_t kv_scan_start = mtb_hal_lptimer_read(&lptimer_obj);
+    if (!kv_store_init())
+    {
+        printf("KV store not available, using the default parameters\r\n");
+    }
+    uint32_t kv_scan_ticks = mtb_hal_lptimer_read(&lptimer_obj) -
+            kv_scan_start;
+    kv_store_print_stats();
+    printf("KV store boot scan took %lu us\r\n", (unsigned long)
+           (((uint64_t) kv_scan_ticks * USEC_PER_SEC) /
+            POWER_STATS_LPTIMER_HZ));
+
     /* Register call back and configuration with stack */
     result = wiced_bt_stack_init(bt_app_management_cb, &cy_bt_cfg_settings);
 
@@ -300,6 +376,46 @@ int main(void)
         handle_app_error();
     }
 
+    /* Create the CapSense diagnostics task */
+    if (pdPASS != xTaskCreate(capsense_diag_task, "CapSense Diag Task",
+            CAPSENSE_DIAG_TASK_STACK_SIZE, NULL, CAPSENSE_DIAG_TASK_PRIORITY,
+            &capsense_diag_task_handle))
+    {
+        printf("Failed to create the CapSense diagnostics task!\r\n");
+        handle_app_error();
+    }
+
+    /* Lock of the runtime parameters, written by BLE and the console */
+    if (!bt_control_init())
+    {
+        printf("Failed to create the control lock!\r\n");
+        handle_app_error();
+    }
+
+    /* Create the debug console task */
+    if (pdPASS != xTaskCreate(console_task, "Console Task",
+            CONSOLE_TASK_STACK_SIZE, NULL, CONSOLE_TASK_PRIORITY, NULL))
+    {
+        printf("Failed to create the console task!\r\n");
+        handle_app_error();
+    }
+
+    /* Create the periodic power statistics report */
+    TimerHandle_t power_stats_timer = xTimerCreate("Power Stats",
+            pdMS_TO_TICKS(POWER_STATS_REPORT_PERIOD_MS), pdTRUE, NULL,
+            power_stats_report_cb);
+    if ((NULL == power_stats_timer) ||
+            (pdPASS != xTimerStart(power_stats_timer, 0U)))
+    {
+        printf("Failed to create the power statistics timer!\r\n");
+        handle_app_error();
+    }
+
+#if defined(HOT_PATH_BENCHMARK)
+    /* Clear the CM55 benchmark results before CM55 starts */
+    bench_timer_init();
+#endif
+
    /* Enable CM55. CM55_APP_BOOT_ADDR must be updated if CM55
     * memory layout is changed.
     */
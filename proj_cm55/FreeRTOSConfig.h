@@ -197,6 +197,13 @@ extern void vApplicationSleep( uint32_t xExpectedIdleTime );
 #define portSUPPRESS_TICKS_AND_SLEEP( xIdleTime ) vApplicationSleep( xIdleTime )
 #define configUSE_TICKLESS_IDLE                 2
 
+/* Power state accounting hooks around the tickless idle period. The
+ * implementation is in shared/source/power_stats.c */
+extern void power_stats_idle_begin( void );
+extern void power_stats_idle_end( void );
+#define traceLOW_POWER_IDLE_BEGIN()             power_stats_idle_begin()
+#define traceLOW_POWER_IDLE_END()               power_stats_idle_end()
+
 #else
 #define configUSE_TICKLESS_IDLE                 0
 #endif
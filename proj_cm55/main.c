@@ -40,6 +40,11 @@
 #include "cyabs_rtos.h"
 #include "cyabs_rtos_impl.h"
 #include "cy_time.h"
+#include "power_stats.h"
+#include "bench_timer.h"
+#if defined(HOT_PATH_BENCHMARK)
+#include "capsense_bench.h"
+#endif
 
 /*******************************************************************************
  * Macros
@@ -120,6 +125,41 @@ static void setup_clib_support(void)
 }
 
 
+#if defined(HOT_PATH_BENCHMARK)
+
+/*******************************************************************************
+* Function Name: cm55_benchmark
+********************************************************************************
+* Summary:
+* Times the CapSense kernels, hands the results to CM33 through the shared
+* memory region and halts.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void cm55_benchmark(void)
+{
+    static bench_result_t results[BENCH_TIMER_RESULTS_MAX];
+    uint32_t count = 0U;
+
+    bench_timer_init();
+
+    for (; (count < capsense_bench_kernel_count) &&
+            (count < BENCH_TIMER_RESULTS_MAX); count++)
+    {
+        bench_timer_run(&capsense_bench_kernels[count], &results[count]);
+    }
+
+    bench_timer_publish(results, count);
+    bench_timer_halt();
+}
+
+#endif /* defined(HOT_PATH_BENCHMARK) */
+
 /*******************************************************************************
 * Function Name: cm55_task
 ********************************************************************************
@@ -137,6 +177,11 @@ static void setup_clib_support(void)
 static void cm55_task(void * arg)
 {
     CY_UNUSED_PARAMETER(arg);
+
+#if defined(HOT_PATH_BENCHMARK)
+    cm55_benchmark();
+#endif
+
     for (;;)
     {
         /* Suspend the task to enter deepsleep */
@@ -234,6 +279,9 @@ static void setup_tickless_idle_timer(void)
      * tickless idle mode 
      */
     cyabs_rtos_set_lptimer(&lptimer_obj);
+
+    /* Account power state residency and wakeup sources of this CPU */
+    power_stats_init(&lptimer_obj);
 }
 
 /*******************************************************************************
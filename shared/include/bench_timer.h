@@ -0,0 +1,114 @@
+/*******************************************************************************
+* File Name: bench_timer.h
+*
+* Description: This file is the public interface of bench_timer.c, the DWT cycle
+*              timer of the hot path benchmark build. It also describes the results
+*              that CM55 passes to CM33 in the shared memory region.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef BENCH_TIMER_H
+#define BENCH_TIMER_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "cybsp.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Iterations of a kernel unless the kernel sets its own count. This is also
+ * the maximum, as every sample is kept for the median. */
+#define BENCH_TIMER_ITERATIONS              (1000U)
+
+/* Kernel name length including the terminating NUL */
+#define BENCH_TIMER_NAME_LEN                (24U)
+
+/* Maximum number of results passed from CM55 to CM33 */
+#define BENCH_TIMER_RESULTS_MAX             (16U)
+
+/* Marks complete CM55 results in the shared memory region */
+#define BENCH_TIMER_MAGIC                   (0x42454E43UL)
+
+/*******************************************************************************
+* Global Constants
+*******************************************************************************/
+/* Timed kernel */
+typedef struct
+{
+    const char *name;               /* Name printed in the results */
+    void (*run)(void);              /* One call is one sample */
+    uint32_t iterations;            /* Samples, 0 for BENCH_TIMER_ITERATIONS */
+} bench_kernel_t;
+
+/* CPU cycles per call of one kernel */
+typedef struct
+{
+    char name[BENCH_TIMER_NAME_LEN];
+    uint32_t iterations;
+    uint32_t min;
+    uint32_t median;
+    uint32_t max;
+} bench_result_t;
+
+/* Layout of the CM55 results in the CM33/CM55 shared memory region. CM55
+ * sets the magic once all results are written. */
+typedef struct __ALIGNED(32)
+{
+    volatile uint32_t magic;
+    uint32_t count;
+    bench_result_t result[BENCH_TIMER_RESULTS_MAX];
+} bench_timer_shared_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+#if defined(HOT_PATH_BENCHMARK)
+void bench_timer_init(void);
+void bench_timer_run(const bench_kernel_t *p_kernel, bench_result_t *p_result);
+void bench_timer_print_header(void);
+void bench_timer_print(const char *core, const bench_result_t *p_result);
+void bench_timer_publish(const bench_result_t *p_results, uint32_t count);
+uint32_t bench_timer_collect(bench_result_t *p_results, uint32_t max);
+void bench_timer_halt(void);
+#endif
+
+#endif /* BENCH_TIMER_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,141 @@
+/*******************************************************************************
+* File Name: power_stats.h
+*
+* Description: This file is the public interface of power_stats.c. It describes
+*              the power state statistics record that each CPU keeps in the
+*              memory region shared between CM33 and CM55.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef POWER_STATS_H
+#define POWER_STATS_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "cybsp.h"
+#include "mtb_hal.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Marks the shared record as initialized by the CM33 application */
+#define POWER_STATS_MAGIC                   (0x50535453UL)
+
+/* Number of distinct wakeup interrupts tracked per CPU */
+#define POWER_STATS_MAX_WAKEUP_SOURCES      (6U)
+
+/* Wakeup sources included in a diagnostics record */
+#define POWER_STATS_DIAG_WAKEUP_SOURCES     (4U)
+
+/* Frequency of the LPTimer used as the residency time base */
+#define POWER_STATS_LPTIMER_HZ              (32768U)
+
+/* Record type of the power statistics in the diagnostics characteristic */
+#define POWER_STATS_DIAG_RECORD_TYPE        (0x01U)
+
+/* Size of the power statistics diagnostics record in bytes */
+#define POWER_STATS_DIAG_RECORD_SIZE        (2U + (POWER_STATS_CORE_COUNT * \
+                                            (32U + (6U * \
+                                            POWER_STATS_DIAG_WAKEUP_SOURCES))))
+
+/* Wakeup IRQ value used when no pending interrupt was found */
+#define POWER_STATS_IRQN_UNKNOWN            (-1)
+
+/*******************************************************************************
+* Global Constants
+*******************************************************************************/
+/* CPUs that keep power statistics */
+typedef enum
+{
+    POWER_STATS_CORE_CM33,
+    POWER_STATS_CORE_CM55,
+    POWER_STATS_CORE_COUNT
+} power_stats_core_id_t;
+
+/* Power states that are accounted */
+typedef enum
+{
+    POWER_STATE_ACTIVE,
+    POWER_STATE_SLEEP,
+    POWER_STATE_DEEPSLEEP,
+    POWER_STATE_COUNT
+} power_state_t;
+
+/* Number of wakeups caused by one interrupt */
+typedef struct
+{
+    int32_t irqn;                   /* Interrupt number */
+    uint32_t count;                 /* Wakeups caused by this interrupt */
+} power_stats_wakeup_t;
+
+/* Power statistics of one CPU. The owning CPU is the only writer; the
+ * sequence counter is odd while an update is in progress so that the other
+ * CPU can take a consistent snapshot. */
+typedef struct __ALIGNED(32)
+{
+    volatile uint32_t sequence;                 /* Update sequence counter */
+    uint32_t entries[POWER_STATE_COUNT];        /* Entries per power state */
+    uint64_t residency[POWER_STATE_COUNT];      /* Time per state (LPTimer ticks) */
+    uint32_t idle_requests;                     /* Tickless idle entries */
+    uint32_t idle_aborted;                      /* Idle entries without a low power
+                                                 * transition */
+    uint32_t wakeup_unknown;                    /* Wakeups with no pending IRQ */
+    power_stats_wakeup_t wakeup[POWER_STATS_MAX_WAKEUP_SOURCES];
+} power_stats_core_t;
+
+/* Layout of the power statistics in the CM33/CM55 shared memory region */
+typedef struct
+{
+    uint32_t magic;                             /* POWER_STATS_MAGIC when valid */
+    power_stats_core_t core[POWER_STATS_CORE_COUNT];
+} power_stats_shared_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void power_stats_init(mtb_hal_lptimer_t *lptimer);
+void power_stats_idle_begin(void);
+void power_stats_idle_end(void);
+bool power_stats_get(power_stats_core_id_t core, power_stats_core_t *p_stats);
+uint16_t power_stats_serialize(uint8_t *p_buf, uint16_t len);
+void power_stats_print(void);
+
+#endif /* POWER_STATS_H */
+
+/* [] END OF FILE */
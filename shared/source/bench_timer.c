@@ -0,0 +1,298 @@
+/*******************************************************************************
+* File Name: bench_timer.c
+*
+* Description: This file contains the DWT cycle timer of the hot path benchmark
+*              build. Both CPUs time their kernels with it. CM55 has no debug
+*              console, so it writes its results after the power statistics in the
+*              shared memory region and CM33 prints them.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "power_stats.h"
+#include "bench_timer.h"
+
+#if defined(HOT_PATH_BENCHMARK)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#if defined(CORE_NAME_CM55_0)
+#define BENCH_TIMER_REGION_START            (CYMEM_CM55_0_m33_m55_shared_START)
+#else
+#define BENCH_TIMER_REGION_START            (CYMEM_CM33_0_m33_m55_shared_START)
+#endif
+
+/* The results follow the power statistics record, on a cache line */
+#define BENCH_TIMER_CACHE_LINE              (32U)
+#define BENCH_TIMER_SHARED_ADDR             (BENCH_TIMER_REGION_START + \
+        ((sizeof(power_stats_shared_t) + BENCH_TIMER_CACHE_LINE - 1U) & \
+         ~(BENCH_TIMER_CACHE_LINE - 1U)))
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Results of CM55 */
+static bench_timer_shared_t * const bench_timer_shared =
+        (bench_timer_shared_t *) BENCH_TIMER_SHARED_ADDR;
+
+/* Samples of the kernel being timed */
+static uint32_t bench_timer_samples[BENCH_TIMER_ITERATIONS];
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: bench_timer_compare
+********************************************************************************
+* Summary:
+*  qsort() comparison of two cycle counts.
+*******************************************************************************/
+static int bench_timer_compare(const void *p_a, const void *p_b)
+{
+    uint32_t a = *(const uint32_t *) p_a;
+    uint32_t b = *(const uint32_t *) p_b;
+
+    return (a > b) - (a < b);
+}
+
+/*******************************************************************************
+* Function Name: bench_timer_clean
+********************************************************************************
+* Summary:
+*  Makes the shared results visible to the other CPU.
+*******************************************************************************/
+static void bench_timer_clean(void)
+{
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_CleanDCache_by_Addr((void *) bench_timer_shared,
+            sizeof(*bench_timer_shared));
+#endif
+}
+
+/*******************************************************************************
+* Function Name: bench_timer_init
+********************************************************************************
+* Summary:
+*  Enables the DWT cycle counter. The CM33 application also clears the
+*  shared results, so it must call this before enabling CM55.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bench_timer_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+#if !defined(CORE_NAME_CM55_0)
+    memset(bench_timer_shared, 0, sizeof(*bench_timer_shared));
+    bench_timer_clean();
+#endif
+}
+
+/*******************************************************************************
+* Function Name: bench_timer_run
+********************************************************************************
+* Summary:
+*  Calls a kernel once per iteration and takes the minimum, median and
+*  maximum CPU cycles per call. The cycles include the timing itself, which
+*  the "overhead" kernel measures.
+*
+* Parameters:
+*  const bench_kernel_t *p_kernel : Kernel to time
+*  bench_result_t *p_result       : Results of the kernel
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bench_timer_run(const bench_kernel_t *p_kernel, bench_result_t *p_result)
+{
+    uint32_t iterations = p_kernel->iterations;
+
+    if ((0U == iterations) || (iterations > BENCH_TIMER_ITERATIONS))
+    {
+        iterations = BENCH_TIMER_ITERATIONS;
+    }
+
+    for (uint32_t n = 0U; n < iterations; n++)
+    {
+        uint32_t start = DWT->CYCCNT;
+
+        p_kernel->run();
+        bench_timer_samples[n] = DWT->CYCCNT - start;
+    }
+
+    qsort(bench_timer_samples, iterations, sizeof(bench_timer_samples[0]),
+          bench_timer_compare);
+
+    strncpy(p_result->name, p_kernel->name, BENCH_TIMER_NAME_LEN - 1U);
+    p_result->name[BENCH_TIMER_NAME_LEN - 1U] = '\0';
+    p_result->iterations = iterations;
+    p_result->min = bench_timer_samples[0];
+    p_result->median = bench_timer_samples[iterations / 2U];
+    p_result->max = bench_timer_samples[iterations - 1U];
+}
+
+/*******************************************************************************
+* Function Name: bench_timer_print_header
+********************************************************************************
+* Summary:
+*  Prints the column names of the result lines.
+*******************************************************************************/
+void bench_timer_print_header(void)
+{
+    printf("bench,core,kernel,iterations,min_cycles,median_cycles,"
+           "max_cycles\r\n");
+}
+
+/*******************************************************************************
+* Function Name: bench_timer_print
+********************************************************************************
+* Summary:
+*  Prints one result line:
+*  bench,<core>,<kernel>,<iterations>,<min>,<median>,<max>
+*
+* Parameters:
+*  const char *core               : CPU that ran the kernel
+*  const bench_result_t *p_result : Results of the kernel
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bench_timer_print(const char *core, const bench_result_t *p_result)
+{
+    printf("bench,%s,%s,%lu,%lu,%lu,%lu\r\n", core, p_result->name,
+           (unsigned long) p_result->iterations,
+           (unsigned long) p_result->min,
+           (unsigned long) p_result->median,
+           (unsigned long) p_result->max);
+}
+
+/*******************************************************************************
+* Function Name: bench_timer_publish
+********************************************************************************
+* Summary:
+*  Writes the results to the shared memory region and marks them complete.
+*  Called by CM55.
+*
+* Parameters:
+*  const bench_result_t *p_results : Results of the kernels
+*  uint32_t count                  : Number of results
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bench_timer_publish(const bench_result_t *p_results, uint32_t count)
+{
+    if (count > BENCH_TIMER_RESULTS_MAX)
+    {
+        count = BENCH_TIMER_RESULTS_MAX;
+    }
+
+    memcpy(bench_timer_shared->result, p_results, count * sizeof(*p_results));
+    bench_timer_shared->count = count;
+    bench_timer_clean();
+    __DMB();
+
+    bench_timer_shared->magic = BENCH_TIMER_MAGIC;
+    bench_timer_clean();
+}
+
+/*******************************************************************************
+* Function Name: bench_timer_collect
+********************************************************************************
+* Summary:
+*  Copies the CM55 results from the shared memory region. Called by CM33.
+*
+* Parameters:
+*  bench_result_t *p_results : Results destination
+*  uint32_t max              : Capacity of p_results
+*
+* Return:
+*  uint32_t: Number of results, 0 while CM55 has not published them
+*
+*******************************************************************************/
+uint32_t bench_timer_collect(bench_result_t *p_results, uint32_t max)
+{
+    uint32_t count;
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_InvalidateDCache_by_Addr((void *) bench_timer_shared,
+            sizeof(*bench_timer_shared));
+#endif
+
+    if (BENCH_TIMER_MAGIC != bench_timer_shared->magic)
+    {
+        return 0U;
+    }
+    __DMB();
+
+    count = (bench_timer_shared->count < max) ? bench_timer_shared->count : max;
+    memcpy(p_results, bench_timer_shared->result, count * sizeof(*p_results));
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: bench_timer_halt
+********************************************************************************
+* Summary:
+*  Stops the CPU once the benchmark is complete, so that nothing else runs
+*  after the results.
+*******************************************************************************/
+void bench_timer_halt(void)
+{
+    __disable_irq();
+
+    while (true)
+    {
+    }
+}
+
+#endif /* defined(HOT_PATH_BENCHMARK) */
+
+/* [] END OF FILE */
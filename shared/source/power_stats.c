@@ -0,0 +1,571 @@
+/*******************************************************************************
+* File Name: power_stats.c
+*
+* Description: This file counts power state entries, residency and wakeup
+*              sources of the CPU it is built for. The figures are kept in the
+*              memory region shared between CM33 and CM55 so that the CM33
+*              application can report both CPUs.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "power_stats.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#if defined(CORE_NAME_CM55_0)
+#define POWER_STATS_SHARED_ADDR             (CYMEM_CM55_0_m33_m55_shared_START)
+#define POWER_STATS_CORE_SELF               (POWER_STATS_CORE_CM55)
+#else
+#define POWER_STATS_SHARED_ADDR             (CYMEM_CM33_0_m33_m55_shared_START)
+#define POWER_STATS_CORE_SELF               (POWER_STATS_CORE_CM33)
+#endif
+
+/* Run the accounting callback last before and first after the transition */
+#define POWER_STATS_SYSPM_CALLBACK_ORDER    (255U)
+
+/* Maximum attempts to take a consistent snapshot of a record */
+#define POWER_STATS_READ_RETRIES            (8U)
+
+/* Number of NVIC pending registers scanned for the wakeup interrupt */
+#define POWER_STATS_NVIC_ISPR_COUNT         (16U)
+#define POWER_STATS_BITS_PER_WORD           (32U)
+
+#define POWER_STATS_MS_PER_SEC              (1000U)
+#define POWER_STATS_UINT16_MAX              (0xFFFFU)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Shared statistics record of both CPUs */
+static power_stats_shared_t * const power_stats_shared =
+        (power_stats_shared_t *) POWER_STATS_SHARED_ADDR;
+
+/* Time base for residency accounting */
+static mtb_hal_lptimer_t *power_stats_lptimer = NULL;
+
+/* LPTimer count at the start of the current power state */
+static uint32_t power_stats_state_start;
+
+/* Number of low power transitions seen in the current idle period */
+static uint32_t power_stats_idle_transitions;
+
+/* Power state passed to the SysPm callback through its context */
+static power_state_t power_stats_sleep_state = POWER_STATE_SLEEP;
+static power_state_t power_stats_deepsleep_state = POWER_STATE_DEEPSLEEP;
+
+static cy_en_syspm_status_t power_stats_syspm_callback(
+        cy_stc_syspm_callback_params_t *callbackParams,
+        cy_en_syspm_callback_mode_t mode);
+
+/* SysPm callback parameter structures */
+static cy_stc_syspm_callback_params_t power_stats_sleep_params =
+{
+    .context            = &power_stats_sleep_state,
+    .base               = NULL
+};
+
+static cy_stc_syspm_callback_params_t power_stats_deepsleep_params =
+{
+    .context            = &power_stats_deepsleep_state,
+    .base               = NULL
+};
+
+/* SysPm callback structure for CPU Sleep */
+static cy_stc_syspm_callback_t power_stats_sleep_cb =
+{
+    .callback           = &power_stats_syspm_callback,
+    .skipMode           = CY_SYSPM_SKIP_CHECK_FAIL | CY_SYSPM_SKIP_CHECK_READY,
+    .type               = CY_SYSPM_SLEEP,
+    .callbackParams     = &power_stats_sleep_params,
+    .prevItm            = NULL,
+    .nextItm            = NULL,
+    .order              = POWER_STATS_SYSPM_CALLBACK_ORDER
+};
+
+/* SysPm callback structure for DeepSleep */
+static cy_stc_syspm_callback_t power_stats_deepsleep_cb =
+{
+    .callback           = &power_stats_syspm_callback,
+    .skipMode           = CY_SYSPM_SKIP_CHECK_FAIL | CY_SYSPM_SKIP_CHECK_READY,
+    .type               = CY_SYSPM_DEEPSLEEP,
+    .callbackParams     = &power_stats_deepsleep_params,
+    .prevItm            = NULL,
+    .nextItm            = NULL,
+    .order              = POWER_STATS_SYSPM_CALLBACK_ORDER
+};
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: power_stats_self
+********************************************************************************
+* Summary:
+*  Returns the statistics record owned by this CPU.
+*******************************************************************************/
+static power_stats_core_t *power_stats_self(void)
+{
+    return &power_stats_shared->core[POWER_STATS_CORE_SELF];
+}
+
+/*******************************************************************************
+* Function Name: power_stats_clean
+********************************************************************************
+* Summary:
+*  Writes cached lines of a record back to the shared memory and waits for
+*  the write-back to complete. The D-cache does not order the write-back of
+*  different lines, so the sequence counter is cleaned on its own.
+*******************************************************************************/
+static void power_stats_clean(volatile void *p_addr, uint32_t size)
+{
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_CleanDCache_by_Addr((void *) p_addr, (int32_t) size);
+#else
+    CY_UNUSED_PARAMETER(p_addr);
+    CY_UNUSED_PARAMETER(size);
+#endif
+    __DSB();
+}
+
+/*******************************************************************************
+* Function Name: power_stats_update_begin
+********************************************************************************
+* Summary:
+*  Marks the record of this CPU as being updated. The odd sequence counter
+*  reaches the shared memory before any of the data.
+*******************************************************************************/
+static void power_stats_update_begin(power_stats_core_t *p_stats)
+{
+    p_stats->sequence++;
+    power_stats_clean(&p_stats->sequence, sizeof(p_stats->sequence));
+}
+
+/*******************************************************************************
+* Function Name: power_stats_update_end
+********************************************************************************
+* Summary:
+*  Marks the record of this CPU as consistent again and makes it visible to
+*  the other CPU. The data reaches the shared memory before the even
+*  sequence counter.
+*******************************************************************************/
+static void power_stats_update_end(power_stats_core_t *p_stats)
+{
+    power_stats_clean(p_stats, sizeof(*p_stats));
+    p_stats->sequence++;
+    power_stats_clean(&p_stats->sequence, sizeof(p_stats->sequence));
+}
+
+/*******************************************************************************
+* Function Name: power_stats_now
+********************************************************************************
+* Summary:
+*  Returns the current LPTimer count, or zero before initialization.
+*******************************************************************************/
+static uint32_t power_stats_now(void)
+{
+    return (NULL != power_stats_lptimer) ?
+            mtb_hal_lptimer_read(power_stats_lptimer) : 0U;
+}
+
+/*******************************************************************************
+* Function Name: power_stats_pending_irqn
+********************************************************************************
+* Summary:
+*  Finds the interrupt that woke up the CPU. Interrupts are still masked when
+*  the AFTER_TRANSITION callbacks run, so the wakeup interrupt is pending.
+*
+* Return:
+*  int32_t: Lowest pending interrupt number, or POWER_STATS_IRQN_UNKNOWN
+*
+*******************************************************************************/
+static int32_t power_stats_pending_irqn(void)
+{
+    int32_t irqn = POWER_STATS_IRQN_UNKNOWN;
+
+    for (uint32_t i = 0U; i < POWER_STATS_NVIC_ISPR_COUNT; i++)
+    {
+        uint32_t pending = NVIC->ISPR[i] & NVIC->ISER[i];
+
+        if (0U != pending)
+        {
+            irqn = (int32_t) ((i * POWER_STATS_BITS_PER_WORD) +
+                    (uint32_t) __CLZ(__RBIT(pending)));
+            break;
+        }
+    }
+
+    return irqn;
+}
+
+/*******************************************************************************
+* Function Name: power_stats_count_wakeup
+********************************************************************************
+* Summary:
+*  Adds one wakeup to the entry of the given interrupt.
+*******************************************************************************/
+static void power_stats_count_wakeup(power_stats_core_t *p_stats, int32_t irqn)
+{
+    if (POWER_STATS_IRQN_UNKNOWN == irqn)
+    {
+        p_stats->wakeup_unknown++;
+        return;
+    }
+
+    for (uint32_t i = 0U; i < POWER_STATS_MAX_WAKEUP_SOURCES; i++)
+    {
+        if ((p_stats->wakeup[i].irqn == irqn) || (0U == p_stats->wakeup[i].count))
+        {
+            p_stats->wakeup[i].irqn = irqn;
+            p_stats->wakeup[i].count++;
+            return;
+        }
+    }
+
+    /* All entries are taken by other interrupts */
+    p_stats->wakeup_unknown++;
+}
+
+/*******************************************************************************
+* Function Name: power_stats_syspm_callback
+********************************************************************************
+* Summary:
+*  SysPm callback for CPU Sleep and DeepSleep. Accounts the active time before
+*  the transition and the low power residency and wakeup source after it.
+*
+* Parameters:
+*  cy_stc_syspm_callback_params_t *callbackParams : SysPm callback parameters
+*  cy_en_syspm_callback_mode_t mode               : SysPm callback mode
+*
+* Return:
+*  cy_en_syspm_status_t: CY_SYSPM_SUCCESS
+*
+*******************************************************************************/
+static cy_en_syspm_status_t power_stats_syspm_callback(
+        cy_stc_syspm_callback_params_t *callbackParams,
+        cy_en_syspm_callback_mode_t mode)
+{
+    power_state_t state = *(power_state_t *) callbackParams->context;
+    power_stats_core_t *p_stats = power_stats_self();
+    uint32_t now = power_stats_now();
+
+    switch (mode)
+    {
+        case CY_SYSPM_BEFORE_TRANSITION:
+            power_stats_update_begin(p_stats);
+            p_stats->residency[POWER_STATE_ACTIVE] +=
+                    (uint32_t) (now - power_stats_state_start);
+            p_stats->entries[state]++;
+            power_stats_update_end(p_stats);
+            power_stats_state_start = now;
+            power_stats_idle_transitions++;
+            break;
+
+        case CY_SYSPM_AFTER_TRANSITION:
+            power_stats_update_begin(p_stats);
+            p_stats->residency[state] += (uint32_t) (now - power_stats_state_start);
+            p_stats->entries[POWER_STATE_ACTIVE]++;
+            power_stats_count_wakeup(p_stats, power_stats_pending_irqn());
+            power_stats_update_end(p_stats);
+            power_stats_state_start = now;
+            break;
+
+        default:
+            break;
+    }
+
+    return CY_SYSPM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: power_stats_init
+********************************************************************************
+* Summary:
+*  Clears the statistics of this CPU and registers the SysPm callbacks that
+*  account power state transitions. The CM33 application also initializes
+*  the shared record, so it must call this before enabling CM55.
+*
+* Parameters:
+*  mtb_hal_lptimer_t *lptimer : LPTimer used for the tickless idle mode
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void power_stats_init(mtb_hal_lptimer_t *lptimer)
+{
+#if !defined(CORE_NAME_CM55_0)
+    memset(power_stats_shared, 0, sizeof(*power_stats_shared));
+    power_stats_shared->magic = POWER_STATS_MAGIC;
+#else
+    memset(power_stats_self(), 0, sizeof(power_stats_core_t));
+#endif
+
+    power_stats_update_end(power_stats_self());
+
+    power_stats_lptimer = lptimer;
+    power_stats_state_start = power_stats_now();
+
+    Cy_SysPm_RegisterCallback(&power_stats_sleep_cb);
+    Cy_SysPm_RegisterCallback(&power_stats_deepsleep_cb);
+}
+
+/*******************************************************************************
+* Function Name: power_stats_idle_begin
+********************************************************************************
+* Summary:
+*  Tickless idle hook, called by the idle task before it suppresses the tick
+*  and requests a low power mode.
+*******************************************************************************/
+void power_stats_idle_begin(void)
+{
+    power_stats_idle_transitions = 0U;
+}
+
+/*******************************************************************************
+* Function Name: power_stats_idle_end
+********************************************************************************
+* Summary:
+*  Tickless idle hook, called by the idle task after it resumed from the
+*  tickless idle period. Counts periods in which no low power transition took
+*  place, for example because a SysPm callback refused it.
+*******************************************************************************/
+void power_stats_idle_end(void)
+{
+    power_stats_core_t *p_stats = power_stats_self();
+
+    power_stats_update_begin(p_stats);
+    p_stats->idle_requests++;
+    if (0U == power_stats_idle_transitions)
+    {
+        p_stats->idle_aborted++;
+    }
+    power_stats_update_end(p_stats);
+}
+
+/*******************************************************************************
+* Function Name: power_stats_get
+********************************************************************************
+* Summary:
+*  Takes a consistent snapshot of the statistics of one CPU.
+*
+* Parameters:
+*  power_stats_core_id_t core   : CPU to read
+*  power_stats_core_t *p_stats  : Snapshot destination
+*
+* Return:
+*  bool: true if a consistent snapshot was taken
+*
+*******************************************************************************/
+bool power_stats_get(power_stats_core_id_t core, power_stats_core_t *p_stats)
+{
+    const power_stats_core_t *p_src = &power_stats_shared->core[core];
+
+    if (POWER_STATS_MAGIC != power_stats_shared->magic)
+    {
+        return false;
+    }
+
+    for (uint32_t retry = 0U; retry < POWER_STATS_READ_RETRIES; retry++)
+    {
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+        SCB_InvalidateDCache_by_Addr((void *) p_src, sizeof(*p_src));
+#endif
+        uint32_t sequence = p_src->sequence;
+        __DMB();
+        memcpy(p_stats, (const void *) p_src, sizeof(*p_stats));
+        __DMB();
+
+        if ((0U == (sequence & 1U)) && (sequence == p_src->sequence))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: power_stats_ticks_to_ms
+********************************************************************************
+* Summary:
+*  Converts LPTimer ticks to milliseconds.
+*******************************************************************************/
+static uint32_t power_stats_ticks_to_ms(uint64_t ticks)
+{
+    return (uint32_t) ((ticks * POWER_STATS_MS_PER_SEC) / POWER_STATS_LPTIMER_HZ);
+}
+
+/*******************************************************************************
+* Function Name: power_stats_put_u32
+********************************************************************************
+* Summary:
+*  Writes a 32-bit value in little endian byte order.
+*******************************************************************************/
+static uint8_t *power_stats_put_u32(uint8_t *p, uint32_t value)
+{
+    p[0] = (uint8_t) value;
+    p[1] = (uint8_t) (value >> 8U);
+    p[2] = (uint8_t) (value >> 16U);
+    p[3] = (uint8_t) (value >> 24U);
+    return p + sizeof(uint32_t);
+}
+
+/*******************************************************************************
+* Function Name: power_stats_serialize
+********************************************************************************
+* Summary:
+*  Builds the power statistics record of the diagnostics characteristic.
+*  All values are little endian. Per CPU the record holds the entries and the
+*  residency in ms of Active, Sleep and DeepSleep, the tickless idle requests
+*  and aborted requests and the top wakeup interrupts (int16 IRQn, uint32
+*  count). A CPU without a valid snapshot is reported as all zero.
+*
+* Parameters:
+*  uint8_t *p_buf : Destination buffer
+*  uint16_t len   : Size of the destination buffer
+*
+* Return:
+*  uint16_t: Number of bytes written, zero if the buffer is too small
+*
+*******************************************************************************/
+uint16_t power_stats_serialize(uint8_t *p_buf, uint16_t len)
+{
+    power_stats_core_t stats;
+    uint8_t *p = p_buf;
+
+    if (len < POWER_STATS_DIAG_RECORD_SIZE)
+    {
+        return 0U;
+    }
+
+    *p++ = POWER_STATS_DIAG_RECORD_TYPE;
+    *p++ = POWER_STATS_CORE_COUNT;
+
+    for (uint32_t core = 0U; core < POWER_STATS_CORE_COUNT; core++)
+    {
+        if (!power_stats_get((power_stats_core_id_t) core, &stats))
+        {
+            memset(&stats, 0, sizeof(stats));
+        }
+
+        for (uint32_t state = 0U; state < POWER_STATE_COUNT; state++)
+        {
+            p = power_stats_put_u32(p, stats.entries[state]);
+        }
+        for (uint32_t state = 0U; state < POWER_STATE_COUNT; state++)
+        {
+            p = power_stats_put_u32(p,
+                    power_stats_ticks_to_ms(stats.residency[state]));
+        }
+        p = power_stats_put_u32(p, stats.idle_requests);
+        p = power_stats_put_u32(p, stats.idle_aborted);
+
+        for (uint32_t i = 0U; i < POWER_STATS_DIAG_WAKEUP_SOURCES; i++)
+        {
+            uint16_t irqn = (uint16_t) POWER_STATS_UINT16_MAX;
+
+            if (0U != stats.wakeup[i].count)
+            {
+                irqn = (uint16_t) stats.wakeup[i].irqn;
+            }
+            *p++ = (uint8_t) irqn;
+            *p++ = (uint8_t) (irqn >> 8U);
+            p = power_stats_put_u32(p, stats.wakeup[i].count);
+        }
+    }
+
+    return (uint16_t) (p - p_buf);
+}
+
+/*******************************************************************************
+* Function Name: power_stats_print
+********************************************************************************
+* Summary:
+*  Prints the power statistics of both CPUs on the debug console.
+*******************************************************************************/
+void power_stats_print(void)
+{
+    static const char * const core_names[POWER_STATS_CORE_COUNT] =
+    {
+        "CM33", "CM55"
+    };
+    power_stats_core_t stats;
+
+    for (uint32_t core = 0U; core < POWER_STATS_CORE_COUNT; core++)
+    {
+        if (!power_stats_get((power_stats_core_id_t) core, &stats))
+        {
+            printf("%s power stats: not available\r\n", core_names[core]);
+            continue;
+        }
+
+        printf("%s power stats:\r\n"
+               "  Active   : %lu entries, %lu ms\r\n"
+               "  Sleep    : %lu entries, %lu ms\r\n"
+               "  DeepSleep: %lu entries, %lu ms\r\n"
+               "  Idle     : %lu requests, %lu without transition\r\n",
+               core_names[core],
+               (unsigned long) stats.entries[POWER_STATE_ACTIVE],
+               (unsigned long) power_stats_ticks_to_ms(
+                       stats.residency[POWER_STATE_ACTIVE]),
+               (unsigned long) stats.entries[POWER_STATE_SLEEP],
+               (unsigned long) power_stats_ticks_to_ms(
+                       stats.residency[POWER_STATE_SLEEP]),
+               (unsigned long) stats.entries[POWER_STATE_DEEPSLEEP],
+               (unsigned long) power_stats_ticks_to_ms(
+                       stats.residency[POWER_STATE_DEEPSLEEP]),
+               (unsigned long) stats.idle_requests,
+               (unsigned long) stats.idle_aborted);
+
+        for (uint32_t i = 0U; i < POWER_STATS_MAX_WAKEUP_SOURCES; i++)
+        {
+            if (0U != stats.wakeup[i].count)
+            {
+                printf("  Wakeup IRQ %ld: %lu\r\n",
+                       (long) stats.wakeup[i].irqn,
+                       (unsigned long) stats.wakeup[i].count);
+            }
+        }
+        printf("  Wakeup unknown: %lu\r\n",
+               (unsigned long) stats.wakeup_unknown);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,262 @@
+/*******************************************************************************
+* File Name: bench_host.c
+*
+* Description: This file contains the host build of the hot path benchmark. It
+*              runs the CapSense kernels and the GATT kernels that do not need
+*              the target on the stack stand-in and prints the results in
+*              nanoseconds per call, in the format that
+*              benchmark/bench_compare.sh compares.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include "freertos_host.h"
+#include "kv_flash_file.h"
+#include "kv_store.h"
+#include "wiced_bt_host.h"
+#include "bt_app_host.h"
+#include "cycfg_gatt_db.h"
+#include "bt_app.h"
+#include "bt_control.h"
+#include "bt_notify.h"
+#include "bench_timer.h"
+#include "capsense_bench.h"
+#include "hot_path_bench.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_FILE                          "bench_host.bin"
+#define BENCH_CONN_ID                       (0x0040U)
+#define BENCH_START_TICK                    (1000U)
+
+/* ATT MTU and read by type request size of the GATT kernels */
+#define BENCH_MTU                           (247U)
+#define BENCH_READ_BY_TYPE_LEN              (BENCH_MTU - 2U)
+
+#define BENCH_GATT_HANDLE_FIRST             (0x0001U)
+#define BENCH_GATT_HANDLE_LAST              (0xFFFFU)
+
+/* Connection ID the read by type kernel sends to, which is not connected */
+#define BENCH_NO_CONN_ID                    (0U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static volatile uint32_t bench_sink;
+
+static wiced_bt_device_address_t bench_client_addr =
+        { 0x11U, 0x22U, 0x33U, 0x44U, 0x55U, 0x66U };
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: bench_find_by_handle
+********************************************************************************
+* Summary:
+*  Looks up the attribute at the end of the lookup table.
+*******************************************************************************/
+static void bench_find_by_handle(void)
+{
+    bench_sink += (uint32_t) (NULL != bt_app_find_by_handle(
+            app_gatt_db_ext_attr_tbl[app_gatt_db_ext_attr_tbl_size - 1U]
+            .handle));
+}
+
+/*******************************************************************************
+* Function Name: bench_write_value
+********************************************************************************
+* Summary:
+*  Writes the Diagnostics CCCD, which has no side effect beyond the value.
+*******************************************************************************/
+static void bench_write_value(void)
+{
+    uint8_t cccd[] = {0U, 0U};
+
+    bench_sink += (uint32_t) bt_app_gatt_req_write_value(
+            HDLD_CAPSENSE_DIAGNOSTICS_CLIENT_CHAR_CONFIG, cccd, sizeof(cccd));
+}
+
+/*******************************************************************************
+* Function Name: bench_read_by_type
+********************************************************************************
+* Summary:
+*  Builds the Read By Type Response for the device name over the whole
+*  database. As on the target, the response goes to a connection that does
+*  not exist and the stack refuses it.
+*******************************************************************************/
+static void bench_read_by_type(void)
+{
+    wiced_bt_gatt_read_by_type_t req =
+    {
+        .s_handle = BENCH_GATT_HANDLE_FIRST,
+        .e_handle = BENCH_GATT_HANDLE_LAST,
+        .uuid =
+        {
+            .len = LEN_UUID_16,
+            .uu.uuid16 = GATT_UUID_GAP_DEVICE_NAME,
+        },
+    };
+
+    bench_sink += (uint32_t) bt_app_gatt_req_read_by_type_handler(
+            BENCH_NO_CONN_ID, GATT_REQ_READ_BY_TYPE, &req,
+            BENCH_READ_BY_TYPE_LEN);
+}
+
+/*******************************************************************************
+* Function Name: bench_notify
+********************************************************************************
+* Summary:
+*  Sends a slider notification: queues the new value, sends it from the
+*  queue as the BT task does and returns the buffer as the stack does once
+*  it is transmitted.
+*******************************************************************************/
+static void bench_notify(void)
+{
+    capsense_data.sliderdata++;
+    bt_app_send_notification();
+    (void) bt_notify_process();
+    bench_sink += wiced_bt_host_transmit();
+}
+
+/* Host GATT kernels, run in this order after the CapSense kernels */
+static const bench_kernel_t bench_kernels[] =
+{
+    { "find_by_handle",      bench_find_by_handle,      0U },
+    { "write_value",         bench_write_value,         0U },
+    { "read_by_type",        bench_read_by_type,        0U },
+    { "notify",              bench_notify,              0U },
+};
+
+/*******************************************************************************
+* Function Name: bench_run_kernels
+********************************************************************************
+* Summary:
+*  Times the given kernels and prints one result line per kernel.
+*******************************************************************************/
+static void bench_run_kernels(const bench_kernel_t *p_kernels, uint32_t count)
+{
+    bench_result_t result;
+
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        bench_timer_run(&p_kernels[i], &result);
+        bench_timer_print("host", &result);
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_connect
+********************************************************************************
+* Summary:
+*  Connects a client with a 247-byte MTU and the slider notifications
+*  enabled.
+*******************************************************************************/
+static void bench_connect(void)
+{
+    wiced_bt_gatt_attribute_request_t req =
+    {
+        .conn_id = BENCH_CONN_ID,
+        .opcode = GATT_REQ_MTU,
+        .data.remote_mtu = BENCH_MTU,
+    };
+    uint8_t cccd[] = { GATT_CLIENT_CONFIG_NOTIFICATION, 0U };
+
+    wiced_bt_host_connect(BENCH_CONN_ID, bench_client_addr);
+    (void) bt_app_gatt_req_cb(&req);
+    (void) bt_app_gatt_req_write_value(
+            HDLD_CAPSENSE_SLIDER_CLIENT_CHAR_CONFIG, cccd, sizeof(cccd));
+    (void) bt_notify_process();
+    (void) wiced_bt_host_transmit();
+}
+
+/*******************************************************************************
+* Function Name: hot_path_benchmark
+********************************************************************************
+* Summary:
+*  Runs the host kernels and prints the results:
+*  bench,host,<kernel>,<iterations>,<min>,<median>,<max> in nanoseconds per
+*  call, including the overhead kernel. The kernels that use peripherals
+*  (the I2C read, the PWM update and the LED command) and the stream
+*  assembly run on the target only.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void hot_path_benchmark(void)
+{
+    bench_timer_print_header();
+    bench_run_kernels(capsense_bench_kernels, capsense_bench_kernel_count);
+    bench_run_kernels(bench_kernels,
+                      sizeof(bench_kernels) / sizeof(bench_kernels[0]));
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Starts the application on the stack stand-in as the bt_app tests do,
+*  connects a client and runs the benchmark.
+*******************************************************************************/
+int main(void)
+{
+    freertos_host_set_tick(BENCH_START_TICK);
+    bt_app_host_reset();
+    if (!kv_flash_file_open(BENCH_FILE, true) || !kv_store_init() ||
+            !bt_control_init())
+    {
+        printf("FAIL setup\n");
+        return 1;
+    }
+    bt_app_init();
+    bench_connect();
+
+    hot_path_benchmark();
+
+    wiced_bt_host_disconnect();
+    kv_flash_file_close();
+    (void) remove(BENCH_FILE);
+
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,708 @@
+/*******************************************************************************
+* File Name: bt_app_test.c
+*
+* Description: This file contains the host tests of the GATT request callback.
+*              They run the application request handlers, the notification and
+*              indication queues, the bond module and the control characteristic
+*              on the stack stand-in of host/wiced_bt_host.c.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "host_test.h"
+#include "freertos_host.h"
+#include "kv_flash_file.h"
+#include "kv_store.h"
+#include "wiced_bt_host.h"
+#include "bt_app_host.h"
+#include "bt_app.h"
+#include "bt_control.h"
+#include "bt_indicate.h"
+#include "bt_notify.h"
+#include "bt_stream.h"
+#include "cycfg_bt_settings.h"
+#include "power_stats.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BT_TEST_FILE                        "bt_app_test.bin"
+#define BT_TEST_CONN_ID                     (0x0040U)
+#define BT_TEST_START_TICK                  (1000U)
+
+/* Bytes a client can read in one response at the default MTU */
+#define BT_TEST_READ_LEN                    (22U)
+
+/* Handle that is not in the database */
+#define BT_TEST_INVALID_HANDLE              (0x0030U)
+
+/* Diagnostics record of the power_stats_serialize() fake */
+#define BT_TEST_DIAG_RECORD_SIZE            (POWER_STATS_DIAG_RECORD_SIZE)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+unsigned int host_test_failures;
+
+static wiced_bt_device_address_t client_addr =
+        { 0x11U, 0x22U, 0x33U, 0x44U, 0x55U, 0x66U };
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: client_connect
+********************************************************************************
+* Summary:
+*  Connects the client.
+*******************************************************************************/
+static void client_connect(void)
+{
+    wiced_bt_host_reset();
+    bt_app_host_reset();
+    wiced_bt_host_connect(BT_TEST_CONN_ID, client_addr);
+}
+
+/*******************************************************************************
+* Function Name: client_disconnect
+********************************************************************************
+* Summary:
+*  Disconnects the client and checks that the application freed all
+*  buffers.
+*******************************************************************************/
+static void client_disconnect(void)
+{
+    wiced_bt_host_disconnect();
+    TEST_CHECK(0U == wiced_bt_host_pending());
+    TEST_CHECK(0U == freertos_host_allocations());
+}
+
+/*******************************************************************************
+* Function Name: client_encrypt
+********************************************************************************
+* Summary:
+*  Reports an encrypted link, as after pairing.
+*******************************************************************************/
+static void client_encrypt(void)
+{
+    wiced_bt_management_evt_data_t event;
+
+    memset(&event, 0, sizeof(event));
+    event.encryption_status.bd_addr = client_addr;
+    event.encryption_status.transport = BT_TRANSPORT_LE;
+    event.encryption_status.result = WICED_BT_SUCCESS;
+    (void) bt_app_management_cb(BTM_ENCRYPTION_STATUS_EVT, &event);
+}
+
+/*******************************************************************************
+* Function Name: request
+********************************************************************************
+* Summary:
+*  Returns a request of the connected client.
+*******************************************************************************/
+static wiced_bt_gatt_attribute_request_t request(
+        wiced_bt_gatt_opcode_t opcode, uint16_t len_requested)
+{
+    wiced_bt_gatt_attribute_request_t req;
+
+    memset(&req, 0, sizeof(req));
+    req.conn_id = BT_TEST_CONN_ID;
+    req.opcode = opcode;
+    req.len_requested = len_requested;
+
+    return req;
+}
+
+/*******************************************************************************
+* Function Name: read_value
+********************************************************************************
+* Summary:
+*  Sends a Read or Read Blob Request.
+*******************************************************************************/
+static wiced_bt_gatt_status_t read_value(wiced_bt_gatt_opcode_t opcode,
+                                         uint16_t handle, uint16_t offset)
+{
+    wiced_bt_gatt_attribute_request_t req = request(opcode,
+                                                    BT_TEST_READ_LEN);
+
+    req.data.read_req.handle = handle;
+    req.data.read_req.offset = offset;
+
+    return bt_app_gatt_req_cb(&req);
+}
+
+/*******************************************************************************
+* Function Name: write_value
+********************************************************************************
+* Summary:
+*  Sends a Write Request or Write Command.
+*******************************************************************************/
+static wiced_bt_gatt_status_t write_value(wiced_bt_gatt_opcode_t opcode,
+        uint16_t handle, const uint8_t *p_val, uint16_t len)
+{
+    uint8_t value[WICED_BT_HOST_PDU_DATA_MAX];
+    wiced_bt_gatt_attribute_request_t req = request(opcode, 0U);
+
+    memcpy(value, p_val, len);
+    req.data.write_req.handle = handle;
+    req.data.write_req.val_len = len;
+    req.data.write_req.p_val = value;
+
+    return bt_app_gatt_req_cb(&req);
+}
+
+/*******************************************************************************
+* Function Name: set_cccd
+********************************************************************************
+* Summary:
+*  Writes a client characteristic configuration descriptor.
+*******************************************************************************/
+static wiced_bt_gatt_status_t set_cccd(uint16_t handle, uint16_t config)
+{
+    uint8_t value[] = { (uint8_t) config, (uint8_t) (config >> 8U) };
+
+    return write_value(GATT_REQ_WRITE, handle, value, sizeof(value));
+}
+
+/*******************************************************************************
+* Function Name: pdu_is
+********************************************************************************
+* Summary:
+*  Returns true when the last PDU has the given opcode and handle.
+*******************************************************************************/
+static bool pdu_is(uint8_t opcode, uint16_t handle)
+{
+    const wiced_bt_host_pdu_t *p_pdu = wiced_bt_host_last_pdu();
+
+    return (NULL != p_pdu) && (opcode == p_pdu->opcode) &&
+           (handle == p_pdu->handle) && (BT_TEST_CONN_ID == p_pdu->conn_id);
+}
+
+/*******************************************************************************
+* Function Name: error_is
+********************************************************************************
+* Summary:
+*  Returns true when the last PDU is an Error Response to the request.
+*******************************************************************************/
+static bool error_is(wiced_bt_gatt_opcode_t opcode, uint16_t handle,
+                     wiced_bt_gatt_status_t status)
+{
+    const wiced_bt_host_pdu_t *p_pdu = wiced_bt_host_last_pdu();
+
+    return pdu_is(GATT_RSP_ERROR, handle) && (status == p_pdu->error) &&
+           (1U == p_pdu->len) && (opcode == p_pdu->data[0]);
+}
+
+/*******************************************************************************
+* Function Name: test_mtu_exchange
+********************************************************************************
+* Summary:
+*  The MTU response carries the local MTU, and the connection and the stream
+*  use the smaller one.
+*******************************************************************************/
+static void test_mtu_exchange(void)
+{
+    wiced_bt_gatt_attribute_request_t req = request(GATT_REQ_MTU, 0U);
+    const wiced_bt_host_pdu_t *p_pdu;
+
+    client_connect();
+
+    req.data.remote_mtu = 247U;
+    TEST_CHECK(WICED_BT_GATT_SUCCESS == bt_app_gatt_req_cb(&req));
+    p_pdu = wiced_bt_host_last_pdu();
+    TEST_CHECK(pdu_is(GATT_RSP_MTU, 0U));
+    TEST_CHECK((2U == p_pdu->len) && (CY_BT_RX_PDU_SIZE ==
+               (p_pdu->data[0] | (p_pdu->data[1] << 8U))));
+    TEST_CHECK(247U == wiced_bt_host_mtu());
+    TEST_CHECK(247U == bt_app_host.stream_mtu);
+    TEST_CHECK((247U - 3U) == bt_app_max_notification_len());
+
+    req.data.remote_mtu = 1024U;
+    TEST_CHECK(WICED_BT_GATT_SUCCESS == bt_app_gatt_req_cb(&req));
+    TEST_CHECK(CY_BT_RX_PDU_SIZE == wiced_bt_host_mtu());
+    TEST_CHECK(CY_BT_RX_PDU_SIZE == bt_app_host.stream_mtu);
+
+    client_disconnect();
+    TEST_CHECK(BT_STREAM_DEFAULT_MTU == bt_app_host.stream_mtu);
+}
+
+/*******************************************************************************
+* Function Name: test_read
+********************************************************************************
+* Summary:
+*  A read returns the current CapSense data; unknown handles and offsets
+*  past the value get an Error Response.
+*******************************************************************************/
+static void test_read(void)
+{
+    const wiced_bt_host_pdu_t *p_pdu;
+
+    client_connect();
+
+    capsense_data.buttoncount = 2U;
+    capsense_data.buttonstatus1 = 1U;
+    TEST_CHECK(WICED_BT_GATT_SUCCESS ==
+               read_value(GATT_REQ_READ, HDLC_CAPSENSE_BUTTON_VALUE, 0U));
+    p_pdu = wiced_bt_host_last_pdu();
+    TEST_CHECK(pdu_is(GATT_RSP_READ, 0U));
+    TEST_CHECK((3U == p_pdu->len) && (2U == p_pdu->data[0]) &&
+               (1U == p_pdu->data[1]));
+
+    TEST_CHECK(WICED_BT_GATT_SUCCESS ==
+               read_value(GATT_REQ_READ, HDLC_GAP_DEVICE_NAME_VALUE, 0U));
+    p_pdu = wiced_bt_host_last_pdu();
+    TEST_CHECK((app_gap_device_name_len == p_pdu->len) &&
+               (0 == memcmp(p_pdu->data, app_gap_device_name,
+                            app_gap_device_name_len)));
+
+    TEST_CHECK(WICED_BT_GATT_INVALID_HANDLE ==
+               read_value(GATT_REQ_READ, BT_TEST_INVALID_HANDLE, 0U));
+    TEST_CHECK(error_is(GATT_REQ_READ, BT_TEST_INVALID_HANDLE,
+                        WICED_BT_GATT_INVALID_HANDLE));
+
+    TEST_CHECK(WICED_BT_GATT_INVALID_OFFSET ==
+               read_value(GATT_REQ_READ_BLOB, HDLC_CAPSENSE_BUTTON_VALUE, 3U));
+    TEST_CHECK(error_is(GATT_REQ_READ_BLOB, HDLC_CAPSENSE_BUTTON_VALUE,
+                        WICED_BT_GATT_INVALID_OFFSET));
+
+    client_disconnect();
+}
+
+/*******************************************************************************
+* Function Name: test_read_blob_snapshot
+********************************************************************************
+* Summary:
+*  A long read of the diagnostics takes one snapshot at offset 0, so the
+*  Read Blob Requests return the rest of the same record.
+*******************************************************************************/
+static void test_read_blob_snapshot(void)
+{
+    const wiced_bt_host_pdu_t *p_pdu;
+    uint16_t offset = 0U;
+    bool same = true;
+
+    client_connect();
+
+    while (offset < BT_TEST_DIAG_RECORD_SIZE)
+    {
+        TEST_CHECK(WICED_BT_GATT_SUCCESS == read_value(
+                (0U == offset) ? GATT_REQ_READ : GATT_REQ_READ_BLOB,
+                HDLC_CAPSENSE_DIAGNOSTICS_VALUE, offset));
+        p_pdu = wiced_bt_host_last_pdu();
+        TEST_CHECK(MIN(BT_TEST_READ_LEN, BT_TEST_DIAG_RECORD_SIZE - offset) ==
+                   p_pdu->len);
+        for (uint16_t i = 0U; i < p_pdu->len; i++)
+        {
+            same = same && ((uint8_t) (1U + offset + i) == p_pdu->data[i]);
+        }
+        offset += p_pdu->len;
+    }
+    TEST_CHECK(same);
+    TEST_CHECK(1U == bt_app_host.snapshots);
+
+    TEST_CHECK(WICED_BT_GATT_INVALID_OFFSET == read_value(GATT_REQ_READ_BLOB,
+            HDLC_CAPSENSE_DIAGNOSTICS_VALUE, BT_TEST_DIAG_RECORD_SIZE));
+
+    /* A new long read takes a new snapshot */
+    TEST_CHECK(WICED_BT_GATT_SUCCESS == read_value(GATT_REQ_READ,
+            HDLC_CAPSENSE_DIAGNOSTICS_VALUE, 0U));
+    TEST_CHECK(2U == bt_app_host.snapshots);
+    TEST_CHECK(2U == wiced_bt_host_last_pdu()->data[0]);
+
+    client_disconnect();
+}
+
+/*******************************************************************************
+* Function Name: test_read_by_type
+********************************************************************************
+* Summary:
+*  A Read By Type Request for the CCCD type returns the four descriptors,
+*  and the response buffer is released once, by the stack.
+*******************************************************************************/
+static void test_read_by_type(void)
+{
+    static const uint16_t cccds[] =
+    {
+        HDLD_CAPSENSE_BUTTON_CLIENT_CHAR_CONFIG,
+        HDLD_CAPSENSE_SLIDER_CLIENT_CHAR_CONFIG,
+        HDLD_CAPSENSE_DIAGNOSTICS_CLIENT_CHAR_CONFIG,
+        HDLD_CAPSENSE_STREAM_CLIENT_CHAR_CONFIG,
+    };
+    wiced_bt_gatt_attribute_request_t req = request(GATT_REQ_READ_BY_TYPE,
+                                                    BT_TEST_READ_LEN);
+    const wiced_bt_host_pdu_t *p_pdu;
+
+    client_connect();
+
+    req.data.read_by_type.s_handle = 0x0001U;
+    req.data.read_by_type.e_handle = 0xFFFFU;
+    req.data.read_by_type.uuid.len = LEN_UUID_16;
+    req.data.read_by_type.uuid.uu.uuid16 = GATT_UUID_CHAR_CLIENT_CONFIG;
+    TEST_CHECK(WICED_BT_GATT_SUCCESS == bt_app_gatt_req_cb(&req));
+    p_pdu = wiced_bt_host_last_pdu();
+    TEST_CHECK(pdu_is(GATT_RSP_READ_BY_TYPE, 0U));
+    TEST_CHECK((1U + (4U * 4U)) == p_pdu->len);
+    TEST_CHECK(4U == p_pdu->data[0]);
+    for (uint32_t i = 0U; i < 4U; i++)
+    {
+        TEST_CHECK(cccds[i] == (p_pdu->data[1U + (i * 4U)] |
+                                (p_pdu->data[2U + (i * 4U)] << 8U)));
+    }
+
+    /* Only the range is searched */
+    req.data.read_by_type.s_handle = HDLD_CAPSENSE_SLIDER_CLIENT_CHAR_CONFIG;
+    req.data.read_by_type.e_handle = HDLD_CAPSENSE_SLIDER_CLIENT_CHAR_CONFIG;
+    TEST_CHECK(WICED_BT_GATT_SUCCESS == bt_app_gatt_req_cb(&req));
+    TEST_CHECK((1U + 4U) == wiced_bt_host_last_pdu()->len);
+
+    /* No attribute of the type */
+    req.data.read_by_type.s_handle = 0x0001U;
+    req.data.read_by_type.e_handle = 0xFFFFU;
+    req.data.read_by_type.uuid.uu.uuid16 = 0x2A19U;
+    TEST_CHECK(WICED_BT_GATT_INVALID_HANDLE == bt_app_gatt_req_cb(&req));
+
+    TEST_CHECK(2U == wiced_bt_host_transmit());
+    client_disconnect();
+}
+
+/*******************************************************************************
+* Function Name: test_read_multiple
+********************************************************************************
+* Summary:
+*  Read Multiple returns the values back to back, the variable length form
+*  puts the length before each; an unknown handle fails the request.
+*******************************************************************************/
+static void test_read_multiple(void)
+{
+    uint8_t handles[] =
+    {
+        WICED_BT_HOST_DB_UUID16(HDLC_CAPSENSE_BUTTON_VALUE),
+        WICED_BT_HOST_DB_UUID16(HDLC_CAPSENSE_SLIDER_VALUE),
+    };
+    const uint8_t multi[] = { 2U, 1U, 0U, 40U };
+    const uint8_t multi_var[] = { 3U, 0U, 2U, 1U, 0U, 1U, 0U, 40U };
+    wiced_bt_gatt_attribute_request_t req = request(GATT_REQ_READ_MULTI,
+                                                    BT_TEST_READ_LEN);
+    const wiced_bt_host_pdu_t *p_pdu;
+
+    client_connect();
+
+    capsense_data.buttoncount = 2U;
+    capsense_data.buttonstatus1 = 1U;
+    capsense_data.sliderdata = 40U;
+    req.data.read_multiple_req.num_handles = 2U;
+    req.data.read_multiple_req.p_handle_stream = handles;
+    TEST_CHECK(WICED_BT_GATT_SUCCESS == bt_app_gatt_req_cb(&req));
+    p_pdu = wiced_bt_host_last_pdu();
+    TEST_CHECK(pdu_is(GATT_RSP_READ_MULTI, 0U));
+    TEST_CHECK((sizeof(multi) == p_pdu->len) &&
+               (0 == memcmp(p_pdu->data, multi, sizeof(multi))));
+
+    req.opcode = GATT_REQ_READ_MULTI_VAR_LENGTH;
+    TEST_CHECK(WICED_BT_GATT_SUCCESS == bt_app_gatt_req_cb(&req));
+    p_pdu = wiced_bt_host_last_pdu();
+    TEST_CHECK(pdu_is(GATT_RSP_READ_MULTI_VAR_LENGTH, 0U));
+    TEST_CHECK((sizeof(multi_var) == p_pdu->len) &&
+               (0 == memcmp(p_pdu->data, multi_var, sizeof(multi_var))));
+
+    handles[2] = (uint8_t) BT_TEST_INVALID_HANDLE;
+    handles[3] = (uint8_t) (BT_TEST_INVALID_HANDLE >> 8U);
+    TEST_CHECK(WICED_BT_GATT_INVALID_HANDLE == bt_app_gatt_req_cb(&req));
+    TEST_CHECK(error_is(GATT_REQ_READ_MULTI_VAR_LENGTH,
+                        BT_TEST_INVALID_HANDLE,
+                        WICED_BT_GATT_INVALID_HANDLE));
+
+    TEST_CHECK(2U == wiced_bt_host_transmit());
+    client_disconnect();
+}
+
+/*******************************************************************************
+* Function Name: test_cccd_notification
+********************************************************************************
+* Summary:
+*  Enabling the button notifications sends a Write Response and the current
+*  button state through the notification queue; a CCCD of the wrong length
+*  is refused.
+*******************************************************************************/
+static void test_cccd_notification(void)
+{
+    const uint8_t one_byte = GATT_CLIENT_CONFIG_NOTIFICATION;
+    const wiced_bt_host_pdu_t *p_pdu;
+    bt_notify_stats_t stats;
+    uint32_t pdus;
+
+    client_connect();
+
+    capsense_data.buttonstatus1 = 1U;
+    TEST_CHECK(WICED_BT_GATT_SUCCESS ==
+               set_cccd(HDLD_CAPSENSE_BUTTON_CLIENT_CHAR_CONFIG,
+                        GATT_CLIENT_CONFIG_NOTIFICATION));
+    TEST_CHECK(pdu_is(GATT_RSP_WRITE,
+                      HDLD_CAPSENSE_BUTTON_CLIENT_CHAR_CONFIG));
+
+    /* The BT task sends the queued value */
+    (void) bt_notify_process();
+    p_pdu = wiced_bt_host_last_pdu();
+    TEST_CHECK(pdu_is(GATT_HANDLE_VALUE_NOTIF, HDLC_CAPSENSE_BUTTON_VALUE));
+    TEST_CHECK((3U == p_pdu->len) &&
+               (CAPSENSE_BUTTON_COUNT == p_pdu->data[0]) &&
+               (1U == p_pdu->data[1]));
+    bt_notify_get_stats(&stats);
+    TEST_CHECK(1U == stats.in_flight);
+
+    TEST_CHECK(1U == wiced_bt_host_transmit());
+    bt_notify_get_stats(&stats);
+    TEST_CHECK(0U == stats.in_flight);
+
+    pdus = wiced_bt_host_pdu_count();
+    TEST_CHECK(WICED_BT_GATT_INVALID_ATTR_LEN ==
+               write_value(GATT_REQ_WRITE,
+                           HDLD_CAPSENSE_SLIDER_CLIENT_CHAR_CONFIG,
+                           &one_byte, sizeof(one_byte)));
+    TEST_CHECK(pdus == wiced_bt_host_pdu_count());
+
+    client_disconnect();
+    TEST_CHECK(0U == app_capsense_button_client_char_config[0]);
+}
+
+/*******************************************************************************
+* Function Name: test_cccd_indication
+********************************************************************************
+* Summary:
+*  With indications enabled, a button value is sent as an indication and
+*  leaves the queue when the client confirms it.
+*******************************************************************************/
+static void test_cccd_indication(void)
+{
+    wiced_bt_gatt_attribute_request_t req = request(GATT_HANDLE_VALUE_CONF,
+                                                    0U);
+    bt_indicate_stats_t before;
+    bt_indicate_stats_t after;
+
+    client_connect();
+    bt_indicate_get_stats(&before);
+
+    TEST_CHECK(WICED_BT_GATT_SUCCESS ==
+               set_cccd(HDLD_CAPSENSE_BUTTON_CLIENT_CHAR_CONFIG,
+                        GATT_CLIENT_CONFIG_INDICATION));
+    (void) bt_indicate_process();
+    TEST_CHECK(pdu_is(GATT_HANDLE_VALUE_IND, HDLC_CAPSENSE_BUTTON_VALUE));
+
+    freertos_host_advance(pdMS_TO_TICKS(30U));
+    req.data.confirm_handle = HDLC_CAPSENSE_BUTTON_VALUE;
+    TEST_CHECK(WICED_BT_GATT_SUCCESS == bt_app_gatt_req_cb(&req));
+    bt_indicate_get_stats(&after);
+    TEST_CHECK((before.confirmed + 1U) == after.confirmed);
+    TEST_CHECK(0U == after.pending);
+    TEST_CHECK(30U == after.rtt_last_ms);
+
+    client_disconnect();
+}
+
+/*******************************************************************************
+* Function Name: test_control_write
+********************************************************************************
+* Summary:
+*  The control characteristic refuses writes on a link that is not
+*  encrypted. Once it is, a write is applied, answered and saved by the
+*  BT task; an invalid record changes nothing.
+*******************************************************************************/
+static void test_control_write(void)
+{
+    const uint8_t interval[] = { BT_CONTROL_NOTIFY_INTERVAL, 2U, 50U, 0U };
+    const uint8_t too_long[] = { BT_CONTROL_NOTIFY_INTERVAL, 2U, 0xE9U, 0x03U };
+    uint8_t saved[KV_VALUE_MAX];
+    uint16_t saved_len = 0U;
+    bool found = false;
+    uint32_t pdus;
+
+    client_connect();
+
+    pdus = wiced_bt_host_pdu_count();
+    TEST_CHECK(WICED_BT_GATT_INSUF_AUTHENTICATION ==
+               write_value(GATT_REQ_WRITE, HDLC_CAPSENSE_CONTROL_VALUE,
+                           interval, sizeof(interval)));
+    TEST_CHECK(pdus == wiced_bt_host_pdu_count());
+    TEST_CHECK(50U != bt_app_get_notify_interval());
+
+    client_encrypt();
+    TEST_CHECK(WICED_BT_GATT_SUCCESS ==
+               write_value(GATT_REQ_WRITE, HDLC_CAPSENSE_CONTROL_VALUE,
+                           interval, sizeof(interval)));
+    TEST_CHECK(pdu_is(GATT_RSP_WRITE, HDLC_CAPSENSE_CONTROL_VALUE));
+    TEST_CHECK(50U == bt_app_get_notify_interval());
+
+    /* The BT task saves the parameters */
+    (void) bt_control_process();
+    TEST_CHECK(kv_store_get(KV_KEY_CONTROL, saved, sizeof(saved),
+                            &saved_len));
+    for (uint16_t i = 0U; (i + sizeof(interval)) <= saved_len; i++)
+    {
+        found = found || (0 == memcmp(&saved[i], interval, sizeof(interval)));
+    }
+    TEST_CHECK(found);
+
+    TEST_CHECK(WICED_BT_GATT_SUCCESS !=
+               write_value(GATT_CMD_WRITE, HDLC_CAPSENSE_CONTROL_VALUE,
+                           too_long, sizeof(too_long)));
+    TEST_CHECK(50U == bt_app_get_notify_interval());
+
+    client_disconnect();
+}
+
+/*******************************************************************************
+* Function Name: test_client_features
+********************************************************************************
+* Summary:
+*  The client may set Client Supported Features bits but not clear them.
+*******************************************************************************/
+static void test_client_features(void)
+{
+    const uint8_t robust_caching = 0x01U;
+    const uint8_t none = 0x00U;
+    const uint8_t two_bytes[] = { 0x01U, 0x00U };
+
+    client_connect();
+
+    TEST_CHECK(WICED_BT_GATT_SUCCESS ==
+               write_value(GATT_REQ_WRITE,
+                           HDLC_GATT_CLIENT_SUPPORTED_FEATURES_VALUE,
+                           &robust_caching, sizeof(robust_caching)));
+    TEST_CHECK(WICED_BT_GATT_VALUE_NOT_ALLOWED ==
+               write_value(GATT_REQ_WRITE,
+                           HDLC_GATT_CLIENT_SUPPORTED_FEATURES_VALUE,
+                           &none, sizeof(none)));
+    TEST_CHECK(robust_caching == app_gatt_client_supported_features[0]);
+    TEST_CHECK(WICED_BT_GATT_INVALID_HANDLE ==
+               write_value(GATT_REQ_WRITE,
+                           HDLC_GATT_CLIENT_SUPPORTED_FEATURES_VALUE,
+                           two_bytes, sizeof(two_bytes)));
+
+    client_disconnect();
+    app_gatt_client_supported_features[0] = 0U;
+}
+
+/*******************************************************************************
+* Function Name: test_write_not_permitted
+********************************************************************************
+* Summary:
+*  A write to a handle without a value in the table is refused.
+*******************************************************************************/
+static void test_write_not_permitted(void)
+{
+    const uint8_t value = 0x01U;
+
+    client_connect();
+
+    TEST_CHECK(WICED_BT_GATT_WRITE_NOT_PERMIT ==
+               write_value(GATT_REQ_WRITE, HDLC_CAPSENSE_BUTTON, &value,
+                           sizeof(value)));
+    TEST_CHECK(WICED_BT_GATT_WRITE_NOT_PERMIT ==
+               write_value(GATT_CMD_WRITE, BT_TEST_INVALID_HANDLE, &value,
+                           sizeof(value)));
+    TEST_CHECK(0U == wiced_bt_host_pdu_count());
+
+    client_disconnect();
+}
+
+/*******************************************************************************
+* Function Name: test_disconnect
+********************************************************************************
+* Summary:
+*  A disconnection clears the CCCDs and the stream, drops the queued
+*  notifications and restarts advertising.
+*******************************************************************************/
+static void test_disconnect(void)
+{
+    client_connect();
+
+    TEST_CHECK(WICED_BT_GATT_SUCCESS ==
+               set_cccd(HDLD_CAPSENSE_STREAM_CLIENT_CHAR_CONFIG,
+                        GATT_CLIENT_CONFIG_NOTIFICATION));
+    TEST_CHECK(bt_app_host.stream_enabled);
+    TEST_CHECK(WICED_BT_GATT_SUCCESS ==
+               set_cccd(HDLD_CAPSENSE_SLIDER_CLIENT_CHAR_CONFIG,
+                        GATT_CLIENT_CONFIG_NOTIFICATION));
+    TEST_CHECK(0U != freertos_host_allocations());
+
+    client_disconnect();
+    TEST_CHECK(!bt_app_host.stream_enabled);
+    TEST_CHECK(0U == app_capsense_stream_client_char_config[0]);
+    TEST_CHECK(0U == app_capsense_slider_client_char_config[0]);
+    TEST_CHECK(BTM_BLE_ADVERT_OFF != wiced_bt_host_advert_mode());
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Mounts the KV store on an erased memory file, starts the application as
+*  the BTM_ENABLED_EVT handler does and runs the tests.
+*******************************************************************************/
+int main(void)
+{
+    freertos_host_set_tick(BT_TEST_START_TICK);
+    bt_app_host_reset();
+    if (!kv_flash_file_open(BT_TEST_FILE, true) || !kv_store_init() ||
+            !bt_control_init())
+    {
+        printf("FAIL setup\n");
+        return 1;
+    }
+    bt_app_init();
+
+    TEST_RUN(test_mtu_exchange);
+    TEST_RUN(test_read);
+    TEST_RUN(test_read_blob_snapshot);
+    TEST_RUN(test_read_by_type);
+    TEST_RUN(test_read_multiple);
+    TEST_RUN(test_cccd_notification);
+    TEST_RUN(test_cccd_indication);
+    TEST_RUN(test_control_write);
+    TEST_RUN(test_client_features);
+    TEST_RUN(test_write_not_permitted);
+    TEST_RUN(test_disconnect);
+
+    kv_flash_file_close();
+    (void) remove(BT_TEST_FILE);
+
+    return TEST_EXIT_STATUS();
+}
+
+/* [] END OF FILE */
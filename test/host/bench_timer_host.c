@@ -0,0 +1,171 @@
+/*******************************************************************************
+* File Name: bench_timer_host.c
+*
+* Description: This file contains the host build of the benchmark timer
+*              (bench_timer.h). It times the kernels with the monotonic clock
+*              and prints the results in nanoseconds per call.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bench_timer.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_NS_PER_S                      (1000000000ULL)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint32_t bench_timer_samples[BENCH_TIMER_ITERATIONS];
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: bench_timer_now_ns
+********************************************************************************
+* Summary:
+*  Returns the monotonic time in nanoseconds.
+*******************************************************************************/
+static uint64_t bench_timer_now_ns(void)
+{
+    struct timespec now;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t) now.tv_sec * BENCH_NS_PER_S) + (uint64_t) now.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: bench_timer_compare
+********************************************************************************
+* Summary:
+*  Orders two samples for qsort().
+*******************************************************************************/
+static int bench_timer_compare(const void *p_a, const void *p_b)
+{
+    uint32_t a = *(const uint32_t *) p_a;
+    uint32_t b = *(const uint32_t *) p_b;
+
+    return (a > b) - (a < b);
+}
+
+/*******************************************************************************
+* Function Name: bench_timer_run
+********************************************************************************
+* Summary:
+*  Calls a kernel once per iteration and takes the minimum, median and
+*  maximum nanoseconds per call. The time includes the clock reads, which
+*  the "overhead" kernel measures.
+*
+* Parameters:
+*  const bench_kernel_t *p_kernel : Kernel to time
+*  bench_result_t *p_result       : Results of the kernel
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bench_timer_run(const bench_kernel_t *p_kernel, bench_result_t *p_result)
+{
+    uint32_t iterations = p_kernel->iterations;
+
+    if ((0U == iterations) || (iterations > BENCH_TIMER_ITERATIONS))
+    {
+        iterations = BENCH_TIMER_ITERATIONS;
+    }
+
+    for (uint32_t n = 0U; n < iterations; n++)
+    {
+        uint64_t start = bench_timer_now_ns();
+
+        p_kernel->run();
+        bench_timer_samples[n] = (uint32_t) (bench_timer_now_ns() - start);
+    }
+
+    qsort(bench_timer_samples, iterations, sizeof(bench_timer_samples[0]),
+          bench_timer_compare);
+
+    strncpy(p_result->name, p_kernel->name, BENCH_TIMER_NAME_LEN - 1U);
+    p_result->name[BENCH_TIMER_NAME_LEN - 1U] = '\0';
+    p_result->iterations = iterations;
+    p_result->min = bench_timer_samples[0];
+    p_result->median = bench_timer_samples[iterations / 2U];
+    p_result->max = bench_timer_samples[iterations - 1U];
+}
+
+/*******************************************************************************
+* Function Name: bench_timer_print_header
+********************************************************************************
+* Summary:
+*  Prints the column names of the result lines.
+*******************************************************************************/
+void bench_timer_print_header(void)
+{
+    printf("bench,core,kernel,iterations,min_ns,median_ns,max_ns\n");
+}
+
+/*******************************************************************************
+* Function Name: bench_timer_print
+********************************************************************************
+* Summary:
+*  Prints one result line:
+*  bench,<core>,<kernel>,<iterations>,<min>,<median>,<max>
+*
+* Parameters:
+*  const char *core               : "host"
+*  const bench_result_t *p_result : Results of the kernel
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void bench_timer_print(const char *core, const bench_result_t *p_result)
+{
+    printf("bench,%s,%s,%lu,%lu,%lu,%lu\n", core, p_result->name,
+           (unsigned long) p_result->iterations,
+           (unsigned long) p_result->min,
+           (unsigned long) p_result->median,
+           (unsigned long) p_result->max);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,370 @@
+/*******************************************************************************
+* File Name: bt_app_host.c
+*
+* Description: This file contains the host fakes of the application modules that
+*              bt_app.c calls and that the host tests do not build. The fakes
+*              record what the application passed to them.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "bt_app.h"
+#include "bt_adv.h"
+#include "bt_conn_param.h"
+#include "bt_link.h"
+#include "bt_stream.h"
+#include "bt_time.h"
+#include "board.h"
+#include "capsense_diag.h"
+#include "i2c_capsense.h"
+#include "power_stats.h"
+#include "bt_app_host.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Defined by main.c and i2c_capsense.c on the target */
+TaskHandle_t bt_task_handle;
+capsense_data_t capsense_data;
+
+bt_app_host_t bt_app_host;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: bt_app_host_reset
+********************************************************************************
+* Summary:
+*  Resets the state of the fakes and the CapSense data.
+*******************************************************************************/
+void bt_app_host_reset(void)
+{
+    memset(&bt_app_host, 0, sizeof(bt_app_host));
+    memset(&capsense_data, 0, sizeof(capsense_data));
+    bt_app_host.stream_mtu = BT_STREAM_DEFAULT_MTU;
+}
+
+/*******************************************************************************
+* Function Name: power_stats_serialize
+********************************************************************************
+* Summary:
+*  Fills a diagnostics record with a pattern that starts at the number of
+*  the snapshot, so that a test can tell the snapshots apart.
+*******************************************************************************/
+uint16_t power_stats_serialize(uint8_t *p_buf, uint16_t len)
+{
+    uint16_t size = MIN(len, (uint16_t) POWER_STATS_DIAG_RECORD_SIZE);
+
+    bt_app_host.snapshots++;
+    for (uint16_t i = 0U; i < size; i++)
+    {
+        p_buf[i] = (uint8_t) (bt_app_host.snapshots + i);
+    }
+
+    return size;
+}
+
+/*******************************************************************************
+* Function Name: bt_stream_set_mtu
+********************************************************************************
+* Summary:
+*  Records the ATT MTU of the stream.
+*******************************************************************************/
+void bt_stream_set_mtu(uint16_t mtu)
+{
+    bt_app_host.stream_mtu = mtu;
+}
+
+/*******************************************************************************
+* Function Name: bt_stream_enable
+********************************************************************************
+* Summary:
+*  Records the stream state.
+*******************************************************************************/
+void bt_stream_enable(bool enable)
+{
+    bt_app_host.stream_enabled = enable;
+}
+
+/*******************************************************************************
+* Function Name: bt_stream_is_enabled
+********************************************************************************
+* Summary:
+*  Returns the stream state.
+*******************************************************************************/
+bool bt_stream_is_enabled(void)
+{
+    return bt_app_host.stream_enabled;
+}
+
+/*******************************************************************************
+* Function Name: bt_stream_process
+********************************************************************************
+* Summary:
+*  Has nothing to send.
+*******************************************************************************/
+TickType_t bt_stream_process(void)
+{
+    return portMAX_DELAY;
+}
+
+/*******************************************************************************
+* Function Name: bt_adv_init
+********************************************************************************
+* Summary:
+*  Fake of the touch state broadcast.
+*******************************************************************************/
+void bt_adv_init(void)
+{
+}
+
+/*******************************************************************************
+* Function Name: bt_adv_stop
+********************************************************************************
+* Summary:
+*  Fake of the touch state broadcast.
+*******************************************************************************/
+void bt_adv_stop(void)
+{
+}
+
+/*******************************************************************************
+* Function Name: bt_adv_on_state_changed
+********************************************************************************
+* Summary:
+*  Fake of the touch state broadcast.
+*******************************************************************************/
+void bt_adv_on_state_changed(wiced_bt_ble_advert_mode_t mode)
+{
+    CY_UNUSED_PARAMETER(mode);
+}
+
+/*******************************************************************************
+* Function Name: bt_adv_process
+********************************************************************************
+* Summary:
+*  Fake of the touch state broadcast.
+*******************************************************************************/
+TickType_t bt_adv_process(void)
+{
+    return portMAX_DELAY;
+}
+
+/*******************************************************************************
+* Function Name: bt_conn_param_on_connect
+********************************************************************************
+* Summary:
+*  Fake of the connection parameter policy.
+*******************************************************************************/
+void bt_conn_param_on_connect(wiced_bt_device_address_t bd_addr)
+{
+    CY_UNUSED_PARAMETER(bd_addr);
+}
+
+/*******************************************************************************
+* Function Name: bt_conn_param_on_disconnect
+********************************************************************************
+* Summary:
+*  Fake of the connection parameter policy.
+*******************************************************************************/
+void bt_conn_param_on_disconnect(void)
+{
+}
+
+/*******************************************************************************
+* Function Name: bt_conn_param_on_update
+********************************************************************************
+* Summary:
+*  Fake of the connection parameter policy.
+*******************************************************************************/
+void bt_conn_param_on_update(wiced_bt_ble_connection_param_update_t *p_update)
+{
+    CY_UNUSED_PARAMETER(p_update);
+}
+
+/*******************************************************************************
+* Function Name: bt_conn_param_process
+********************************************************************************
+* Summary:
+*  Fake of the connection parameter policy.
+*******************************************************************************/
+TickType_t bt_conn_param_process(void)
+{
+    return portMAX_DELAY;
+}
+
+/*******************************************************************************
+* Function Name: bt_link_on_connect
+********************************************************************************
+* Summary:
+*  Fake of the PHY and data length negotiation.
+*******************************************************************************/
+void bt_link_on_connect(wiced_bt_device_address_t bd_addr)
+{
+    CY_UNUSED_PARAMETER(bd_addr);
+}
+
+/*******************************************************************************
+* Function Name: bt_link_on_disconnect
+********************************************************************************
+* Summary:
+*  Fake of the PHY and data length negotiation.
+*******************************************************************************/
+void bt_link_on_disconnect(void)
+{
+}
+
+/*******************************************************************************
+* Function Name: bt_link_on_phy_update
+********************************************************************************
+* Summary:
+*  Fake of the PHY and data length negotiation.
+*******************************************************************************/
+void bt_link_on_phy_update(wiced_bt_ble_phy_update_t *p_update)
+{
+    CY_UNUSED_PARAMETER(p_update);
+}
+
+/*******************************************************************************
+* Function Name: bt_link_on_data_length_update
+********************************************************************************
+* Summary:
+*  Fake of the PHY and data length negotiation.
+*******************************************************************************/
+void bt_link_on_data_length_update(
+        wiced_bt_ble_phy_data_length_update_t *p_update)
+{
+    CY_UNUSED_PARAMETER(p_update);
+}
+
+/*******************************************************************************
+* Function Name: bt_link_process
+********************************************************************************
+* Summary:
+*  Fake of the PHY and data length negotiation.
+*******************************************************************************/
+TickType_t bt_link_process(void)
+{
+    return portMAX_DELAY;
+}
+
+/*******************************************************************************
+* Function Name: bt_link_get_info
+********************************************************************************
+* Summary:
+*  Returns the defaults of a link without negotiation.
+*******************************************************************************/
+void bt_link_get_info(bt_link_info_t *p_info)
+{
+    memset(p_info, 0, sizeof(*p_info));
+    p_info->tx_phy = BT_LINK_PHY_1M;
+    p_info->rx_phy = BT_LINK_PHY_1M;
+    p_info->max_tx_octets = BT_LINK_DEFAULT_OCTETS;
+    p_info->max_rx_octets = BT_LINK_DEFAULT_OCTETS;
+}
+
+/*******************************************************************************
+* Function Name: board_led2_set_state
+********************************************************************************
+* Summary:
+*  Records the LED2 duty cycle.
+*******************************************************************************/
+void board_led2_set_state(uint32_t value)
+{
+    bt_app_host.led2_state = value;
+}
+
+/*******************************************************************************
+* Function Name: i2c_capsense_get_tuning
+********************************************************************************
+* Summary:
+*  Returns the last tuning set.
+*******************************************************************************/
+void i2c_capsense_get_tuning(capsense_tuning_t *p_tuning)
+{
+    *p_tuning = bt_app_host.tuning;
+}
+
+/*******************************************************************************
+* Function Name: i2c_capsense_set_tuning
+********************************************************************************
+* Summary:
+*  Records the tuning.
+*******************************************************************************/
+void i2c_capsense_set_tuning(const capsense_tuning_t *p_tuning)
+{
+    bt_app_host.tuning = *p_tuning;
+}
+
+/*******************************************************************************
+* Function Name: capsense_diag_configure
+********************************************************************************
+* Summary:
+*  Records the diagnostics configuration.
+*******************************************************************************/
+void capsense_diag_configure(uint32_t period_ms, uint8_t outputs)
+{
+    bt_app_host.diag_period_ms = period_ms;
+    bt_app_host.diag_outputs = outputs;
+}
+
+/*******************************************************************************
+* Function Name: capsense_diag_get_configuration
+********************************************************************************
+* Summary:
+*  Returns the diagnostics configuration.
+*******************************************************************************/
+void capsense_diag_get_configuration(uint32_t *p_period_ms,
+                                     uint8_t *p_outputs)
+{
+    *p_period_ms = bt_app_host.diag_period_ms;
+    *p_outputs = bt_app_host.diag_outputs;
+}
+
+/*******************************************************************************
+* Function Name: bt_time_now_us
+********************************************************************************
+* Summary:
+*  Returns the time set by the test.
+*******************************************************************************/
+uint32_t bt_time_now_us(void)
+{
+    return bt_app_host.time_us;
+}
+
+/* [] END OF FILE */
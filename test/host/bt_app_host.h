@@ -0,0 +1,81 @@
+/*******************************************************************************
+* File Name: bt_app_host.h
+*
+* Description: This file contains the host fakes of the application modules that
+*              bt_app.c calls and that the host tests do not build. The fakes
+*              record what the application passed to them.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef BT_APP_HOST_H
+#define BT_APP_HOST_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "i2c_capsense.h"
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* State of the fakes */
+typedef struct
+{
+    uint16_t stream_mtu;                /* bt_stream_set_mtu() */
+    bool stream_enabled;                /* bt_stream_enable() */
+    uint32_t led2_state;                /* board_led2_set_state() */
+    uint32_t diag_period_ms;            /* capsense_diag_configure() */
+    uint8_t diag_outputs;
+    capsense_tuning_t tuning;           /* i2c_capsense_set_tuning() */
+    uint32_t snapshots;                 /* power_stats_serialize() calls */
+    uint32_t time_us;                   /* Returned by bt_time_now_us() */
+} bt_app_host_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern bt_app_host_t bt_app_host;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void bt_app_host_reset(void);
+
+#endif /* BT_APP_HOST_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,188 @@
+/*******************************************************************************
+* File Name: cycfg_bt_host.c
+*
+* Description: This file contains the host stand-in of the GAP and GATT
+*              configuration generated by the Bluetooth Configurator from
+*              design.cybt. The values and lengths are those of design.cybt;
+*              gatt_database is a host record list, see WICED_BT_HOST_DB_RECORD.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include "cycfg_gap.h"
+#include "cycfg_gatt_db.h"
+#include "wiced_bt_uuid.h"
+#include "wiced_bt_host.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* 128-bit UUID 0003xxxx-0000-1000-8000-00805F9B0131 of the CapSense service
+ * and characteristics, little endian */
+#define CAPSENSE_UUID128(id)                                                  \
+    0x31U, 0x01U, 0x9BU, 0x5FU, 0x80U, 0x00U, 0x00U, 0x80U,                   \
+    0x00U, 0x10U, 0x00U, 0x00U, (uint8_t) (id), (uint8_t) ((id) >> 8U),       \
+    0x03U, 0x00U
+
+#define DB_UUID16(handle, uuid)                                               \
+    WICED_BT_HOST_DB_RECORD(handle, LEN_UUID_16),                             \
+    WICED_BT_HOST_DB_UUID16(uuid)
+#define DB_CAPSENSE_UUID(handle, id)                                          \
+    WICED_BT_HOST_DB_RECORD(handle, LEN_UUID_128), CAPSENSE_UUID128(id)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+uint8_t app_gap_device_name[] = "CapSense Button Slider";
+wiced_bt_device_address_t cy_bt_device_address =
+        { 0x00U, 0xA0U, 0x50U, 0x01U, 0x02U, 0x03U };
+
+/* Attribute types of the database, in the handle order of the
+ * configurator */
+const uint8_t gatt_database[] =
+{
+    DB_UUID16(HDLS_GAP, GATT_UUID_PRI_SERVICE),
+    DB_UUID16(HDLC_GAP_DEVICE_NAME, GATT_UUID_CHAR_DECLARE),
+    DB_UUID16(HDLC_GAP_DEVICE_NAME_VALUE, GATT_UUID_GAP_DEVICE_NAME),
+    DB_UUID16(HDLC_GAP_APPEARANCE, GATT_UUID_CHAR_DECLARE),
+    DB_UUID16(HDLC_GAP_APPEARANCE_VALUE, GATT_UUID_GAP_ICON),
+    DB_UUID16(HDLS_GATT, GATT_UUID_PRI_SERVICE),
+    DB_UUID16(HDLC_GATT_CLIENT_SUPPORTED_FEATURES, GATT_UUID_CHAR_DECLARE),
+    DB_UUID16(HDLC_GATT_CLIENT_SUPPORTED_FEATURES_VALUE,
+              GATT_UUID_CLIENT_SUP_FEAT),
+    DB_UUID16(HDLC_GATT_DATABASE_HASH, GATT_UUID_CHAR_DECLARE),
+    DB_UUID16(HDLC_GATT_DATABASE_HASH_VALUE, GATT_UUID_DATABASE_HASH),
+    DB_UUID16(HDLS_CAPSENSE, GATT_UUID_PRI_SERVICE),
+    DB_UUID16(HDLC_CAPSENSE_BUTTON, GATT_UUID_CHAR_DECLARE),
+    DB_CAPSENSE_UUID(HDLC_CAPSENSE_BUTTON_VALUE, 0xCAA3U),
+    DB_UUID16(HDLD_CAPSENSE_BUTTON_CLIENT_CHAR_CONFIG,
+              GATT_UUID_CHAR_CLIENT_CONFIG),
+    DB_UUID16(HDLC_CAPSENSE_SLIDER, GATT_UUID_CHAR_DECLARE),
+    DB_CAPSENSE_UUID(HDLC_CAPSENSE_SLIDER_VALUE, 0xCAA2U),
+    DB_UUID16(HDLD_CAPSENSE_SLIDER_CLIENT_CHAR_CONFIG,
+              GATT_UUID_CHAR_CLIENT_CONFIG),
+    DB_UUID16(HDLC_CAPSENSE_DIAGNOSTICS, GATT_UUID_CHAR_DECLARE),
+    DB_CAPSENSE_UUID(HDLC_CAPSENSE_DIAGNOSTICS_VALUE, 0xCAA4U),
+    DB_UUID16(HDLD_CAPSENSE_DIAGNOSTICS_CLIENT_CHAR_CONFIG,
+              GATT_UUID_CHAR_CLIENT_CONFIG),
+    DB_UUID16(HDLC_CAPSENSE_STREAM, GATT_UUID_CHAR_DECLARE),
+    DB_CAPSENSE_UUID(HDLC_CAPSENSE_STREAM_VALUE, 0xCAA5U),
+    DB_UUID16(HDLD_CAPSENSE_STREAM_CLIENT_CHAR_CONFIG,
+              GATT_UUID_CHAR_CLIENT_CONFIG),
+    DB_UUID16(HDLC_CAPSENSE_CONTROL, GATT_UUID_CHAR_DECLARE),
+    DB_CAPSENSE_UUID(HDLC_CAPSENSE_CONTROL_VALUE, 0xCAA6U),
+};
+const uint16_t gatt_database_len = sizeof(gatt_database);
+
+/* Attribute values */
+uint8_t app_gap_appearance[] = { 0x00U, 0x00U };
+uint8_t app_gatt_client_supported_features[] = { 0x00U };
+uint8_t app_gatt_database_hash[16];
+uint8_t app_capsense_button[] = { 0x00U, 0x00U, 0x00U };
+uint8_t app_capsense_button_client_char_config[] = { 0x00U, 0x00U };
+uint8_t app_capsense_slider[] = { 0x00U };
+uint8_t app_capsense_slider_client_char_config[] = { 0x00U, 0x00U };
+uint8_t app_capsense_diagnostics[244];
+uint8_t app_capsense_diagnostics_client_char_config[] = { 0x00U, 0x00U };
+uint8_t app_capsense_stream[244];
+uint8_t app_capsense_stream_client_char_config[] = { 0x00U, 0x00U };
+uint8_t app_capsense_control[64];
+
+/* Value lengths. The device name has no terminating NUL. */
+const uint16_t app_gap_device_name_len = sizeof(app_gap_device_name) - 1U;
+const uint16_t app_gap_appearance_len = sizeof(app_gap_appearance);
+const uint16_t app_gatt_client_supported_features_len =
+        sizeof(app_gatt_client_supported_features);
+const uint16_t app_gatt_database_hash_len = sizeof(app_gatt_database_hash);
+const uint16_t app_capsense_button_len = sizeof(app_capsense_button);
+const uint16_t app_capsense_button_client_char_config_len =
+        sizeof(app_capsense_button_client_char_config);
+const uint16_t app_capsense_slider_len = sizeof(app_capsense_slider);
+const uint16_t app_capsense_slider_client_char_config_len =
+        sizeof(app_capsense_slider_client_char_config);
+const uint16_t app_capsense_diagnostics_len =
+        sizeof(app_capsense_diagnostics);
+const uint16_t app_capsense_diagnostics_client_char_config_len =
+        sizeof(app_capsense_diagnostics_client_char_config);
+const uint16_t app_capsense_stream_len = sizeof(app_capsense_stream);
+const uint16_t app_capsense_stream_client_char_config_len =
+        sizeof(app_capsense_stream_client_char_config);
+const uint16_t app_capsense_control_len = sizeof(app_capsense_control);
+
+/* Values the application reads and writes. Variable length values start
+ * empty. */
+gatt_db_lookup_table_t app_gatt_db_ext_attr_tbl[] =
+{
+    { HDLC_GAP_DEVICE_NAME_VALUE, sizeof(app_gap_device_name) - 1U,
+      sizeof(app_gap_device_name) - 1U, app_gap_device_name },
+    { HDLC_GAP_APPEARANCE_VALUE, sizeof(app_gap_appearance),
+      sizeof(app_gap_appearance), app_gap_appearance },
+    { HDLC_GATT_CLIENT_SUPPORTED_FEATURES_VALUE,
+      sizeof(app_gatt_client_supported_features),
+      sizeof(app_gatt_client_supported_features),
+      app_gatt_client_supported_features },
+    { HDLC_GATT_DATABASE_HASH_VALUE, sizeof(app_gatt_database_hash),
+      sizeof(app_gatt_database_hash), app_gatt_database_hash },
+    { HDLC_CAPSENSE_BUTTON_VALUE, sizeof(app_capsense_button),
+      sizeof(app_capsense_button), app_capsense_button },
+    { HDLD_CAPSENSE_BUTTON_CLIENT_CHAR_CONFIG,
+      sizeof(app_capsense_button_client_char_config),
+      sizeof(app_capsense_button_client_char_config),
+      app_capsense_button_client_char_config },
+    { HDLC_CAPSENSE_SLIDER_VALUE, sizeof(app_capsense_slider),
+      sizeof(app_capsense_slider), app_capsense_slider },
+    { HDLD_CAPSENSE_SLIDER_CLIENT_CHAR_CONFIG,
+      sizeof(app_capsense_slider_client_char_config),
+      sizeof(app_capsense_slider_client_char_config),
+      app_capsense_slider_client_char_config },
+    { HDLC_CAPSENSE_DIAGNOSTICS_VALUE, sizeof(app_capsense_diagnostics), 0U,
+      app_capsense_diagnostics },
+    { HDLD_CAPSENSE_DIAGNOSTICS_CLIENT_CHAR_CONFIG,
+      sizeof(app_capsense_diagnostics_client_char_config),
+      sizeof(app_capsense_diagnostics_client_char_config),
+      app_capsense_diagnostics_client_char_config },
+    { HDLC_CAPSENSE_STREAM_VALUE, sizeof(app_capsense_stream), 0U,
+      app_capsense_stream },
+    { HDLD_CAPSENSE_STREAM_CLIENT_CHAR_CONFIG,
+      sizeof(app_capsense_stream_client_char_config),
+      sizeof(app_capsense_stream_client_char_config),
+      app_capsense_stream_client_char_config },
+    { HDLC_CAPSENSE_CONTROL_VALUE, sizeof(app_capsense_control), 0U,
+      app_capsense_control },
+};
+const uint16_t app_gatt_db_ext_attr_tbl_size =
+        sizeof(app_gatt_db_ext_attr_tbl) / sizeof(app_gatt_db_ext_attr_tbl[0]);
+
+/* [] END OF FILE */
@@ -0,0 +1,263 @@
+/*******************************************************************************
+* File Name: freertos_host.c
+*
+* Description: This file contains the host stand-in of the FreeRTOS kernel
+*              functions used by the application modules that the host tests
+*              build.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdlib.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "freertos_host.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+struct host_mutex
+{
+    bool taken;
+};
+
+/* The tests run in one thread: the tick only moves when a test or
+ * vTaskDelay() moves it, and the notifications are only counted */
+static TickType_t host_tick;
+static uint32_t host_notifications;
+static uint32_t host_notifications_pending;
+
+/* Heap buffers not yet freed */
+static uint32_t host_allocations;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: xSemaphoreCreateMutex
+********************************************************************************
+* Summary:
+*  Creates a mutex.
+*******************************************************************************/
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return calloc(1U, sizeof(struct host_mutex));
+}
+
+/*******************************************************************************
+* Function Name: xSemaphoreTake
+********************************************************************************
+* Summary:
+*  Takes a mutex. The tests run in one thread, so a taken mutex is never
+*  released by another task and taking it again is an error.
+*******************************************************************************/
+BaseType_t xSemaphoreTake(SemaphoreHandle_t mutex, TickType_t ticks)
+{
+    (void) ticks;
+
+    configASSERT((NULL != mutex) && !mutex->taken);
+    mutex->taken = true;
+
+    return pdTRUE;
+}
+
+/*******************************************************************************
+* Function Name: xSemaphoreGive
+********************************************************************************
+* Summary:
+*  Releases a mutex.
+*******************************************************************************/
+BaseType_t xSemaphoreGive(SemaphoreHandle_t mutex)
+{
+    configASSERT((NULL != mutex) && mutex->taken);
+    mutex->taken = false;
+
+    return pdTRUE;
+}
+
+/*******************************************************************************
+* Function Name: pvPortMalloc
+********************************************************************************
+* Summary:
+*  Allocates a buffer from the heap and counts it.
+*******************************************************************************/
+void *pvPortMalloc(size_t size)
+{
+    void *p_data = malloc(size);
+
+    if (NULL != p_data)
+    {
+        host_allocations++;
+    }
+
+    return p_data;
+}
+
+/*******************************************************************************
+* Function Name: vPortFree
+********************************************************************************
+* Summary:
+*  Frees a buffer of pvPortMalloc().
+*******************************************************************************/
+void vPortFree(void *p_data)
+{
+    if (NULL != p_data)
+    {
+        configASSERT(0U != host_allocations);
+        host_allocations--;
+        free(p_data);
+    }
+}
+
+/*******************************************************************************
+* Function Name: xTaskGetTickCount
+********************************************************************************
+* Summary:
+*  Returns the tick count set by the test.
+*******************************************************************************/
+TickType_t xTaskGetTickCount(void)
+{
+    return host_tick;
+}
+
+/*******************************************************************************
+* Function Name: xTaskNotify
+********************************************************************************
+* Summary:
+*  Counts a task notification. The value is not kept, the application only
+*  uses it to wake up a task.
+*******************************************************************************/
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value,
+                       eNotifyAction action)
+{
+    (void) task;
+    (void) value;
+    (void) action;
+
+    host_notifications++;
+    host_notifications_pending++;
+
+    return pdPASS;
+}
+
+/*******************************************************************************
+* Function Name: xTaskNotifyWait
+********************************************************************************
+* Summary:
+*  Takes the pending notifications. Without one, the wait times out at once
+*  and the tick moves by the wait time.
+*******************************************************************************/
+BaseType_t xTaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit,
+                           uint32_t *p_value, TickType_t ticks)
+{
+    (void) clear_on_entry;
+    (void) clear_on_exit;
+
+    if (NULL != p_value)
+    {
+        *p_value = 0U;
+    }
+    if (0U != host_notifications_pending)
+    {
+        host_notifications_pending = 0U;
+        return pdTRUE;
+    }
+    if (portMAX_DELAY != ticks)
+    {
+        host_tick += ticks;
+    }
+
+    return pdFALSE;
+}
+
+/*******************************************************************************
+* Function Name: vTaskDelay
+********************************************************************************
+* Summary:
+*  Moves the tick by the delay.
+*******************************************************************************/
+void vTaskDelay(TickType_t ticks)
+{
+    host_tick += ticks;
+}
+
+/*******************************************************************************
+* Function Name: freertos_host_set_tick
+********************************************************************************
+* Summary:
+*  Sets the tick count.
+*******************************************************************************/
+void freertos_host_set_tick(TickType_t tick)
+{
+    host_tick = tick;
+}
+
+/*******************************************************************************
+* Function Name: freertos_host_advance
+********************************************************************************
+* Summary:
+*  Moves the tick count forward.
+*******************************************************************************/
+void freertos_host_advance(TickType_t ticks)
+{
+    host_tick += ticks;
+}
+
+/*******************************************************************************
+* Function Name: freertos_host_notifications
+********************************************************************************
+* Summary:
+*  Returns the number of task notifications sent so far.
+*******************************************************************************/
+uint32_t freertos_host_notifications(void)
+{
+    return host_notifications;
+}
+
+/*******************************************************************************
+* Function Name: freertos_host_allocations
+********************************************************************************
+* Summary:
+*  Returns the number of heap buffers not yet freed.
+*******************************************************************************/
+uint32_t freertos_host_allocations(void)
+{
+    return host_allocations;
+}
+
+/* [] END OF FILE */
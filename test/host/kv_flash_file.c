@@ -0,0 +1,311 @@
+/*******************************************************************************
+* File Name: kv_flash_file.c
+*
+* Description: This file contains a file-backed model of the KV store memory. It
+*              replaces kv_flash.c in the host tests, counts the accesses, and
+*              can tear a write or damage a byte to simulate a reset during a
+*              write.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "kv_flash_file.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Model state. Writes only clear bits, like NOR flash, so a record written
+ * over one that is not erased shows up as a damaged record. A torn write
+ * writes the first half of its bytes and fails. */
+static struct
+{
+    FILE *p_file;
+    uint32_t tear;                  /* Successful writes before a torn one */
+    uint32_t writes;
+    uint32_t read_bytes;
+    uint32_t erases[KV_FLASH_SECTOR_COUNT];
+} flash = { .tear = KV_FLASH_FILE_NO_TEAR };
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: kv_flash_file_open
+********************************************************************************
+* Summary:
+*  Opens the file that holds the memory. A new file, or any file when erase
+*  is set, is filled with the erased value.
+*
+* Parameters:
+*  const char *p_path : File name
+*  bool erase         : Start with an erased memory
+*
+* Return:
+*  bool: true on success
+*
+*******************************************************************************/
+bool kv_flash_file_open(const char *p_path, bool erase)
+{
+    uint8_t erased[KV_FLASH_SECTOR_SIZE];
+    bool ok = true;
+
+    kv_flash_file_close();
+    flash.p_file = erase ? NULL : fopen(p_path, "r+b");
+    if (NULL == flash.p_file)
+    {
+        flash.p_file = fopen(p_path, "w+b");
+        memset(erased, KV_FLASH_ERASED, sizeof(erased));
+        for (uint32_t sector = 0U; (NULL != flash.p_file) &&
+             (sector < KV_FLASH_SECTOR_COUNT); sector++)
+        {
+            ok = ok && (1U == fwrite(erased, sizeof(erased), 1U,
+                                     flash.p_file));
+        }
+    }
+    kv_flash_file_tear(KV_FLASH_FILE_NO_TEAR);
+    kv_flash_file_reset_counts();
+
+    return ok && (NULL != flash.p_file) && (0 == fflush(flash.p_file));
+}
+
+/*******************************************************************************
+* Function Name: kv_flash_file_close
+********************************************************************************
+* Summary:
+*  Closes the file that holds the memory.
+*******************************************************************************/
+void kv_flash_file_close(void)
+{
+    if (NULL != flash.p_file)
+    {
+        fclose(flash.p_file);
+        flash.p_file = NULL;
+    }
+}
+
+/*******************************************************************************
+* Function Name: kv_flash_file_tear
+********************************************************************************
+* Summary:
+*  Tears the write after the given number of successful writes, as a reset
+*  during that write would.
+*******************************************************************************/
+void kv_flash_file_tear(uint32_t writes)
+{
+    flash.tear = writes;
+}
+
+/*******************************************************************************
+* Function Name: kv_flash_file_corrupt
+********************************************************************************
+* Summary:
+*  Inverts the bits of a byte that are set in the mask.
+*******************************************************************************/
+void kv_flash_file_corrupt(uint32_t offset, uint8_t mask)
+{
+    uint8_t data = 0U;
+
+    if ((offset < KV_FLASH_SIZE) &&
+            (0 == fseek(flash.p_file, (long) offset, SEEK_SET)) &&
+            (1U == fread(&data, 1U, 1U, flash.p_file)))
+    {
+        data ^= mask;
+        (void) fseek(flash.p_file, (long) offset, SEEK_SET);
+        (void) fwrite(&data, 1U, 1U, flash.p_file);
+        (void) fflush(flash.p_file);
+    }
+}
+
+/*******************************************************************************
+* Function Name: kv_flash_file_writes
+********************************************************************************
+* Summary:
+*  Returns the number of writes since the counts were reset.
+*******************************************************************************/
+uint32_t kv_flash_file_writes(void)
+{
+    return flash.writes;
+}
+
+/*******************************************************************************
+* Function Name: kv_flash_file_read_bytes
+********************************************************************************
+* Summary:
+*  Returns the number of bytes read since the counts were reset.
+*******************************************************************************/
+uint32_t kv_flash_file_read_bytes(void)
+{
+    return flash.read_bytes;
+}
+
+/*******************************************************************************
+* Function Name: kv_flash_file_erases
+********************************************************************************
+* Summary:
+*  Returns the number of erases of a sector since the counts were reset.
+*******************************************************************************/
+uint32_t kv_flash_file_erases(uint32_t sector)
+{
+    return (sector < KV_FLASH_SECTOR_COUNT) ? flash.erases[sector] : 0U;
+}
+
+/*******************************************************************************
+* Function Name: kv_flash_file_reset_counts
+********************************************************************************
+* Summary:
+*  Resets the access counts.
+*******************************************************************************/
+void kv_flash_file_reset_counts(void)
+{
+    flash.writes = 0U;
+    flash.read_bytes = 0U;
+    memset(flash.erases, 0, sizeof(flash.erases));
+}
+
+/*******************************************************************************
+* Function Name: kv_flash_read
+********************************************************************************
+* Summary:
+*  Reads from the store region.
+*
+* Parameters:
+*  uint32_t offset : Offset in the region
+*  void *p_data    : Destination
+*  uint32_t len    : Number of bytes to read
+*
+* Return:
+*  bool: true on success
+*
+*******************************************************************************/
+bool kv_flash_read(uint32_t offset, void *p_data, uint32_t len)
+{
+    if ((NULL == flash.p_file) || (offset > KV_FLASH_SIZE) ||
+            (len > (KV_FLASH_SIZE - offset)))
+    {
+        return false;
+    }
+
+    flash.read_bytes += len;
+
+    return (0U == len) ||
+           ((0 == fseek(flash.p_file, (long) offset, SEEK_SET)) &&
+            (1U == fread(p_data, len, 1U, flash.p_file)));
+}
+
+/*******************************************************************************
+* Function Name: kv_flash_write
+********************************************************************************
+* Summary:
+*  Writes to the store region. The written bits are ANDed with the stored
+*  ones. A torn write stores half of the bytes and fails.
+*
+* Parameters:
+*  uint32_t offset      : Offset in the region
+*  const void *p_data   : Data to write
+*  uint32_t len         : Number of bytes to write
+*
+* Return:
+*  bool: true on success
+*
+*******************************************************************************/
+bool kv_flash_write(uint32_t offset, const void *p_data, uint32_t len)
+{
+    const uint8_t *p_src = (const uint8_t *) p_data;
+    uint8_t data[KV_FLASH_SECTOR_SIZE];
+    bool torn = (0U == flash.tear);
+
+    if ((NULL == flash.p_file) || (offset > KV_FLASH_SIZE) ||
+            (len > (KV_FLASH_SIZE - offset)) || (len > sizeof(data)) ||
+            (0 != fseek(flash.p_file, (long) offset, SEEK_SET)) ||
+            ((0U != len) && (1U != fread(data, len, 1U, flash.p_file))))
+    {
+        return false;
+    }
+
+    if (KV_FLASH_FILE_NO_TEAR != flash.tear)
+    {
+        flash.tear = torn ? KV_FLASH_FILE_NO_TEAR : (flash.tear - 1U);
+    }
+    if (torn)
+    {
+        len /= 2U;
+    }
+
+    for (uint32_t i = 0U; i < len; i++)
+    {
+        data[i] &= p_src[i];
+    }
+    flash.writes++;
+
+    return (0 == fseek(flash.p_file, (long) offset, SEEK_SET)) &&
+           ((0U == len) || (1U == fwrite(data, len, 1U, flash.p_file))) &&
+           (0 == fflush(flash.p_file)) && !torn;
+}
+
+/*******************************************************************************
+* Function Name: kv_flash_erase_sector
+********************************************************************************
+* Summary:
+*  Erases one sector.
+*
+* Parameters:
+*  uint32_t offset : Offset of the sector in the region
+*
+* Return:
+*  bool: true on success
+*
+*******************************************************************************/
+bool kv_flash_erase_sector(uint32_t offset)
+{
+    uint8_t erased[KV_FLASH_SECTOR_SIZE];
+
+    if ((NULL == flash.p_file) || (0U != (offset % KV_FLASH_SECTOR_SIZE)) ||
+            (offset >= KV_FLASH_SIZE))
+    {
+        return false;
+    }
+
+    memset(erased, KV_FLASH_ERASED, sizeof(erased));
+    flash.erases[offset / KV_FLASH_SECTOR_SIZE]++;
+
+    return (0 == fseek(flash.p_file, (long) offset, SEEK_SET)) &&
+           (1U == fwrite(erased, sizeof(erased), 1U, flash.p_file)) &&
+           (0 == fflush(flash.p_file));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,72 @@
+/*******************************************************************************
+* File Name: kv_flash_file.h
+*
+* Description: This file is the interface of the file-backed memory model that
+*              replaces kv_flash.c in the host tests.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef KV_FLASH_FILE_H
+#define KV_FLASH_FILE_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "kv_flash.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Argument of kv_flash_file_tear() that tears no write */
+#define KV_FLASH_FILE_NO_TEAR               (UINT32_MAX)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool kv_flash_file_open(const char *p_path, bool erase);
+void kv_flash_file_close(void);
+void kv_flash_file_tear(uint32_t writes);
+void kv_flash_file_corrupt(uint32_t offset, uint8_t mask);
+uint32_t kv_flash_file_writes(void);
+uint32_t kv_flash_file_read_bytes(void);
+uint32_t kv_flash_file_erases(uint32_t sector);
+void kv_flash_file_reset_counts(void);
+
+#endif /* KV_FLASH_FILE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,798 @@
+/*******************************************************************************
+* File Name: wiced_bt_host.c
+*
+* Description: This file contains the host stand-in of the BTSTACK functions
+*              used by the application. It logs the ATT PDUs that the
+*              application sends, keeps the buffers handed to the stack until
+*              the test transmits them, and delivers the connection events
+*              through the registered GATT callback.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <string.h>
+#include "wiced_bt_ble.h"
+#include "wiced_bt_dev.h"
+#include "wiced_bt_gatt.h"
+#include "wiced_bt_host.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define ATT_DEFAULT_MTU                     (23U)
+#define ATT_READ_BY_TYPE_HEADER_SIZE        (2U)
+#define ATT_MULTI_VAR_LENGTH_SIZE           (2U)
+#define ATT_PAIR_LEN_MAX                    (255U)
+#define DB_RECORD_HEADER_SIZE               (3U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Buffer handed to the stack with an application context */
+typedef struct
+{
+    uint8_t *p_data;
+    void *p_app_ctx;
+} host_buffer_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static struct
+{
+    wiced_bt_gatt_cback_t *p_gatt_cback;
+    const uint8_t *p_db;
+    uint32_t db_len;
+    uint16_t conn_id;                       /* 0 while not connected */
+    wiced_bt_device_address_t bd_addr;
+    wiced_bt_device_address_t local_addr;
+    uint16_t mtu;
+    wiced_bt_ble_advert_mode_t advert_mode;
+    uint32_t pdu_count;
+    wiced_bt_host_pdu_t pdus[WICED_BT_HOST_PDU_MAX];
+    uint32_t buffer_count;
+    host_buffer_t buffers[WICED_BT_HOST_BUFFERS_MAX];
+} host = { .mtu = ATT_DEFAULT_MTU };
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: wiced_bt_host_log
+********************************************************************************
+* Summary:
+*  Adds a PDU to the log.
+*******************************************************************************/
+static void wiced_bt_host_log(uint8_t opcode, uint16_t conn_id,
+                              uint16_t handle, uint8_t error,
+                              const uint8_t *p_data, uint16_t len)
+{
+    if (host.pdu_count < WICED_BT_HOST_PDU_MAX)
+    {
+        wiced_bt_host_pdu_t *p_pdu = &host.pdus[host.pdu_count];
+
+        p_pdu->opcode = opcode;
+        p_pdu->conn_id = conn_id;
+        p_pdu->handle = handle;
+        p_pdu->error = error;
+        p_pdu->len = MIN(len, WICED_BT_HOST_PDU_DATA_MAX);
+        if (NULL != p_data)
+        {
+            memcpy(p_pdu->data, p_data, p_pdu->len);
+        }
+    }
+    host.pdu_count++;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_host_check
+********************************************************************************
+* Summary:
+*  Checks that a PDU goes to the connected client and fits in the MTU.
+*******************************************************************************/
+static wiced_bt_gatt_status_t wiced_bt_host_check(uint16_t conn_id,
+                                                  uint32_t pdu_len)
+{
+    if ((0U == host.conn_id) || (conn_id != host.conn_id) ||
+            (pdu_len > host.mtu))
+    {
+        return WICED_BT_GATT_ILLEGAL_PARAMETER;
+    }
+
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_host_hold
+********************************************************************************
+* Summary:
+*  Keeps a buffer with an application context until it is transmitted.
+*******************************************************************************/
+static wiced_bt_gatt_status_t wiced_bt_host_hold(uint8_t *p_data,
+                                                 void *p_app_ctx)
+{
+    if (NULL == p_app_ctx)
+    {
+        return WICED_BT_GATT_SUCCESS;
+    }
+    if (WICED_BT_HOST_BUFFERS_MAX == host.buffer_count)
+    {
+        return WICED_BT_GATT_NO_RESOURCES;
+    }
+    host.buffers[host.buffer_count].p_data = p_data;
+    host.buffers[host.buffer_count].p_app_ctx = p_app_ctx;
+    host.buffer_count++;
+
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_host_send
+********************************************************************************
+* Summary:
+*  Sends a PDU that may hold a buffer of the application.
+*******************************************************************************/
+static wiced_bt_gatt_status_t wiced_bt_host_send(uint8_t opcode,
+        uint16_t conn_id, uint16_t handle, uint32_t header_len,
+        uint8_t *p_data, uint16_t len, void *p_app_ctx)
+{
+    wiced_bt_gatt_status_t status = wiced_bt_host_check(conn_id,
+            header_len + len);
+
+    if (WICED_BT_GATT_SUCCESS == status)
+    {
+        status = wiced_bt_host_hold(p_data, p_app_ctx);
+    }
+    if (WICED_BT_GATT_SUCCESS == status)
+    {
+        wiced_bt_host_log(opcode, conn_id, handle, 0U, p_data, len);
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_host_reset
+********************************************************************************
+* Summary:
+*  Transmits the buffers the stack still holds, then clears the log and the
+*  connection. The registered callback and the database are kept.
+*******************************************************************************/
+void wiced_bt_host_reset(void)
+{
+    (void) wiced_bt_host_transmit();
+
+    host.conn_id = 0U;
+    host.mtu = ATT_DEFAULT_MTU;
+    host.advert_mode = BTM_BLE_ADVERT_OFF;
+    host.pdu_count = 0U;
+    memset(host.pdus, 0, sizeof(host.pdus));
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_host_connect
+********************************************************************************
+* Summary:
+*  Connects a client and reports it through the GATT callback.
+*******************************************************************************/
+void wiced_bt_host_connect(uint16_t conn_id,
+                           wiced_bt_device_address_t bd_addr)
+{
+    wiced_bt_gatt_event_data_t event;
+
+    host.conn_id = conn_id;
+    host.mtu = ATT_DEFAULT_MTU;
+    memcpy(host.bd_addr, bd_addr, BD_ADDR_LEN);
+
+    memset(&event, 0, sizeof(event));
+    event.connection_status.bd_addr = host.bd_addr;
+    event.connection_status.conn_id = conn_id;
+    event.connection_status.connected = WICED_TRUE;
+    event.connection_status.transport = BT_TRANSPORT_LE;
+    (void) host.p_gatt_cback(GATT_CONNECTION_STATUS_EVT, &event);
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_host_disconnect
+********************************************************************************
+* Summary:
+*  Transmits the buffers the stack still holds and reports the
+*  disconnection through the GATT callback.
+*******************************************************************************/
+void wiced_bt_host_disconnect(void)
+{
+    wiced_bt_gatt_event_data_t event;
+
+    (void) wiced_bt_host_transmit();
+
+    memset(&event, 0, sizeof(event));
+    event.connection_status.bd_addr = host.bd_addr;
+    event.connection_status.conn_id = host.conn_id;
+    event.connection_status.connected = WICED_FALSE;
+    event.connection_status.transport = BT_TRANSPORT_LE;
+    host.conn_id = 0U;
+    (void) host.p_gatt_cback(GATT_CONNECTION_STATUS_EVT, &event);
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_host_transmit
+********************************************************************************
+* Summary:
+*  Hands the buffers the stack holds back to the application with
+*  GATT_APP_BUFFER_TRANSMITTED_EVT, in the order they were sent.
+*
+* Return:
+*  uint32_t: Buffers handed back
+*******************************************************************************/
+uint32_t wiced_bt_host_transmit(void)
+{
+    wiced_bt_gatt_event_data_t event;
+    uint32_t count = 0U;
+
+    /* The application may send again from the callback, so the buffers
+     * are taken one at a time */
+    while (0U != host.buffer_count)
+    {
+        host_buffer_t buffer = host.buffers[0];
+
+        host.buffer_count--;
+        memmove(&host.buffers[0], &host.buffers[1],
+                host.buffer_count * sizeof(host.buffers[0]));
+
+        memset(&event, 0, sizeof(event));
+        event.buffer_xmitted.p_app_data = buffer.p_data;
+        event.buffer_xmitted.p_app_ctxt = buffer.p_app_ctx;
+        (void) host.p_gatt_cback(GATT_APP_BUFFER_TRANSMITTED_EVT, &event);
+        count++;
+    }
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_host_pending
+********************************************************************************
+* Summary:
+*  Returns the number of buffers the stack holds.
+*******************************************************************************/
+uint32_t wiced_bt_host_pending(void)
+{
+    return host.buffer_count;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_host_pdu_count
+********************************************************************************
+* Summary:
+*  Returns the number of PDUs sent since the reset.
+*******************************************************************************/
+uint32_t wiced_bt_host_pdu_count(void)
+{
+    return host.pdu_count;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_host_pdu
+********************************************************************************
+* Summary:
+*  Returns a PDU of the log, or NULL if it was not kept.
+*******************************************************************************/
+const wiced_bt_host_pdu_t *wiced_bt_host_pdu(uint32_t index)
+{
+    return ((index < host.pdu_count) && (index < WICED_BT_HOST_PDU_MAX)) ?
+            &host.pdus[index] : NULL;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_host_last_pdu
+********************************************************************************
+* Summary:
+*  Returns the last PDU sent, or NULL if there is none.
+*******************************************************************************/
+const wiced_bt_host_pdu_t *wiced_bt_host_last_pdu(void)
+{
+    return (0U == host.pdu_count) ? NULL :
+            wiced_bt_host_pdu(host.pdu_count - 1U);
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_host_mtu
+********************************************************************************
+* Summary:
+*  Returns the ATT MTU of the connection.
+*******************************************************************************/
+uint16_t wiced_bt_host_mtu(void)
+{
+    return host.mtu;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_host_advert_mode
+********************************************************************************
+* Summary:
+*  Returns the mode of the last wiced_bt_start_advertisements() call.
+*******************************************************************************/
+wiced_bt_ble_advert_mode_t wiced_bt_host_advert_mode(void)
+{
+    return host.advert_mode;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_gatt_register
+********************************************************************************
+* Summary:
+*  Registers the GATT callback.
+*******************************************************************************/
+wiced_bt_gatt_status_t wiced_bt_gatt_register(
+        wiced_bt_gatt_cback_t *p_gatt_cback)
+{
+    host.p_gatt_cback = p_gatt_cback;
+
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_gatt_db_init
+********************************************************************************
+* Summary:
+*  Keeps the database for wiced_bt_gatt_find_handle_by_type() and fills the
+*  hash with a digest of it. The digest stands in for the AES-CMAC of the
+*  specification, it only has to change with the database.
+*******************************************************************************/
+wiced_bt_gatt_status_t wiced_bt_gatt_db_init(const uint8_t *p_gatt_db,
+        uint32_t gatt_db_size, wiced_bt_db_hash_t hash)
+{
+    uint32_t digest = 2166136261UL;
+
+    host.p_db = p_gatt_db;
+    host.db_len = gatt_db_size;
+
+    /* FNV-1a of the database, repeated over the hash */
+    for (uint32_t i = 0U; i < gatt_db_size; i++)
+    {
+        digest = (digest ^ p_gatt_db[i]) * 16777619UL;
+    }
+    for (uint32_t i = 0U; i < sizeof(wiced_bt_db_hash_t); i++)
+    {
+        digest = (digest ^ i) * 16777619UL;
+        hash[i] = (uint8_t) (digest >> 24U);
+    }
+
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_gatt_disconnect
+********************************************************************************
+* Summary:
+*  Accepts a disconnection request. The test reports the disconnection.
+*******************************************************************************/
+wiced_bt_gatt_status_t wiced_bt_gatt_disconnect(uint16_t conn_id)
+{
+    return (conn_id == host.conn_id) ? WICED_BT_GATT_SUCCESS :
+            WICED_BT_GATT_ILLEGAL_PARAMETER;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_gatt_find_handle_by_type
+********************************************************************************
+* Summary:
+*  Returns the first handle in the range with the given type, or 0.
+*******************************************************************************/
+uint16_t wiced_bt_gatt_find_handle_by_type(uint16_t s_handle,
+        uint16_t e_handle, wiced_bt_uuid_t *p_uuid)
+{
+    uint32_t offset = 0U;
+
+    while ((offset + DB_RECORD_HEADER_SIZE) <= host.db_len)
+    {
+        const uint8_t *p_record = &host.p_db[offset];
+        uint16_t handle = (uint16_t) (p_record[0] | (p_record[1] << 8U));
+        uint8_t uuid_len = p_record[2];
+        const uint8_t *p_type = &p_record[DB_RECORD_HEADER_SIZE];
+        bool match = false;
+
+        if ((handle >= s_handle) && (handle <= e_handle) &&
+                (uuid_len == p_uuid->len))
+        {
+            match = (LEN_UUID_16 == uuid_len) ?
+                    (p_uuid->uu.uuid16 == (p_type[0] | (p_type[1] << 8U))) :
+                    (0 == memcmp(p_type, p_uuid->uu.uuid128, uuid_len));
+        }
+        if (match)
+        {
+            return handle;
+        }
+        offset += DB_RECORD_HEADER_SIZE + uuid_len;
+    }
+
+    return 0U;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_gatt_get_handle_from_stream
+********************************************************************************
+* Summary:
+*  Returns a handle of the handle list of a Read Multiple Request.
+*******************************************************************************/
+int wiced_bt_gatt_get_handle_from_stream(uint8_t *p_stream,
+        uint16_t stream_offset)
+{
+    const uint8_t *p_handle = &p_stream[stream_offset * 2U];
+
+    return p_handle[0] | (p_handle[1] << 8U);
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_gatt_put_read_by_type_rsp_in_stream
+********************************************************************************
+* Summary:
+*  Adds a handle-value pair to a Read By Type Response. All pairs have the
+*  length of the first, which is cut to fit; later values that do not have
+*  the same length or do not fit end the response.
+*
+* Return:
+*  int: Bytes added, 0 if the pair was not added
+*******************************************************************************/
+int wiced_bt_gatt_put_read_by_type_rsp_in_stream(uint8_t *p_stream,
+        int stream_len, uint8_t *p_pair_len, uint16_t attr_handle,
+        uint16_t attr_len, const uint8_t *p_attr)
+{
+    int pair_len = WICED_BT_HOST_ATT_HANDLE_SIZE + attr_len;
+
+    if (0U == *p_pair_len)
+    {
+        pair_len = MIN(pair_len, MIN(stream_len, (int) ATT_PAIR_LEN_MAX));
+        if (pair_len <= (int) WICED_BT_HOST_ATT_HANDLE_SIZE)
+        {
+            return 0;
+        }
+        *p_pair_len = (uint8_t) pair_len;
+    }
+    else if ((pair_len != *p_pair_len) || (pair_len > stream_len))
+    {
+        return 0;
+    }
+
+    p_stream[0] = (uint8_t) attr_handle;
+    p_stream[1] = (uint8_t) (attr_handle >> 8U);
+    memcpy(&p_stream[WICED_BT_HOST_ATT_HANDLE_SIZE], p_attr,
+           pair_len - WICED_BT_HOST_ATT_HANDLE_SIZE);
+
+    return pair_len;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_gatt_put_read_multi_rsp_in_stream
+********************************************************************************
+* Summary:
+*  Adds a value to a Read Multiple or Read Multiple Variable Length
+*  Response, cut to fit. The variable length form puts the full length of
+*  the value before it.
+*
+* Return:
+*  int: Bytes added, 0 if nothing fits
+*******************************************************************************/
+int wiced_bt_gatt_put_read_multi_rsp_in_stream(wiced_bt_gatt_opcode_t opcode,
+        uint8_t *p_stream, int stream_len, uint16_t attr_handle,
+        uint16_t attr_len, const uint8_t *p_attr)
+{
+    int header_len = (GATT_REQ_READ_MULTI_VAR_LENGTH == opcode) ?
+            (int) ATT_MULTI_VAR_LENGTH_SIZE : 0;
+    int value_len = MIN((int) attr_len, stream_len - header_len);
+
+    (void) attr_handle;
+
+    if ((value_len < 0) || ((0 == value_len) && (0 == header_len)))
+    {
+        return 0;
+    }
+    if (0 != header_len)
+    {
+        p_stream[0] = (uint8_t) attr_len;
+        p_stream[1] = (uint8_t) (attr_len >> 8U);
+    }
+    memcpy(&p_stream[header_len], p_attr, value_len);
+
+    return header_len + value_len;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_gatt_server_send_notification
+********************************************************************************
+* Summary:
+*  Sends a Handle Value Notification.
+*******************************************************************************/
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_notification(
+        uint16_t conn_id, uint16_t attr_handle, uint16_t val_len,
+        uint8_t *p_val, void *p_app_ctx)
+{
+    return wiced_bt_host_send(GATT_HANDLE_VALUE_NOTIF, conn_id, attr_handle,
+            WICED_BT_HOST_ATT_OPCODE_SIZE + WICED_BT_HOST_ATT_HANDLE_SIZE,
+            p_val, val_len, p_app_ctx);
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_gatt_server_send_indication
+********************************************************************************
+* Summary:
+*  Sends a Handle Value Indication.
+*******************************************************************************/
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_indication(uint16_t conn_id,
+        uint16_t attr_handle, uint16_t val_len, uint8_t *p_val,
+        void *p_app_ctx)
+{
+    return wiced_bt_host_send(GATT_HANDLE_VALUE_IND, conn_id, attr_handle,
+            WICED_BT_HOST_ATT_OPCODE_SIZE + WICED_BT_HOST_ATT_HANDLE_SIZE,
+            p_val, val_len, p_app_ctx);
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_gatt_server_send_read_handle_rsp
+********************************************************************************
+* Summary:
+*  Sends a Read or Read Blob Response.
+*******************************************************************************/
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_handle_rsp(
+        uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint16_t len,
+        uint8_t *p_attr, void *p_app_ctx)
+{
+    return wiced_bt_host_send((uint8_t) (opcode + 1U), conn_id, 0U,
+            WICED_BT_HOST_ATT_OPCODE_SIZE, p_attr, len, p_app_ctx);
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_gatt_server_send_read_by_type_rsp
+********************************************************************************
+* Summary:
+*  Sends a Read By Type Response. The logged data starts with the pair
+*  length, as in the PDU.
+*******************************************************************************/
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_by_type_rsp(
+        uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint8_t type_len,
+        uint16_t data_len, uint8_t *p_data, void *p_app_ctx)
+{
+    uint8_t pdu[WICED_BT_HOST_PDU_DATA_MAX];
+    wiced_bt_gatt_status_t status = wiced_bt_host_check(conn_id,
+            ATT_READ_BY_TYPE_HEADER_SIZE + data_len);
+
+    if (WICED_BT_GATT_SUCCESS == status)
+    {
+        status = wiced_bt_host_hold(p_data, p_app_ctx);
+    }
+    if (WICED_BT_GATT_SUCCESS == status)
+    {
+        pdu[0] = type_len;
+        memcpy(&pdu[1], p_data, data_len);
+        wiced_bt_host_log((uint8_t) (opcode + 1U), conn_id, 0U, 0U, pdu,
+                          (uint16_t) (data_len + 1U));
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_gatt_server_send_read_multiple_rsp
+********************************************************************************
+* Summary:
+*  Sends a Read Multiple or Read Multiple Variable Length Response.
+*******************************************************************************/
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_multiple_rsp(
+        uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint16_t len,
+        uint8_t *p_rsp, void *p_app_ctx)
+{
+    return wiced_bt_host_send((uint8_t) (opcode + 1U), conn_id, 0U,
+            WICED_BT_HOST_ATT_OPCODE_SIZE, p_rsp, len, p_app_ctx);
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_gatt_server_send_mtu_rsp
+********************************************************************************
+* Summary:
+*  Sends an Exchange MTU Response. The connection uses the smaller MTU.
+*******************************************************************************/
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_mtu_rsp(uint16_t conn_id,
+        uint16_t remote_mtu, uint16_t local_mtu)
+{
+    uint8_t pdu[2] = { (uint8_t) local_mtu, (uint8_t) (local_mtu >> 8U) };
+    wiced_bt_gatt_status_t status = wiced_bt_host_check(conn_id, 0U);
+
+    if (WICED_BT_GATT_SUCCESS == status)
+    {
+        host.mtu = MAX(ATT_DEFAULT_MTU, MIN(remote_mtu, local_mtu));
+        wiced_bt_host_log(GATT_RSP_MTU, conn_id, 0U, 0U, pdu, sizeof(pdu));
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_gatt_server_send_write_rsp
+********************************************************************************
+* Summary:
+*  Sends a Write Response.
+*******************************************************************************/
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_write_rsp(uint16_t conn_id,
+        wiced_bt_gatt_opcode_t opcode, uint16_t handle)
+{
+    wiced_bt_gatt_status_t status = wiced_bt_host_check(conn_id, 0U);
+
+    (void) opcode;
+
+    if (WICED_BT_GATT_SUCCESS == status)
+    {
+        wiced_bt_host_log(GATT_RSP_WRITE, conn_id, handle, 0U, NULL, 0U);
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_gatt_server_send_error_rsp
+********************************************************************************
+* Summary:
+*  Sends an Error Response. The logged data is the request opcode.
+*******************************************************************************/
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_error_rsp(uint16_t conn_id,
+        wiced_bt_gatt_opcode_t opcode, uint16_t handle,
+        wiced_bt_gatt_status_t status)
+{
+    wiced_bt_gatt_status_t result = wiced_bt_host_check(conn_id, 0U);
+
+    if (WICED_BT_GATT_SUCCESS == result)
+    {
+        wiced_bt_host_log(GATT_RSP_ERROR, conn_id, handle, (uint8_t) status,
+                          &opcode, 1U);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_start_advertisements
+********************************************************************************
+* Summary:
+*  Records the advertising mode.
+*******************************************************************************/
+wiced_result_t wiced_bt_start_advertisements(
+        wiced_bt_ble_advert_mode_t advert_mode,
+        wiced_bt_ble_address_type_t directed_advertisement_bdaddr_type,
+        wiced_bt_device_address_ptr_t directed_advertisement_bdaddr_ptr)
+{
+    (void) directed_advertisement_bdaddr_type;
+    (void) directed_advertisement_bdaddr_ptr;
+
+    host.advert_mode = advert_mode;
+
+    return WICED_BT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_ble_security_grant
+********************************************************************************
+* Summary:
+*  Accepts the security grant of a peer.
+*******************************************************************************/
+void wiced_bt_ble_security_grant(wiced_bt_device_address_t bd_addr,
+                                 uint8_t res)
+{
+    (void) bd_addr;
+    (void) res;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_set_local_bdaddr
+********************************************************************************
+* Summary:
+*  Sets the local address.
+*******************************************************************************/
+wiced_result_t wiced_bt_set_local_bdaddr(wiced_bt_device_address_t bd_addr,
+                                         wiced_bt_ble_address_type_t type)
+{
+    (void) type;
+
+    memcpy(host.local_addr, bd_addr, BD_ADDR_LEN);
+
+    return WICED_BT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_dev_read_local_addr
+********************************************************************************
+* Summary:
+*  Returns the local address.
+*******************************************************************************/
+void wiced_bt_dev_read_local_addr(wiced_bt_device_address_t bd_addr)
+{
+    memcpy(bd_addr, host.local_addr, BD_ADDR_LEN);
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_set_pairable_mode
+********************************************************************************
+* Summary:
+*  Accepts the pairable mode.
+*******************************************************************************/
+void wiced_bt_set_pairable_mode(uint8_t allow_pairing,
+                                uint8_t connect_only_paired)
+{
+    (void) allow_pairing;
+    (void) connect_only_paired;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_dev_delete_bonded_device
+********************************************************************************
+* Summary:
+*  Accepts the removal of a bonded device.
+*******************************************************************************/
+wiced_result_t wiced_bt_dev_delete_bonded_device(
+        wiced_bt_device_address_t bd_addr)
+{
+    (void) bd_addr;
+
+    return WICED_BT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_dev_add_device_to_address_resolution_db
+********************************************************************************
+* Summary:
+*  Accepts the keys of a bonded device for address resolution.
+*******************************************************************************/
+wiced_result_t wiced_bt_dev_add_device_to_address_resolution_db(
+        wiced_bt_device_link_keys_t *p_link_keys)
+{
+    (void) p_link_keys;
+
+    return WICED_BT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: wiced_bt_dev_remove_device_from_address_resolution_db
+********************************************************************************
+* Summary:
+*  Accepts the removal of a device from address resolution.
+*******************************************************************************/
+wiced_result_t wiced_bt_dev_remove_device_from_address_resolution_db(
+        wiced_bt_device_link_keys_t *p_link_keys)
+{
+    (void) p_link_keys;
+
+    return WICED_BT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,110 @@
+/*******************************************************************************
+* File Name: wiced_bt_host.h
+*
+* Description: This file contains the host stand-in of the BTSTACK functions
+*              used by the application. It logs the ATT PDUs that the
+*              application sends, keeps the buffers handed to the stack until
+*              the test transmits them, and delivers the connection events
+*              through the registered GATT callback.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef WICED_BT_HOST_H
+#define WICED_BT_HOST_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "wiced_bt_dev.h"
+#include "wiced_bt_gatt.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* PDUs kept in the log and bytes kept of each */
+#define WICED_BT_HOST_PDU_MAX               (32U)
+#define WICED_BT_HOST_PDU_DATA_MAX          (517U)
+
+/* Buffers the stack holds until they are transmitted */
+#define WICED_BT_HOST_BUFFERS_MAX           (16U)
+
+/* Header bytes of the ATT PDUs, checked against the MTU */
+#define WICED_BT_HOST_ATT_OPCODE_SIZE       (1U)
+#define WICED_BT_HOST_ATT_HANDLE_SIZE       (2U)
+
+/* Host record of gatt_database: handle (u16), UUID length and UUID, so
+ * that wiced_bt_gatt_find_handle_by_type() can search it */
+#define WICED_BT_HOST_DB_RECORD(handle, uuid_len)                             \
+    (uint8_t) (handle), (uint8_t) ((handle) >> 8U), (uint8_t) (uuid_len)
+#define WICED_BT_HOST_DB_UUID16(uuid)                                         \
+    (uint8_t) (uuid), (uint8_t) ((uuid) >> 8U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* ATT PDU sent by the application. The opcode is the response opcode of
+ * the specification; the handle is set for the error and write responses,
+ * the notifications and the indications. */
+typedef struct
+{
+    uint8_t opcode;
+    uint16_t conn_id;
+    uint16_t handle;
+    uint8_t error;                          /* Status of an error response */
+    uint16_t len;
+    uint8_t data[WICED_BT_HOST_PDU_DATA_MAX];
+} wiced_bt_host_pdu_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void wiced_bt_host_reset(void);
+void wiced_bt_host_connect(uint16_t conn_id,
+                           wiced_bt_device_address_t bd_addr);
+void wiced_bt_host_disconnect(void);
+uint32_t wiced_bt_host_transmit(void);
+uint32_t wiced_bt_host_pending(void);
+uint32_t wiced_bt_host_pdu_count(void);
+const wiced_bt_host_pdu_t *wiced_bt_host_pdu(uint32_t index);
+const wiced_bt_host_pdu_t *wiced_bt_host_last_pdu(void);
+uint16_t wiced_bt_host_mtu(void);
+wiced_bt_ble_advert_mode_t wiced_bt_host_advert_mode(void);
+
+#endif /* WICED_BT_HOST_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,577 @@
+/*******************************************************************************
+* File Name: kv_store_test.c
+*
+* Description: This file contains the host tests of the key-value store.
+*              kv_store.c runs on the file-backed memory model of
+*              kv_flash_file.c.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "host_test.h"
+#include "kv_flash_file.h"
+#include "kv_store.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define KV_TEST_FILE                        "kv_store_test.bin"
+
+/* Layout of kv_store.c */
+#define KV_TEST_MAGIC                       (0x3153564BUL)
+#define KV_TEST_SECTOR_HEADER_SIZE          (16U)
+#define KV_TEST_RECORD_HEADER_SIZE          (8U)
+#define KV_TEST_RECORD_SIZE(len)            ((((len) + \
+                                              KV_TEST_RECORD_HEADER_SIZE + \
+                                              KV_FLASH_PROGRAM_SIZE - 1U) / \
+                                             KV_FLASH_PROGRAM_SIZE) * \
+                                             KV_FLASH_PROGRAM_SIZE)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+unsigned int host_test_failures;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: store_open
+********************************************************************************
+* Summary:
+*  Opens the memory file and mounts the store, as after a reset.
+*******************************************************************************/
+static bool store_open(bool erase)
+{
+    return kv_flash_file_open(KV_TEST_FILE, erase) && kv_store_init();
+}
+
+/*******************************************************************************
+* Function Name: store_stats
+********************************************************************************
+* Summary:
+*  Returns the store state.
+*******************************************************************************/
+static kv_store_stats_t store_stats(void)
+{
+    kv_store_stats_t stats;
+
+    kv_store_get_stats(&stats);
+
+    return stats;
+}
+
+/*******************************************************************************
+* Function Name: value_is
+********************************************************************************
+* Summary:
+*  Returns true when a key has the given value, or no value for NULL.
+*******************************************************************************/
+static bool value_is(uint16_t key, const void *p_expected, uint16_t len)
+{
+    uint8_t value[KV_VALUE_MAX];
+    uint16_t value_len = 0U;
+    bool found = kv_store_get(key, value, sizeof(value), &value_len);
+
+    if (NULL == p_expected)
+    {
+        return !found;
+    }
+
+    return found && (value_len == len) &&
+           (0 == memcmp(value, p_expected, len));
+}
+
+/*******************************************************************************
+* Function Name: string_is
+********************************************************************************
+* Summary:
+*  Returns true when a key has the given string value.
+*******************************************************************************/
+static bool string_is(uint16_t key, const char *p_expected)
+{
+    return value_is(key, p_expected,
+                    (NULL == p_expected) ? 0U : (uint16_t) strlen(p_expected));
+}
+
+/*******************************************************************************
+* Function Name: set_string
+********************************************************************************
+* Summary:
+*  Sets a key to a string value.
+*******************************************************************************/
+static bool set_string(uint16_t key, const char *p_value)
+{
+    return kv_store_set(key, p_value, (uint16_t) strlen(p_value));
+}
+
+/*******************************************************************************
+* Function Name: sector_crc
+********************************************************************************
+* Summary:
+*  Returns the CRC-32 of the magic and sequence of a sector header.
+*******************************************************************************/
+static uint32_t sector_crc(const uint32_t *p_words)
+{
+    const uint8_t *p = (const uint8_t *) p_words;
+    uint32_t crc = 0xFFFFFFFFUL;
+
+    for (uint32_t i = 0U; i < (2U * sizeof(uint32_t)); i++)
+    {
+        crc ^= p[i];
+        for (uint32_t bit = 0U; bit < 8U; bit++)
+        {
+            crc = (crc >> 1U) ^ ((0U != (crc & 1U)) ? 0xEDB88320UL : 0U);
+        }
+    }
+
+    return ~crc;
+}
+
+/*******************************************************************************
+* Function Name: fill_sector
+********************************************************************************
+* Summary:
+*  Updates a key with short values until the next update starts a new
+*  sector. Returns the last value.
+*******************************************************************************/
+static void fill_sector(uint16_t key, char *p_value, size_t size)
+{
+    char next[32];
+    uint32_t count = 0U;
+
+    for (;;)
+    {
+        snprintf(next, sizeof(next), "fill-%lu", (unsigned long) count++);
+        if ((store_stats().used + KV_TEST_RECORD_SIZE(strlen(next))) >
+                KV_FLASH_SECTOR_SIZE)
+        {
+            break;
+        }
+        TEST_CHECK(set_string(key, next));
+        snprintf(p_value, size, "%s", next);
+    }
+}
+
+/*******************************************************************************
+* Function Name: next_sector
+********************************************************************************
+* Summary:
+*  Fills the sector with values of a key, then changes the following key,
+*  which starts the next sector. Returns the last value of the first key.
+*******************************************************************************/
+static void next_sector(uint16_t key, char *p_value, size_t size)
+{
+    static uint32_t round;
+    char marker[24];
+    uint32_t sequence;
+
+    fill_sector(key, p_value, size);
+    sequence = store_stats().sequence;
+    snprintf(marker, sizeof(marker), "round-%lu", (unsigned long) round++);
+    TEST_CHECK(set_string(key + 1U, marker));
+    TEST_CHECK((sequence + 1U) == store_stats().sequence);
+}
+
+/*******************************************************************************
+* Function Name: test_set_get
+********************************************************************************
+* Summary:
+*  Values are kept over a reset, deleted keys have no value, and writing an
+*  unchanged value writes nothing.
+*******************************************************************************/
+static void test_set_get(void)
+{
+    uint8_t big[KV_VALUE_MAX + 1U] = { 0U };
+
+    TEST_CHECK(store_open(true));
+    TEST_CHECK(string_is(1U, NULL));
+    TEST_CHECK(set_string(1U, "hello"));
+    TEST_CHECK(set_string(2U, "world"));
+    TEST_CHECK(string_is(1U, "hello"));
+
+    TEST_CHECK(store_open(false));
+    TEST_CHECK(string_is(1U, "hello"));
+    TEST_CHECK(string_is(2U, "world"));
+    TEST_CHECK(kv_store_delete(2U));
+    TEST_CHECK(store_open(false));
+    TEST_CHECK(string_is(2U, NULL));
+    TEST_CHECK(3U == store_stats().scan_records);
+
+    kv_flash_file_reset_counts();
+    TEST_CHECK(set_string(1U, "hello"));
+    TEST_CHECK(kv_store_delete(2U));
+    TEST_CHECK(0U == kv_flash_file_writes());
+
+    TEST_CHECK(!set_string(KV_KEY_MAX, "key"));
+    TEST_CHECK(!kv_store_set(1U, big, sizeof(big)));
+    TEST_CHECK(kv_store_set(1U, big, KV_VALUE_MAX));
+    TEST_CHECK(value_is(1U, big, KV_VALUE_MAX));
+}
+
+/*******************************************************************************
+* Function Name: test_crc_rejection
+********************************************************************************
+* Summary:
+*  A record with a bad CRC ends the boot scan: the older value is used and
+*  the next write starts a new sector. A sector header with a bad CRC is
+*  ignored, so the previous sector is used.
+*******************************************************************************/
+static void test_crc_rejection(void)
+{
+    kv_store_stats_t stats;
+
+    TEST_CHECK(store_open(true));
+    TEST_CHECK(0U == store_stats().sector);
+    TEST_CHECK(set_string(1U, "one"));
+    TEST_CHECK(set_string(1U, "two"));
+
+    /* Damage the value of the second record */
+    kv_flash_file_corrupt(KV_TEST_SECTOR_HEADER_SIZE +
+                          KV_TEST_RECORD_SIZE(3U) +
+                          KV_TEST_RECORD_HEADER_SIZE, 0x01U);
+    TEST_CHECK(store_open(false));
+    stats = store_stats();
+    TEST_CHECK(string_is(1U, "one"));
+    TEST_CHECK(1U == stats.errors);
+    TEST_CHECK(1U == stats.scan_records);
+    TEST_CHECK((KV_TEST_SECTOR_HEADER_SIZE + KV_TEST_RECORD_SIZE(3U)) ==
+               stats.used);
+
+    TEST_CHECK(set_string(2U, "x"));
+    TEST_CHECK(1U == store_stats().sector);
+    TEST_CHECK(store_open(false));
+    TEST_CHECK(0U == store_stats().errors);
+    TEST_CHECK(string_is(1U, "one"));
+    TEST_CHECK(string_is(2U, "x"));
+
+    /* Damage the sequence number of the sector in use */
+    kv_flash_file_corrupt(KV_FLASH_SECTOR_SIZE + sizeof(uint32_t), 0x80U);
+    TEST_CHECK(store_open(false));
+    stats = store_stats();
+    TEST_CHECK(0U == stats.sector);
+    TEST_CHECK(1U == stats.errors);
+    TEST_CHECK(string_is(1U, "one"));
+    TEST_CHECK(string_is(2U, NULL));
+}
+
+/*******************************************************************************
+* Function Name: test_torn_append
+********************************************************************************
+* Summary:
+*  A reset during an append leaves the previous value, and the next write
+*  goes to a new sector instead of after the partial record.
+*******************************************************************************/
+static void test_torn_append(void)
+{
+    TEST_CHECK(store_open(true));
+    TEST_CHECK(set_string(1U, "before"));
+
+    kv_flash_file_tear(0U);
+    TEST_CHECK(!set_string(1U, "torn value"));
+    TEST_CHECK(string_is(1U, "before"));
+
+    TEST_CHECK(store_open(false));
+    TEST_CHECK(1U == store_stats().errors);
+    TEST_CHECK(string_is(1U, "before"));
+
+    TEST_CHECK(set_string(1U, "after"));
+    TEST_CHECK(1U == store_stats().sector);
+    TEST_CHECK(store_open(false));
+    TEST_CHECK(0U == store_stats().errors);
+    TEST_CHECK(string_is(1U, "after"));
+}
+
+/*******************************************************************************
+* Function Name: test_torn_compaction
+********************************************************************************
+* Summary:
+*  A reset while the values are copied to the next sector, including while
+*  its header is written, leaves the previous sector in use.
+*******************************************************************************/
+static void test_torn_compaction(void)
+{
+    char value[32];
+
+    /* The copy writes key 1, key 2 and then the header */
+    for (uint32_t tear = 0U; tear <= 2U; tear++)
+    {
+        uint32_t sector;
+
+        TEST_CHECK(store_open(true));
+        TEST_CHECK(set_string(2U, "kept"));
+        fill_sector(1U, value, sizeof(value));
+        sector = store_stats().sector;
+
+        kv_flash_file_tear(tear);
+        TEST_CHECK(!set_string(3U, "new value"));
+
+        TEST_CHECK(store_open(false));
+        TEST_CHECK(sector == store_stats().sector);
+        TEST_CHECK(string_is(1U, value));
+        TEST_CHECK(string_is(2U, "kept"));
+        TEST_CHECK(string_is(3U, NULL));
+
+        TEST_CHECK(set_string(3U, "new value"));
+        TEST_CHECK(sector != store_stats().sector);
+        TEST_CHECK(store_open(false));
+        TEST_CHECK(string_is(1U, value));
+        TEST_CHECK(string_is(2U, "kept"));
+        TEST_CHECK(string_is(3U, "new value"));
+    }
+}
+
+/*******************************************************************************
+* Function Name: test_compaction
+********************************************************************************
+* Summary:
+*  A new sector holds the values of the previous one and the record that
+*  did not fit, and values of the largest size still fit after every
+*  compaction.
+*******************************************************************************/
+static void test_compaction(void)
+{
+    uint8_t value[KV_VALUE_MAX];
+    uint16_t len[KV_KEY_MAX];
+    uint32_t live = KV_TEST_SECTOR_HEADER_SIZE;
+    uint32_t sequence;
+    uint32_t count = 0U;
+    kv_store_stats_t stats;
+
+    TEST_CHECK(store_open(true));
+    for (uint16_t key = 0U; key < KV_KEY_MAX; key++)
+    {
+        memset(value, key, sizeof(value));
+        len[key] = KV_VALUE_MAX;
+        TEST_CHECK(kv_store_set(key, value, len[key]));
+    }
+
+    /* Update one key with short values until the sector is compacted */
+    sequence = store_stats().sequence;
+    len[0] = 4U;
+    do
+    {
+        memcpy(value, &count, sizeof(count));
+        count++;
+        TEST_CHECK(kv_store_set(0U, value, len[0]));
+    } while (sequence == store_stats().sequence);
+
+    /* Key 0 was copied before its new value was appended */
+    for (uint16_t key = 0U; key < KV_KEY_MAX; key++)
+    {
+        live += KV_TEST_RECORD_SIZE(len[key]);
+    }
+    stats = store_stats();
+    TEST_CHECK((live + KV_TEST_RECORD_SIZE(len[0])) == stats.used);
+    TEST_CHECK(KV_KEY_MAX == stats.keys);
+    TEST_CHECK((KV_FLASH_SECTOR_SIZE - stats.used) >=
+               KV_TEST_RECORD_SIZE(KV_VALUE_MAX));
+    TEST_CHECK(value_is(0U, value, len[0]));
+
+    /* Rewrite all keys with the largest values through several sectors */
+    for (uint32_t round = 0U; round < (3U * KV_FLASH_SECTOR_COUNT); round++)
+    {
+        for (uint16_t key = 0U; key < KV_KEY_MAX; key++)
+        {
+            memset(value, (int) (round + key), sizeof(value));
+            TEST_CHECK(kv_store_set(key, value, KV_VALUE_MAX));
+            TEST_CHECK(store_stats().used <= KV_FLASH_SECTOR_SIZE);
+        }
+    }
+    TEST_CHECK(store_stats().sequence > (sequence + KV_FLASH_SECTOR_COUNT));
+
+    TEST_CHECK(store_open(false));
+    TEST_CHECK(0U == store_stats().errors);
+    for (uint16_t key = 0U; key < KV_KEY_MAX; key++)
+    {
+        memset(value, (int) ((3U * KV_FLASH_SECTOR_COUNT) - 1U + key),
+               sizeof(value));
+        TEST_CHECK(value_is(key, value, KV_VALUE_MAX));
+    }
+}
+
+/*******************************************************************************
+* Function Name: test_boot_scan_bound
+********************************************************************************
+* Summary:
+*  The boot scan reads the sector headers and the log of one sector, however
+*  many sectors were written before, and reports the bytes it read.
+*******************************************************************************/
+static void test_boot_scan_bound(void)
+{
+    char value[32];
+    uint32_t records;
+    uint32_t sequence;
+    kv_store_stats_t stats;
+
+    TEST_CHECK(store_open(true));
+    fill_sector(1U, value, sizeof(value));
+    records = (store_stats().used - KV_TEST_SECTOR_HEADER_SIZE) /
+              KV_TEST_RECORD_SIZE(strlen(value));
+
+    TEST_CHECK(store_open(false));
+    stats = store_stats();
+    TEST_CHECK(records == stats.scan_records);
+    TEST_CHECK(kv_flash_file_read_bytes() == stats.scan_bytes);
+    TEST_CHECK(stats.scan_bytes <= stats.scan_bytes_max);
+    TEST_CHECK(stats.scan_bytes_max < (KV_FLASH_SECTOR_SIZE +
+               (KV_FLASH_SECTOR_COUNT * KV_TEST_SECTOR_HEADER_SIZE)));
+
+    /* Write every sector several times */
+    sequence = stats.sequence;
+    while (store_stats().sequence < (sequence + (2U * KV_FLASH_SECTOR_COUNT)))
+    {
+        next_sector(1U, value, sizeof(value));
+    }
+
+    TEST_CHECK(store_open(false));
+    stats = store_stats();
+    TEST_CHECK(kv_flash_file_read_bytes() == stats.scan_bytes);
+    TEST_CHECK(stats.scan_bytes <= stats.scan_bytes_max);
+    TEST_CHECK(string_is(1U, value));
+}
+
+/*******************************************************************************
+* Function Name: test_ring_wraparound
+********************************************************************************
+* Summary:
+*  The sectors are used in ring order past the last sector, and are erased
+*  equally often.
+*******************************************************************************/
+static void test_ring_wraparound(void)
+{
+    char value[32];
+    uint32_t sector;
+    uint32_t sequence;
+    uint32_t erases_min = UINT32_MAX;
+    uint32_t erases_max = 0U;
+
+    TEST_CHECK(store_open(true));
+    TEST_CHECK(set_string(1U, "a"));
+    kv_flash_file_reset_counts();
+    sector = store_stats().sector;
+    sequence = store_stats().sequence;
+
+    for (uint32_t count = 0U; count < (3U * KV_FLASH_SECTOR_COUNT); count++)
+    {
+        next_sector(2U, value, sizeof(value));
+        TEST_CHECK(((sector + 1U) % KV_FLASH_SECTOR_COUNT) ==
+                   store_stats().sector);
+        TEST_CHECK((sequence + 1U) == store_stats().sequence);
+        sector = store_stats().sector;
+        sequence = store_stats().sequence;
+    }
+
+    for (uint32_t i = 0U; i < KV_FLASH_SECTOR_COUNT; i++)
+    {
+        uint32_t erases = kv_flash_file_erases(i);
+
+        erases_min = (erases < erases_min) ? erases : erases_min;
+        erases_max = (erases > erases_max) ? erases : erases_max;
+    }
+    TEST_CHECK(erases_max == erases_min);
+
+    TEST_CHECK(store_open(false));
+    TEST_CHECK(sector == store_stats().sector);
+    TEST_CHECK(string_is(1U, "a"));
+    TEST_CHECK(string_is(2U, value));
+}
+
+/*******************************************************************************
+* Function Name: test_sequence_wraparound
+********************************************************************************
+* Summary:
+*  The newest sector is found when the sequence number wraps around.
+*******************************************************************************/
+static void test_sequence_wraparound(void)
+{
+    uint32_t header[4] = { KV_TEST_MAGIC, 0xFFFFFFFEUL, 0U, 0xFFFFFFFFUL };
+    char value[32];
+    uint32_t sequence;
+
+    /* Start from a sector close to the wraparound */
+    header[2] = sector_crc(header);
+    TEST_CHECK(kv_flash_file_open(KV_TEST_FILE, true));
+    TEST_CHECK(kv_flash_write(0U, header, sizeof(header)));
+    TEST_CHECK(kv_store_init());
+    TEST_CHECK(0U == store_stats().sector);
+    TEST_CHECK(0xFFFFFFFEUL == store_stats().sequence);
+    TEST_CHECK(set_string(1U, "kept"));
+
+    /* Sectors 1, 2, 3 and 0 get 0xFFFFFFFF, 0, 1 and 2 */
+    sequence = store_stats().sequence;
+    for (uint32_t count = 0U; count < KV_FLASH_SECTOR_COUNT; count++)
+    {
+        next_sector(2U, value, sizeof(value));
+        TEST_CHECK((sequence + 1U) == store_stats().sequence);
+        sequence = store_stats().sequence;
+
+        TEST_CHECK(store_open(false));
+        TEST_CHECK(sequence == store_stats().sequence);
+        TEST_CHECK(string_is(1U, "kept"));
+        TEST_CHECK(string_is(2U, value));
+    }
+    TEST_CHECK(2U == sequence);
+    TEST_CHECK(0U == store_stats().sector);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs the tests.
+*******************************************************************************/
+int main(void)
+{
+    TEST_RUN(test_set_get);
+    TEST_RUN(test_crc_rejection);
+    TEST_RUN(test_torn_append);
+    TEST_RUN(test_torn_compaction);
+    TEST_RUN(test_compaction);
+    TEST_RUN(test_boot_scan_bound);
+    TEST_RUN(test_ring_wraparound);
+    TEST_RUN(test_sequence_wraparound);
+
+    kv_flash_file_close();
+    (void) remove(KV_TEST_FILE);
+
+    return TEST_EXIT_STATUS();
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,84 @@
+/*******************************************************************************
+* File Name: FreeRTOS.h
+*
+* Description: This file is the host stand-in of the FreeRTOS kernel header. It
+*              has the types and macros used by the application modules that the
+*              host tests build; the functions are in freertos_host.c.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define configTICK_RATE_HZ                  (1000U)
+#define portTICK_PERIOD_MS                  (1000U / configTICK_RATE_HZ)
+#define configASSERT(x)                     assert(x)
+
+#define pdFALSE                             (0)
+#define pdTRUE                              (1)
+#define pdFAIL                              (pdFALSE)
+#define pdPASS                              (pdTRUE)
+
+#define portMAX_DELAY                       ((TickType_t) 0xFFFFFFFFUL)
+#define pdMS_TO_TICKS(ms)                   ((TickType_t) (((TickType_t) (ms) \
+                                            * configTICK_RATE_HZ) / 1000U))
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void *pvPortMalloc(size_t size);
+void vPortFree(void *p_data);
+
+#endif /* FREERTOS_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,68 @@
+/*******************************************************************************
+* File Name: cy_scb_i2c.h
+*
+* Description: This file is the host stand-in of the PDL SCB I2C driver header.
+*              It has the types used in the declarations of the EZI2C client.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef CY_SCB_I2C_H
+#define CY_SCB_I2C_H
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef enum
+{
+    CY_SCB_I2C_SUCCESS,
+    CY_SCB_I2C_BAD_PARAM,
+    CY_SCB_I2C_MASTER_NOT_READY,
+    CY_SCB_I2C_MASTER_MANUAL_TIMEOUT,
+    CY_SCB_I2C_MASTER_MANUAL_ADDR_NAK,
+    CY_SCB_I2C_MASTER_MANUAL_NAK,
+    CY_SCB_I2C_MASTER_MANUAL_ARB_LOST,
+    CY_SCB_I2C_MASTER_MANUAL_BUS_ERR,
+} cy_en_scb_i2c_status_t;
+
+typedef enum
+{
+    CY_SCB_I2C_WRITE_XFER,
+    CY_SCB_I2C_READ_XFER,
+} cy_en_scb_i2c_direction_t;
+
+#endif /* CY_SCB_I2C_H */
+
+/* [] END OF FILE */
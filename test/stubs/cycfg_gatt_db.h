@@ -0,0 +1,136 @@
+/*******************************************************************************
+* File Name: cycfg_gatt_db.h
+*
+* Description: This file is the host stand-in of the GATT database generated by
+*              the Bluetooth Configurator from design.cybt. It keeps the
+*              generated names and the handle layout of the configurator, the
+*              definitions are in host/cycfg_bt_host.c.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef CYCFG_GATT_DB_H
+#define CYCFG_GATT_DB_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Generic Access service */
+#define HDLS_GAP                                        (0x0001U)
+#define HDLC_GAP_DEVICE_NAME                            (0x0002U)
+#define HDLC_GAP_DEVICE_NAME_VALUE                      (0x0003U)
+#define HDLC_GAP_APPEARANCE                             (0x0004U)
+#define HDLC_GAP_APPEARANCE_VALUE                       (0x0005U)
+
+/* Generic Attribute service */
+#define HDLS_GATT                                       (0x0006U)
+#define HDLC_GATT_CLIENT_SUPPORTED_FEATURES             (0x0007U)
+#define HDLC_GATT_CLIENT_SUPPORTED_FEATURES_VALUE       (0x0008U)
+#define HDLC_GATT_DATABASE_HASH                         (0x0009U)
+#define HDLC_GATT_DATABASE_HASH_VALUE                   (0x000AU)
+
+/* CapSense service */
+#define HDLS_CAPSENSE                                   (0x000BU)
+#define HDLC_CAPSENSE_BUTTON                            (0x000CU)
+#define HDLC_CAPSENSE_BUTTON_VALUE                      (0x000DU)
+#define HDLD_CAPSENSE_BUTTON_CLIENT_CHAR_CONFIG         (0x000EU)
+#define HDLC_CAPSENSE_SLIDER                            (0x000FU)
+#define HDLC_CAPSENSE_SLIDER_VALUE                      (0x0010U)
+#define HDLD_CAPSENSE_SLIDER_CLIENT_CHAR_CONFIG         (0x0011U)
+#define HDLC_CAPSENSE_DIAGNOSTICS                       (0x0012U)
+#define HDLC_CAPSENSE_DIAGNOSTICS_VALUE                 (0x0013U)
+#define HDLD_CAPSENSE_DIAGNOSTICS_CLIENT_CHAR_CONFIG    (0x0014U)
+#define HDLC_CAPSENSE_STREAM                            (0x0015U)
+#define HDLC_CAPSENSE_STREAM_VALUE                      (0x0016U)
+#define HDLD_CAPSENSE_STREAM_CLIENT_CHAR_CONFIG         (0x0017U)
+#define HDLC_CAPSENSE_CONTROL                           (0x0018U)
+#define HDLC_CAPSENSE_CONTROL_VALUE                     (0x0019U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Attribute value of the lookup table */
+typedef struct
+{
+    uint16_t handle;
+    uint16_t max_len;
+    uint16_t cur_len;
+    uint8_t *p_data;
+} gatt_db_lookup_table_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern const uint8_t gatt_database[];
+extern const uint16_t gatt_database_len;
+extern gatt_db_lookup_table_t app_gatt_db_ext_attr_tbl[];
+extern const uint16_t app_gatt_db_ext_attr_tbl_size;
+
+extern uint8_t app_gap_device_name[];
+extern uint8_t app_gap_appearance[];
+extern uint8_t app_gatt_client_supported_features[];
+extern uint8_t app_gatt_database_hash[];
+extern uint8_t app_capsense_button[];
+extern uint8_t app_capsense_button_client_char_config[];
+extern uint8_t app_capsense_slider[];
+extern uint8_t app_capsense_slider_client_char_config[];
+extern uint8_t app_capsense_diagnostics[];
+extern uint8_t app_capsense_diagnostics_client_char_config[];
+extern uint8_t app_capsense_stream[];
+extern uint8_t app_capsense_stream_client_char_config[];
+extern uint8_t app_capsense_control[];
+
+extern const uint16_t app_gap_device_name_len;
+extern const uint16_t app_gap_appearance_len;
+extern const uint16_t app_gatt_client_supported_features_len;
+extern const uint16_t app_gatt_database_hash_len;
+extern const uint16_t app_capsense_button_len;
+extern const uint16_t app_capsense_button_client_char_config_len;
+extern const uint16_t app_capsense_slider_len;
+extern const uint16_t app_capsense_slider_client_char_config_len;
+extern const uint16_t app_capsense_diagnostics_len;
+extern const uint16_t app_capsense_diagnostics_client_char_config_len;
+extern const uint16_t app_capsense_stream_len;
+extern const uint16_t app_capsense_stream_client_char_config_len;
+extern const uint16_t app_capsense_control_len;
+
+#endif /* CYCFG_GATT_DB_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,110 @@
+/*******************************************************************************
+* File Name: wiced_bt_ble.h
+*
+* Description: This file is the host stand-in of the BTSTACK LE header. It has
+*              the advertising and link event types used by the application
+*              modules that the host tests build.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef WICED_BT_BLE_H
+#define WICED_BT_BLE_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include "wiced_bt_types.h"
+#include "wiced_result.h"
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Advertising modes */
+typedef enum
+{
+    BTM_BLE_ADVERT_OFF,
+    BTM_BLE_ADVERT_DIRECTED_HIGH,
+    BTM_BLE_ADVERT_DIRECTED_LOW,
+    BTM_BLE_ADVERT_UNDIRECTED_HIGH,
+    BTM_BLE_ADVERT_UNDIRECTED_LOW,
+    BTM_BLE_ADVERT_NONCONN_HIGH,
+    BTM_BLE_ADVERT_NONCONN_LOW,
+    BTM_BLE_ADVERT_DISCOVERABLE_HIGH,
+    BTM_BLE_ADVERT_DISCOVERABLE_LOW,
+} wiced_bt_ble_advert_mode_t;
+
+/* Connection parameter update event */
+typedef struct
+{
+    uint8_t status;
+    wiced_bt_device_address_t bd_addr;
+    uint16_t conn_interval;
+    uint16_t conn_latency;
+    uint16_t supervision_timeout;
+} wiced_bt_ble_connection_param_update_t;
+
+/* PHY update event */
+typedef struct
+{
+    uint8_t status;
+    wiced_bt_device_address_t bd_address;
+    uint8_t tx_phy;
+    uint8_t rx_phy;
+} wiced_bt_ble_phy_update_t;
+
+/* Data length update event */
+typedef struct
+{
+    wiced_bt_device_address_t bd_address;
+    uint16_t max_tx_octets;
+    uint16_t max_tx_time;
+    uint16_t max_rx_octets;
+    uint16_t max_rx_time;
+} wiced_bt_ble_phy_data_length_update_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+wiced_result_t wiced_bt_start_advertisements(
+        wiced_bt_ble_advert_mode_t advert_mode,
+        wiced_bt_ble_address_type_t directed_advertisement_bdaddr_type,
+        wiced_bt_device_address_ptr_t directed_advertisement_bdaddr_ptr);
+void wiced_bt_ble_security_grant(wiced_bt_device_address_t bd_addr,
+                                 uint8_t res);
+
+#endif /* WICED_BT_BLE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,210 @@
+/*******************************************************************************
+* File Name: wiced_bt_dev.h
+*
+* Description: This file is the host stand-in of the BTSTACK device management
+*              header. It has the management events and the security types used
+*              by the application modules that the host tests build.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef WICED_BT_DEV_H
+#define WICED_BT_DEV_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include "wiced_bt_types.h"
+#include "wiced_bt_ble.h"
+#include "wiced_result.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* IO capabilities, OOB data and authentication requirements */
+#define BTM_IO_CAPABILITIES_NONE            (3U)
+#define BTM_OOB_NONE                        (0U)
+#define BTM_LE_AUTH_REQ_BOND                (0x01U)
+#define BTM_LE_AUTH_REQ_SC_ONLY             (0x08U)
+#define BTM_LE_AUTH_REQ_SC_BOND                                               \
+    (BTM_LE_AUTH_REQ_SC_ONLY | BTM_LE_AUTH_REQ_BOND)
+
+/* LE key distribution */
+#define BTM_LE_KEY_PENC                     (0x01U)
+#define BTM_LE_KEY_PID                      (0x02U)
+#define BTM_LE_KEY_PCSRK                    (0x04U)
+#define BTM_LE_KEY_PLK                      (0x08U)
+#define BTM_LE_KEY_LENC                     (0x10U)
+#define BTM_LE_KEY_LID                      (0x20U)
+#define BTM_LE_KEY_LCSRK                    (0x40U)
+
+#define BTM_SECURITY_KEY_DATA_LEN           (132U)
+#define BTM_SECURITY_LOCAL_KEY_DATA_LEN     (65U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Management events */
+typedef enum
+{
+    BTM_ENABLED_EVT,
+    BTM_DISABLED_EVT,
+    BTM_PIN_REQUEST_EVT,
+    BTM_PASSKEY_REQUEST_EVT,
+    BTM_PAIRING_IO_CAPABILITIES_BLE_REQUEST_EVT,
+    BTM_PAIRING_COMPLETE_EVT,
+    BTM_ENCRYPTION_STATUS_EVT,
+    BTM_SECURITY_REQUEST_EVT,
+    BTM_PAIRED_DEVICE_LINK_KEYS_UPDATE_EVT,
+    BTM_PAIRED_DEVICE_LINK_KEYS_REQUEST_EVT,
+    BTM_LOCAL_IDENTITY_KEYS_UPDATE_EVT,
+    BTM_LOCAL_IDENTITY_KEYS_REQUEST_EVT,
+    BTM_BLE_ADVERT_STATE_CHANGED_EVT,
+    BTM_BLE_CONNECTION_PARAM_UPDATE,
+    BTM_BLE_PHY_UPDATE_EVT,
+    BTM_BLE_DATA_LENGTH_UPDATE_EVENT,
+} wiced_bt_management_evt_t;
+
+typedef struct
+{
+    wiced_result_t status;
+} wiced_bt_dev_enabled_t;
+
+typedef struct
+{
+    wiced_bt_device_address_t bd_addr;
+    uint8_t local_io_cap;
+    uint8_t oob_data;
+    uint8_t auth_req;
+    uint8_t max_key_size;
+    uint8_t init_keys;
+    uint8_t resp_keys;
+} wiced_bt_dev_ble_io_caps_req_t;
+
+typedef struct
+{
+    uint8_t status;
+    uint8_t reason;
+    uint8_t sec_level;
+    wiced_bool_t privacy_supported;
+    wiced_bt_device_address_t resolved_bd_addr;
+    wiced_bt_ble_address_type_t resolved_bd_addr_type;
+} wiced_bt_dev_ble_pairing_info_t;
+
+typedef struct
+{
+    uint8_t *bd_addr;
+    wiced_bt_transport_t transport;
+    union
+    {
+        wiced_bt_dev_ble_pairing_info_t ble;
+    } pairing_complete_info;
+    uint8_t bonding_status;
+} wiced_bt_dev_pairing_cplt_t;
+
+typedef struct
+{
+    uint8_t *bd_addr;
+    wiced_bt_transport_t transport;
+    wiced_result_t result;
+} wiced_bt_dev_encryption_status_t;
+
+typedef struct
+{
+    wiced_bt_device_address_t bd_addr;
+    wiced_bt_transport_t transport;
+} wiced_bt_dev_security_request_t;
+
+/* Keys of a bonded peer. The stack treats the key data as opaque. */
+typedef struct
+{
+    uint8_t le_keys_available_mask;
+    wiced_bt_ble_address_type_t ble_addr_type;
+    wiced_bt_ble_address_type_t static_addr_type;
+    wiced_bt_device_address_t static_addr;
+    uint8_t le_keys[BTM_SECURITY_KEY_DATA_LEN];
+} wiced_bt_device_sec_keys_t;
+
+typedef struct
+{
+    wiced_bt_device_address_t bd_addr;
+    wiced_bt_device_sec_keys_t key_data;
+} wiced_bt_device_link_keys_t;
+
+typedef struct
+{
+    uint8_t local_key_data[BTM_SECURITY_LOCAL_KEY_DATA_LEN];
+} wiced_bt_local_identity_keys_t;
+
+/* Management event data */
+typedef union
+{
+    wiced_bt_dev_enabled_t enabled;
+    wiced_bt_ble_advert_mode_t ble_advert_state_changed;
+    wiced_bt_ble_connection_param_update_t ble_connection_param_update;
+    wiced_bt_ble_phy_update_t ble_phy_update_event;
+    wiced_bt_ble_phy_data_length_update_t ble_data_length_update_event;
+    wiced_bt_dev_ble_io_caps_req_t pairing_io_capabilities_ble_request;
+    wiced_bt_dev_pairing_cplt_t pairing_complete;
+    wiced_bt_dev_security_request_t security_request;
+    wiced_bt_dev_encryption_status_t encryption_status;
+    wiced_bt_device_link_keys_t paired_device_link_keys_update;
+    wiced_bt_device_link_keys_t paired_device_link_keys_request;
+    wiced_bt_local_identity_keys_t local_identity_keys_update;
+    wiced_bt_local_identity_keys_t local_identity_keys_request;
+} wiced_bt_management_evt_data_t;
+
+typedef wiced_result_t (wiced_bt_management_cback_t)(
+        wiced_bt_management_evt_t event,
+        wiced_bt_management_evt_data_t *p_event_data);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+wiced_result_t wiced_bt_set_local_bdaddr(wiced_bt_device_address_t bd_addr,
+                                         wiced_bt_ble_address_type_t type);
+void wiced_bt_dev_read_local_addr(wiced_bt_device_address_t bd_addr);
+void wiced_bt_set_pairable_mode(uint8_t allow_pairing,
+                                uint8_t connect_only_paired);
+wiced_result_t wiced_bt_dev_delete_bonded_device(
+        wiced_bt_device_address_t bd_addr);
+wiced_result_t wiced_bt_dev_add_device_to_address_resolution_db(
+        wiced_bt_device_link_keys_t *p_link_keys);
+wiced_result_t wiced_bt_dev_remove_device_from_address_resolution_db(
+        wiced_bt_device_link_keys_t *p_link_keys);
+
+#endif /* WICED_BT_DEV_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,274 @@
+/*******************************************************************************
+* File Name: wiced_bt_gatt.h
+*
+* Description: This file is the host stand-in of the BTSTACK GATT header. It has
+*              the GATT events, requests and server functions used by the
+*              application modules that the host tests build.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef WICED_BT_GATT_H
+#define WICED_BT_GATT_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include "wiced_bt_types.h"
+#include "wiced_result.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define GATT_CLIENT_CONFIG_NONE             (0x0000U)
+#define GATT_CLIENT_CONFIG_NOTIFICATION     (0x0001U)
+#define GATT_CLIENT_CONFIG_INDICATION       (0x0002U)
+
+/* Largest ATT MTU of the stack */
+#define GATT_BLE_DEFAULT_MTU_SIZE           (23U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* GATT status codes, the ATT error codes of the specification */
+typedef enum
+{
+    WICED_BT_GATT_SUCCESS                   = 0x00,
+    WICED_BT_GATT_INVALID_HANDLE            = 0x01,
+    WICED_BT_GATT_READ_NOT_PERMIT           = 0x02,
+    WICED_BT_GATT_WRITE_NOT_PERMIT          = 0x03,
+    WICED_BT_GATT_INVALID_PDU               = 0x04,
+    WICED_BT_GATT_INSUF_AUTHENTICATION      = 0x05,
+    WICED_BT_GATT_REQ_NOT_SUPPORTED         = 0x06,
+    WICED_BT_GATT_INVALID_OFFSET            = 0x07,
+    WICED_BT_GATT_INSUF_AUTHORIZATION       = 0x08,
+    WICED_BT_GATT_PREPARE_Q_FULL            = 0x09,
+    WICED_BT_GATT_ATTRIBUTE_NOT_FOUND       = 0x0A,
+    WICED_BT_GATT_NOT_LONG                  = 0x0B,
+    WICED_BT_GATT_INSUF_KEY_SIZE            = 0x0C,
+    WICED_BT_GATT_INVALID_ATTR_LEN          = 0x0D,
+    WICED_BT_GATT_ERR_UNLIKELY              = 0x0E,
+    WICED_BT_GATT_INSUF_ENCRYPTION          = 0x0F,
+    WICED_BT_GATT_UNSUPPORT_GRP_TYPE        = 0x10,
+    WICED_BT_GATT_INSUF_RESOURCE            = 0x11,
+    WICED_BT_GATT_DATABASE_OUT_OF_SYNC      = 0x12,
+    WICED_BT_GATT_VALUE_NOT_ALLOWED         = 0x13,
+    WICED_BT_GATT_WRITE_REQ_REJECTED        = 0xFC,
+    WICED_BT_GATT_CCCD_IMPROPER_CONFIGURED  = 0xFD,
+    WICED_BT_GATT_BUSY                      = 0xFE,
+    WICED_BT_GATT_OUT_OF_RANGE              = 0xFF,
+    WICED_BT_GATT_ILLEGAL_PARAMETER         = 0x8780,
+    WICED_BT_GATT_NO_RESOURCES              = 0x8781,
+    WICED_BT_GATT_INTERNAL_ERROR            = 0x8783,
+    WICED_BT_GATT_WRONG_STATE               = 0x8784,
+    WICED_BT_GATT_DB_FULL                   = 0x8785,
+    WICED_BT_GATT_ERROR                     = 0x8787,
+} wiced_bt_gatt_status_e;
+
+typedef uint16_t wiced_bt_gatt_status_t;
+
+/* ATT opcodes */
+typedef enum
+{
+    GATT_RSP_ERROR                          = 0x01,
+    GATT_REQ_MTU                            = 0x02,
+    GATT_RSP_MTU                            = 0x03,
+    GATT_REQ_READ_BY_TYPE                   = 0x08,
+    GATT_RSP_READ_BY_TYPE                   = 0x09,
+    GATT_REQ_READ                           = 0x0A,
+    GATT_RSP_READ                           = 0x0B,
+    GATT_REQ_READ_BLOB                      = 0x0C,
+    GATT_RSP_READ_BLOB                      = 0x0D,
+    GATT_REQ_READ_MULTI                     = 0x0E,
+    GATT_RSP_READ_MULTI                     = 0x0F,
+    GATT_REQ_WRITE                          = 0x12,
+    GATT_RSP_WRITE                          = 0x13,
+    GATT_HANDLE_VALUE_NOTIF                 = 0x1B,
+    GATT_HANDLE_VALUE_IND                   = 0x1D,
+    GATT_HANDLE_VALUE_CONF                  = 0x1E,
+    GATT_REQ_READ_MULTI_VAR_LENGTH          = 0x20,
+    GATT_RSP_READ_MULTI_VAR_LENGTH          = 0x21,
+    GATT_CMD_WRITE                          = 0x52,
+} wiced_bt_gatt_opcode_e;
+
+typedef uint8_t wiced_bt_gatt_opcode_t;
+
+/* GATT events */
+typedef enum
+{
+    GATT_CONNECTION_STATUS_EVT,
+    GATT_OPERATION_CPLT_EVT,
+    GATT_DISCOVERY_RESULT_EVT,
+    GATT_DISCOVERY_CPLT_EVT,
+    GATT_ATTRIBUTE_REQUEST_EVT,
+    GATT_CONGESTION_EVT,
+    GATT_GET_RESPONSE_BUFFER_EVT,
+    GATT_APP_BUFFER_TRANSMITTED_EVT,
+} wiced_bt_gatt_evt_t;
+
+/* Database Hash computed by wiced_bt_gatt_db_init() */
+typedef uint8_t wiced_bt_db_hash_t[16];
+
+typedef struct
+{
+    uint16_t handle;
+    uint16_t offset;
+} wiced_bt_gatt_read_t;
+
+typedef struct
+{
+    uint16_t s_handle;
+    uint16_t e_handle;
+    wiced_bt_uuid_t uuid;
+} wiced_bt_gatt_read_by_type_t;
+
+typedef struct
+{
+    uint16_t num_handles;
+    uint8_t *p_handle_stream;
+} wiced_bt_gatt_read_multiple_req_t;
+
+typedef struct
+{
+    uint16_t handle;
+    uint16_t offset;
+    uint16_t val_len;
+    uint8_t *p_val;
+} wiced_bt_gatt_write_req_t;
+
+typedef union
+{
+    wiced_bt_gatt_read_t read_req;
+    wiced_bt_gatt_read_by_type_t read_by_type;
+    wiced_bt_gatt_read_multiple_req_t read_multiple_req;
+    wiced_bt_gatt_write_req_t write_req;
+    uint16_t remote_mtu;
+    uint16_t confirm_handle;
+} wiced_bt_gatt_request_data_t;
+
+typedef struct
+{
+    uint16_t conn_id;
+    wiced_bt_gatt_opcode_t opcode;
+    wiced_bt_gatt_request_data_t data;
+    uint16_t len_requested;
+} wiced_bt_gatt_attribute_request_t;
+
+typedef struct
+{
+    uint8_t *bd_addr;
+    wiced_bt_ble_address_type_t addr_type;
+    uint16_t conn_id;
+    wiced_bool_t connected;
+    uint16_t reason;
+    wiced_bt_transport_t transport;
+    uint8_t link_role;
+} wiced_bt_gatt_connection_status_t;
+
+typedef struct
+{
+    uint8_t *p_app_rsp_buffer;
+    void *p_app_ctxt;
+} wiced_bt_gatt_buffer_t;
+
+typedef struct
+{
+    uint16_t len_requested;
+    wiced_bt_gatt_buffer_t buffer;
+} wiced_bt_gatt_buffer_request_t;
+
+typedef struct
+{
+    uint8_t *p_app_data;
+    void *p_app_ctxt;
+} wiced_bt_gatt_buffer_transmitted_t;
+
+typedef union
+{
+    wiced_bt_gatt_connection_status_t connection_status;
+    wiced_bt_gatt_attribute_request_t attribute_request;
+    wiced_bt_gatt_buffer_request_t buffer_request;
+    wiced_bt_gatt_buffer_transmitted_t buffer_xmitted;
+} wiced_bt_gatt_event_data_t;
+
+typedef wiced_bt_gatt_status_t (wiced_bt_gatt_cback_t)(
+        wiced_bt_gatt_evt_t event, wiced_bt_gatt_event_data_t *p_event_data);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+wiced_bt_gatt_status_t wiced_bt_gatt_register(
+        wiced_bt_gatt_cback_t *p_gatt_cback);
+wiced_bt_gatt_status_t wiced_bt_gatt_db_init(const uint8_t *p_gatt_db,
+        uint32_t gatt_db_size, wiced_bt_db_hash_t hash);
+wiced_bt_gatt_status_t wiced_bt_gatt_disconnect(uint16_t conn_id);
+
+uint16_t wiced_bt_gatt_find_handle_by_type(uint16_t s_handle,
+        uint16_t e_handle, wiced_bt_uuid_t *p_uuid);
+int wiced_bt_gatt_get_handle_from_stream(uint8_t *p_stream,
+        uint16_t stream_offset);
+int wiced_bt_gatt_put_read_by_type_rsp_in_stream(uint8_t *p_stream,
+        int stream_len, uint8_t *p_pair_len, uint16_t attr_handle,
+        uint16_t attr_len, const uint8_t *p_attr);
+int wiced_bt_gatt_put_read_multi_rsp_in_stream(wiced_bt_gatt_opcode_t opcode,
+        uint8_t *p_stream, int stream_len, uint16_t attr_handle,
+        uint16_t attr_len, const uint8_t *p_attr);
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_notification(
+        uint16_t conn_id, uint16_t attr_handle, uint16_t val_len,
+        uint8_t *p_val, void *p_app_ctx);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_indication(uint16_t conn_id,
+        uint16_t attr_handle, uint16_t val_len, uint8_t *p_val,
+        void *p_app_ctx);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_handle_rsp(
+        uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint16_t len,
+        uint8_t *p_attr, void *p_app_ctx);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_by_type_rsp(
+        uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint8_t type_len,
+        uint16_t data_len, uint8_t *p_data, void *p_app_ctx);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_multiple_rsp(
+        uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint16_t len,
+        uint8_t *p_rsp, void *p_app_ctx);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_mtu_rsp(uint16_t conn_id,
+        uint16_t remote_mtu, uint16_t local_mtu);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_write_rsp(uint16_t conn_id,
+        wiced_bt_gatt_opcode_t opcode, uint16_t handle);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_error_rsp(uint16_t conn_id,
+        wiced_bt_gatt_opcode_t opcode, uint16_t handle,
+        wiced_bt_gatt_status_t status);
+
+#endif /* WICED_BT_GATT_H */
+
+/* [] END OF FILE */
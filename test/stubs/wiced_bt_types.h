@@ -0,0 +1,101 @@
+/*******************************************************************************
+* File Name: wiced_bt_types.h
+*
+* Description: This file is the host stand-in of the BTSTACK type header. It has
+*              the types and constants used by the application modules that the
+*              host tests build.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef WICED_BT_TYPES_H
+#define WICED_BT_TYPES_H
+
+/*******************************************************************************
+* Header file includes
+*******************************************************************************/
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TRUE                                (1U)
+#define FALSE                               (0U)
+#define WICED_TRUE                          (1U)
+#define WICED_FALSE                         (0U)
+
+#ifndef MIN
+#define MIN(a, b)                           (((a) < (b)) ? (a) : (b))
+#endif
+#ifndef MAX
+#define MAX(a, b)                           (((a) > (b)) ? (a) : (b))
+#endif
+
+#define BD_ADDR_LEN                         (6U)
+
+#define BLE_ADDR_PUBLIC                     (0x00U)
+#define BLE_ADDR_RANDOM                     (0x01U)
+
+#define BT_TRANSPORT_LE                     (2U)
+
+#define LEN_UUID_16                         (2U)
+#define LEN_UUID_32                         (4U)
+#define LEN_UUID_128                        (16U)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef uint8_t wiced_bool_t;
+typedef uint8_t wiced_bt_device_address_t[BD_ADDR_LEN];
+typedef uint8_t *wiced_bt_device_address_ptr_t;
+typedef uint8_t wiced_bt_ble_address_type_t;
+typedef uint8_t wiced_bt_transport_t;
+
+typedef struct
+{
+    uint16_t len;                   /* LEN_UUID_xx */
+    union
+    {
+        uint16_t uuid16;
+        uint32_t uuid32;
+        uint8_t uuid128[LEN_UUID_128];
+    } uu;
+} wiced_bt_uuid_t;
+
+#endif /* WICED_BT_TYPES_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,57 @@
+/*******************************************************************************
+* File Name: wiced_bt_uuid.h
+*
+* Description: This file is the host stand-in of the BTSTACK UUID header.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* (c) 2023-2026, Infineon Technologies AG, or an affiliate of Infineon
+* Technologies AG. All rights reserved.
+* This software, associated documentation and materials ("Software") is
+* owned by Infineon Technologies AG or one of its affiliates ("Infineon")
+* and is protected by and subject to worldwide patent protection, worldwide
+* copyright laws, and international treaty provisions. Therefore, you may use
+* this Software only as provided in the license agreement accompanying the
+* software package from which you obtained this Software. If no license
+* agreement applies, then any use, reproduction, modification, translation, or
+* compilation of this Software is prohibited without the express written
+* permission of Infineon.
+*
+* Disclaimer: UNLESS OTHERWISE EXPRESSLY AGREED WITH INFINEON, THIS SOFTWARE
+* IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+* INCLUDING, BUT NOT LIMITED TO, ALL WARRANTIES OF NON-INFRINGEMENT OF
+* THIRD-PARTY RIGHTS AND IMPLIED WARRANTIES SUCH AS WARRANTIES OF FITNESS FOR A
+* SPECIFIC USE/PURPOSE OR MERCHANTABILITY.
+* Infineon reserves the right to make changes to the Software without notice.
+* You are responsible for properly designing, programming, and testing the
+* functionality and safety of your intended application of the Software, as
+* well as complying with any legal requirements related to its use. Infineon
+* does not guarantee that the Software will be free from intrusion, data theft
+* or loss, or other breaches ("Security Breaches"), and Infineon shall have
+* no liability arising out of any Security Breaches. Unless otherwise
+* explicitly approved by Infineon, the Software may not be used in any
+* application where a failure of the Product or any consequences of the use
+* thereof can reasonably be expected to result in personal injury.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef WICED_BT_UUID_H
+#define WICED_BT_UUID_H
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define GATT_UUID_PRI_SERVICE               (0x2800U)
+#define GATT_UUID_CHAR_DECLARE              (0x2803U)
+#define GATT_UUID_CHAR_CLIENT_CONFIG        (0x2902U)
+#define GATT_UUID_GAP_DEVICE_NAME           (0x2A00U)
+#define GATT_UUID_GAP_ICON                  (0x2A01U)
+#define GATT_UUID_CLIENT_SUP_FEAT           (0x2B29U)
+#define GATT_UUID_DATABASE_HASH             (0x2B2AU)
+
+#endif /* WICED_BT_UUID_H */
+
+/* [] END OF FILE */